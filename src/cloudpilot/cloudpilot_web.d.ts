@@ -3,8 +3,10 @@ import 'emscripten';
 
 import { Cloudpilot, RomInfo, VoidPtr } from './web/binding/binding';
 import {
+    FrameDiffEncoder as FrameDiffEncoderImpl,
     GunzipContext as GunzipContextImpl,
     ZipfileWalker as ZipfileWalkerImpl,
+    ModuleWithFrameDiffEncoder,
     ModuleWithGunzipContext,
     ModuleWithZipfileWalker,
 } from '../common/web/common';
@@ -14,11 +16,13 @@ export { GunzipState, ZipfileWalkerState } from '../common/web/common';
 
 export type GunzipContext = GunzipContextImpl<VoidPtr>;
 export type ZipfileWalker = ZipfileWalkerImpl<VoidPtr>;
+export type FrameDiffEncoder = FrameDiffEncoderImpl<VoidPtr>;
 
 export interface Module
     extends Omit<EmscriptenModule, 'instantiateWasm'>,
         ModuleWithGunzipContext<VoidPtr>,
-        ModuleWithZipfileWalker<VoidPtr> {
+        ModuleWithZipfileWalker<VoidPtr>,
+        ModuleWithFrameDiffEncoder<VoidPtr> {
     addFunction: typeof addFunction;
     getPointer(ptr: VoidPtr): number;
     UTF8ToString(charPtr: number): string;
@@ -35,6 +39,7 @@ export interface Module
     destroy(sessionImage: SessionImage): void;
     destroy(skinLoader: SkinLoader): void;
     destroy(gunzipContext: GunzipContext): void;
+    destroy(frameDiffEncoder: FrameDiffEncoder): void;
 }
 
 declare const createModule: (moduleOverrides: Partial<Module>) => Promise<Module>;
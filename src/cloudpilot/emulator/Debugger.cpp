@@ -22,6 +22,8 @@ void* gDebuggerPtr = &gDebugger;
 
 Debugger::BreakState Debugger::GetBreakState() const { return breakState; }
 
+bool Debugger::IsEnabled() const { return enabled; }
+
 bool Debugger::IsStopped() const { return breakState != BreakState::none; }
 
 bool Debugger::IsStepping() const { return stepping; }
@@ -28,6 +28,7 @@ class Debugger {
     Debugger() = default;
 
     BreakState GetBreakState() const;
+    bool IsEnabled() const;
     bool IsStopped() const;
     bool IsStepping() const;
 
@@ -25,6 +25,7 @@
 #include "EmLowMem.h"       // TrapExists
 #include "EmPalmStructs.h"  // SysLibTblEntryType, RecordEntryType, RsrcEntryType, etc.
 #include "EmSession.h"      // ExecuteUntilIdle, gSession
+#include "Logging.h"
 #include "Miscellaneous.h"  // StMemoryMapper
 #include "Platform.h"       // Platform::DisposeMemory
 #include "ROMStubs.h"  // ExgLibControl, DmFindDatabase, EvtEnqueueKey, EvtWakeup, DmDeleteDatabase, DmCreateDatabase...
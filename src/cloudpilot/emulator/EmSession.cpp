@@ -19,10 +19,12 @@
 #include "MetaMemory.h"
 #include "Miscellaneous.h"
 #include "NetworkProxy.h"
+#include "Platform.h"
 #include "ROMStubs.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
+#include "SessionDelta.h"
 #include "SessionImage.h"
 #include "SuspendManager.h"
 
@@ -122,6 +124,8 @@ void EmSession::Deinitialize() {
     romSize = 0;
     romImage.reset();
     savestate.Reset();
+    deltaSavestate.reset();
+    deltaSavestateSize = 0;
 
     gExternalStorage.UnmountAll();
 
@@ -147,6 +151,48 @@ bool EmSession::SaveImage(SessionImage& image) {
     return image.Serialize();
 }
 
+bool EmSession::SaveBaseImage(SessionImage& image) {
+    deltaSavestate.reset();
+
+    if (!SaveImage(image)) return false;
+
+    deltaSavestateSize = savestate.GetSize();
+    deltaSavestate = make_unique<uint8[]>(deltaSavestateSize);
+    memcpy(deltaSavestate.get(), savestate.GetBuffer(), deltaSavestateSize);
+
+    memset(GetDirtyPagesPtr(), 0, SessionDelta::DirtyPagesSize(GetMemorySize()));
+
+    return true;
+}
+
+bool EmSession::SaveImageDelta(SessionDelta& delta) {
+    if (!deltaSavestate) {
+        logging::printf("unable to save delta: no base image");
+        return false;
+    }
+
+    if (!savestate.Save(*this) || savestate.GetSize() != deltaSavestateSize) {
+        logging::printf("failed to save savestate");
+        return false;
+    }
+
+    delta.Reset(GetMemorySize(), deltaSavestateSize);
+    delta.AddDirtyPages(GetDirtyPagesPtr(), GetMemoryPtr());
+
+    uint8* currentSavestate = static_cast<uint8*>(savestate.GetBuffer());
+
+    delta.AddSavestateChanges(currentSavestate, deltaSavestate.get());
+    memcpy(deltaSavestate.get(), currentSavestate, deltaSavestateSize);
+
+    if (!delta.Serialize()) {
+        // The pages in this delta are gone from the bitmap, so the chain cannot be continued
+        deltaSavestate.reset();
+        return false;
+    }
+
+    return true;
+}
+
 bool EmSession::LoadImage(SessionImage& image) {
     EmDevice* device = new EmDevice(image.GetDeviceId());
     if (device->GetIDString() != device->GetIDString()) {
@@ -214,10 +260,10 @@ void EmSession::Save(T& savestate) {
     gExternalStorage.Save(savestate);
 }
 
-template void EmSession::Save(Savestate& savestate);
-template void EmSession::Save(SavestateProbe& savestate);
+template void EmSession::Save(Savestate<ChunkType>& savestate);
+template void EmSession::Save(SavestateProbe<ChunkType>& savestate);
 
-void EmSession::Load(SavestateLoader& loader) {
+void EmSession::Load(SavestateLoader<ChunkType>& loader) {
     EmAssert(device);
     EmAssert(cpu);
 
@@ -273,7 +319,7 @@ bool EmSession::Save() {
 }
 
 bool EmSession::Load(size_t size, uint8* buffer) {
-    SavestateLoader loader;
+    SavestateLoader<ChunkType> loader;
 
     if (!loader.Load(buffer, size, *this)) {
         Reset(ResetType::soft);
@@ -286,7 +332,7 @@ bool EmSession::Load(size_t size, uint8* buffer) {
     return true;
 }
 
-Savestate& EmSession::GetSavestate() { return savestate; }
+Savestate<ChunkType>& EmSession::GetSavestate() { return savestate; }
 
 pair<size_t, uint8*> EmSession::GetRomImage() {
     EmAssert(romImage);
@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "ButtonEvent.h"
+#include "ChunkType.h"
 #include "EmCPU.h"
 #include "EmCommon.h"
 #include "EmDevice.h"
@@ -18,7 +19,9 @@
 #include "PenEvent.h"
 #include "Savestate.h"
 
+template <typename ChunkType>
 class SavestateLoader;
+class SessionDelta;
 class SessionImage;
 
 class EmSession {
@@ -31,16 +34,21 @@ class EmSession {
     bool SaveImage(SessionImage& image);
     bool LoadImage(SessionImage& image);
 
+    // Incremental snapshots. SaveBaseImage saves a full image and starts a chain of deltas, each
+    // holding the changes since the previous snapshot. Both clear the dirty page bitmap.
+    bool SaveBaseImage(SessionImage& image);
+    bool SaveImageDelta(SessionDelta& delta);
+
     template <typename T>
     void Save(T& savestate);
-    void Load(SavestateLoader& loader);
+    void Load(SavestateLoader<ChunkType>& loader);
 
     bool Save();
     bool Load(size_t size, uint8* buffer);
 
     void Reset(ResetType);
 
-    Savestate& GetSavestate();
+    Savestate<ChunkType>& GetSavestate();
     pair<size_t, uint8*> GetRomImage();
 
     uint32 RunEmulation(uint32 maxCycles = 10000);
@@ -141,7 +149,11 @@ class EmSession {
 
     unique_ptr<uint8[]> romImage;
     size_t romSize{0};
-    Savestate savestate;
+    Savestate<ChunkType> savestate;
+
+    // Savestate of the previous snapshot in a delta chain
+    unique_ptr<uint8[]> deltaSavestate;
+    size_t deltaSavestateSize{0};
 
     bool deadMansSwitch{false};
 
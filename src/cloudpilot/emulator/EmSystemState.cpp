@@ -39,10 +39,10 @@ void EmSystemState::Save(T& savestate) {
     DoSaveLoad(helper, SAVESTATE_VERSION);
 }
 
-template void EmSystemState::Save(Savestate& savestate);
-template void EmSystemState::Save(SavestateProbe& savestate);
+template void EmSystemState::Save(Savestate<ChunkType>& savestate);
+template void EmSystemState::Save(SavestateProbe<ChunkType>& savestate);
 
-void EmSystemState::Load(SavestateLoader& loader) {
+void EmSystemState::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::systemState);
     if (!chunk) return;
 
@@ -1,9 +1,11 @@
 #ifndef _EM_SYSTEM_STATE_H_
 #define _EM_SYSTEM_STATE_H_
 
+#include "ChunkType.h"
 #include "EmCommon.h"
 #include "EmEvent.h"
 
+template <typename ChunkType>
 class SavestateLoader;
 
 class EmSystemState {
@@ -16,7 +18,7 @@ class EmSystemState {
     template <typename T>
     void Save(T& savestate);
 
-    void Load(SavestateLoader& loader);
+    void Load(SavestateLoader<ChunkType>& loader);
 
     void SetOSVersion(uint32 version);
     uint32 OSVersion(void) const;
@@ -2,6 +2,7 @@
 
 #include "ChunkHelper.h"
 #include "EmSPISlaveSD.h"
+#include "Logging.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -164,10 +165,10 @@ void ExternalStorage::Save(T& savestate) {
     DoSaveLoad(helper);
 }
 
-template void ExternalStorage::Save<Savestate>(Savestate&);
-template void ExternalStorage::Save<SavestateProbe>(SavestateProbe&);
+template void ExternalStorage::Save<Savestate<ChunkType>>(Savestate<ChunkType>&);
+template void ExternalStorage::Save<SavestateProbe<ChunkType>>(SavestateProbe<ChunkType>&);
 
-void ExternalStorage::Load(SavestateLoader& loader) {
+void ExternalStorage::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::externalStorage);
     if (!chunk) return;
 
@@ -3,9 +3,22 @@
 #include <cstdarg>
 #include <cstdio>
 
+#include "LoggingHook.h"
+
 namespace {
     bool loggingEnabled = true;
     uint32 enabledDomains = 0;
+
+    void commonHandler(const char* format, va_list args) {
+        if (!loggingEnabled) return;
+
+        vfprintf(stderr, format, args);
+        fprintf(stderr, "\n");
+    }
+
+    // Messages from the code shared with uarm are subject to the same switch
+    [[maybe_unused]] const bool commonHandlerInstalled =
+        (logging::setCommonHandler(commonHandler), true);
 }  // namespace
 
 int logging::printf(const char* format, ...) {
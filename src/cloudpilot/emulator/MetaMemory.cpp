@@ -21,9 +21,37 @@
 #include "MemoryRegion.h"
 
 set<emuptr> MetaMemory::breakpoints;
+uint32 MetaMemory::breakpointPages[MetaMemory::kBreakpointPageBits / 32];
 
 void MetaMemory::Clear() { EmAssert(breakpoints.size() == 0); }
 
+// ---------------------------------------------------------------------------
+//		� MetaMemory::MarkInstructionBreak
+// ---------------------------------------------------------------------------
+
+void MetaMemory::MarkInstructionBreak(emuptr opcodeLocation) {
+    const uint32 page = BreakpointPage(opcodeLocation);
+
+    breakpoints.insert(opcodeLocation);
+    breakpointPages[page >> 5] |= 1u << (page & 31);
+}
+
+// ---------------------------------------------------------------------------
+//		� MetaMemory::UnmarkInstructionBreak
+// ---------------------------------------------------------------------------
+
+void MetaMemory::UnmarkInstructionBreak(emuptr opcodeLocation) {
+    const uint32 page = BreakpointPage(opcodeLocation);
+
+    breakpoints.erase(opcodeLocation);
+
+    // Pages are folded, so other breakpoints may share the bit
+    for (emuptr breakpoint : breakpoints)
+        if (BreakpointPage(breakpoint) == page) return;
+
+    breakpointPages[page >> 5] &= ~(1u << (page & 31));
+}
+
 void MetaMemory::MarkRange(emuptr start, emuptr end, uint8 v) {
     if (end <= start) return;
 
@@ -37,6 +37,12 @@ class MetaMemory {
     static Bool IsScreenBuffer32(uint8* metaAddress);  // Inlined, defined below
     static Bool IsScreenBuffer(uint8* metaAddress, uint32 size);
 
+    static void MarkPredecoded(uint8* metaAddress, uint32 size);    // Inlined, defined below
+    static void UnmarkPredecoded(uint8* metaAddress, uint32 size);  // Inlined, defined below
+    static Bool IsPredecoded8(uint8* metaAddress);                  // Inlined, defined below
+    static Bool IsPredecoded16(uint8* metaAddress);                 // Inlined, defined below
+    static Bool IsPredecoded32(uint8* metaAddress);                 // Inlined, defined below
+
    private:
     static void MarkRange(emuptr start, emuptr end, uint8 v);
     static void UnmarkRange(emuptr start, emuptr end, uint8 v);
@@ -44,11 +50,19 @@ class MetaMemory {
 
     static std::set<emuptr> breakpoints;
 
+    // One bit per 256 byte page, folded into 64k bits. IsCPUBreak only consults
+    // the set if the bit for the page is set.
+    enum { kBreakpointPageShift = 8, kBreakpointPageBits = 0x10000 };
+
+    static uint32 breakpointPages[kBreakpointPageBits / 32];
+
+    static uint32 BreakpointPage(emuptr opcodeLocation);
+
     enum {
         kNoAppAccess = 0x0001,
         kNoSystemAccess = 0x0002,
         kNoMemMgrAccess = 0x0004,
-        kUnusedMeta1 = 0x0008,
+        kPredecoded = 0x0008,    // Instruction words cached by the CPU; invalidate if changed.
         kStackBuffer = 0x0010,   // Stack buffer; check to see if below-SP access is made.
         kScreenBuffer = 0x0020,  // Screen buffer; update host screen if these bytes are changed.
         kInstructionBreak = 0x0040,  // Halt CPU emulation and check to see why.
@@ -139,7 +153,41 @@ inline Bool MetaMemory::IsScreenBuffer32(uint8* metaAddress) {
     return (META_VALUE_32(metaAddress) & kMask) != 0;
 }
 
+inline void MetaMemory::MarkPredecoded(uint8* metaAddress, uint32 size) {
+    for (uint32 ii = 0; ii < size; ++ii) metaAddress[ii] |= kPredecoded;
+}
+
+inline void MetaMemory::UnmarkPredecoded(uint8* metaAddress, uint32 size) {
+    for (uint32 ii = 0; ii < size; ++ii) metaAddress[ii] &= ~kPredecoded;
+}
+
+inline Bool MetaMemory::IsPredecoded8(uint8* metaAddress) {
+    const uint8 kMask = META_BITS_8(kPredecoded);
+
+    return (META_VALUE_8(metaAddress) & kMask) != 0;
+}
+
+inline Bool MetaMemory::IsPredecoded16(uint8* metaAddress) {
+    const uint16 kMask = META_BITS_16(kPredecoded);
+
+    return (META_VALUE_16(metaAddress) & kMask) != 0;
+}
+
+inline Bool MetaMemory::IsPredecoded32(uint8* metaAddress) {
+    const uint32 kMask = META_BITS_32(kPredecoded);
+
+    return (META_VALUE_32(metaAddress) & kMask) != 0;
+}
+
+inline uint32 MetaMemory::BreakpointPage(emuptr opcodeLocation) {
+    return (opcodeLocation >> kBreakpointPageShift) & (kBreakpointPageBits - 1);
+}
+
 inline Bool MetaMemory::IsCPUBreak(emuptr opcodeLocation) {
+    const uint32 page = BreakpointPage(opcodeLocation);
+
+    if ((breakpointPages[page >> 5] & (1u << (page & 31))) == 0) return false;
+
     return breakpoints.find(opcodeLocation) != breakpoints.end();
 }
 
@@ -161,20 +209,4 @@ inline void MetaMemory::UnmarkScreen(emuptr begin, emuptr end) {
     UnmarkRange(begin, end, kScreenBuffer);
 }
 
-// ---------------------------------------------------------------------------
-//		� MetaMemory::MarkInstructionBreak
-// ---------------------------------------------------------------------------
-
-inline void MetaMemory::MarkInstructionBreak(emuptr opcodeLocation) {
-    breakpoints.insert(opcodeLocation);
-}
-
-// ---------------------------------------------------------------------------
-//		� MetaMemory::UnmarkInstructionBreak
-// ---------------------------------------------------------------------------
-
-inline void MetaMemory::UnmarkInstructionBreak(emuptr opcodeLocation) {
-    breakpoints.erase(opcodeLocation);
-}
-
 #endif  // _METAMEMORY_H_
@@ -0,0 +1,250 @@
+#include "SessionDelta.h"
+
+#include "SavestateByteorder.h"
+#include "SessionImage.h"
+#include "miniz.h"
+
+namespace {
+    constexpr uint32 MAGIC = 0x20150203;
+    constexpr uint32 VERSION = 0x01;
+    constexpr size_t UNCOMPRESSED_HEADER_SIZE = 12;
+    constexpr size_t HEADER_SIZE = 16;
+
+    void put32(uint8* buffer, uint32 value) {
+        buffer[0] = value & 0xff;
+        buffer[1] = (value >> 8) & 0xff;
+        buffer[2] = (value >> 16) & 0xff;
+        buffer[3] = (value >> 24) & 0xff;
+    }
+
+    uint32 get32(const uint8* buffer) {
+        return buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | (buffer[3] << 24);
+    }
+
+    void append32(vector<uint8>& buffer, uint32 value) {
+        buffer.resize(buffer.size() + 4);
+        put32(buffer.data() + buffer.size() - 4, value);
+    }
+
+    uint32 savestateWord(const uint8* savestate, size_t index) {
+        uint32 word;
+        memcpy(&word, savestate + 4 * index, 4);
+
+        return savestate::SwapIfRequired(word);
+    }
+}  // namespace
+
+void SessionDelta::Reset(uint32 memorySize, uint32 savestateSize) {
+    this->memorySize = memorySize;
+    this->savestateSize = savestateSize;
+
+    pageCount = chunkCount = 0;
+
+    pages.clear();
+    chunks.clear();
+    serializedDelta.clear();
+}
+
+void SessionDelta::AddPage(uint32 page, const uint8* memory) {
+    const uint32 offset = page * PAGE_SIZE;
+    if (offset >= memorySize) return;
+
+    AddPageData(page, memory + offset);
+}
+
+void SessionDelta::AddDirtyPages(uint8* dirtyPages, const uint8* memory) {
+    const size_t dirtyPagesSize = DirtyPagesSize(memorySize);
+
+    for (size_t i = 0; i < dirtyPagesSize; i++) {
+        if (dirtyPages[i] == 0) continue;
+
+        for (uint32 bit = 0; bit < 8; bit++)
+            if (dirtyPages[i] & (1 << bit)) AddPage(i * 8 + bit, memory);
+    }
+
+    memset(dirtyPages, 0, dirtyPagesSize);
+}
+
+void SessionDelta::AddPageData(uint32 page, const uint8* data) {
+    const uint32 size = min(PAGE_SIZE, memorySize - page * PAGE_SIZE);
+
+    append32(pages, page);
+    pages.insert(pages.end(), data, data + size);
+
+    pageCount++;
+}
+
+void SessionDelta::AddSavestateChanges(const uint8* savestate, const uint8* previousSavestate) {
+    auto addIfChanged = [&](size_t offset, size_t size) {
+        if (memcmp(savestate + offset, previousSavestate + offset, size) != 0)
+            AddSavestateRange(offset, size, savestate + offset);
+    };
+
+    // The savestate starts with a TOC of (type, size in words) pairs, followed by the chunks
+    const size_t tocSize = savestateSize >= 4 ? 4 + 8 * savestateWord(savestate, 0) : 0;
+
+    if (tocSize == 0 || tocSize > savestateSize) {
+        addIfChanged(0, savestateSize);
+        return;
+    }
+
+    addIfChanged(0, tocSize);
+
+    size_t offset = tocSize;
+
+    for (size_t i = 1; i < tocSize / 4; i += 2) {
+        const size_t size = 4 * static_cast<size_t>(savestateWord(savestate, i + 1));
+
+        if (size > savestateSize - offset) break;
+
+        addIfChanged(offset, size);
+        offset += size;
+    }
+
+    if (offset < savestateSize) addIfChanged(offset, savestateSize - offset);
+}
+
+void SessionDelta::AddSavestateRange(uint32 offset, uint32 size, const uint8* data) {
+    append32(chunks, offset);
+    append32(chunks, size);
+    chunks.insert(chunks.end(), data, data + size);
+
+    chunkCount++;
+}
+
+uint32 SessionDelta::GetPageCount() const { return pageCount; }
+
+uint32 SessionDelta::GetChunkCount() const { return chunkCount; }
+
+bool SessionDelta::Serialize() {
+    vector<uint8> payload;
+    payload.reserve(HEADER_SIZE + pages.size() + chunks.size());
+
+    append32(payload, memorySize);
+    append32(payload, savestateSize);
+    append32(payload, pageCount);
+    append32(payload, chunkCount);
+
+    payload.insert(payload.end(), pages.begin(), pages.end());
+    payload.insert(payload.end(), chunks.begin(), chunks.end());
+
+    mz_ulong compressedSize = compressBound(payload.size());
+    serializedDelta.resize(UNCOMPRESSED_HEADER_SIZE + compressedSize);
+
+    put32(serializedDelta.data(), MAGIC);
+    put32(serializedDelta.data() + 4, VERSION);
+    put32(serializedDelta.data() + 8, payload.size());
+
+    if (compress2(serializedDelta.data() + UNCOMPRESSED_HEADER_SIZE, &compressedSize,
+                  payload.data(), payload.size(), MZ_DEFAULT_COMPRESSION) != MZ_OK) {
+        serializedDelta.clear();
+        return false;
+    }
+
+    serializedDelta.resize(UNCOMPRESSED_HEADER_SIZE + compressedSize);
+
+    return true;
+}
+
+void* SessionDelta::GetSerializedDelta() const { return (void*)serializedDelta.data(); }
+
+size_t SessionDelta::GetSerializedDeltaSize() const { return serializedDelta.size(); }
+
+bool SessionDelta::Deserialize(void* _buffer, size_t size) {
+    const uint8* buffer = static_cast<const uint8*>(_buffer);
+
+    if (size < UNCOMPRESSED_HEADER_SIZE) return false;
+    if (get32(buffer) != MAGIC || get32(buffer + 4) > VERSION) return false;
+
+    const uint32 uncompressedSize = get32(buffer + 8);
+    if (uncompressedSize < HEADER_SIZE) return false;
+
+    vector<uint8> payload(uncompressedSize);
+
+    mz_ulong realUncompressedSize = uncompressedSize;
+    if (uncompress(payload.data(), &realUncompressedSize, buffer + UNCOMPRESSED_HEADER_SIZE,
+                   size - UNCOMPRESSED_HEADER_SIZE) != MZ_OK ||
+        realUncompressedSize != uncompressedSize)
+        return false;
+
+    Reset(get32(payload.data()), get32(payload.data() + 4));
+
+    const uint32 pageRecords = get32(payload.data() + 8);
+    const uint32 chunkRecords = get32(payload.data() + 12);
+
+    const uint8* record = payload.data() + HEADER_SIZE;
+    const uint8* end = payload.data() + payload.size();
+
+    for (uint32 i = 0; i < pageRecords; i++) {
+        if (end - record < 4) return false;
+
+        const uint64 offset = static_cast<uint64>(get32(record)) * PAGE_SIZE;
+        if (offset >= memorySize) return false;
+
+        const size_t pageSize = min<uint64>(PAGE_SIZE, memorySize - offset);
+        if (static_cast<size_t>(end - record - 4) < pageSize) return false;
+
+        AddPageData(get32(record), record + 4);
+        record += 4 + pageSize;
+    }
+
+    for (uint32 i = 0; i < chunkRecords; i++) {
+        if (end - record < 8) return false;
+
+        const uint32 offset = get32(record);
+        const uint32 chunkSize = get32(record + 4);
+
+        if (offset > savestateSize || chunkSize > savestateSize - offset ||
+            static_cast<size_t>(end - record - 8) < chunkSize)
+            return false;
+
+        AddSavestateRange(offset, chunkSize, record + 8);
+        record += 8 + chunkSize;
+    }
+
+    return record == end;
+}
+
+bool SessionDelta::ApplyTo(SessionImage& image) const {
+    if (image.GetMemoryImageSize() != memorySize || image.GetSavestateSize() != savestateSize)
+        return false;
+
+    uint8* memory = static_cast<uint8*>(image.GetMemoryImage());
+    uint8* savestate = static_cast<uint8*>(image.GetSavestate());
+
+    for (const uint8* record = pages.data(); record < pages.data() + pages.size();) {
+        const uint32 offset = get32(record) * PAGE_SIZE;
+        const uint32 size = min(PAGE_SIZE, memorySize - offset);
+
+        memcpy(memory + offset, record + 4, size);
+        record += 4 + size;
+    }
+
+    for (const uint8* record = chunks.data(); record < chunks.data() + chunks.size();) {
+        const uint32 offset = get32(record);
+        const uint32 size = get32(record + 4);
+
+        memcpy(savestate + offset, record + 8, size);
+        record += 8 + size;
+    }
+
+    return true;
+}
+
+bool SessionDelta::Compact(SessionImage& image, void* base, size_t baseSize,
+                           const vector<pair<void*, size_t>>& deltas) {
+    // Deltas index the V4 memory layout, and Serialize always writes V4 images
+    if (!image.Deserialize(base, baseSize) || image.GetVersion() < 4) return false;
+
+    SessionDelta delta;
+
+    for (auto [buffer, size] : deltas) {
+        if (!delta.Deserialize(buffer, size) || !delta.ApplyTo(image)) return false;
+    }
+
+    return image.Serialize();
+}
+
+size_t SessionDelta::DirtyPagesSize(uint32 memorySize) {
+    return memorySize / (8 * PAGE_SIZE) + (memorySize % (8 * PAGE_SIZE) == 0 ? 0 : 1);
+}
@@ -0,0 +1,70 @@
+#ifndef _SESSION_DELTA_H_
+#define _SESSION_DELTA_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "EmCommon.h"
+
+class SessionImage;
+
+// An incremental snapshot of a session: the memory pages dirtied since the previous snapshot and
+// the savestate chunks that changed. A chain of deltas is created with EmSession::SaveBaseImage and
+// EmSession::SaveImageDelta and restored by applying it to the base image in order.
+class SessionDelta {
+   public:
+    // Granularity of the memory dirty page bitmap
+    static constexpr uint32 PAGE_SIZE = 1024;
+
+   public:
+    SessionDelta() = default;
+
+    void Reset(uint32 memorySize, uint32 savestateSize);
+
+    void AddPage(uint32 page, const uint8* memory);
+
+    // Adds the pages marked in a dirty page bitmap (one bit per page, LSB first) and clears the
+    // bitmap.
+    void AddDirtyPages(uint8* dirtyPages, const uint8* memory);
+
+    // Adds the chunks that differ between two savestates with the same layout.
+    void AddSavestateChanges(const uint8* savestate, const uint8* previousSavestate);
+
+    uint32 GetPageCount() const;
+    uint32 GetChunkCount() const;
+
+    bool Serialize();
+    void* GetSerializedDelta() const;
+    size_t GetSerializedDeltaSize() const;
+
+    bool Deserialize(void* buffer, size_t size);
+
+    // Fails if the image was not taken from a session with the same memory and savestate layout.
+    bool ApplyTo(SessionImage& image) const;
+
+    // Folds a chain of serialized deltas into a serialized base image. On success the compacted
+    // base is available from image.GetSerializedImage ().
+    static bool Compact(SessionImage& image, void* base, size_t baseSize,
+                        const vector<pair<void*, size_t>>& deltas);
+
+    static size_t DirtyPagesSize(uint32 memorySize);
+
+   private:
+    void AddPageData(uint32 page, const uint8* data);
+    void AddSavestateRange(uint32 offset, uint32 size, const uint8* data);
+
+   private:
+    uint32 memorySize{0};
+    uint32 savestateSize{0};
+    uint32 pageCount{0};
+    uint32 chunkCount{0};
+
+    // Page records (u32 index, data) and savestate records (u32 offset, u32 size, data)
+    vector<uint8> pages;
+    vector<uint8> chunks;
+
+    vector<uint8> serializedDelta;
+};
+
+#endif  // _SESSION_DELTA_H_
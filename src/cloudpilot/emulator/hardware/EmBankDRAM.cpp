@@ -38,7 +38,8 @@ namespace {
                                  EmBankDRAM::GetByte,        EmBankDRAM::SetLong,
                                  EmBankDRAM::SetWord,        EmBankDRAM::SetByte,
                                  EmBankDRAM::GetRealAddress, EmBankDRAM::ValidAddress,
-                                 EmBankDRAM::GetMetaAddress, EmBankDRAM::AddOpcodeCycles};
+                                 EmBankDRAM::GetMetaAddress, EmBankDRAM::AddOpcodeCycles,
+                                 true};
 
     EmAddressBank addressBankDisabled = {EmBankDRAM::GetDummy,       EmBankDRAM::GetDummy,
                                          EmBankDRAM::GetDummy,       EmBankDRAM::SetDummy,
@@ -243,6 +244,9 @@ void EmBankDRAM::SetLong(emuptr address, uint32 value) {
 
     if (MetaMemory::IsScreenBuffer32(InlineGetMetaAddress(address)))
         gSystemState.MarkScreenDirty(address, address + 4);
+
+    if (MetaMemory::IsPredecoded32(InlineGetMetaAddress(address)))
+        gCPU68K->InvalidatePredecoded(address, InlineGetMetaAddress(address), 4);
 }
 
 // ---------------------------------------------------------------------------
@@ -271,6 +275,9 @@ void EmBankDRAM::SetWord(emuptr address, uint32 value) {
 
     if (MetaMemory::IsScreenBuffer16(InlineGetMetaAddress(address)))
         gSystemState.MarkScreenDirty(address, address + 2);
+
+    if (MetaMemory::IsPredecoded16(InlineGetMetaAddress(address)))
+        gCPU68K->InvalidatePredecoded(address, InlineGetMetaAddress(address), 2);
 }
 
 // ---------------------------------------------------------------------------
@@ -294,6 +301,9 @@ void EmBankDRAM::SetByte(emuptr address, uint32 value) {
 
     if (MetaMemory::IsScreenBuffer8(InlineGetMetaAddress(address)))
         gSystemState.MarkScreenDirty(address, address);
+
+    if (MetaMemory::IsPredecoded8(InlineGetMetaAddress(address)))
+        gCPU68K->InvalidatePredecoded(address, InlineGetMetaAddress(address), 1);
 }
 
 uint32 EmBankDRAM::GetDummy(emuptr address) { return 0; }
@@ -51,7 +51,7 @@ static EmAddressBank gROMAddressBank = {
     EmBankROM::GetLong,        EmBankROM::GetWord,      EmBankROM::GetByte,
     EmBankROM::SetLong,        EmBankROM::SetWord,      EmBankROM::SetByte,
     EmBankROM::GetRealAddress, EmBankROM::ValidAddress, nullptr,
-    EmBankROM::AddOpcodeCycles};
+    EmBankROM::AddOpcodeCycles, true};
 
 static uint32 gROMBank_Size;
 static uint32 gManagedROMSize;
@@ -277,6 +277,9 @@ void EmBankROM::SetLong(emuptr address, uint32 value) {
     address &= gROMBank_Mask;
 
     EmMemDoPut32(gROM_Memory + address, value);
+
+    // There is no meta memory for ROM, so cached instructions cannot be tracked individually
+    gCPU68K->FlushPredecoded();
 }
 
 // ---------------------------------------------------------------------------
@@ -309,6 +312,8 @@ void EmBankROM::SetWord(emuptr address, uint32 value) {
     address &= gROMBank_Mask;
 
     EmMemDoPut16(gROM_Memory + address, value);
+
+    gCPU68K->FlushPredecoded();
 }
 
 // ---------------------------------------------------------------------------
@@ -335,6 +340,8 @@ void EmBankROM::SetByte(emuptr address, uint32 value) {
     address &= gROMBank_Mask;
 
     EmMemDoPut8(gROM_Memory + address, value);
+
+    gCPU68K->FlushPredecoded();
 }
 
 // ---------------------------------------------------------------------------
@@ -699,13 +706,27 @@ static EmAddressBank gFlashAddressBank = {
     EmBankFlash::GetLong,        EmBankFlash::GetWord,      EmBankFlash::GetByte,
     EmBankFlash::SetLong,        EmBankFlash::SetWord,      EmBankFlash::SetByte,
     EmBankFlash::GetRealAddress, EmBankFlash::ValidAddress, nullptr,
-    EmBankFlash::AddOpcodeCycles};
+    EmBankFlash::AddOpcodeCycles, true};
 
 #define FLASHBASE (EmBankROM::GetMemoryStart())
 
 static int gState = kAMDState_Normal;
 static Bool gEraseIsSetup;
 
+static void PrvSetState(int state) {
+    gState = state;
+
+    // Reads only act like ROM in kAMDState_Normal, so the flash may only be read directly (and
+    // its code be cached) in that state
+    const int direct = state == kAMDState_Normal;
+    if (gFlashAddressBank.direct == direct) return;
+
+    gFlashAddressBank.direct = direct;
+    EmBankFlash::SetBankHandlers();
+
+    if (gCPU68K) gCPU68K->FlushPredecoded();
+}
+
 /***********************************************************************
  *
  * FUNCTION:	EmBankFlash::Initialize
@@ -742,7 +763,7 @@ void EmBankFlash::Initialize(void) {}
 
 void EmBankFlash::Reset(Bool hardwareReset) {
     if (hardwareReset) {
-        gState = kAMDState_Normal;
+        PrvSetState(kAMDState_Normal);
     }
 }
 
@@ -857,7 +878,7 @@ uint32 EmBankFlash::GetWord(emuptr address) {
             // !!! We should really check that address is the same as the
             // one specified in the Erase command.
 
-            gState = kAMDState_Normal;
+            PrvSetState(kAMDState_Normal);
             return 0x0080;
 
         case kAMDState_ProgramDone:
@@ -868,7 +889,7 @@ uint32 EmBankFlash::GetWord(emuptr address) {
             // !!! We should really check that address is the same as the
             // one specified in the Program command.
 
-            gState = kAMDState_Normal;
+            PrvSetState(kAMDState_Normal);
             return 0x0080 & EmBankROM::GetWord(address);
     }
 
@@ -900,7 +921,7 @@ void EmBankFlash::SetWord(emuptr address, uint32 value) {
             // A write of 0x00AA to 0xAAAA will put us in kAMDState_Unlocked1.
 
             if (address == FLASHBASE + 0xAAAA && value == 0x00AA) {
-                gState = kAMDState_Unlocked1;
+                PrvSetState(kAMDState_Unlocked1);
                 return;
             }
 
@@ -919,10 +940,10 @@ void EmBankFlash::SetWord(emuptr address, uint32 value) {
             // ??? What happens on other operations?
 
             if (value == 0x00F0) {
-                gState = kAMDState_Normal;
+                PrvSetState(kAMDState_Normal);
                 return;
             } else if (address == FLASHBASE + 0x5554 && value == 0x0055) {
-                gState = kAMDState_Unlocked2;
+                PrvSetState(kAMDState_Unlocked2);
                 return;
             }
             break;
@@ -937,7 +958,7 @@ void EmBankFlash::SetWord(emuptr address, uint32 value) {
             // ??? What happens on other operations?
 
             if (value == 0x00F0) {
-                gState = kAMDState_Normal;
+                PrvSetState(kAMDState_Normal);
                 return;
             } else if (value == 0x0030 && gEraseIsSetup) {
                 const int kEraseValue = 0xFF;
@@ -987,18 +1008,18 @@ void EmBankFlash::SetWord(emuptr address, uint32 value) {
                     EmMem_memset(kSector4Start, kEraseValue, kSector4Size);
                 }
 
-                gState = kAMDState_EraseDone;
+                PrvSetState(kAMDState_EraseDone);
                 return;
             } else if (address == FLASHBASE + 0xAAAA) {
                 if (value == 0x0090) {
-                    gState = kAMDState_Autoselect;
+                    PrvSetState(kAMDState_Autoselect);
                     return;
                 } else if (value == 0x0080) {
                     gEraseIsSetup = true;
-                    gState = kAMDState_Normal;
+                    PrvSetState(kAMDState_Normal);
                     return;
                 } else if (value == 0x00A0) {
-                    gState = kAMDState_Program;
+                    PrvSetState(kAMDState_Program);
                     return;
                 }
             }
@@ -1012,7 +1033,7 @@ void EmBankFlash::SetWord(emuptr address, uint32 value) {
             // ??? What happens on other operations?
 
             if (value == 0x00F0) {
-                gState = kAMDState_Normal;
+                PrvSetState(kAMDState_Normal);
                 return;
             }
             break;
@@ -1025,7 +1046,7 @@ void EmBankFlash::SetWord(emuptr address, uint32 value) {
             address &= gROMBank_Mask;
             EmMemDoPut16(gROM_Memory + address, value);
 
-            gState = kAMDState_ProgramDone;
+            PrvSetState(kAMDState_ProgramDone);
             return;
 
         case kAMDState_EraseDone:
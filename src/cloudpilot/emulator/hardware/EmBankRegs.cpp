@@ -78,6 +78,7 @@ static uint64 gLastStart;
 static uint32 gLastRange;
 
 static void PrvSwitchBanks(EmRegsList& fromList, EmRegsList& toList, emuptr address);
+static void PrvSynchronizeHardware(void);
 
 #pragma mark -
 
@@ -158,10 +159,10 @@ void EmBankRegs::Save(T& savestate) {
     }
 }
 
-template void EmBankRegs::Save(Savestate& savestate);
-template void EmBankRegs::Save(SavestateProbe& savestate);
+template void EmBankRegs::Save(Savestate<ChunkType>& savestate);
+template void EmBankRegs::Save(SavestateProbe<ChunkType>& savestate);
 
-void EmBankRegs::Load(SavestateLoader& loader) {
+void EmBankRegs::Load(SavestateLoader<ChunkType>& loader) {
     EmRegsList::iterator iter = fgSubBanks.begin();
     while (iter != fgSubBanks.end()) {
         (*iter)->Load(loader);
@@ -236,6 +237,8 @@ uint32 EmBankRegs::GetLong(emuptr address) {
     EmRegs* bank = EmBankRegs::GetSubBank(address, sizeof(uint32));
 
     if (bank) {
+        PrvSynchronizeHardware();
+
 #if (CHECK_FOR_ADDRESS_ERROR)
         if ((address & 1 && !bank->AllowUnalignedAccess(address, 4)) != 0) {
             AddressError(address, sizeof(uint32), true);
@@ -264,6 +267,8 @@ uint32 EmBankRegs::GetWord(emuptr address) {
     EmRegs* bank = EmBankRegs::GetSubBank(address, sizeof(uint16));
 
     if (bank) {
+        PrvSynchronizeHardware();
+
 #if (CHECK_FOR_ADDRESS_ERROR)
         if ((address & 1 && !bank->AllowUnalignedAccess(address, 2)) != 0) {
             AddressError(address, sizeof(uint16), true);
@@ -292,6 +297,8 @@ uint32 EmBankRegs::GetByte(emuptr address) {
     EmRegs* bank = EmBankRegs::GetSubBank(address, sizeof(uint8));
 
     if (bank) {
+        PrvSynchronizeHardware();
+
         return bank->GetByte(address);
     }
 
@@ -313,6 +320,8 @@ void EmBankRegs::SetLong(emuptr address, uint32 value) {
     EmRegs* bank = EmBankRegs::GetSubBank(address, sizeof(uint32));
 
     if (bank) {
+        PrvSynchronizeHardware();
+
 #if (CHECK_FOR_ADDRESS_ERROR)
         if ((address & 1 && !bank->AllowUnalignedAccess(address, 4)) != 0) {
             AddressError(address, sizeof(uint32), false);
@@ -342,6 +351,8 @@ void EmBankRegs::SetWord(emuptr address, uint32 value) {
     EmRegs* bank = EmBankRegs::GetSubBank(address, sizeof(uint16));
 
     if (bank) {
+        PrvSynchronizeHardware();
+
 #if (CHECK_FOR_ADDRESS_ERROR)
         if ((address & 1 && !bank->AllowUnalignedAccess(address, 2)) != 0) {
             AddressError(address, sizeof(uint16), false);
@@ -371,6 +382,8 @@ void EmBankRegs::SetByte(emuptr address, uint32 value) {
     EmRegs* bank = EmBankRegs::GetSubBank(address, sizeof(uint8));
 
     if (bank) {
+        PrvSynchronizeHardware();
+
         bank->SetByte(address, value);
 
         return;
@@ -508,3 +521,13 @@ void PrvSwitchBanks(EmRegsList& fromList, EmRegsList& toList, emuptr address) {
         ++iter;
     }
 }
+
+// ---------------------------------------------------------------------------
+//		� PrvSynchronizeHardware
+// ---------------------------------------------------------------------------
+// Registers may depend on the current cycle, so let the HAL catch up with the
+// CPU before they are accessed.
+
+void PrvSynchronizeHardware(void) {
+    if (gCPU68K) gCPU68K->SynchronizeHardware();
+}
@@ -33,7 +33,8 @@ namespace {
                                   EmBankSRAM::GetByte,        EmBankSRAM::SetLong,
                                   EmBankSRAM::SetWord,        EmBankSRAM::SetByte,
                                   EmBankSRAM::GetRealAddress, EmBankSRAM::ValidAddress,
-                                  EmBankSRAM::GetMetaAddress, EmBankSRAM::AddOpcodeCycles};
+                                  EmBankSRAM::GetMetaAddress, EmBankSRAM::AddOpcodeCycles,
+                                  true};
 
     EmAddressBank gAddressBankDisabled = {EmBankSRAM::GetDummy,       EmBankSRAM::GetDummy,
                                           EmBankSRAM::GetDummy,       EmBankSRAM::SetDummy,
@@ -303,6 +304,9 @@ void EmBankSRAM::SetLong(emuptr address, uint32 value) {
 
     if (MetaMemory::IsScreenBuffer32(InlineGetMetaAddress(phyAddress)))
         gSystemState.MarkScreenDirty(address, address + 4);
+
+    if (MetaMemory::IsPredecoded32(InlineGetMetaAddress(phyAddress)))
+        gCPU68K->InvalidatePredecoded(address, InlineGetMetaAddress(phyAddress), 4);
 }
 
 // ---------------------------------------------------------------------------
@@ -341,6 +345,9 @@ void EmBankSRAM::SetWord(emuptr address, uint32 value) {
 
     if (MetaMemory::IsScreenBuffer16(InlineGetMetaAddress(phyAddress)))
         gSystemState.MarkScreenDirty(address, address + 2);
+
+    if (MetaMemory::IsPredecoded16(InlineGetMetaAddress(phyAddress)))
+        gCPU68K->InvalidatePredecoded(address, InlineGetMetaAddress(phyAddress), 2);
 }
 
 // ---------------------------------------------------------------------------
@@ -372,6 +379,9 @@ void EmBankSRAM::SetByte(emuptr address, uint32 value) {
 
     if (MetaMemory::IsScreenBuffer8(InlineGetMetaAddress(phyAddress)))
         gSystemState.MarkScreenDirty(address, address);
+
+    if (MetaMemory::IsPredecoded8(InlineGetMetaAddress(phyAddress)))
+        gCPU68K->InvalidatePredecoded(address, InlineGetMetaAddress(phyAddress), 1);
 }
 
 uint32 EmBankSRAM::GetDummy(emuptr address) { return 0; }
@@ -394,9 +404,9 @@ int EmBankSRAM::ValidAddress(emuptr address, uint32 size) {
 // ---------------------------------------------------------------------------
 
 uint8* EmBankSRAM::GetRealAddress(emuptr address) {
-    // Strip the uppermost bit of the address.
+    // Map the address to physical RAM in the same way as the accessors.
 
-    address &= (ramSize - 1);
+    address &= gRAMBank_Mask;
 
     return (uint8*)&(ram[address]);
 }
@@ -14,10 +14,14 @@
 #ifndef EmCPU_h
 #define EmCPU_h
 
+#include "ChunkType.h"
 #include "EmCommon.h"
 
+template <typename ChunkType>
 class SavestateProbe;
+template <typename ChunkType>
 class Savestate;
+template <typename ChunkType>
 class SavestateLoader;
 
 class EmSession;
@@ -46,9 +50,9 @@ class EmCPU {
     //				Reset has been called first.
 
     virtual void Reset(Bool hardwareReset);
-    virtual void Save(Savestate&);
-    virtual void Save(SavestateProbe&);
-    virtual void Load(SavestateLoader&);
+    virtual void Save(Savestate<ChunkType>&);
+    virtual void Save(SavestateProbe<ChunkType>&);
+    virtual void Load(SavestateLoader<ChunkType>&);
 
     // Execute the main CPU loop until asked to stop.
 
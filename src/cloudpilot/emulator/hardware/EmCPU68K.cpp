@@ -49,6 +49,25 @@ constexpr uint32 SAVESTATE_VERSION = 1;
 
 #define SPCFLAG_END_OF_CYCLE (0x40000000)
 
+namespace {
+    // The longest 68000 instruction is five words.
+    constexpr uint32 kPredecodeWords = 5;
+    constexpr uint32 kPredecodeBytes = 2 * kPredecodeWords;
+
+    constexpr size_t kPredecodeEntries = 8192;
+}  // namespace
+
+// A direct mapped cache of decoded instructions, indexed by PC.  Entries in
+// RAM are tracked in meta memory (kPredecoded) so that writes can invalidate
+// them.
+
+struct EmCPU68K::PredecodedInstruction {
+    emuptr address;
+    uint16 words[kPredecodeWords];
+    cpuop_func* handler;
+    uint8* metaAddress;
+};
+
 // Data needed by UAE.
 
 int areg_byteinc[] = {1, 1, 1, 1, 1, 1, 1, 2};  // (normally in newcpu.c)
@@ -69,6 +88,7 @@ emuptr last_addr_for_exception_3;  /* PC at fault time */
 emuptr last_fault_for_exception_3; /* Address that generated the exception */
 
 struct regstruct regs;        // (normally in newcpu.c)
+const uae_u16* regs_iwords;
 struct flag_struct regflags;  // (normally in support.c)
 
 // These variables should strictly be in a sub-system that implements
@@ -113,22 +133,28 @@ EmCPU68K* gCPU68K;
 // code can be more efficient if "counter" can be cached in a register
 // instead of being a static or global variable.
 
-#define CYCLE(sleeping)                                                                  \
-    {                                                                                    \
-        /* Don't do anything if we're in the middle of an ATrap call.  We don't */       \
-        /* need interrupts firing or tmr counters incrementing. */                       \
-                                                                                         \
-        EmAssert(session);                                                               \
-        if (!session->IsNested()) {                                                      \
-            /* Perform CPU-specific idling. */                                           \
-            EmHAL::DispatchCycle(session->GetSystemCycles() + fCurrentCycles, sleeping); \
-                                                                                         \
-            /* Perform expensive operations. */                                          \
-                                                                                         \
-            if (sleeping || ((counter++ & 0x7FFF) == 0)) {                               \
-                this->CycleSlowly(sleeping);                                             \
-            }                                                                            \
-        }                                                                                \
+#define CYCLE(sleeping)                                                                   \
+    {                                                                                     \
+        /* Don't do anything if we're in the middle of an ATrap call.  We don't */        \
+        /* need interrupts firing or tmr counters incrementing. */                        \
+                                                                                          \
+        EmAssert(session);                                                                \
+        if (!session->IsNested()) {                                                       \
+            uint64 systemCycles = session->GetSystemCycles() + fCurrentCycles;            \
+            Bool cycleSlowly = sleeping || ((counter++ & 0x7FFF) == 0);                   \
+                                                                                          \
+            /* Perform CPU-specific idling if a hardware event is due or on STOP. */      \
+                                                                                          \
+            if (cycleSlowly || regs.stopped || systemCycles >= EmHAL::GetNextCycle()) {   \
+                EmHAL::DispatchCycle(systemCycles, sleeping);                             \
+            }                                                                             \
+                                                                                          \
+            /* Perform expensive operations. */                                           \
+                                                                                          \
+            if (cycleSlowly) {                                                            \
+                this->CycleSlowly(sleeping);                                              \
+            }                                                                             \
+        }                                                                                 \
     }
 
 namespace {
@@ -212,7 +238,8 @@ EmCPU68K::EmCPU68K(EmSession* session)
     : EmCPU(session),
       fLastTraceAddress(EmMemNULL),
       //	fExceptionHandlers (),
-      fHookJSR_Ind()
+      fHookJSR_Ind(),
+      fPredecodeCache(make_unique<PredecodedInstruction[]>(kPredecodeEntries))
 #if REGISTER_HISTORY
       ,
       fRegHistoryIndex(0)
@@ -226,6 +253,8 @@ EmCPU68K::EmCPU68K(EmSession* session)
 {
     this->InitializeUAETables();
 
+    for (size_t i = 0; i < kPredecodeEntries; i++) this->DropPredecoded(i);
+
     EmAssert(gCPU68K == NULL);
     gCPU68K = this;
 }
@@ -246,6 +275,8 @@ EmCPU68K::~EmCPU68K(void) {
 // ---------------------------------------------------------------------------
 
 void EmCPU68K::Reset(Bool hardwareReset) {
+    this->FlushPredecoded();
+
     isSettingUpExceptionFrame = false;
     fLastTraceAddress = EmMemNULL;
 #if REGISTER_HISTORY
@@ -298,11 +329,11 @@ void EmCPU68K::Reset(Bool hardwareReset) {
 //		� EmCPU68K::Save
 // ---------------------------------------------------------------------------
 
-void EmCPU68K::Save(Savestate& savestate) { DoSave(savestate); }
+void EmCPU68K::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmCPU68K::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmCPU68K::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmCPU68K::Load(SavestateLoader& loader) {
+void EmCPU68K::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::cpu68k);
     if (!chunk) {
         logging::printf("error restoring cpu68k: missing savestate");
@@ -325,6 +356,8 @@ void EmCPU68K::Load(SavestateLoader& loader) {
     DoSaveLoad(helper);
 
     SetRegisters(regs);
+
+    this->FlushPredecoded();
 }
 
 template <typename T>
@@ -354,6 +387,22 @@ void EmCPU68K::DoSaveLoad(T& helper) {
 // ---------------------------------------------------------------------------
 
 uint32 EmCPU68K::Execute(uint32 maxCycles) {
+#ifdef ENABLE_DEBUGGER
+    if (gDebugger.IsEnabled()) return this->ExecuteLoop<true>(maxCycles);
+#endif
+
+    return this->ExecuteLoop<false>(maxCycles);
+}
+
+// ---------------------------------------------------------------------------
+//		� EmCPU68K::ExecuteLoop
+// ---------------------------------------------------------------------------
+// The loop is instantiated with and without the debugger hooks.  The debugger
+// is attached between calls to Execute, so the variant without hooks is used
+// whenever no debugger is enabled.
+
+template <bool debugger>
+uint32 EmCPU68K::ExecuteLoop(uint32 maxCycles) {
     // This function is the bottleneck for all 68K emulation.  It's
     // important that it run as quickly as possible.  To that end,
     // fine tune register allocation as much as we can by hand.
@@ -364,6 +413,7 @@ uint32 EmCPU68K::Execute(uint32 maxCycles) {
     int counter = maxCycles ? 0 : 1;
 
     uint32 cycles;
+    PredecodedInstruction* instruction;
 
 #define pc (regs.pc)
 #define spcflags (regs.spcflags)
@@ -402,8 +452,10 @@ uint32 EmCPU68K::Execute(uint32 maxCycles) {
         // -----------------------------------------------------------------------
 
 #ifdef ENABLE_DEBUGGER
-        gDebugger.NotificyPc(pc);
-        if (gDebugger.IsStopped() && !gSession->IsNested()) break;
+        if (debugger) {
+            gDebugger.NotificyPc(pc);
+            if (gDebugger.IsStopped() && !gSession->IsNested()) break;
+        }
 #endif
 
         if (MetaMemory::IsCPUBreak(m68k_getpc())) {
@@ -417,17 +469,38 @@ uint32 EmCPU68K::Execute(uint32 maxCycles) {
         // -----------------------------------------------------------------------
 
         EmOpcode68K opcode;
+        cpuop_func* handler;
 
-        opcode = EmMemGet16(pc);
-#ifdef TRACE_FUNCTION_CALLS
-        traceFunctionCalls(opcode, pc);
+        // Most instructions are dispatched from the predecode cache.  This
+        // saves going through the memory banks for the opcode and the
+        // extension words (see get_iword in newcpu.h).
+
+        instruction = &fPredecodeCache[(pc >> 1) & (kPredecodeEntries - 1)];
+        if (instruction->address != pc) instruction = this->Predecode(pc, instruction);
+
+        if (instruction) {
+#ifdef ENABLE_DEBUGGER
+            if (debugger) DbgNotifyRead16(pc);
 #endif
 
+            opcode = instruction->words[0];
+            handler = instruction->handler;
+            regs_iwords = instruction->words;
+        } else {
+            opcode = EmMemGet16(pc);
 #ifdef __EMSCRIPTEN__
-        cycles = ((cpuop_func*)((long)cpufunctbl_base + opcode))(opcode);
+            handler = (cpuop_func*)((long)cpufunctbl_base + opcode);
 #else
-        cycles = (cpufunctbl[opcode])(opcode);
+            handler = cpufunctbl[opcode];
+#endif
+            regs_iwords = NULL;
+        }
+
+#ifdef TRACE_FUNCTION_CALLS
+        traceFunctionCalls(opcode, pc);
 #endif
+
+        cycles = handler(opcode);
         fCurrentCycles += cycles;
         // =======================================================================
 
@@ -445,6 +518,7 @@ uint32 EmCPU68K::Execute(uint32 maxCycles) {
         // -----------------------------------------------------------------------
 
         if (spcflags || regs.stopped) {
+            this->SynchronizeHardware();
             if (this->ExecuteSpecial(maxCycles)) break;
         }
 
@@ -452,6 +526,8 @@ uint32 EmCPU68K::Execute(uint32 maxCycles) {
 
     }  // while (1)
 
+    this->SynchronizeHardware();
+
 #undef pc
 #undef spcflags
 #undef session
@@ -459,6 +535,89 @@ uint32 EmCPU68K::Execute(uint32 maxCycles) {
     return fCurrentCycles;
 }
 
+// ---------------------------------------------------------------------------
+//		� EmCPU68K::InvalidatePredecoded
+// ---------------------------------------------------------------------------
+
+void EmCPU68K::InvalidatePredecoded(emuptr address, uint8* metaAddress, uint32 size) {
+    // Entries are indexed by the low address bits, which are the same for all
+    // aliases of a location (banks are 64k aligned).  Only the entries for
+    // instructions starting up to kPredecodeBytes - 2 bytes before the written
+    // range can overlap it.
+
+    const emuptr first = (address & ~1) - (kPredecodeBytes - 2);
+    const uint32 count = (((address + size - 1) & ~1) - (address & ~1)) / 2 + kPredecodeWords;
+
+    for (uint32 i = 0; i < count; i++) {
+        const size_t index = ((first >> 1) + i) & (kPredecodeEntries - 1);
+        const PredecodedInstruction& instruction = fPredecodeCache[index];
+
+        if (instruction.metaAddress && instruction.metaAddress < metaAddress + size &&
+            metaAddress < instruction.metaAddress + kPredecodeBytes)
+            this->DropPredecoded(index);
+    }
+
+    // All entries that covered these bytes are gone now
+    MetaMemory::UnmarkPredecoded(metaAddress, size);
+}
+
+// ---------------------------------------------------------------------------
+//		� EmCPU68K::FlushPredecoded
+// ---------------------------------------------------------------------------
+
+void EmCPU68K::FlushPredecoded(void) {
+    for (size_t i = 0; i < kPredecodeEntries; i++) {
+        const PredecodedInstruction& instruction = fPredecodeCache[i];
+
+        if (instruction.metaAddress)
+            MetaMemory::UnmarkPredecoded(instruction.metaAddress, kPredecodeBytes);
+
+        this->DropPredecoded(i);
+    }
+}
+
+// ---------------------------------------------------------------------------
+//		� EmCPU68K::Predecode
+// ---------------------------------------------------------------------------
+// Fills the cache entry for the instruction at the given address.  Returns
+// NULL if the instruction has to be fetched through the memory banks.
+
+EmCPU68K::PredecodedInstruction* EmCPU68K::Predecode(emuptr address,
+                                                     PredecodedInstruction* instruction) {
+    // Odd addresses raise an address error, and entries may not straddle banks.
+
+    if ((address & 1) || (address & 0xffff) > 0x10000 - kPredecodeBytes) return NULL;
+
+    EmAddressBank& bank = EmMemGetBank(address);
+    if (!bank.direct || !bank.checkaddr(address, kPredecodeBytes)) return NULL;
+
+    for (uint32 i = 0; i < kPredecodeWords; i++) instruction->words[i] = bank.wget(address + 2 * i);
+
+#ifdef __EMSCRIPTEN__
+    instruction->handler = (cpuop_func*)((long)cpufunctbl_base + instruction->words[0]);
+#else
+    instruction->handler = cpufunctbl[instruction->words[0]];
+#endif
+
+    instruction->address = address;
+    instruction->metaAddress = bank.xlatemetaaddr ? bank.xlatemetaaddr(address) : NULL;
+
+    if (instruction->metaAddress)
+        MetaMemory::MarkPredecoded(instruction->metaAddress, kPredecodeBytes);
+
+    return instruction;
+}
+
+// ---------------------------------------------------------------------------
+//		� EmCPU68K::DropPredecoded
+// ---------------------------------------------------------------------------
+
+void EmCPU68K::DropPredecoded(size_t index) {
+    // An address that maps to a different entry can never match.
+    fPredecodeCache[index].address = (index ^ 1) << 1;
+    fPredecodeCache[index].metaAddress = NULL;
+}
+
 // ---------------------------------------------------------------------------
 //		� EmCPU68K::ExecuteSpecial
 // ---------------------------------------------------------------------------
@@ -578,6 +737,21 @@ Bool EmCPU68K::ExecuteStoppedLoop(uint32 maxCycles) {
 
 void EmCPU68K::CycleSlowly(Bool sleeping) { EmHAL::CycleSlowly(sleeping); }
 
+// ---------------------------------------------------------------------------
+//		� EmCPU68K::SynchronizeHardware
+// ---------------------------------------------------------------------------
+// The CPU loop only dispatches cycles to the HAL when an event is due.  Bring
+// the hardware up to date with the current instruction before it is accessed
+// or the loop is left.
+
+void EmCPU68K::SynchronizeHardware(void) {
+    EmAssert(fSession);
+    if (fSession->IsNested()) return;
+
+    // Sleeping is only signaled while the CPU is stopped
+    EmHAL::DispatchCycle(fSession->GetSystemCycles() + fCurrentCycles, regs.stopped);
+}
+
 // ---------------------------------------------------------------------------
 //		� EmCPU68K::CheckAfterCycle
 // ---------------------------------------------------------------------------
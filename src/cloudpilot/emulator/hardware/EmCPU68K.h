@@ -14,6 +14,7 @@
 #ifndef EmCPU68K_h
 #define EmCPU68K_h
 
+#include <memory>  // unique_ptr
 #include <vector>  // vector
 
 #include "EmCPU.h"  // EmCPU
@@ -219,9 +220,9 @@ class EmCPU68K : public EmCPU {
     //				Reset has been called first.
 
     virtual void Reset(Bool hardwareReset);
-    virtual void Save(Savestate&);
-    virtual void Save(SavestateProbe&);
-    virtual void Load(SavestateLoader&);
+    virtual void Save(Savestate<ChunkType>&);
+    virtual void Save(SavestateProbe<ChunkType>&);
+    virtual void Load(SavestateLoader<ChunkType>&);
 
     // Execute the main CPU loop until asked to stop.
 
@@ -266,10 +267,29 @@ class EmCPU68K : public EmCPU {
     void UpdateSRFromRegisters(void);
     void UpdateRegistersFromSR(void);
 
+    // Dispatches the current cycle to the HAL.  Called before hardware
+    // registers are accessed.
+
+    void SynchronizeHardware(void);
+
     void BusError(emuptr address, long size, Bool forRead);
     void AddressError(emuptr address, long size, Bool forRead);
 
+    // Called by the memory banks when code in the predecode cache may have
+    // changed.
+
+    void InvalidatePredecoded(emuptr address, uint8* metaAddress, uint32 size);
+    void FlushPredecoded(void);
+
    private:
+    struct PredecodedInstruction;
+
+    PredecodedInstruction* Predecode(emuptr address, PredecodedInstruction* instruction);
+    void DropPredecoded(size_t index);
+
+    template <bool debugger>
+    uint32 ExecuteLoop(uint32 maxCycles);
+
     Bool ExecuteSpecial(uint32 maxCycles);
     Bool ExecuteStoppedLoop(uint32 maxCycles);
 
@@ -293,6 +313,8 @@ class EmCPU68K : public EmCPU {
     uint32 fCurrentCycles{0};
     Bool isSettingUpExceptionFrame{false};
 
+    unique_ptr<PredecodedInstruction[]> fPredecodeCache;
+
 #if REGISTER_HISTORY
     #define kRegHistorySize 512
     long fRegHistoryIndex;
@@ -44,6 +44,7 @@ EmEvent<double, double> EmHAL::onPwmChange{};
 EmEvent<> EmHAL::onDayRollover{};
 
 vector<EmHAL::CycleConsumer> EmHAL::cycleConsumers;
+uint64 EmHAL::nextCycle{0};
 
 // ---------------------------------------------------------------------------
 //		� EmHAL::AddHandler
@@ -448,6 +449,9 @@ void EmHAL::AddCycleConsumer(CycleHandler handler, void* context) {
     }
 
     cycleConsumers.push_back({handler, context});
+
+    // Give the new consumer a chance to schedule itself
+    nextCycle = 0;
 }
 
 void EmHAL::RemoveCycleConsumer(CycleHandler handler, void* context) {
@@ -463,9 +467,15 @@ void EmHAL::RemoveCycleConsumer(CycleHandler handler, void* context) {
 }
 
 void EmHAL::DispatchCycle(uint64 cycles, bool sleeping) {
+    nextCycle = ~0;
+
     for (auto consumer : cycleConsumers) consumer.handler(consumer.context, cycles, sleeping);
 }
 
+void EmHAL::ScheduleCycle(uint64 cycles) {
+    if (cycles < nextCycle) nextCycle = cycles;
+}
+
 bool EmHAL::SupportsImageInSlot(Slot slot, uint32 blocksTotal) {
     EmAssert(EmHAL::GetRootHandler());
     return EmHAL::GetRootHandler()->SupportsImageInSlot(slot, blocksTotal);
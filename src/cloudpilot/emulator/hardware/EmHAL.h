@@ -94,6 +94,11 @@ class EmHAL {
     static void RemoveCycleConsumer(CycleHandler handler, void* context);
     static void DispatchCycle(uint64 cycles, bool sleeping);
 
+    // The CPU only dispatches cycles once the earliest scheduled cycle is reached.  Dispatching
+    // clears the schedule, so consumers have to schedule their next event on every call.
+    static void ScheduleCycle(uint64 cycles);
+    static uint64 GetNextCycle(void) { return nextCycle; }
+
     static bool SupportsImageInSlot(Slot slot, uint32 blocksTotal);
     static bool SupportsImageInSlot(Slot slot, const CardImage& cardImage);
     static void Mount(Slot slot, CardImage& cardImage);
@@ -117,6 +122,7 @@ class EmHAL {
     static EmHALHandler* fgRootHandler;
 
     static vector<CycleConsumer> cycleConsumers;
+    static uint64 nextCycle;
 };
 
 class EmHALHandler {
@@ -21,6 +21,7 @@
 #include "EmBankROM.h"     // EmBankROM::Initialize
 #include "EmBankRegs.h"    // EmBankRegs::Initialize
 #include "EmBankSRAM.h"    // EmBankSRAM::Initialize
+#include "EmCPU68K.h"      // gCPU68K
 #include "EmCommon.h"
 #include "EmDevice.h"
 #include "EmSession.h"  // gSession, GetDevice
@@ -188,6 +189,7 @@
 #pragma mark Globals
 
 EmAddressBank* gEmMemBanks[65536];  // (normally defined in memory.c)
+uint8* gEmMemDirectBanks[65536];
 
 Bool gPCInRAM;
 Bool gPCInROM;
@@ -262,6 +264,15 @@ namespace {
     uint32 get32(uint8* address) {
         return address[0] | (address[1] << 8) | (address[2] << 16) | (address[3] << 24);
     }
+
+    uint8* directBase(EmAddressBank& bank, emuptr start) {
+        if (!bank.direct || !bank.checkaddr(start, 0x10000)) return nullptr;
+
+        // The whole bank has to be backed by one contiguous block of host memory
+        uint8* base = bank.xlateaddr(start);
+
+        return bank.xlateaddr(start + 0xFFFF) == base + 0xFFFF ? base : nullptr;
+    }
 }  // namespace
 
 // ===========================================================================
@@ -314,6 +325,7 @@ bool Memory::Initialize(const uint8* romBuffer, size_t romSize, EmDevice& device
     // Clear everything out.
 
     memset(gEmMemBanks, 0, sizeof(gEmMemBanks));
+    memset(gEmMemDirectBanks, 0, sizeof(gEmMemDirectBanks));
 
     // Initialize the valid memory banks.
 
@@ -381,10 +393,10 @@ void Memory::Save(T& savestate) {
     EmBankRegs::Save(savestate);
 }
 
-template void Memory::Save(Savestate& savestate);
-template void Memory::Save(SavestateProbe& savestate);
+template void Memory::Save(Savestate<ChunkType>& savestate);
+template void Memory::Save(SavestateProbe<ChunkType>& savestate);
 
-void Memory::Load(SavestateLoader& loader) {
+void Memory::Load(SavestateLoader<ChunkType>& loader) {
     EmBankRegs::Load(loader);
 
     Memory::ResetBankHandlers();
@@ -435,6 +447,7 @@ void Memory::InitializeBanks(EmAddressBank& iBankInitializer, int32 iStartingBan
     for (int32 aBankIndex = iStartingBankIndex; aBankIndex < iStartingBankIndex + iNumberOfBanks;
          aBankIndex++) {
         gEmMemBanks[aBankIndex] = &iBankInitializer;
+        gEmMemDirectBanks[aBankIndex] = directBase(iBankInitializer, aBankIndex << 16);
     }
 }
 
@@ -464,6 +477,9 @@ void Memory::ResetBankHandlers(void) {
 
     EmAssert(gSession);
     if (gSession->GetDevice().HasFlash()) EmBankFlash::SetBankHandlers();
+
+    // Cached instructions are keyed by address and may now belong to a different bank
+    if (gCPU68K) gCPU68K->FlushPredecoded();
 }
 
 // ---------------------------------------------------------------------------
@@ -59,6 +59,12 @@ typedef struct EmAddressBank {
 
     EmMemTranslateMetaFunc xlatemetaaddr;
     EmMemCycleFunc EmMemAddOpcodeCycles;
+
+    /* Set for RAM and ROM: reads have no side effects and come straight
+     * from xlateaddr. These banks are read through gEmMemDirectBanks, and
+     * instructions in them may be cached by EmCPU68K, so writes must
+     * invalidate the cache. */
+    int direct;
 } EmAddressBank;
 
 #ifndef ECM_DYNAMIC_PATCH
@@ -71,6 +77,9 @@ extern EmAddressBank** gDynEmMemBanksP;
 
 #endif  // ECM_DYNAMIC_PATCH
 
+/* Host address of each bank that can be read directly, NULL otherwise. */
+extern uint8* gEmMemDirectBanks[65536];
+
 // ---------------------------------------------------------------------------
 //		� Support macros
 // ---------------------------------------------------------------------------
@@ -95,6 +104,51 @@ extern EmAddressBank** gDynEmMemBanksP;
 #define EmMemCallGetFunc(func, addr) ((*EmMemGetBank(addr).func)(addr))
 #define EmMemCallPutFunc(func, addr, v) ((*EmMemGetBank(addr).func)(addr, v))
 
+// ---------------------------------------------------------------------------
+//		� EmMemDoGet32
+// ---------------------------------------------------------------------------
+
+STATIC_INLINE uint32 EmMemDoGet32(void* a) {
+#if WORDSWAP_MEMORY || !UNALIGNED_LONG_ACCESS
+    return (((uint32) * (((uint16*)a) + 0)) << 16) | (((uint32) * (((uint16*)a) + 1)));
+#else
+    return *(uint32*)a;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+//		� EmMemDoGet16
+// ---------------------------------------------------------------------------
+
+STATIC_INLINE uint16 EmMemDoGet16(void* a) { return *(uint16*)a; }
+
+// ---------------------------------------------------------------------------
+//		� EmMemDoGet8
+// ---------------------------------------------------------------------------
+
+STATIC_INLINE uint8 EmMemDoGet8(void* a) {
+#if WORDSWAP_MEMORY
+    return *(uint8*)((long)a ^ 1);
+#else
+    return *(uint8*)a;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+//		� EmMemGetDirectAddress
+// ---------------------------------------------------------------------------
+// Returns the host address for reading size bytes at addr without calling
+// into the bank, or NULL if the access has to go through the bank.  Odd word
+// and long accesses take the slow path so that they raise an address error.
+
+STATIC_INLINE uint8* EmMemGetDirectAddress(emuptr addr, uint32 size) {
+    uint8* base = gEmMemDirectBanks[EmMemBankIndex(addr)];
+
+    if (!base || (size > 1 && (addr & 1)) || (addr & 0xFFFF) > 0x10000 - size) return NULL;
+
+    return base + (addr & 0xFFFF);
+}
+
 // ---------------------------------------------------------------------------
 //		� EmMemGet32
 // ---------------------------------------------------------------------------
@@ -104,6 +158,9 @@ STATIC_INLINE uint32 EmMemGet32(emuptr addr) {
     DbgNotifyRead32(addr);
 #endif
 
+    uint8* direct = EmMemGetDirectAddress(addr, 4);
+    if (direct) return EmMemDoGet32(direct);
+
     return EmMemCallGetFunc(lget, addr);
 }
 
@@ -116,6 +173,9 @@ STATIC_INLINE uint16 EmMemGet16(emuptr addr) {
     DbgNotifyRead16(addr);
 #endif
 
+    uint8* direct = EmMemGetDirectAddress(addr, 2);
+    if (direct) return EmMemDoGet16(direct);
+
     return EmMemCallGetFunc(wget, addr);
 }
 
@@ -128,6 +188,9 @@ STATIC_INLINE uint8 EmMemGet8(emuptr addr) {
     DbgNotifyRead8(addr);
 #endif
 
+    uint8* direct = EmMemGetDirectAddress(addr, 1);
+    if (direct) return EmMemDoGet8(direct);
+
     return EmMemCallGetFunc(bget, addr);
 }
 
@@ -199,36 +262,6 @@ STATIC_INLINE uint8* EmMemGetMetaAddress(emuptr addr) {
     return EmMemGetBank(addr).xlatemetaaddr(addr);
 }
 
-// ---------------------------------------------------------------------------
-//		� EmMemDoGet32
-// ---------------------------------------------------------------------------
-
-STATIC_INLINE uint32 EmMemDoGet32(void* a) {
-#if WORDSWAP_MEMORY || !UNALIGNED_LONG_ACCESS
-    return (((uint32) * (((uint16*)a) + 0)) << 16) | (((uint32) * (((uint16*)a) + 1)));
-#else
-    return *(uint32*)a;
-#endif
-}
-
-// ---------------------------------------------------------------------------
-//		� EmMemDoGet16
-// ---------------------------------------------------------------------------
-
-STATIC_INLINE uint16 EmMemDoGet16(void* a) { return *(uint16*)a; }
-
-// ---------------------------------------------------------------------------
-//		� EmMemDoGet8
-// ---------------------------------------------------------------------------
-
-STATIC_INLINE uint8 EmMemDoGet8(void* a) {
-#if WORDSWAP_MEMORY
-    return *(uint8*)((long)a ^ 1);
-#else
-    return *(uint8*)a;
-#endif
-}
-
 // ---------------------------------------------------------------------------
 //		� EmMemDoPut32
 // ---------------------------------------------------------------------------
@@ -266,6 +299,7 @@ STATIC_INLINE void EmMemDoPut8(void* a, uint8 v) {
 
 #ifdef __cplusplus
 
+    #include "ChunkType.h"
     #include "MemoryRegion.h"
 
 class EmStream;
@@ -329,6 +363,7 @@ extern Bool gPCInRAM;
 extern Bool gPCInROM;
 
 struct EmAddressBank;
+template <typename ChunkType>
 class SavestateLoader;
 
 // Function prototypes.
@@ -342,7 +377,7 @@ class Memory {
 
     template <typename T>
     static void Save(T& savestate);
-    static void Load(SavestateLoader& loader);
+    static void Load(SavestateLoader<ChunkType>& loader);
 
     static void Dispose(void);
 
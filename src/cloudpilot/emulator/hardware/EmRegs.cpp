@@ -103,9 +103,9 @@ void EmRegs::Reset(Bool /*hardwareReset*/) {}
 //		� EmRegs::Save
 // ---------------------------------------------------------------------------
 
-void EmRegs::Save(Savestate&) {}
-void EmRegs::Save(SavestateProbe&) {}
-void EmRegs::Load(SavestateLoader&) {}
+void EmRegs::Save(Savestate<ChunkType>&) {}
+void EmRegs::Save(SavestateProbe<ChunkType>&) {}
+void EmRegs::Load(SavestateLoader<ChunkType>&) {}
 
 // ---------------------------------------------------------------------------
 //		� EmRegs::Dispose
@@ -745,11 +745,11 @@ void EmRegs328::Reset(Bool hardwareReset) {
 // ---------------------------------------------------------------------------
 //		� EmRegs328::Save
 // ---------------------------------------------------------------------------
-void EmRegs328::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegs328::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegs328::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegs328::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegs328::Load(SavestateLoader& savestate) {
+void EmRegs328::Load(SavestateLoader<ChunkType>& savestate) {
     Chunk* chunk = savestate.GetChunk(ChunkType::regs328);
     if (!chunk) {
         logging::printf("unable to restore Regs328: missing savestate\n");
@@ -784,6 +784,7 @@ void EmRegs328::Load(SavestateLoader& savestate) {
     powerOffCached = GetAsleep();
 
     afterLoad = true;
+    EmHAL::ScheduleCycle(0);
 }
 
 template <typename T>
@@ -1056,7 +1057,11 @@ void EmRegs328::Cycle(uint64 systemCycles, Bool sleeping) {
     if (unlikely(powerOffCached)) return;
 
     this->systemCycles = systemCycles;
-    if (unlikely(systemCycles >= nextTimerEventAfterCycle)) UpdateTimers();
+
+    if (unlikely(systemCycles >= nextTimerEventAfterCycle))
+        UpdateTimers();
+    else
+        EmHAL::ScheduleCycle(nextTimerEventAfterCycle);
 }
 
 void EmRegs328::SetUARTSync(bool sync) {
@@ -2799,6 +2804,8 @@ void EmRegs328::UpdateTimers() {
     } else {
         tmr2LastProcessedSystemCycles = systemCycles;
     }
+
+    EmHAL::ScheduleCycle(nextTimerEventAfterCycle);
 }
 
 void EmRegs328::pwmcWrite(emuptr address, int size, uint32 value) {
@@ -512,11 +512,11 @@ void EmRegsEZ::Reset(Bool hardwareReset) {
 //		� EmRegsEZ::Save
 // ---------------------------------------------------------------------------
 
-void EmRegsEZ::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsEZ::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsEZ::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegsEZ::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsEZ::Load(SavestateLoader& savestate) {
+void EmRegsEZ::Load(SavestateLoader<ChunkType>& savestate) {
     if (fSPISlaveADC) fSPISlaveADC->Load(savestate);
 
     Chunk* chunk = savestate.GetChunk(ChunkType::regsEZ);
@@ -548,6 +548,7 @@ void EmRegsEZ::Load(SavestateLoader& savestate) {
     screenMarked = false;
 
     afterLoad = true;
+    EmHAL::ScheduleCycle(0);
 
     systemCycles = gSession->GetSystemCycles();
     UpdateTimer();
@@ -793,7 +794,11 @@ void EmRegsEZ::Cycle(uint64 systemCycles, Bool sleeping) {
     if (unlikely(powerOffCached)) return;
 
     this->systemCycles = systemCycles;
-    if (unlikely(systemCycles >= nextTimerEventAfterCycle)) UpdateTimer();
+
+    if (unlikely(systemCycles >= nextTimerEventAfterCycle))
+        UpdateTimer();
+    else
+        EmHAL::ScheduleCycle(nextTimerEventAfterCycle);
 }
 
 void EmRegsEZ::SetUARTSync(bool sync) {
@@ -2601,6 +2606,8 @@ void EmRegsEZ::UpdateTimer() {
     } else {
         lastProcessedSystemCycles = systemCycles;
     }
+
+    EmHAL::ScheduleCycle(nextTimerEventAfterCycle);
 }
 
 void EmRegsEZ::HandleDayRollover() {
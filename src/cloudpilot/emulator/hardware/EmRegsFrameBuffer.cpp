@@ -17,6 +17,7 @@
 #include "EmCommon.h"
 #include "EmMemory.h"  // EmMemDoGet32
 #include "EmSystemState.h"
+#include "Logging.h"
 #include "MemoryRegion.h"
 #include "Miscellaneous.h"  // StWordSwapper
 #include "Platform.h"       // Platform::AllocateMemoryClear
@@ -71,7 +72,7 @@ void EmRegsFrameBuffer::Initialize(void) {
 
 void EmRegsFrameBuffer::Reset(Bool hardwareReset) { EmRegs::Reset(hardwareReset); }
 
-void EmRegsFrameBuffer::Load(SavestateLoader& loader) {
+void EmRegsFrameBuffer::Load(SavestateLoader<ChunkType>& loader) {
     if (!loader.HasChunk(ChunkType::regsFrameBuffer)) return;
 
     Chunk* chunk = loader.GetChunk(ChunkType::regsFrameBuffer);
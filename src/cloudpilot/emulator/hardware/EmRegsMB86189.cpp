@@ -1,6 +1,7 @@
 #include "EmRegsMB86189.h"
 
 #include "ChunkHelper.h"
+#include "Logging.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -53,11 +54,11 @@ void EmRegsMB86189::Reset(Bool hardwareReset) {
     memoryStick.Reset();
 }
 
-void EmRegsMB86189::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsMB86189::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsMB86189::Save(SavestateProbe& savestateProbe) { DoSave(savestateProbe); }
+void EmRegsMB86189::Save(SavestateProbe<ChunkType>& savestateProbe) { DoSave(savestateProbe); }
 
-void EmRegsMB86189::Load(SavestateLoader& loader) {
+void EmRegsMB86189::Load(SavestateLoader<ChunkType>& loader) {
     memoryStick.Load(loader);
 
     Chunk* chunk = loader.GetChunk(ChunkType::regsMB86189);
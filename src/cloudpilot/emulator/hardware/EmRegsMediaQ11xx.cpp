@@ -1333,11 +1333,11 @@ void EmRegsMediaQ11xx::Reset(Bool hardwareReset) {
     }
 }
 
-void EmRegsMediaQ11xx::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsMediaQ11xx::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsMediaQ11xx::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegsMediaQ11xx::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsMediaQ11xx::Load(SavestateLoader& loader) {
+void EmRegsMediaQ11xx::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::regsMQ1xx);
     if (!chunk) {
         logging::printf("unable to restore RegsMediaQ11xx: missing savestate\n");
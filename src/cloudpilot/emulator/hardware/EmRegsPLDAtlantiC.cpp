@@ -1,6 +1,7 @@
 #include "EmRegsPLDAtlantiC.h"
 
 #include "ChunkHelper.h"
+#include "Logging.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -15,11 +16,11 @@ void EmRegsPLDAtlantiC::Reset(Bool hardwareReset) {
     if (hardwareReset) memset(regs, 0, sizeof(regs));
 }
 
-void EmRegsPLDAtlantiC::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsPLDAtlantiC::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsPLDAtlantiC::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegsPLDAtlantiC::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsPLDAtlantiC::Load(SavestateLoader& loader) {
+void EmRegsPLDAtlantiC::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::regsPLLDAtlantiC);
     if (!chunk) {
         logging::printf("unable to restore RegsPLDAtlantiC: missing savestate\n");
@@ -10,9 +10,9 @@ class EmRegsPLDAtlantiC : public EmRegs, EmHALHandler {
     EmRegsPLDAtlantiC(emuptr baseAddress);
 
     virtual void Reset(Bool hardwareReset);
-    virtual void Save(Savestate&);
-    virtual void Save(SavestateProbe&);
-    virtual void Load(SavestateLoader&);
+    virtual void Save(Savestate<ChunkType>&);
+    virtual void Save(SavestateProbe<ChunkType>&);
+    virtual void Load(SavestateLoader<ChunkType>&);
 
     virtual void SetSubBankHandlers(void);
 
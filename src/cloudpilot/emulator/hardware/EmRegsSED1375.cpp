@@ -19,6 +19,7 @@
 #include "EmRegsFrameBuffer.h"
 #include "EmSystemState.h"
 #include "Frame.h"
+#include "Logging.h"
 #include "Miscellaneous.h"  // StWordSwapper
 #include "Nibbler.h"
 #include "Savestate.h"
@@ -102,11 +103,11 @@ void EmRegsSED1375::Reset(Bool hardwareReset) {
     }
 }
 
-void EmRegsSED1375::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsSED1375::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsSED1375::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegsSED1375::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsSED1375::Load(SavestateLoader& loader) {
+void EmRegsSED1375::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::regsSED1375);
     if (!chunk) {
         logging::printf("unable to restore RegsSED1375: missing savestate\n");
@@ -18,6 +18,7 @@
 #include "EmRegsFrameBuffer.h"
 #include "EmSystemState.h"
 #include "Frame.h"
+#include "Logging.h"
 #include "Nibbler.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
@@ -126,11 +127,11 @@ void EmRegsSED1376::Reset(Bool hardwareReset) {
     }
 }
 
-void EmRegsSED1376::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsSED1376::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsSED1376::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegsSED1376::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsSED1376::Load(SavestateLoader& loader) {
+void EmRegsSED1376::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::regsSED1376);
     if (!chunk) {
         logging::printf("unable to restore RegsSED1376: missing savestate\n");
@@ -30,6 +30,7 @@
 #include "MetaMemory.h"
 #include "Miscellaneous.h"  // GetHostTime
 #include "Nibbler.h"
+#include "Platform.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -1218,11 +1219,11 @@ void EmRegsSZ::Dispose(void) {
 
 EmRegsESRAM* EmRegsSZ::GetESRAM() { return esram; }
 
-void EmRegsSZ::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsSZ::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsSZ::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegsSZ::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsSZ::Load(SavestateLoader& loader) {
+void EmRegsSZ::Load(SavestateLoader<ChunkType>& loader) {
     if (fSPISlaveADC) fSPISlaveADC->Load(loader);
 
     Chunk* chunk = loader.GetChunk(ChunkType::regsSZ);
@@ -1764,7 +1765,11 @@ inline void EmRegsSZ::Cycle(uint64 systemCycles, Bool sleeping) {
     if (unlikely(powerOffCached)) return;
 
     this->systemCycles = systemCycles;
-    if (unlikely(systemCycles >= nextTimerEventAfterCycle)) UpdateTimers();
+
+    if (unlikely(systemCycles >= nextTimerEventAfterCycle))
+        UpdateTimers();
+    else
+        EmHAL::ScheduleCycle(nextTimerEventAfterCycle);
 }
 
 void EmRegsSZ::SetUARTSync(bool sync) {
@@ -3980,6 +3985,8 @@ void EmRegsSZ::UpdateTimers() {
     } else {
         tmr2LastProcessedSystemCycles = systemCycles;
     }
+
+    EmHAL::ScheduleCycle(nextTimerEventAfterCycle);
 }
 
 void EmRegsSZ::HandleDayRollover() {
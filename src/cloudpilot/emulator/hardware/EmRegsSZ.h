@@ -39,9 +39,9 @@ class EmRegsSZ : public EmRegs, public EmHALHandler {
 
     EmRegsESRAM* GetESRAM();
 
-    virtual void Save(Savestate&);
-    virtual void Save(SavestateProbe&);
-    virtual void Load(SavestateLoader&);
+    virtual void Save(Savestate<ChunkType>&);
+    virtual void Save(SavestateProbe<ChunkType>&);
+    virtual void Load(SavestateLoader<ChunkType>&);
 
     virtual void SetSubBankHandlers(void);
     virtual uint8* GetRealAddress(emuptr address);
@@ -31,6 +31,7 @@
 #include "Logging.h"  // LogAppendMsg
 #include "MetaMemory.h"
 #include "Miscellaneous.h"  // GetHostTime
+#include "Platform.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -599,11 +600,11 @@ void EmRegsVZ::Reset(Bool hardwareReset) {
     UpdateTimers();
 }
 
-void EmRegsVZ::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsVZ::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsVZ::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegsVZ::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsVZ::Load(SavestateLoader& loader) {
+void EmRegsVZ::Load(SavestateLoader<ChunkType>& loader) {
     if (fSPISlaveADC) fSPISlaveADC->Load(loader);
     if (GetSPI1Slave()) GetSPI1Slave()->Load(loader);
 
@@ -639,6 +640,7 @@ void EmRegsVZ::Load(SavestateLoader& loader) {
     markScreenScheduled = true;
     screenMarked = false;
     afterLoad = true;
+    EmHAL::ScheduleCycle(0);
 
     systemCycles = gSession->GetSystemCycles();
     UpdateTimers();
@@ -959,7 +961,10 @@ inline void EmRegsVZ::Cycle(uint64 systemCycles, Bool sleeping) {
 
     this->systemCycles = systemCycles;
 
-    if (unlikely(systemCycles >= nextTimerEventAfterCycle)) UpdateTimers();
+    if (unlikely(systemCycles >= nextTimerEventAfterCycle))
+        UpdateTimers();
+    else
+        ScheduleCycle();
 }
 
 void EmRegsVZ::SetUARTSync(bool sync) {
@@ -1687,7 +1692,11 @@ uint32 EmRegsVZ::rtcHourMinSecRead(emuptr address, int size) {
 void EmRegsVZ::sdctlWrite(emuptr address, int size, uint32 value) {
     EmRegsVZ::StdWrite(address, size, value);
 
+    const uint32 ramBankMask = gRAMBank_Mask;
     ApplySdctl();
+
+    // Direct RAM reads go through host pointers that were set up for the old layout
+    if (gRAMBank_Mask != ramBankMask) gSession->ScheduleResetBanks();
 }
 
 void EmRegsVZ::ApplySdctl() {
@@ -2988,6 +2997,8 @@ void EmRegsVZ::Spi1TransmitWord() {
 
     uint16 spiCont1 = READ_REGISTER(spiCont1);
     spi1Countdown += (4 << ((spiCont1 >> 13) & 0x07)) * ((spiCont1 & 0x0f) + 1);
+
+    ScheduleCycle();
 }
 
 void EmRegsVZ::Spi1UpdateInterrupts() {
@@ -3127,6 +3138,14 @@ void EmRegsVZ::UpdateTimers() {
     } else {
         tmr2LastProcessedSystemCycles = systemCycles;
     }
+
+    ScheduleCycle();
+}
+
+void EmRegsVZ::ScheduleCycle() {
+    EmHAL::ScheduleCycle(nextTimerEventAfterCycle);
+
+    if (spi1TransferInProgress) EmHAL::ScheduleCycle(systemCycles + std::max(spi1Countdown, 0));
 }
 
 void EmRegsVZ::HandleDayRollover() {
@@ -14,10 +14,14 @@
 #ifndef EmSPISlave_h
 #define EmSPISlave_h
 
+#include "ChunkType.h"
 #include "EmCommon.h"
 
+template <typename ChunkType>
 class Savestate;
+template <typename ChunkType>
 class SavestateProbe;
+template <typename ChunkType>
 class SavestateLoader;
 
 class EmSPISlave {
@@ -25,9 +29,9 @@ class EmSPISlave {
     EmSPISlave(void);
     virtual ~EmSPISlave(void);
 
-    virtual void Save(Savestate&);
-    virtual void Save(SavestateProbe&);
-    virtual void Load(SavestateLoader&);
+    virtual void Save(Savestate<ChunkType>&);
+    virtual void Save(SavestateProbe<ChunkType>&);
+    virtual void Load(SavestateLoader<ChunkType>&);
 
     virtual uint16 DoExchange(uint16 control, uint16 data) = 0;
     virtual void Enable(void);
@@ -107,7 +107,7 @@ EmSPISlaveADS784x::EmSPISlaveADS784x(EmADSChannelType ch0, EmADSChannelType ch1,
 
 EmSPISlaveADS784x::~EmSPISlaveADS784x(void) {}
 
-void EmSPISlaveADS784x::Load(SavestateLoader& loader) {
+void EmSPISlaveADS784x::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::spiSlaveADS784);
     if (!chunk) return;
 
@@ -123,9 +123,9 @@ void EmSPISlaveADS784x::Load(SavestateLoader& loader) {
     DoSaveLoad(helper);
 }
 
-void EmSPISlaveADS784x::Save(Savestate& savestate) { DoSave(savestate); }
+void EmSPISlaveADS784x::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmSPISlaveADS784x::Save(SavestateProbe& savestateProbe) { DoSave(savestateProbe); }
+void EmSPISlaveADS784x::Save(SavestateProbe<ChunkType>& savestateProbe) { DoSave(savestateProbe); }
 
 template <typename T>
 void EmSPISlaveADS784x::DoSave(T& savestate) {
@@ -3,6 +3,7 @@
 #include "CPCrc.h"
 #include "ChunkHelper.h"
 #include "ExternalStorage.h"
+#include "Logging.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -46,11 +47,11 @@ void EmSPISlaveSD::Reset() {
     cmd12Countdown = 0;
 }
 
-void EmSPISlaveSD::Save(Savestate& savestate) { DoSave(savestate); }
+void EmSPISlaveSD::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmSPISlaveSD::Save(SavestateProbe& savestateProbe) { DoSave(savestateProbe); }
+void EmSPISlaveSD::Save(SavestateProbe<ChunkType>& savestateProbe) { DoSave(savestateProbe); }
 
-void EmSPISlaveSD::Load(SavestateLoader& loader) {
+void EmSPISlaveSD::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::spiSlaveSD);
     if (!chunk) return;
 
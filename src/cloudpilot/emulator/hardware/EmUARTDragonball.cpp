@@ -323,7 +323,8 @@ void EmUARTDragonball::StateChanged(State& newState, Bool sendTxData) {
                     systemCycles +
                     (MESSAGE_TIMEOUT_USEC * static_cast<uint64>(gSession->GetClocksPerSecond())) /
                         1000000ull;
-                ;
+
+                ScheduleCycle();
             }
 
             if (transport && transport->CanWrite())  // The host serial port is open
@@ -411,6 +412,8 @@ void EmUARTDragonball::UpdateState(State& state, Bool refreshRxData) {
                 systemCycles + (WAITING_FOR_DATA_TIMEOUT_USEC *
                                 static_cast<uint64>(gSession->GetClocksPerSecond())) /
                                    1000000ull;
+
+            ScheduleCycle();
         }
 
         this->ReceiveRxFIFO(transport);
@@ -717,6 +720,14 @@ void EmUARTDragonball::Cycle(uint64 systemCycles, bool isSleeping) {
 #endif
         UpdateTransactionState(TransactionState::idle);
     }
+
+    ScheduleCycle();
+}
+
+void EmUARTDragonball::ScheduleCycle() {
+    if (transactionState == TransactionState::sending ||
+        transactionState == TransactionState::waitingForData)
+        EmHAL::ScheduleCycle(transactionTimeoutCycles + 1);
 }
 
 void EmUARTDragonball::CycleThunk(void* ctx, uint64 systemCycles, bool isSleeping) {
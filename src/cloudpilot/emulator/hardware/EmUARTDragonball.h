@@ -140,6 +140,7 @@ class EmUARTDragonball {
     void UpdateTransactionState(TransactionState state);
 
     void Cycle(uint64 systemCycles, bool isSleeping);
+    void ScheduleCycle();
     static void CycleThunk(void* ctx, uint64 systemCycles, bool isSleeping);
 
    private:
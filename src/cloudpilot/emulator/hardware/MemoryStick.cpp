@@ -2,6 +2,7 @@
 
 #include "ChunkHelper.h"
 #include "EmMemory.h"
+#include "Logging.h"
 #include "MemoryStickStructs.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
@@ -82,7 +83,7 @@ MemoryStick::MemoryStick() {}
 
 MemoryStick::~MemoryStick() {}
 
-void MemoryStick::Load(SavestateLoader& loader) {
+void MemoryStick::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::memoryStick);
     if (!chunk) return;
 
@@ -126,8 +127,8 @@ void MemoryStick::Save(T& savestate) {
     DoSaveLoad(helper, SAVESTATE_VERSION);
 }
 
-template void MemoryStick::Save<Savestate>(Savestate&);
-template void MemoryStick::Save<SavestateProbe>(SavestateProbe&);
+template void MemoryStick::Save<Savestate<ChunkType>>(Savestate<ChunkType>&);
+template void MemoryStick::Save<SavestateProbe<ChunkType>>(SavestateProbe<ChunkType>&);
 
 template <typename T>
 void MemoryStick::DoSaveLoad(T& helper, uint32 version) {
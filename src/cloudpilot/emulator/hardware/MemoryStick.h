@@ -2,11 +2,15 @@
 #define _MEMORY_STICK_
 
 #include "CardImage.h"
+#include "ChunkType.h"
 #include "EmCommon.h"
 #include "EmEvent.h"
 
+template <typename ChunkType>
 class Savestate;
+template <typename ChunkType>
 class SavestateProbe;
+template <typename ChunkType>
 class SavestateLoader;
 
 class MemoryStick {
@@ -56,7 +60,7 @@ class MemoryStick {
 
     template <typename T>
     void Save(T& savestate);
-    void Load(SavestateLoader&);
+    void Load(SavestateLoader<ChunkType>&);
 
     void Initialize();
     void Reset();
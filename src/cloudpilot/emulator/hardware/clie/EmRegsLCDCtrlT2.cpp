@@ -6,6 +6,7 @@
 #include "EmSession.h"
 #include "EmSystemState.h"
 #include "Frame.h"
+#include "Logging.h"
 #include "Nibbler.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
@@ -75,11 +76,11 @@ void EmRegsMQLCDControlT2::Reset(Bool hardwareReset) {
 
 void EmRegsMQLCDControlT2::Dispose(void) { EmRegs::Dispose(); }
 
-void EmRegsMQLCDControlT2::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsMQLCDControlT2::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsMQLCDControlT2::Save(SavestateProbe& savestate) { DoSave(savestate); }
+void EmRegsMQLCDControlT2::Save(SavestateProbe<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsMQLCDControlT2::Load(SavestateLoader& loader) {
+void EmRegsMQLCDControlT2::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::regsMQ1168);
     if (!chunk) {
         logging::printf("unable to restore RegsMQLCDControlT2: missing savestate\n");
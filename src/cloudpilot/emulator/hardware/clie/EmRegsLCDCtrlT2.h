@@ -306,9 +306,9 @@ class EmRegsMQLCDControlT2 : public EmRegs, public MediaQFramebuffer<EmRegsMQLCD
     virtual void Reset(Bool hardwareReset);
     virtual void Dispose();
 
-    virtual void Save(Savestate&);
-    virtual void Save(SavestateProbe&);
-    virtual void Load(SavestateLoader&);
+    virtual void Save(Savestate<ChunkType>&);
+    virtual void Save(SavestateProbe<ChunkType>&);
+    virtual void Load(SavestateLoader<ChunkType>&);
 
     virtual void SetSubBankHandlers();
     virtual uint8* GetRealAddress(emuptr address);
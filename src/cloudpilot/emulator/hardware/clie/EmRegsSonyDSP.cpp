@@ -6,6 +6,7 @@
 #include "ChunkHelper.h"
 #include "EmCPU68K.h"
 #include "EmMemory.h"
+#include "Logging.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -165,11 +166,11 @@ void EmRegsSonyDSP::Reset(Bool hardwareReset) {
     memoryStick.Reset();
 }
 
-void EmRegsSonyDSP::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsSonyDSP::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsSonyDSP::Save(SavestateProbe& savestateProbe) { DoSave(savestateProbe); }
+void EmRegsSonyDSP::Save(SavestateProbe<ChunkType>& savestateProbe) { DoSave(savestateProbe); }
 
-void EmRegsSonyDSP::Load(SavestateLoader& loader) {
+void EmRegsSonyDSP::Load(SavestateLoader<ChunkType>& loader) {
     memoryStick.Load(loader);
 
     Chunk* chunk = loader.GetChunk(ChunkType::regsSonyDsp);
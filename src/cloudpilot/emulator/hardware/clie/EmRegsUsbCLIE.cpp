@@ -20,6 +20,7 @@
 #include "EmCommon.h"
 #include "EmHAL.h"
 #include "EmMemory.h"  // gMemoryAccess
+#include "Logging.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -129,11 +130,11 @@ void EmRegsUsbCLIE::Reset(Bool hardwareReset) {
 
 void EmRegsUsbCLIE::Dispose(void) {}
 
-void EmRegsUsbCLIE::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsUsbCLIE::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsUsbCLIE::Save(SavestateProbe& savestateProbe) { DoSave(savestateProbe); }
+void EmRegsUsbCLIE::Save(SavestateProbe<ChunkType>& savestateProbe) { DoSave(savestateProbe); }
 
-void EmRegsUsbCLIE::Load(SavestateLoader& loader) {
+void EmRegsUsbCLIE::Load(SavestateLoader<ChunkType>& loader) {
     if (!loader.HasChunk(ChunkType::regsUsbClie)) return;
 
     Chunk* chunk = loader.GetChunk(ChunkType::regsUsbClie);
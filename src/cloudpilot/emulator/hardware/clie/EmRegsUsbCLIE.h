@@ -33,9 +33,9 @@ class EmRegsUsbCLIE : public EmRegs {
     EmRegsUsbCLIE(uint32 offset);
     virtual ~EmRegsUsbCLIE(void);
 
-    virtual void Save(Savestate&);
-    virtual void Save(SavestateProbe&);
-    virtual void Load(SavestateLoader&);
+    virtual void Save(Savestate<ChunkType>&);
+    virtual void Save(SavestateProbe<ChunkType>&);
+    virtual void Load(SavestateLoader<ChunkType>&);
 
     virtual void Initialize(void);
     virtual void Reset(Bool hardwareReset);
@@ -19,6 +19,7 @@
 #include "EmMemory.h"
 #include "EmSystemState.h"
 #include "ExternalStorage.h"
+#include "Logging.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -62,11 +63,11 @@ EmRegs330CPLD::EmRegs330CPLD(emuptr memoryStart, HandEra330PortManager* fPortMan
 
 EmRegs330CPLD::~EmRegs330CPLD(void) {}
 
-void EmRegs330CPLD::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegs330CPLD::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegs330CPLD::Save(SavestateProbe& savestateProbe) { DoSave(savestateProbe); }
+void EmRegs330CPLD::Save(SavestateProbe<ChunkType>& savestateProbe) { DoSave(savestateProbe); }
 
-void EmRegs330CPLD::Load(SavestateLoader& loader) {
+void EmRegs330CPLD::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::regs330CPLD);
     if (!chunk) {
         logging::printf("unable to restore Regs330CPLD: missing savestate\n");
@@ -20,6 +20,7 @@
 #include "EmRegsVZPrv.h"
 #include "EmSPISlave330Current.h"
 #include "EmSPISlaveADS784x.h"  // EmSPISlaveADS784x
+#include "Logging.h"
 #include "Savestate.h"
 #include "SavestateLoader.h"
 #include "SavestateProbe.h"
@@ -85,7 +86,7 @@ EmRegsVZHandEra330::EmRegsVZHandEra330(HandEra330PortManager** fPortManager)
 
 EmRegsVZHandEra330::~EmRegsVZHandEra330(void) { delete fSPISlaveADC; }
 
-void EmRegsVZHandEra330::Load(SavestateLoader& loader) {
+void EmRegsVZHandEra330::Load(SavestateLoader<ChunkType>& loader) {
     EmRegsVZ::Load(loader);
     fSPISlaveCurrent->Load(loader);
 
@@ -109,9 +110,9 @@ void EmRegsVZHandEra330::Load(SavestateLoader& loader) {
     DoSaveLoad(helper);
 }
 
-void EmRegsVZHandEra330::Save(Savestate& savestate) { DoSave(savestate); }
+void EmRegsVZHandEra330::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmRegsVZHandEra330::Save(SavestateProbe& savestateProbe) { DoSave(savestateProbe); }
+void EmRegsVZHandEra330::Save(SavestateProbe<ChunkType>& savestateProbe) { DoSave(savestateProbe); }
 
 template <typename T>
 void EmRegsVZHandEra330::DoSave(T& savestate) {
@@ -56,7 +56,7 @@ EmSPISlave330Current::EmSPISlave330Current()
 
 EmSPISlave330Current::~EmSPISlave330Current(void) {}
 
-void EmSPISlave330Current::Load(SavestateLoader& loader) {
+void EmSPISlave330Current::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::spiSlave330Current);
     if (!chunk) return;
 
@@ -72,9 +72,9 @@ void EmSPISlave330Current::Load(SavestateLoader& loader) {
     DoSaveLoad(helper);
 }
 
-void EmSPISlave330Current::Save(Savestate& savestate) { DoSave(savestate); }
+void EmSPISlave330Current::Save(Savestate<ChunkType>& savestate) { DoSave(savestate); }
 
-void EmSPISlave330Current::Save(SavestateProbe& savestateProbe) { DoSave(savestateProbe); }
+void EmSPISlave330Current::Save(SavestateProbe<ChunkType>& savestateProbe) { DoSave(savestateProbe); }
 
 template <typename T>
 void EmSPISlave330Current::DoSave(T& savestate) {
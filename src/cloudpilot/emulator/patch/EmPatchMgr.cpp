@@ -193,10 +193,10 @@ void EmPatchMgr::Save(T& savestate) {
     }
 }
 
-template void EmPatchMgr::Save<Savestate>(Savestate& savestate);
-template void EmPatchMgr::Save<SavestateProbe>(SavestateProbe& savestate);
+template void EmPatchMgr::Save<Savestate<ChunkType>>(Savestate<ChunkType>& savestate);
+template void EmPatchMgr::Save<SavestateProbe<ChunkType>>(SavestateProbe<ChunkType>& savestate);
 
-void EmPatchMgr::Load(SavestateLoader& loader) {
+void EmPatchMgr::Load(SavestateLoader<ChunkType>& loader) {
     Chunk* chunk = loader.GetChunk(ChunkType::patchMgr);
     if (!chunk) return;
 
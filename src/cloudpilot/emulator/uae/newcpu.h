@@ -91,9 +91,43 @@ extern regstruct lastint_regs;
 #define m68k_dreg(r,num) ((r).regs[(num)])
 #define m68k_areg(r,num) (((r).regs + 8)[(num)])
 
-#define get_ibyte(o) get_byte(regs.pc + (o) + 1)
-#define get_iword(o) get_word(regs.pc + (o))
-#define get_ilong(o) get_long(regs.pc + (o))
+/* Instruction words at regs.pc if the opcode was dispatched from the predecode
+ * cache in EmCPU68K, NULL otherwise. Covers the longest 68000 instruction.
+ */
+extern const uae_u16* regs_iwords;
+
+STATIC_INLINE uae_u8 get_ibyte (int o)
+{
+    if (!regs_iwords) return get_byte (regs.pc + o + 1);
+
+#ifdef ENABLE_DEBUGGER
+    DbgNotifyRead8 (regs.pc + o + 1);
+#endif
+
+    return (uae_u8) regs_iwords[o >> 1];
+}
+
+STATIC_INLINE uae_u16 get_iword (int o)
+{
+    if (!regs_iwords) return get_word (regs.pc + o);
+
+#ifdef ENABLE_DEBUGGER
+    DbgNotifyRead16 (regs.pc + o);
+#endif
+
+    return regs_iwords[o >> 1];
+}
+
+STATIC_INLINE uae_u32 get_ilong (int o)
+{
+    if (!regs_iwords) return get_long (regs.pc + o);
+
+#ifdef ENABLE_DEBUGGER
+    DbgNotifyRead32 (regs.pc + o);
+#endif
+
+    return ((uae_u32) regs_iwords[o >> 1] << 16) | regs_iwords[(o >> 1) + 1];
+}
 
 #define m68k_incpc(o) (regs.pc += (o))
 
@@ -77,7 +77,7 @@ namespace {
             fifo.DoSaveLoad(helper);
         }
 
-        void Load(SavestateLoader& loader) {
+        void Load(SavestateLoader<ChunkType>& loader) {
             auto* chunk = loader.GetChunk(ChunkType::cpu68k);
             LoadChunkHelper helper(*chunk);
 
@@ -86,7 +86,7 @@ namespace {
     };
 
     TEST(FifoTest, deSearializesCorrectly) {
-        Savestate savestate;
+        Savestate<ChunkType> savestate;
         MockRoot root;
 
         root.fifo.Push(1u);
@@ -96,7 +96,7 @@ namespace {
         savestate.Save(root);
 
         MockRoot deserializedRoot;
-        SavestateLoader loader;
+        SavestateLoader<ChunkType> loader;
 
         ASSERT_TRUE(loader.Load(savestate.GetBuffer(), savestate.GetSize(), deserializedRoot));
 
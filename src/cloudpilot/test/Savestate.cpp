@@ -5,15 +5,16 @@
 #include "Savestate.h"
 
 #include "ChunkHelper.h"
+#include "ChunkType.h"
 #include "SavestateLoader.h"
 
 namespace {
     namespace SavestateDeSerialisation {
         struct MockCpu68k {
-            uint32 x{0};
-            int16 y{0};
+            uint32_t x{0};
+            int16_t y{0};
             double z{0};
-            string str{"hello world"};
+            std::string str{"hello world"};
 
             template <typename T>
             void Save(T& savestate) {
@@ -24,7 +25,7 @@ namespace {
                 DoSaveLoad(helper);
             }
 
-            void Load(SavestateLoader& loader) {
+            void Load(SavestateLoader<ChunkType>& loader) {
                 Chunk* chunk = loader.GetChunk(ChunkType::cpu68k);
                 if (!chunk) return;
 
@@ -43,9 +44,9 @@ namespace {
         };
 
         struct MockRegsEZ {
-            uint8 x{0};
-            uint8 y{0};
-            uint8 z{0};
+            uint8_t x{0};
+            uint8_t y{0};
+            uint8_t z{0};
             bool b1{false}, b2{true};
 
             template <typename T>
@@ -57,7 +58,7 @@ namespace {
                 DoSaveLoad(helper);
             }
 
-            void Load(SavestateLoader& loader) {
+            void Load(SavestateLoader<ChunkType>& loader) {
                 Chunk* chunk = loader.GetChunk(ChunkType::regsEZ);
                 if (!chunk) return;
 
@@ -87,7 +88,7 @@ namespace {
                 regsEZ.Save(savestate);
             }
 
-            void Load(SavestateLoader& loader) {
+            void Load(SavestateLoader<ChunkType>& loader) {
                 cpu68k.Load(loader);
                 regsEZ.Load(loader);
             }
@@ -98,12 +99,12 @@ namespace {
             MockCpu68k cpu68k{0x12345678, -17, 3.5};
             MockRoot root{cpu68k, regsEZ};
 
-            Savestate savestate;
+            Savestate<ChunkType> savestate;
             ASSERT_TRUE(savestate.Save(root));
             ASSERT_EQ(savestate.GetSize(), 60u);
 
             MockRoot loadRoot;
-            SavestateLoader loader;
+            SavestateLoader<ChunkType> loader;
 
             ASSERT_TRUE(loader.Load(savestate.GetBuffer(), savestate.GetSize(), loadRoot));
             ASSERT_EQ(loadRoot.cpu68k, cpu68k);
@@ -115,12 +116,12 @@ namespace {
             MockCpu68k cpu68k{0x12345678, -17, 3.5};
             MockRoot root{cpu68k, regsEZ};
 
-            Savestate savestate;
+            Savestate<ChunkType> savestate;
             ASSERT_TRUE(savestate.Save(root));
             ASSERT_EQ(savestate.GetSize(), 60u);
 
             MockRoot loadRoot;
-            SavestateLoader loader;
+            SavestateLoader<ChunkType> loader;
 
             ASSERT_TRUE(loader.Load(savestate.GetBuffer(), savestate.GetSize(), loadRoot));
             ASSERT_EQ(loadRoot.cpu68k, cpu68k);
@@ -148,7 +149,7 @@ namespace {
         };
 
         TEST(SavestateSave, RequestingAChunkTwiceDuringSaveGeneratesAnError) {
-            Savestate savestate;
+            Savestate<ChunkType> savestate;
             Mock mock;
 
             ASSERT_FALSE(savestate.Save(mock));
@@ -177,7 +178,7 @@ namespace {
         };
 
         TEST(SavestateSave, ChunkErrorsArePropagated) {
-            Savestate savestate;
+            Savestate<ChunkType> savestate;
             Mock1 mock1;
             Mock2 mock2;
 
@@ -200,7 +201,7 @@ namespace {
         };
 
         TEST(SavestateSave, NotifyErrorRaisesAnError) {
-            Savestate savestate;
+            Savestate<ChunkType> savestate;
             Mock1 mock1;
             Mock2 mock2;
 
@@ -4,6 +4,7 @@
 
 #include "SavestateLoader.h"
 
+#include "ChunkType.h"
 #include "Savestate.h"
 
 namespace {
@@ -18,7 +19,7 @@ namespace {
             chunkRegsEZ->Put64(0);
         }
 
-        void Load(SavestateLoader& loader) {}
+        void Load(SavestateLoader<ChunkType>& loader) {}
     };
 
     class SavestateLoaderTest : public ::testing::Test {
@@ -27,8 +28,8 @@ namespace {
 
        protected:
         Mock mock;
-        Savestate savestate;
-        SavestateLoader loader;
+        Savestate<ChunkType> savestate;
+        SavestateLoader<ChunkType> loader;
     };
 
     TEST_F(SavestateLoaderTest, ItFailsIfBufferIsTooSmallForHeader) {
@@ -48,7 +49,7 @@ namespace {
     }
 
     TEST_F(SavestateLoaderTest, ItFailsIfBufferIsTooLarge) {
-        uint8 buffer[33];
+        uint8_t buffer[33];
         memcpy(buffer, savestate.GetBuffer(), savestate.GetSize());
 
         ASSERT_FALSE(loader.Load(buffer, 33, mock));
@@ -2,13 +2,14 @@
 #include <gtest/gtest.h>
 // clang-format on
 
+#include "ChunkType.h"
 #include "Logging.h"
 #include "SavestateProbe.h"
 
 namespace {
 
     TEST(SavestateProbe, ItMapsTheRequestedChunkCorrectly) {
-        SavestateProbe probe;
+        SavestateProbe<ChunkType> probe;
 
         ChunkProbe* chunkCpu68K = probe.GetChunk(ChunkType::cpu68k);
         ASSERT_TRUE(chunkCpu68K);
@@ -35,7 +36,7 @@ namespace {
     }
 
     TEST(SavestateProbe, RequestingAChunkTwiceGeneratesAnError) {
-        SavestateProbe probe;
+        SavestateProbe<ChunkType> probe;
 
         ASSERT_TRUE(probe.GetChunk(ChunkType::cpu68k));
         ASSERT_FALSE(probe.HasError());
@@ -45,7 +46,7 @@ namespace {
     }
 
     TEST(SavestateProbe, NotifyErrorGeneratesAnError) {
-        SavestateProbe probe;
+        SavestateProbe<ChunkType> probe;
 
         probe.NotifyError();
 
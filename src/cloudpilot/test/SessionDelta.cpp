@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+// clang-format off
+#include "SessionDelta.h"
+// clang-format on
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "SessionImage.h"
+
+namespace {
+    class SessionDeltaTest : public ::testing::Test {
+       protected:
+        // Ten and a half pages, so the last page is partial
+        static constexpr uint32 MEMORY_SIZE = 10 * SessionDelta::PAGE_SIZE + 512;
+
+        void SetUp() override {
+            memory.resize(MEMORY_SIZE);
+            for (size_t i = 0; i < memory.size(); i++) memory[i] = i * 7;
+
+            dirtyPages.resize(SessionDelta::DirtyPagesSize(MEMORY_SIZE));
+
+            // TOC with two chunks of two and three words, followed by the chunks
+            savestate = {2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0};
+            for (size_t i = 0; i < 20; i++) savestate.push_back(i);
+
+            SessionImage image;
+            image.SetDeviceId("PalmV")
+                .SetRomImage(rom, sizeof(rom))
+                .SetMemoryImage(memory.data(), memory.size())
+                .SetSavestate(savestate.data(), savestate.size());
+
+            ASSERT_TRUE(image.Serialize());
+
+            base.assign(static_cast<uint8*>(image.GetSerializedImage()),
+                        static_cast<uint8*>(image.GetSerializedImage()) +
+                            image.GetSerializedImageSize());
+        }
+
+        // Writes memory and marks the page dirty, as the RAM banks do
+        void Poke(uint32 offset, uint8 value) {
+            memory[offset] = value;
+            dirtyPages[offset >> 13] |= 1 << ((offset >> 10) & 0x07);
+        }
+
+        vector<uint8> TakeDelta(SessionDelta& delta) {
+            delta.Reset(memory.size(), savestate.size());
+            delta.AddDirtyPages(dirtyPages.data(), memory.data());
+            delta.AddSavestateChanges(savestate.data(), previousSavestate.data());
+
+            EXPECT_TRUE(delta.Serialize());
+
+            previousSavestate = savestate;
+
+            return vector<uint8>(static_cast<uint8*>(delta.GetSerializedDelta()),
+                                 static_cast<uint8*>(delta.GetSerializedDelta()) +
+                                     delta.GetSerializedDeltaSize());
+        }
+
+        void StartChain() {
+            fill(dirtyPages.begin(), dirtyPages.end(), 0);
+            previousSavestate = savestate;
+        }
+
+        bool Compact(vector<vector<uint8>>& deltas) {
+            vector<pair<void*, size_t>> buffers;
+            for (auto& delta : deltas) buffers.push_back({delta.data(), delta.size()});
+
+            if (!SessionDelta::Compact(compacted, base.data(), base.size(), buffers)) return false;
+
+            EXPECT_TRUE(restored.Deserialize(compacted.GetSerializedImage(),
+                                             compacted.GetSerializedImageSize()));
+
+            return true;
+        }
+
+        void ExpectRestored() {
+            ASSERT_EQ(restored.GetMemoryImageSize(), memory.size());
+            ASSERT_EQ(restored.GetSavestateSize(), savestate.size());
+
+            EXPECT_EQ(memcmp(restored.GetMemoryImage(), memory.data(), memory.size()), 0);
+            EXPECT_EQ(memcmp(restored.GetSavestate(), savestate.data(), savestate.size()), 0);
+            EXPECT_STREQ(restored.GetDeviceId(), "PalmV");
+        }
+
+        uint8 rom[64]{0x42};
+        vector<uint8> memory, savestate;
+        vector<uint8> dirtyPages, previousSavestate;
+        vector<uint8> base;
+
+        SessionImage compacted, restored;
+    };
+
+    TEST_F(SessionDeltaTest, onlyChangedPagesAndChunksAreRecorded) {
+        StartChain();
+
+        Poke(5, 0xff);
+        Poke(MEMORY_SIZE - 1, 0xff);
+        savestate[36]++;
+
+        SessionDelta delta;
+        TakeDelta(delta);
+
+        EXPECT_EQ(delta.GetPageCount(), 2u);
+        EXPECT_EQ(delta.GetChunkCount(), 1u);
+    }
+
+    TEST_F(SessionDeltaTest, aDeltaCompactsIntoTheBase) {
+        StartChain();
+
+        Poke(3000, 0xff);
+        Poke(MEMORY_SIZE - 1, 0xff);
+        savestate[20] = 0x55;
+
+        SessionDelta delta;
+        vector<vector<uint8>> deltas{TakeDelta(delta)};
+
+        ASSERT_TRUE(Compact(deltas));
+        ExpectRestored();
+    }
+
+    TEST_F(SessionDeltaTest, aChainOfDeltasIsAppliedInOrder) {
+        StartChain();
+
+        SessionDelta delta;
+        vector<vector<uint8>> deltas;
+
+        for (int i = 0; i < 5; i++) {
+            Poke(100 + i, i);
+            Poke(1024 * (i + 2), 0x80 | i);
+            savestate[20 + 4 * i] = i;
+
+            deltas.push_back(TakeDelta(delta));
+        }
+
+        ASSERT_TRUE(Compact(deltas));
+        ExpectRestored();
+    }
+
+    TEST_F(SessionDeltaTest, anEmptyDeltaLeavesTheImageUnchanged) {
+        StartChain();
+
+        SessionDelta delta;
+        vector<vector<uint8>> deltas{TakeDelta(delta)};
+
+        EXPECT_EQ(delta.GetPageCount(), 0u);
+        EXPECT_EQ(delta.GetChunkCount(), 0u);
+
+        ASSERT_TRUE(Compact(deltas));
+        ExpectRestored();
+    }
+
+    TEST_F(SessionDeltaTest, deltasFromADifferentLayoutAreRejected) {
+        memory.resize(MEMORY_SIZE - 512);
+        StartChain();
+
+        Poke(0, 0x42);
+
+        SessionDelta delta;
+        vector<vector<uint8>> deltas{TakeDelta(delta)};
+
+        EXPECT_FALSE(Compact(deltas));
+    }
+
+    TEST_F(SessionDeltaTest, dirtyPagesAreTakenFromTheBitmapAndCleared) {
+        StartChain();
+
+        // Pages 1, 8 and 10 (the partial last page); the remaining bits of the last bitmap byte
+        // lie beyond the end of memory
+        Poke(SessionDelta::PAGE_SIZE, 0x01);
+        Poke(8 * SessionDelta::PAGE_SIZE + 7, 0x02);
+        Poke(MEMORY_SIZE - 1, 0x03);
+        dirtyPages[1] |= 0xf8;
+
+        SessionDelta delta;
+        vector<vector<uint8>> deltas{TakeDelta(delta)};
+
+        EXPECT_EQ(delta.GetPageCount(), 3u);
+        EXPECT_TRUE(all_of(dirtyPages.begin(), dirtyPages.end(), [](uint8 b) { return b == 0; }));
+
+        ASSERT_TRUE(Compact(deltas));
+        ExpectRestored();
+
+        TakeDelta(delta);
+        EXPECT_EQ(delta.GetPageCount(), 0u);
+    }
+
+    TEST_F(SessionDeltaTest, malformedDeltasAreRejected) {
+        StartChain();
+
+        Poke(0, 0x42);
+
+        SessionDelta delta;
+        vector<uint8> serialized = TakeDelta(delta);
+
+        EXPECT_FALSE(delta.Deserialize(serialized.data(), serialized.size() - 1));
+
+        serialized[0]++;
+        EXPECT_FALSE(delta.Deserialize(serialized.data(), serialized.size()));
+    }
+}  // namespace
@@ -5,6 +5,7 @@
 #include "Cloudpilot.h"
 #include "EmTransportSerialBuffer.h"
 #include "Frame.h"
+#include "FrameDiff.h"
 #include "GunzipContext.h"
 #include "RomInfo.h"
 #include "SessionImage.h"
@@ -0,0 +1,506 @@
+#include "FrameDiff.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define FRAME_DIFF_SIMD_SSE2
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define FRAME_DIFF_SIMD_NEON
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define FRAME_DIFF_SIMD_WASM
+#endif
+
+using namespace std;
+
+namespace {
+    constexpr size_t RLE_MAX_LITERAL = 128;
+    constexpr size_t RLE_MAX_RUN = 129;
+    constexpr uint8_t RLE_RUN = 0x80;
+
+    constexpr size_t PALETTE_MAX_COLORS = 256;
+    constexpr size_t PALETTE_HASH_BITS = 10;
+
+    static_assert(FrameDiffEncoder::TILE_WIDTH == 32, "tile comparison assumes 32 byte tiles");
+
+    size_t unitSize(uint8_t bpp, uint32_t bytesPerLine) {
+        const size_t size = bpp >= 24 ? 4 : (bpp >= 16 ? 2 : 1);
+
+        return bytesPerLine % size == 0 ? size : 1;
+    }
+
+    template <typename T>
+    inline T load(const uint8_t* data) {
+        T value;
+        memcpy(&value, data, sizeof(T));
+
+        return value;
+    }
+
+    inline bool tileDiffers(const uint8_t* a, const uint8_t* b) {
+#if defined(FRAME_DIFF_SIMD_SSE2)
+        const __m128i diff = _mm_or_si128(
+            _mm_xor_si128(_mm_loadu_si128((const __m128i*)a), _mm_loadu_si128((const __m128i*)b)),
+            _mm_xor_si128(_mm_loadu_si128((const __m128i*)(a + 16)),
+                          _mm_loadu_si128((const __m128i*)(b + 16))));
+
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xffff;
+#elif defined(FRAME_DIFF_SIMD_NEON)
+        const uint64x2_t diff = vreinterpretq_u64_u8(vorrq_u8(
+            veorq_u8(vld1q_u8(a), vld1q_u8(b)), veorq_u8(vld1q_u8(a + 16), vld1q_u8(b + 16))));
+
+        return (vgetq_lane_u64(diff, 0) | vgetq_lane_u64(diff, 1)) != 0;
+#elif defined(FRAME_DIFF_SIMD_WASM)
+        return wasm_v128_any_true(
+            wasm_v128_or(wasm_v128_xor(wasm_v128_load(a), wasm_v128_load(b)),
+                         wasm_v128_xor(wasm_v128_load(a + 16), wasm_v128_load(b + 16))));
+#else
+        return memcmp(a, b, 32) != 0;
+#endif
+    }
+
+    template <typename T>
+    void rleEncode(const uint8_t* data, size_t size, vector<uint8_t>& out) {
+        const size_t count = size / sizeof(T);
+        size_t i = 0;
+
+        while (i < count) {
+            const T value = load<T>(data + i * sizeof(T));
+
+            size_t run = 1;
+            while (i + run < count && run < RLE_MAX_RUN &&
+                   load<T>(data + (i + run) * sizeof(T)) == value)
+                run++;
+
+            if (run > 1) {
+                out.push_back(RLE_RUN + run - 2);
+                out.insert(out.end(), data + i * sizeof(T), data + (i + 1) * sizeof(T));
+
+                i += run;
+                continue;
+            }
+
+            // Collect literals up to the start of the next run
+            const size_t start = i++;
+            while (i < count && i - start < RLE_MAX_LITERAL &&
+                   !(i + 1 < count &&
+                     load<T>(data + i * sizeof(T)) == load<T>(data + (i + 1) * sizeof(T))))
+                i++;
+
+            out.push_back(i - start - 1);
+            out.insert(out.end(), data + start * sizeof(T), data + i * sizeof(T));
+        }
+    }
+
+    void rleEncode(const uint8_t* data, size_t size, size_t unit, vector<uint8_t>& out) {
+        switch (unit) {
+            case 4:
+                return rleEncode<uint32_t>(data, size, out);
+
+            case 2:
+                return rleEncode<uint16_t>(data, size, out);
+
+            default:
+                return rleEncode<uint8_t>(data, size, out);
+        }
+    }
+
+    bool rleDecode(const uint8_t* data, size_t size, size_t unit, uint8_t* out, size_t outSize) {
+        const uint8_t* end = data + size;
+        const uint8_t* outEnd = out + outSize;
+
+        while (data < end) {
+            const uint8_t control = *(data++);
+
+            if (control & RLE_RUN) {
+                const size_t run = control - RLE_RUN + 2;
+                if (static_cast<size_t>(end - data) < unit ||
+                    static_cast<size_t>(outEnd - out) < run * unit)
+                    return false;
+
+                for (size_t i = 0; i < run; i++, out += unit) memcpy(out, data, unit);
+                data += unit;
+            } else {
+                const size_t literalSize = (control + 1) * unit;
+                if (static_cast<size_t>(end - data) < literalSize ||
+                    static_cast<size_t>(outEnd - out) < literalSize)
+                    return false;
+
+                memcpy(out, data, literalSize);
+                data += literalSize;
+                out += literalSize;
+            }
+        }
+
+        return out == outEnd;
+    }
+
+    template <typename T>
+    bool buildPalette(const uint8_t* data, size_t size, vector<uint8_t>& colors,
+                      vector<uint8_t>& indices) {
+        constexpr size_t HASH_SIZE = 1 << PALETTE_HASH_BITS;
+
+        T keys[HASH_SIZE];
+        int16_t slots[HASH_SIZE];
+        fill(slots, slots + HASH_SIZE, -1);
+
+        const size_t count = size / sizeof(T);
+        size_t colorCount = 0;
+
+        colors.clear();
+        indices.resize(count);
+
+        T lastValue = 0;
+        int16_t lastSlot = -1;
+
+        for (size_t i = 0; i < count; i++) {
+            const T value = load<T>(data + i * sizeof(T));
+
+            if (lastSlot < 0 || value != lastValue) {
+                size_t hash =
+                    (static_cast<uint32_t>(value) * 2654435761u) >> (32 - PALETTE_HASH_BITS);
+                while (slots[hash] >= 0 && keys[hash] != value) hash = (hash + 1) % HASH_SIZE;
+
+                if (slots[hash] < 0) {
+                    if (colorCount == PALETTE_MAX_COLORS) return false;
+
+                    keys[hash] = value;
+                    slots[hash] = colorCount++;
+                    colors.insert(colors.end(), data + i * sizeof(T), data + (i + 1) * sizeof(T));
+                }
+
+                lastValue = value;
+                lastSlot = slots[hash];
+            }
+
+            indices[i] = lastSlot;
+        }
+
+        return true;
+    }
+
+    class Reader {
+       public:
+        Reader(const void* data, size_t size)
+            : data(static_cast<const uint8_t*>(data)), end(this->data + size) {}
+
+        bool Read8(uint8_t& value) {
+            if (end - data < 1) return false;
+
+            value = *(data++);
+            return true;
+        }
+
+        bool Read16(uint16_t& value) {
+            if (end - data < 2) return false;
+
+            value = data[0] | (data[1] << 8);
+            data += 2;
+
+            return true;
+        }
+
+        bool Read32(uint32_t& value) {
+            if (end - data < 4) return false;
+
+            value = data[0] | (data[1] << 8) | (data[2] << 16) |
+                    (static_cast<uint32_t>(data[3]) << 24);
+            data += 4;
+
+            return true;
+        }
+
+        const uint8_t* Take(size_t size) {
+            if (static_cast<size_t>(end - data) < size) return nullptr;
+
+            const uint8_t* result = data;
+            data += size;
+
+            return result;
+        }
+
+        bool AtEnd() const { return data == end; }
+
+       private:
+        const uint8_t* data;
+        const uint8_t* end;
+    };
+}  // namespace
+
+int FrameDiffEncoder::Encode(const void* frameData, uint32_t bytesPerLine, uint32_t lines,
+                             uint8_t bpp) {
+    const uint8_t* frame = static_cast<const uint8_t*>(frameData);
+
+    packet.clear();
+    rects.clear();
+
+    if (bytesPerLine > 0xffff || lines > 0xffff) return 0;
+
+    const bool keyframe = keyframeRequested || bytesPerLine != this->bytesPerLine ||
+                          lines != this->lines || bpp != this->bpp;
+
+    if (keyframe) {
+        this->bytesPerLine = bytesPerLine;
+        this->lines = lines;
+        this->bpp = bpp;
+
+        previousFrame.resize(bytesPerLine * lines);
+        keyframeRequested = false;
+    } else {
+        FindDirtyRects(frame);
+    }
+
+    if ((keyframe || rects.size() > 0xffff) && bytesPerLine > 0 && lines > 0)
+        rects.assign(1, Rect{0, 0, bytesPerLine, lines});
+
+    Write8(VERSION);
+    Write8(keyframe ? FLAG_KEYFRAME : 0);
+    Write8(bpp);
+    Write8(0);
+    Write16(bytesPerLine);
+    Write16(lines);
+    Write16(rects.size());
+
+    for (auto& rect : rects) EncodeRect(frame, rect);
+
+    return rects.size();
+}
+
+void FrameDiffEncoder::RequestKeyframe() { keyframeRequested = true; }
+
+uint8_t* FrameDiffEncoder::GetData() { return packet.data(); }
+
+size_t FrameDiffEncoder::GetSize() const { return packet.size(); }
+
+void FrameDiffEncoder::FindDirtyRects(const uint8_t* frame) {
+    const uint32_t tiles = (bytesPerLine + TILE_WIDTH - 1) / TILE_WIDTH;
+
+    dirtyTiles.resize(tiles);
+    openRects.clear();
+
+    for (uint32_t y = 0; y < lines; y += TILE_HEIGHT) {
+        const uint32_t height = min(TILE_HEIGHT, lines - y);
+
+        fill(dirtyTiles.begin(), dirtyTiles.end(), 0);
+
+        for (uint32_t line = y; line < y + height; line++) {
+            const uint8_t* current = frame + line * bytesPerLine;
+            const uint8_t* previous = previousFrame.data() + line * bytesPerLine;
+
+            for (uint32_t tile = 0; tile < tiles; tile++) {
+                if (dirtyTiles[tile]) continue;
+
+                const uint32_t x = tile * TILE_WIDTH;
+
+                dirtyTiles[tile] = x + TILE_WIDTH <= bytesPerLine
+                                       ? tileDiffers(current + x, previous + x)
+                                       : memcmp(current + x, previous + x, bytesPerLine - x) != 0;
+            }
+        }
+
+        AddBand(y, height);
+    }
+}
+
+void FrameDiffEncoder::AddBand(uint32_t y, uint32_t height) {
+    const uint32_t tiles = dirtyTiles.size();
+    auto open = openRects.begin();
+
+    nextOpenRects.clear();
+
+    for (uint32_t tile = 0; tile < tiles;) {
+        if (!dirtyTiles[tile]) {
+            tile++;
+            continue;
+        }
+
+        const uint32_t first = tile;
+        while (tile < tiles && dirtyTiles[tile]) tile++;
+
+        const uint32_t x = first * TILE_WIDTH;
+        const uint32_t width = min(tile * TILE_WIDTH, bytesPerLine) - x;
+
+        // Grow the rectangle from the band above if it covers the same columns
+        while (open != openRects.end() && rects[*open].x < x) open++;
+
+        if (open != openRects.end() && rects[*open].x == x && rects[*open].width == width) {
+            rects[*open].height += height;
+            nextOpenRects.push_back(*open);
+        } else {
+            rects.push_back({x, y, width, height});
+            nextOpenRects.push_back(rects.size() - 1);
+        }
+    }
+
+    openRects.swap(nextOpenRects);
+}
+
+void FrameDiffEncoder::EncodeRect(const uint8_t* frame, const Rect& rect) {
+    const size_t size = rect.width * rect.height;
+    const size_t unit = unitSize(bpp, bytesPerLine);
+
+    scratch.resize(size);
+
+    for (uint32_t line = 0; line < rect.height; line++) {
+        const size_t offset = (rect.y + line) * bytesPerLine + rect.x;
+
+        memcpy(scratch.data() + line * rect.width, frame + offset, rect.width);
+        memcpy(previousFrame.data() + offset, frame + offset, rect.width);
+    }
+
+    Encoding encoding = Encoding::raw;
+    const uint8_t* payload = scratch.data();
+    size_t payloadSize = size;
+
+    rleBuffer.clear();
+    rleEncode(scratch.data(), size, unit, rleBuffer);
+
+    if (rleBuffer.size() < payloadSize) {
+        encoding = Encoding::rle;
+        payload = rleBuffer.data();
+        payloadSize = rleBuffer.size();
+    }
+
+    if (unit > 1 && EncodePalette(scratch.data(), size) && paletteBuffer.size() < payloadSize) {
+        encoding = Encoding::palette;
+        payload = paletteBuffer.data();
+        payloadSize = paletteBuffer.size();
+    }
+
+    Write16(rect.x);
+    Write16(rect.y);
+    Write16(rect.width);
+    Write16(rect.height);
+    Write8(static_cast<uint8_t>(encoding));
+    Write32(payloadSize);
+
+    packet.insert(packet.end(), payload, payload + payloadSize);
+}
+
+bool FrameDiffEncoder::EncodePalette(const uint8_t* data, size_t size) {
+    const size_t unit = unitSize(bpp, bytesPerLine);
+
+    const bool success = unit == 4 ? buildPalette<uint32_t>(data, size, colorBuffer, indexBuffer)
+                                   : buildPalette<uint16_t>(data, size, colorBuffer, indexBuffer);
+    if (!success) return false;
+
+    paletteBuffer.assign(1, colorBuffer.size() / unit - 1);
+    paletteBuffer.insert(paletteBuffer.end(), colorBuffer.begin(), colorBuffer.end());
+
+    rleEncode<uint8_t>(indexBuffer.data(), indexBuffer.size(), paletteBuffer);
+
+    return true;
+}
+
+void FrameDiffEncoder::Write8(uint8_t value) { packet.push_back(value); }
+
+void FrameDiffEncoder::Write16(uint16_t value) {
+    packet.push_back(value);
+    packet.push_back(value >> 8);
+}
+
+void FrameDiffEncoder::Write32(uint32_t value) {
+    Write16(value);
+    Write16(value >> 16);
+}
+
+bool FrameDiffDecoder::Decode(const void* data, size_t size) {
+    Reader reader(data, size);
+
+    uint8_t version, flags, bpp, reserved;
+    uint16_t bytesPerLine, lines, rectCount;
+
+    if (!reader.Read8(version) || !reader.Read8(flags) || !reader.Read8(bpp) ||
+        !reader.Read8(reserved) || !reader.Read16(bytesPerLine) || !reader.Read16(lines) ||
+        !reader.Read16(rectCount))
+        return false;
+
+    if (version != FrameDiffEncoder::VERSION) return false;
+
+    if (flags & FrameDiffEncoder::FLAG_KEYFRAME) {
+        this->bytesPerLine = bytesPerLine;
+        this->lines = lines;
+        this->bpp = bpp;
+
+        frame.assign(bytesPerLine * lines, 0);
+    } else if (bytesPerLine != this->bytesPerLine || lines != this->lines || bpp != this->bpp) {
+        return false;
+    }
+
+    const size_t unit = unitSize(bpp, bytesPerLine);
+
+    for (uint16_t i = 0; i < rectCount; i++) {
+        uint16_t x, y, width, height;
+        uint8_t encoding;
+        uint32_t payloadSize;
+
+        if (!reader.Read16(x) || !reader.Read16(y) || !reader.Read16(width) ||
+            !reader.Read16(height) || !reader.Read8(encoding) || !reader.Read32(payloadSize))
+            return false;
+
+        if (x + width > bytesPerLine || y + height > lines || width % unit) return false;
+
+        const uint8_t* payload = reader.Take(payloadSize);
+        if (!payload) return false;
+
+        const size_t rectSize = width * height;
+        scratch.resize(rectSize);
+
+        switch (static_cast<FrameDiffEncoder::Encoding>(encoding)) {
+            case FrameDiffEncoder::Encoding::raw:
+                if (payloadSize != rectSize) return false;
+
+                memcpy(scratch.data(), payload, rectSize);
+                break;
+
+            case FrameDiffEncoder::Encoding::rle:
+                if (!rleDecode(payload, payloadSize, unit, scratch.data(), rectSize)) return false;
+                break;
+
+            case FrameDiffEncoder::Encoding::palette: {
+                if (unit == 1 || payloadSize < 1) return false;
+
+                const size_t colorCount = payload[0] + 1;
+                const size_t colorsSize = colorCount * unit;
+                if (payloadSize < 1 + colorsSize) return false;
+
+                const uint8_t* colors = payload + 1;
+                const size_t pixels = rectSize / unit;
+
+                indexBuffer.resize(pixels);
+                if (!rleDecode(colors + colorsSize, payloadSize - 1 - colorsSize, 1,
+                               indexBuffer.data(), pixels))
+                    return false;
+
+                for (size_t pixel = 0; pixel < pixels; pixel++) {
+                    if (indexBuffer[pixel] >= colorCount) return false;
+
+                    memcpy(scratch.data() + pixel * unit, colors + indexBuffer[pixel] * unit,
+                           unit);
+                }
+
+                break;
+            }
+
+            default:
+                return false;
+        }
+
+        for (uint32_t line = 0; line < height; line++)
+            memcpy(frame.data() + (y + line) * bytesPerLine + x, scratch.data() + line * width,
+                   width);
+    }
+
+    return reader.AtEnd();
+}
+
+const uint8_t* FrameDiffDecoder::GetFrame() const { return frame.data(); }
+
+uint32_t FrameDiffDecoder::GetBytesPerLine() const { return bytesPerLine; }
+
+uint32_t FrameDiffDecoder::GetLines() const { return lines; }
+
+uint8_t FrameDiffDecoder::GetBpp() const { return bpp; }
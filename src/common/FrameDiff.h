@@ -0,0 +1,137 @@
+#ifndef _FRAME_DIFF_H_
+#define _FRAME_DIFF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Delta compression for streaming the display to remote clients. Each packet describes the
+// rectangles that changed since the previously encoded frame. Frames are handled as lines of
+// bytes regardless of their pixel format, so rectangle coordinates are in bytes and lines.
+//
+// Packet layout, all values little endian:
+//
+//   u8  version
+//   u8  flags                      FLAG_KEYFRAME
+//   u8  bpp
+//   u8  reserved
+//   u16 bytesPerLine
+//   u16 lines
+//   u16 rectCount
+//
+// followed by rectCount rectangles:
+//
+//   u16 x, y, width, height
+//   u8  encoding
+//   u32 payloadSize
+//   payload
+//
+// Payload encodings:
+//
+//   raw      the rectangle, line by line
+//   rle      runs of pixel units (4 bytes at 24 and 32 bpp, 2 bytes at 16 bpp, 1 byte otherwise).
+//            A control byte c < 0x80 is followed by c + 1 literal units, c >= 0x80 by a single
+//            unit that repeats c - 0x7e times.
+//   palette  16 bpp and above only: u8 color count - 1, the colors, then the rle encoded indices
+
+class FrameDiffEncoder {
+   public:
+    enum class Encoding : uint8_t { raw = 0, rle = 1, palette = 2 };
+
+    static constexpr uint8_t VERSION = 1;
+    static constexpr uint8_t FLAG_KEYFRAME = 0x01;
+
+    static constexpr size_t HEADER_SIZE = 10;
+    static constexpr size_t RECT_HEADER_SIZE = 13;
+
+    // Granularity of change detection in bytes and lines
+    static constexpr uint32_t TILE_WIDTH = 32;
+    static constexpr uint32_t TILE_HEIGHT = 16;
+
+   public:
+    FrameDiffEncoder() = default;
+
+    // Encodes a frame and returns the number of changed rectangles. The first frame, frames with
+    // a different geometry and frames after RequestKeyframe are sent in full. Frames are limited
+    // to 65535 lines of 65535 bytes; larger frames produce an empty packet.
+    int Encode(const void* frame, uint32_t bytesPerLine, uint32_t lines, uint8_t bpp);
+
+    void RequestKeyframe();
+
+    uint8_t* GetData();
+    size_t GetSize() const;
+
+   private:
+    struct Rect {
+        uint32_t x, y, width, height;
+    };
+
+   private:
+    void FindDirtyRects(const uint8_t* frame);
+    void AddBand(uint32_t y, uint32_t height);
+
+    void EncodeRect(const uint8_t* frame, const Rect& rect);
+    bool EncodePalette(const uint8_t* data, size_t size);
+
+    void Write8(uint8_t value);
+    void Write16(uint16_t value);
+    void Write32(uint32_t value);
+
+   private:
+    uint32_t bytesPerLine{0};
+    uint32_t lines{0};
+    uint8_t bpp{0};
+    bool keyframeRequested{true};
+
+    std::vector<uint8_t> previousFrame;
+    std::vector<uint8_t> dirtyTiles;
+
+    std::vector<Rect> rects;
+    std::vector<size_t> openRects;
+    std::vector<size_t> nextOpenRects;
+
+    std::vector<uint8_t> scratch;
+    std::vector<uint8_t> rleBuffer;
+    std::vector<uint8_t> indexBuffer;
+    std::vector<uint8_t> colorBuffer;
+    std::vector<uint8_t> paletteBuffer;
+
+    std::vector<uint8_t> packet;
+
+   private:
+    FrameDiffEncoder(const FrameDiffEncoder&) = delete;
+    FrameDiffEncoder(FrameDiffEncoder&&) = delete;
+    FrameDiffEncoder& operator=(const FrameDiffEncoder&) = delete;
+    FrameDiffEncoder& operator=(FrameDiffEncoder&&) = delete;
+};
+
+// Reconstructs frames from a sequence of packets.
+class FrameDiffDecoder {
+   public:
+    FrameDiffDecoder() = default;
+
+    // Fails on malformed packets and on deltas that do not match the current geometry.
+    bool Decode(const void* data, size_t size);
+
+    const uint8_t* GetFrame() const;
+    uint32_t GetBytesPerLine() const;
+    uint32_t GetLines() const;
+    uint8_t GetBpp() const;
+
+   private:
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> scratch;
+    std::vector<uint8_t> indexBuffer;
+
+    uint32_t bytesPerLine{0};
+    uint32_t lines{0};
+    uint8_t bpp{0};
+
+   private:
+    FrameDiffDecoder(const FrameDiffDecoder&) = delete;
+    FrameDiffDecoder(FrameDiffDecoder&&) = delete;
+    FrameDiffDecoder& operator=(const FrameDiffDecoder&) = delete;
+    FrameDiffDecoder& operator=(FrameDiffDecoder&&) = delete;
+};
+
+#endif  // _FRAME_DIFF_H_
@@ -0,0 +1,23 @@
+#include "LoggingHook.h"
+
+#include <cstdio>
+
+namespace {
+    logging::Handler commonHandler = nullptr;
+}  // namespace
+
+void logging::setCommonHandler(Handler handler) { commonHandler = handler; }
+
+void logging::commonPrintf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    if (commonHandler) {
+        commonHandler(format, args);
+    } else {
+        vfprintf(stderr, format, args);
+        fprintf(stderr, "\n");
+    }
+
+    va_end(args);
+}
@@ -0,0 +1,16 @@
+#ifndef _LOGGING_HOOK_H_
+#define _LOGGING_HOOK_H_
+
+#include <cstdarg>
+
+// Messages from shared code are passed to a handler installed by the emulator, so they end up in
+// its log. They go to stderr until a handler is installed. Messages do not end with a newline.
+namespace logging {
+    using Handler = void (*)(const char* format, va_list args);
+
+    void setCommonHandler(Handler handler);
+
+    void commonPrintf(const char* format, ...) __attribute__((format(printf, 1, 2)));
+}  // namespace logging
+
+#endif  // _LOGGING_HOOK_H_
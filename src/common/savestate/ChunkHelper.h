@@ -1,10 +1,14 @@
 #ifndef _CHUNK_HELPER_H_
 #define _CHUNK_HELPER_H_
 
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 #include "Chunk.h"
-#include "EmCommon.h"
 
 template <typename T>
 class SaveChunkHelper {
@@ -17,13 +21,13 @@ class SaveChunkHelper {
 
         friend BoolPack operator<<(BoolPack pack, bool value) {
             if (pack.size++ > 0) pack.value <<= 1;
-            pack.value = (pack.value & ~0x01) | static_cast<uint32>(value);
+            pack.value = (pack.value & ~0x01) | static_cast<uint32_t>(value);
 
             return pack;
         }
 
        private:
-        uint32 value{0};
+        uint32_t value{0};
         size_t size{0};
     };
 
@@ -33,7 +37,7 @@ class SaveChunkHelper {
        public:
         Pack8() = default;
 
-        friend Pack8 operator<<(Pack8 pack, uint8 value) {
+        friend Pack8 operator<<(Pack8 pack, uint8_t value) {
             if (pack.size++ > 0) pack.value <<= 8;
             pack.value = (pack.value & ~0xff) | value;
 
@@ -41,7 +45,7 @@ class SaveChunkHelper {
         }
 
        private:
-        uint32 value{0};
+        uint32_t value{0};
         size_t size{0};
     };
 
@@ -51,7 +55,7 @@ class SaveChunkHelper {
        public:
         Pack16() = default;
 
-        friend Pack16 operator<<(Pack16 pack, uint16 value) {
+        friend Pack16 operator<<(Pack16 pack, uint16_t value) {
             if (pack.size++ > 0) pack.value <<= 16;
             pack.value = (pack.value & ~0xffff) | value;
 
@@ -59,20 +63,20 @@ class SaveChunkHelper {
         }
 
        private:
-        uint32 value{0};
+        uint32_t value{0};
         size_t size{0};
     };
 
    public:
     SaveChunkHelper(T& t);
-    inline SaveChunkHelper<T>& Do8(uint8 value);
-    inline SaveChunkHelper<T>& Do16(uint16 value);
-    inline SaveChunkHelper<T>& Do32(uint32 value);
-    inline SaveChunkHelper<T>& Do64(uint64 value);
+    inline SaveChunkHelper<T>& Do8(uint8_t value);
+    inline SaveChunkHelper<T>& Do16(uint16_t value);
+    inline SaveChunkHelper<T>& Do32(uint32_t value);
+    inline SaveChunkHelper<T>& Do64(uint64_t value);
     inline SaveChunkHelper<T>& DoBool(bool value);
     inline SaveChunkHelper<T>& DoDouble(double value);
     inline SaveChunkHelper<T>& DoBuffer(void* buffer, size_t size);
-    inline SaveChunkHelper<T>& DoString(const string& str, size_t maxLength);
+    inline SaveChunkHelper<T>& DoString(const std::string& str, size_t maxLength);
     inline SaveChunkHelper<T>& Do(BoolPack pack);
     inline SaveChunkHelper<T>& Do(Pack8 pack);
     inline SaveChunkHelper<T>& Do(Pack16 pack);
@@ -106,20 +110,20 @@ class LoadChunkHelper {
        public:
         Pack8() { values.reserve(4); }
 
-        friend Pack8 operator<<(Pack8 pack, uint8& ref) {
+        friend Pack8 operator<<(Pack8 pack, uint8_t& ref) {
             pack.values.push_back(&ref);
 
             return pack;
         }
 
-        friend Pack8 operator<<(Pack8 pack, int8& ref) {
-            pack.values.push_back(reinterpret_cast<uint8*>(&ref));
+        friend Pack8 operator<<(Pack8 pack, int8_t& ref) {
+            pack.values.push_back(reinterpret_cast<uint8_t*>(&ref));
 
             return pack;
         }
 
        private:
-        std::vector<uint8*> values;
+        std::vector<uint8_t*> values;
     };
 
     class Pack16 {
@@ -128,38 +132,38 @@ class LoadChunkHelper {
        public:
         Pack16() { values.reserve(2); }
 
-        friend Pack16 operator<<(Pack16 pack, uint16& ref) {
+        friend Pack16 operator<<(Pack16 pack, uint16_t& ref) {
             pack.values.push_back(&ref);
 
             return pack;
         }
 
-        friend Pack16 operator<<(Pack16 pack, int16& ref) {
-            pack.values.push_back(reinterpret_cast<uint16*>(&ref));
+        friend Pack16 operator<<(Pack16 pack, int16_t& ref) {
+            pack.values.push_back(reinterpret_cast<uint16_t*>(&ref));
 
             return pack;
         }
 
        private:
-        std::vector<uint16*> values;
+        std::vector<uint16_t*> values;
     };
 
    public:
     LoadChunkHelper(T& t);
 
-    inline LoadChunkHelper& Do8(uint8& value);
-    inline LoadChunkHelper& Do16(uint16& value);
-    inline LoadChunkHelper& Do32(uint32& value);
-    inline LoadChunkHelper& Do64(uint64& value);
-    inline LoadChunkHelper& Do8(int8& value);
-    inline LoadChunkHelper& Do16(int16& value);
-    inline LoadChunkHelper& Do16(int16& v1, int16& v2);
-    inline LoadChunkHelper& Do32(int32& value);
-    inline LoadChunkHelper& Do64(int64& value);
+    inline LoadChunkHelper& Do8(uint8_t& value);
+    inline LoadChunkHelper& Do16(uint16_t& value);
+    inline LoadChunkHelper& Do32(uint32_t& value);
+    inline LoadChunkHelper& Do64(uint64_t& value);
+    inline LoadChunkHelper& Do8(int8_t& value);
+    inline LoadChunkHelper& Do16(int16_t& value);
+    inline LoadChunkHelper& Do16(int16_t& v1, int16_t& v2);
+    inline LoadChunkHelper& Do32(int32_t& value);
+    inline LoadChunkHelper& Do64(int64_t& value);
     inline LoadChunkHelper& DoBool(bool& value);
     inline LoadChunkHelper& DoDouble(double& value);
     inline LoadChunkHelper& DoBuffer(void* buffer, size_t size);
-    inline LoadChunkHelper<T>& DoString(string& str, size_t maxLength);
+    inline LoadChunkHelper<T>& DoString(std::string& str, size_t maxLength);
     inline LoadChunkHelper<T>& Do(BoolPack pack);
     inline LoadChunkHelper<T>& Do(Pack8 pack);
     inline LoadChunkHelper<T>& Do(Pack16 pack);
@@ -176,28 +180,28 @@ template <typename T>
 SaveChunkHelper<T>::SaveChunkHelper(T& t) : t(t) {}
 
 template <typename T>
-SaveChunkHelper<T>& SaveChunkHelper<T>::Do8(uint8 value) {
+SaveChunkHelper<T>& SaveChunkHelper<T>::Do8(uint8_t value) {
     t.Put8(value);
 
     return *this;
 }
 
 template <typename T>
-SaveChunkHelper<T>& SaveChunkHelper<T>::Do16(uint16 value) {
+SaveChunkHelper<T>& SaveChunkHelper<T>::Do16(uint16_t value) {
     t.Put16(value);
 
     return *this;
 }
 
 template <typename T>
-SaveChunkHelper<T>& SaveChunkHelper<T>::Do32(uint32 value) {
+SaveChunkHelper<T>& SaveChunkHelper<T>::Do32(uint32_t value) {
     t.Put32(value);
 
     return *this;
 }
 
 template <typename T>
-SaveChunkHelper<T>& SaveChunkHelper<T>::Do64(uint64 value) {
+SaveChunkHelper<T>& SaveChunkHelper<T>::Do64(uint64_t value) {
     t.Put64(value);
 
     return *this;
@@ -225,7 +229,7 @@ SaveChunkHelper<T>& SaveChunkHelper<T>::DoBuffer(void* buffer, size_t size) {
 }
 
 template <typename T>
-SaveChunkHelper<T>& SaveChunkHelper<T>::DoString(const string& str, size_t maxLength) {
+SaveChunkHelper<T>& SaveChunkHelper<T>::DoString(const std::string& str, size_t maxLength) {
     t.PutString(str, maxLength);
 
     return *this;
@@ -250,50 +254,50 @@ template <typename T>
 LoadChunkHelper<T>::LoadChunkHelper(T& t) : t(t) {}
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do8(uint8& value) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do8(uint8_t& value) {
     value = t.Get8();
 
     return *this;
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do16(uint16& value) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do16(uint16_t& value) {
     value = t.Get16();
 
     return *this;
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do32(uint32& value) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do32(uint32_t& value) {
     value = t.Get32();
 
     return *this;
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do64(uint64& value) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do64(uint64_t& value) {
     value = t.Get64();
 
     return *this;
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do8(int8& value) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do8(int8_t& value) {
     value = t.Get8();
 
     return *this;
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do16(int16& value) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do16(int16_t& value) {
     value = t.Get16();
 
     return *this;
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do16(int16& v1, int16& v2) {
-    uint32 v = t.Get32();
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do16(int16_t& v1, int16_t& v2) {
+    uint32_t v = t.Get32();
 
     v1 = v & 0xffff;
     v2 = (v >> 16) & 0xffff;
@@ -302,14 +306,14 @@ LoadChunkHelper<T>& LoadChunkHelper<T>::Do16(int16& v1, int16& v2) {
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do32(int32& value) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do32(int32_t& value) {
     value = t.Get32();
 
     return *this;
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::Do64(int64& value) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::Do64(int64_t& value) {
     value = t.Get64();
 
     return *this;
@@ -337,7 +341,7 @@ LoadChunkHelper<T>& LoadChunkHelper<T>::DoBuffer(void* buffer, size_t size) {
 }
 
 template <typename T>
-LoadChunkHelper<T>& LoadChunkHelper<T>::DoString(string& str, size_t maxLength) {
+LoadChunkHelper<T>& LoadChunkHelper<T>::DoString(std::string& str, size_t maxLength) {
     str = std::move(t.GetString(maxLength));
 
     return *this;
@@ -345,7 +349,7 @@ LoadChunkHelper<T>& LoadChunkHelper<T>::DoString(string& str, size_t maxLength)
 
 template <typename T>
 LoadChunkHelper<T>& LoadChunkHelper<T>::Do(typename LoadChunkHelper<T>::Pack8 pack) {
-    uint32 value;
+    uint32_t value;
     Do32(value);
 
     for (ssize_t i = pack.values.size() - 1; i >= 0; i--) {
@@ -358,7 +362,7 @@ LoadChunkHelper<T>& LoadChunkHelper<T>::Do(typename LoadChunkHelper<T>::Pack8 pa
 
 template <typename T>
 LoadChunkHelper<T>& LoadChunkHelper<T>::Do(typename LoadChunkHelper<T>::Pack16 pack) {
-    uint32 value;
+    uint32_t value;
     Do32(value);
 
     for (ssize_t i = pack.values.size() - 1; i >= 0; i--) {
@@ -371,7 +375,7 @@ LoadChunkHelper<T>& LoadChunkHelper<T>::Do(typename LoadChunkHelper<T>::Pack16 p
 
 template <typename T>
 LoadChunkHelper<T>& LoadChunkHelper<T>::Do(typename LoadChunkHelper<T>::BoolPack pack) {
-    uint32 value;
+    uint32_t value;
     Do32(value);
 
     for (ssize_t i = pack.values.size() - 1; i >= 0; i--) {
@@ -1,7 +1,9 @@
 #ifndef _CHUNK_PROBE_H_
 #define _CHUNK_PROBE_H_
 
-#include "EmCommon.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
 
 class ChunkProbe {
    public:
@@ -10,14 +12,14 @@ class ChunkProbe {
    public:
     ChunkProbe() = default;
 
-    void Put8(uint8 value);
-    void Put16(uint16 value);
-    void Put32(uint32 value);
-    void Put64(uint64 value);
+    void Put8(uint8_t value);
+    void Put16(uint16_t value);
+    void Put32(uint32_t value);
+    void Put64(uint64_t value);
     void PutBool(bool value);
     void PutDouble(double value);
     void PutBuffer(void* buffer, size_t size);
-    void PutString(const string& str, size_t maxLength);
+    void PutString(const std::string& str, size_t maxLength);
 
     bool HasError() const;
 
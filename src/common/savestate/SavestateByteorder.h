@@ -0,0 +1,17 @@
+#ifndef _SAVESTATE_BYTEORDER_H_
+#define _SAVESTATE_BYTEORDER_H_
+
+#include <cstdint>
+
+namespace savestate {
+    // Savestates are stored in little endian byte order
+    inline uint32_t SwapIfRequired(uint32_t value) {
+#if (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        return __builtin_bswap32(value);
+#else
+        return value;
+#endif
+    }
+}  // namespace savestate
+
+#endif  // _SAVESTATE_BYTEORDER_H_
@@ -0,0 +1,67 @@
+#ifndef _SAVESTATE_PROBE_H_
+#define _SAVESTATE_PROBE_H_
+
+#include <cstdint>
+#include <map>
+
+#include "ChunkProbe.h"
+#include "LoggingHook.h"
+
+template <typename ChunkType>
+class SavestateProbe {
+   public:
+    using chunkMapT = std::map<ChunkType, ChunkProbe>;
+    using chunkT = ChunkProbe;
+
+   public:
+    SavestateProbe() = default;
+
+    ChunkProbe* GetChunk(ChunkType type);
+
+    const chunkMapT& GetChunkMap() const;
+
+    bool HasError() const;
+
+    void NotifyError();
+
+   private:
+    chunkMapT chunkMap;
+    bool error{false};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename ChunkType>
+ChunkProbe* SavestateProbe<ChunkType>::GetChunk(ChunkType type) {
+    if (chunkMap.find(type) == chunkMap.end())
+        chunkMap.insert(std::pair<ChunkType, ChunkProbe>(type, ChunkProbe()));
+    else {
+        logging::commonPrintf("serialization error: chunk 0x%08x requested twice",
+                              static_cast<uint32_t>(type));
+
+        error = true;
+        return nullptr;
+    }
+
+    return &(chunkMap[type]);
+}
+
+template <typename ChunkType>
+bool SavestateProbe<ChunkType>::HasError() const {
+    return error;
+}
+
+template <typename ChunkType>
+const typename SavestateProbe<ChunkType>::chunkMapT& SavestateProbe<ChunkType>::GetChunkMap()
+    const {
+    return chunkMap;
+}
+
+template <typename ChunkType>
+void SavestateProbe<ChunkType>::NotifyError() {
+    error = true;
+}
+
+#endif  // _SAVESTATE_PROBE_H_
@@ -0,0 +1,148 @@
+#include "FrameDiff.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    class FrameDiffTest : public ::testing::Test {
+       protected:
+        void Configure(uint32_t bytesPerLine, uint32_t lines, uint8_t bpp) {
+            this->bytesPerLine = bytesPerLine;
+            this->lines = lines;
+            this->bpp = bpp;
+
+            frame.assign(bytesPerLine * lines, 0);
+        }
+
+        int EncodeAndCheck() {
+            const int rects = encoder.Encode(frame.data(), bytesPerLine, lines, bpp);
+
+            EXPECT_TRUE(decoder.Decode(encoder.GetData(), encoder.GetSize()));
+            EXPECT_EQ(memcmp(decoder.GetFrame(), frame.data(), frame.size()), 0);
+
+            return rects;
+        }
+
+        void Fill(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint8_t value) {
+            for (uint32_t line = y; line < y + height; line++)
+                memset(frame.data() + line * bytesPerLine + x, value, width);
+        }
+
+        FrameDiffEncoder encoder;
+        FrameDiffDecoder decoder;
+
+        vector<uint8_t> frame;
+        uint32_t bytesPerLine{0};
+        uint32_t lines{0};
+        uint8_t bpp{0};
+
+        mt19937 random{0x320};
+    };
+
+    TEST_F(FrameDiffTest, theFirstFrameIsAKeyframe) {
+        Configure(1280, 320, 32);
+
+        EXPECT_EQ(EncodeAndCheck(), 1);
+        EXPECT_TRUE(encoder.GetData()[1] & FrameDiffEncoder::FLAG_KEYFRAME);
+
+        // A blank screen compresses to almost nothing
+        EXPECT_LT(encoder.GetSize(), 5000u);
+    }
+
+    TEST_F(FrameDiffTest, anUnchangedFrameProducesAnEmptyDelta) {
+        Configure(1280, 320, 32);
+        EncodeAndCheck();
+
+        EXPECT_EQ(EncodeAndCheck(), 0);
+        EXPECT_EQ(encoder.GetSize(), FrameDiffEncoder::HEADER_SIZE);
+    }
+
+    TEST_F(FrameDiffTest, changesAreSentAsTileAlignedRects) {
+        Configure(1280, 320, 32);
+        EncodeAndCheck();
+
+        Fill(100, 50, 8, 40, 0x55);
+        Fill(1000, 300, 4, 1, 0xaa);
+
+        EXPECT_EQ(EncodeAndCheck(), 2);
+        EXPECT_LT(encoder.GetSize(), 400u);
+
+        const uint8_t* rect = encoder.GetData() + FrameDiffEncoder::HEADER_SIZE;
+
+        EXPECT_EQ(rect[0] | (rect[1] << 8), 96);
+        EXPECT_EQ(rect[2] | (rect[3] << 8), 48);
+        EXPECT_EQ(rect[4] | (rect[5] << 8), 32);
+        EXPECT_EQ(rect[6] | (rect[7] << 8), 48);
+    }
+
+    TEST_F(FrameDiffTest, keyframesCanBeRequested) {
+        Configure(160, 160, 8);
+        EncodeAndCheck();
+
+        encoder.RequestKeyframe();
+
+        EXPECT_EQ(EncodeAndCheck(), 1);
+        EXPECT_TRUE(encoder.GetData()[1] & FrameDiffEncoder::FLAG_KEYFRAME);
+    }
+
+    TEST_F(FrameDiffTest, aNewGeometryStartsWithAKeyframe) {
+        Configure(160, 160, 8);
+        EncodeAndCheck();
+
+        Configure(80, 160, 4);
+        EXPECT_EQ(EncodeAndCheck(), 1);
+    }
+
+    TEST_F(FrameDiffTest, fewColorsUseThePalette) {
+        Configure(640, 320, 16);
+
+        for (auto& byte : frame) byte = (random() % 4) * 0x11;
+
+        EncodeAndCheck();
+        EXPECT_EQ(encoder.GetData()[FrameDiffEncoder::HEADER_SIZE + 8],
+                  static_cast<uint8_t>(FrameDiffEncoder::Encoding::palette));
+    }
+
+    TEST_F(FrameDiffTest, randomDeltasRoundTrip) {
+        for (uint8_t bpp : {1, 2, 4, 8, 16, 24}) {
+            SCOPED_TRACE(testing::Message() << "bpp " << static_cast<int>(bpp));
+
+            // An odd line length leaves a partial tile at the end of each line
+            Configure(bpp >= 16 ? 1000 : 100, 97, bpp);
+            for (auto& byte : frame) byte = random();
+
+            EncodeAndCheck();
+
+            for (int i = 0; i < 50; i++) {
+                const uint32_t x = random() % bytesPerLine;
+                const uint32_t y = random() % lines;
+                const uint32_t width = 1 + random() % (bytesPerLine - x);
+                const uint32_t height = 1 + random() % (lines - y);
+
+                Fill(x, y, width, height, random() % 3 ? random() : 0);
+                if (random() % 2) frame[random() % frame.size()] = random();
+
+                EncodeAndCheck();
+                if (HasFailure()) return;
+            }
+        }
+    }
+
+    TEST_F(FrameDiffTest, malformedPacketsAreRejected) {
+        Configure(64, 64, 8);
+        Fill(0, 0, 64, 32, 0x12);
+
+        encoder.Encode(frame.data(), bytesPerLine, lines, bpp);
+        vector<uint8_t> packet(encoder.GetData(), encoder.GetData() + encoder.GetSize());
+
+        EXPECT_FALSE(decoder.Decode(packet.data(), packet.size() - 1));
+
+        packet[0]++;
+        EXPECT_FALSE(decoder.Decode(packet.data(), packet.size()));
+    }
+}  // namespace
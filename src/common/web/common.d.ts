@@ -65,6 +65,14 @@ export interface ZipfileWalker<VoidPtr> {
     GetCurrentEntryContent(): VoidPtr;
 }
 
+export interface FrameDiffEncoder<VoidPtr> {
+    Encode(frame: VoidPtr, bytesPerLine: number, lines: number, bpp: number): number;
+    RequestKeyframe(): void;
+
+    GetData(): VoidPtr;
+    GetSize(): number;
+}
+
 export interface ModuleWithGunzipContext<VoidPtr> {
     GunzipContext: {
         new (data: VoidPtr, size: number, slizeSize: number): GunzipContext<VoidPtr>;
@@ -88,3 +96,9 @@ export interface ModuleWithZipfileWalker<VoidPtr> {
         new (bufferSize: number, buffer: VoidPtr): ZipfileWalker<VoidPtr>;
     };
 }
+
+export interface ModuleWithFrameDiffEncoder<VoidPtr> {
+    FrameDiffEncoder: {
+        new (): FrameDiffEncoder<VoidPtr>;
+    };
+}
@@ -0,0 +1,248 @@
+// Measures the frame diff encoder on a sequence of frames and verifies that every packet decodes
+// to the original frame. The sequence is either recorded with "headless --record-frames" or
+// synthesized.
+//
+// Recordings start with a header followed by the raw frames:
+//
+//   char[4] magic "CPFR"
+//   u32     bytes per line
+//   u32     lines
+//   u32     bpp
+//
+// All values are little endian.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "FrameDiff.h"
+#include "argparse.h"
+
+using namespace std;
+
+namespace {
+    constexpr char MAGIC[] = {'C', 'P', 'F', 'R'};
+
+    constexpr uint32_t SYNTHETIC_WIDTH = 320;
+    constexpr uint32_t SYNTHETIC_HEIGHT = 320;
+
+    struct Recording {
+        uint32_t bytesPerLine{0};
+        uint32_t lines{0};
+        uint8_t bpp{0};
+
+        vector<vector<uint8_t>> frames;
+    };
+
+    uint32_t read32(const uint8_t* data) {
+        return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    }
+
+    bool loadRecording(const string& file, Recording& recording) {
+        ifstream stream(file, ios::binary);
+        uint8_t header[16];
+
+        if (!stream.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+            memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+            cerr << file << " is not a frame recording" << endl;
+            return false;
+        }
+
+        recording.bytesPerLine = read32(header + 4);
+        recording.lines = read32(header + 8);
+        recording.bpp = read32(header + 12);
+
+        const size_t frameSize = recording.bytesPerLine * recording.lines;
+        if (frameSize == 0) {
+            cerr << file << " has no frames" << endl;
+            return false;
+        }
+
+        vector<uint8_t> frame(frameSize);
+        while (stream.read(reinterpret_cast<char*>(frame.data()), frameSize))
+            recording.frames.push_back(frame);
+
+        return true;
+    }
+
+    // A list that scrolls, a pen stroke and idle periods on a screen with few colors
+    void synthesize(uint32_t frameCount, Recording& recording) {
+        constexpr uint32_t colors[] = {0xffffffff, 0xff000000, 0xff808080, 0xffc06020};
+        constexpr uint32_t LIST_TOP = 40;
+        constexpr uint32_t LIST_BOTTOM = 280;
+        constexpr uint32_t ROW_HEIGHT = 12;
+
+        recording.bytesPerLine = SYNTHETIC_WIDTH * 4;
+        recording.lines = SYNTHETIC_HEIGHT;
+        recording.bpp = 32;
+
+        mt19937 random(0x68);
+        vector<uint32_t> frame(SYNTHETIC_WIDTH * SYNTHETIC_HEIGHT, colors[0]);
+
+        auto pixel = [&](uint32_t x, uint32_t y) -> uint32_t& {
+            return frame[y * SYNTHETIC_WIDTH + x];
+        };
+
+        for (uint32_t x = 0; x < SYNTHETIC_WIDTH; x++)
+            for (uint32_t y = 0; y < 16; y++) pixel(x, y) = colors[3];
+
+        int penX = 160, penY = 300;
+
+        for (uint32_t i = 0; i < frameCount; i++) {
+            switch ((i / 60) % 3) {
+                case 0:
+                    // Scroll the list by one pixel and draw a new line of "text" at the bottom
+                    for (uint32_t y = LIST_TOP; y < LIST_BOTTOM - 1; y++)
+                        memcpy(&pixel(0, y), &pixel(0, y + 1), SYNTHETIC_WIDTH * 4);
+
+                    for (uint32_t x = 0; x < SYNTHETIC_WIDTH; x++)
+                        pixel(x, LIST_BOTTOM - 1) =
+                            (i % ROW_HEIGHT) < 8 && x > 8 && x < 200 && random() % 3 == 0
+                                ? colors[1 + random() % 2]
+                                : colors[0];
+
+                    break;
+
+                case 1:
+                    for (int step = 0; step < 4; step++) {
+                        penX = clamp(penX + static_cast<int>(random() % 5) - 2, 0,
+                                     static_cast<int>(SYNTHETIC_WIDTH) - 2);
+                        penY = clamp(penY + static_cast<int>(random() % 5) - 2,
+                                     static_cast<int>(LIST_BOTTOM),
+                                     static_cast<int>(SYNTHETIC_HEIGHT) - 2);
+
+                        pixel(penX, penY) = pixel(penX + 1, penY) = pixel(penX, penY + 1) =
+                            colors[1];
+                    }
+
+                    break;
+
+                default:
+                    break;
+            }
+
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(frame.data());
+            recording.frames.emplace_back(data, data + frame.size() * 4);
+        }
+    }
+
+    bool run(const Recording& recording, unsigned int iterations) {
+        const size_t frameSize = recording.bytesPerLine * recording.lines;
+
+        FrameDiffEncoder encoder;
+        FrameDiffDecoder decoder;
+
+        size_t keyframeSize = 0;
+        size_t maxDeltaSize = 0;
+        uint64_t encodedBytes = 0;
+        uint64_t rects = 0;
+
+        for (size_t i = 0; i < recording.frames.size(); i++) {
+            const vector<uint8_t>& frame = recording.frames[i];
+
+            rects += encoder.Encode(frame.data(), recording.bytesPerLine, recording.lines,
+                                    recording.bpp);
+
+            if (!decoder.Decode(encoder.GetData(), encoder.GetSize()) ||
+                memcmp(decoder.GetFrame(), frame.data(), frameSize) != 0) {
+                cerr << "frame " << i << " does not decode correctly" << endl;
+                return false;
+            }
+
+            if (i == 0)
+                keyframeSize = encoder.GetSize();
+            else
+                maxDeltaSize = max(maxDeltaSize, encoder.GetSize());
+
+            encodedBytes += encoder.GetSize();
+        }
+
+        const auto start = chrono::steady_clock::now();
+
+        for (unsigned int iteration = 0; iteration < iterations; iteration++) {
+            encoder.RequestKeyframe();
+
+            for (auto& frame : recording.frames)
+                encoder.Encode(frame.data(), recording.bytesPerLine, recording.lines,
+                               recording.bpp);
+        }
+
+        const double seconds =
+            chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        const uint64_t framesEncoded = iterations * recording.frames.size();
+        const uint64_t rawBytes = frameSize * recording.frames.size();
+
+        printf("frames:            %zu\n", recording.frames.size());
+        printf("geometry:          %u bytes x %u lines @ %u bpp\n", recording.bytesPerLine,
+               recording.lines, static_cast<unsigned>(recording.bpp));
+        printf("raw bytes:         %llu\n", static_cast<unsigned long long>(rawBytes));
+        printf("encoded bytes:     %llu\n", static_cast<unsigned long long>(encodedBytes));
+        printf("compression:       %.1f : 1\n", static_cast<double>(rawBytes) / encodedBytes);
+        printf("keyframe bytes:    %zu\n", keyframeSize);
+        printf("max delta bytes:   %zu\n", maxDeltaSize);
+        printf("rects / frame:     %.2f\n", static_cast<double>(rects) / recording.frames.size());
+        printf("usec / frame:      %.2f\n", seconds * 1e6 / framesEncoded);
+        printf("throughput:        %.1f MB/sec\n",
+               static_cast<double>(frameSize) * framesEncoded / seconds / 1e6);
+
+        return true;
+    }
+}  // namespace
+
+int main(int argc, const char** argv) {
+    argparse::ArgumentParser program("framediff");
+
+    program.add_description("Benchmark the frame diff encoder on a recorded or synthetic sequence");
+
+    program.add_argument("recording").help("frame recording").default_value(string());
+
+    program.add_argument("--synthetic")
+        .help("frames to synthesize if no recording is given")
+        .metavar("<frames>")
+        .scan<'u', unsigned int>()
+        .default_value(600u);
+
+    program.add_argument("--iterations")
+        .help("number of passes over the sequence")
+        .metavar("<iterations>")
+        .scan<'u', unsigned int>()
+        .default_value(10u);
+
+    try {
+        program.parse_args(argc, argv);
+    } catch (const invalid_argument& e) {
+        cerr << "invalid argument" << endl << endl;
+        cerr << program;
+
+        exit(1);
+    } catch (const runtime_error& e) {
+        cerr << e.what() << endl << endl;
+        cerr << program;
+
+        exit(1);
+    }
+
+    Recording recording;
+    const string file = program.get("recording");
+
+    if (file.empty())
+        synthesize(program.get<unsigned int>("--synthetic"), recording);
+    else if (!loadRecording(file, recording))
+        exit(1);
+
+    if (recording.frames.empty()) {
+        cerr << "no frames" << endl;
+        exit(1);
+    }
+
+    if (!run(recording, program.get<unsigned int>("--iterations"))) exit(1);
+}
@@ -0,0 +1,442 @@
+// Runs the emulator without display, audio or wall clock pacing for a fixed amount of emulated
+// time, optionally replaying an input trace, and reports the speed of the emulation. Runs are
+// deterministic: the same images and trace always execute the same instructions.
+//
+// Input traces are text files with one event per line, lines starting with '#' are ignored:
+//
+//   <msec> pen-down <x> <y>
+//   <msec> pen-up
+//   <msec> key-down <key>
+//   <msec> key-up <key>
+//
+// The timestamp is emulated time since start. Keys are hard1 - hard4, up, down, left, right,
+// select and power.
+//
+// --record-frames writes every completed frame in the format read by bench/framediff.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FileUtil.h"
+#include "SoC.h"
+#include "argparse.h"
+#include "device.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "sdcard.h"
+
+using namespace std;
+
+struct Options {
+    string nor;
+    optional<string> nand;
+    optional<string> sd;
+    optional<string> trace;
+    optional<string> loadState;
+    optional<string> saveState;
+    optional<string> profile;
+    optional<string> recordFrames;
+    optional<unsigned int> seconds;
+    unsigned int mips;
+};
+
+extern "C" int socExtSerialReadChar(void) { return CHAR_NONE; }
+
+extern "C" void socExtSerialWriteChar(int chr) {
+    if (!(chr & 0xFF00)) fputc(chr, stderr);
+}
+
+namespace {
+    constexpr size_t NAND_SIZE = 34603008;
+    constexpr uint64_t SLICE = 1_msec;
+
+    enum class EventType { penDown, penUp, keyDown, keyUp };
+
+    struct Event {
+        uint64_t time;
+        EventType type;
+
+        int x, y;
+        enum KeyId key;
+    };
+
+    const struct {
+        const char* name;
+        enum KeyId key;
+    } keyNames[] = {{"hard1", keyIdHard1}, {"hard2", keyIdHard2}, {"hard3", keyIdHard3},
+                    {"hard4", keyIdHard4}, {"up", keyIdUp},       {"down", keyIdDown},
+                    {"left", keyIdLeft},   {"right", keyIdRight}, {"select", keyIdSelect},
+                    {"power", keyIdPower}};
+
+    const char* taskNames[] = {"timer", "rtc", "lcd", "i2s", "pcm", "aux1", "aux2", "aux3"};
+
+    bool readFile(const optional<string>& name, unique_ptr<uint8_t[]>& buffer, size_t& size) {
+        if (!name) return true;
+
+        if (!util::ReadFile(*name, buffer, size)) {
+            cerr << "unable to read " << *name << endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool parseKey(const string& name, enum KeyId& key) {
+        for (auto& keyName : keyNames) {
+            if (name != keyName.name) continue;
+
+            key = keyName.key;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool parseTrace(const string& file, vector<Event>& events) {
+        ifstream stream(file);
+        if (!stream) {
+            cerr << "unable to read " << file << endl;
+            return false;
+        }
+
+        string line;
+        for (size_t lineNo = 1; getline(stream, line); lineNo++) {
+            if (line.empty() || line[0] == '#') continue;
+
+            istringstream s(line);
+            uint64_t msec;
+            string type;
+            Event event{};
+
+            s >> msec >> type;
+            event.time = msec * 1_msec;
+
+            if (type == "pen-down") {
+                event.type = EventType::penDown;
+                s >> event.x >> event.y;
+            } else if (type == "pen-up") {
+                event.type = EventType::penUp;
+            } else if (type == "key-down" || type == "key-up") {
+                string key;
+                event.type = type == "key-down" ? EventType::keyDown : EventType::keyUp;
+
+                s >> key;
+                if (!s.fail() && !parseKey(key, event.key)) s.setstate(ios::failbit);
+            } else {
+                s.setstate(ios::failbit);
+            }
+
+            const bool outOfOrder = !events.empty() && events.back().time > event.time;
+
+            if (s.fail() || !(s >> ws).eof() || outOfOrder) {
+                cerr << file << ":" << lineNo << ": invalid event" << endl;
+                return false;
+            }
+
+            events.push_back(event);
+        }
+
+        return true;
+    }
+
+    void dispatchEvent(SoC* soc, const Event& event) {
+        switch (event.type) {
+            case EventType::penDown:
+                socPenDown(soc, event.x, event.y);
+                break;
+
+            case EventType::penUp:
+                socPenUp(soc);
+                break;
+
+            case EventType::keyDown:
+                socKeyDown(soc, event.key);
+                break;
+
+            case EventType::keyUp:
+                socKeyUp(soc, event.key);
+                break;
+        }
+    }
+
+    bool writeSavestate(SoC* soc, const string& file) {
+        if (!socSave(soc)) {
+            cerr << "failed to save state" << endl;
+            return false;
+        }
+
+        struct Buffer savestate = socGetSavestate(soc);
+        ofstream stream(file, ios::binary);
+
+        stream.write(static_cast<const char*>(savestate.data), savestate.size);
+        if (!stream) {
+            cerr << "unable to write " << file << endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool writeProfile(const string& file) {
+        FILE* stream = fopen(file.c_str(), "w");
+        if (!stream) {
+            cerr << "unable to write " << file << endl;
+            return false;
+        }
+
+        profilerWriteFlamegraph(stream);
+        fclose(stream);
+
+        printf("\n");
+        profilerPrintReport(stdout, 20);
+
+        return true;
+    }
+
+    FILE* openFrameRecording(const string& file) {
+        FILE* stream = fopen(file.c_str(), "wb");
+        if (!stream) {
+            cerr << "unable to write " << file << endl;
+            return nullptr;
+        }
+
+        DeviceDisplayConfiguration displayConfiguration;
+        deviceGetDisplayConfiguration(&displayConfiguration);
+
+        const uint32_t header[] = {displayConfiguration.width * 4u, displayConfiguration.height,
+                                   32};
+
+        fwrite("CPFR", 4, 1, stream);
+        for (uint32_t value : header) {
+            const uint8_t bytes[] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                                     static_cast<uint8_t>(value >> 16),
+                                     static_cast<uint8_t>(value >> 24)};
+
+            fwrite(bytes, sizeof(bytes), 1, stream);
+        }
+
+        return stream;
+    }
+
+    bool run(const Options& options) {
+        if (options.profile && !profilerEnabled()) {
+            cerr << "profiler not available; rebuild with PROFILE_CPU=1" << endl;
+            return false;
+        }
+
+        if (options.mips == 0) {
+            cerr << "MIPS must be finite" << endl;
+            return false;
+        }
+
+        vector<Event> events;
+        if (options.trace && !parseTrace(*options.trace, events)) return false;
+
+        uint64_t duration;
+        if (options.seconds) {
+            duration = *options.seconds * 1_sec;
+        } else if (!events.empty()) {
+            duration = events.back().time;
+        } else {
+            cerr << "either a trace or the number of seconds to run is required" << endl;
+            return false;
+        }
+
+        size_t norLen{0};
+        unique_ptr<uint8_t[]> norData;
+        if (!readFile(options.nor, norData, norLen)) return false;
+
+        size_t nandLen{0};
+        unique_ptr<uint8_t[]> nandData;
+        if (!readFile(options.nand, nandData, nandLen)) return false;
+
+        if (!nandData) {
+            nandData = make_unique<uint8_t[]>(NAND_SIZE);
+            memset(nandData.get(), 0xff, NAND_SIZE);
+            nandLen = NAND_SIZE;
+        }
+
+        if (nandLen != NAND_SIZE) {
+            cerr << "invalid NAND size; expected " << NAND_SIZE << " bytes" << endl;
+            return false;
+        }
+
+        size_t sdLen{0};
+        unique_ptr<uint8_t[]> sdData;
+        if (!readFile(options.sd, sdData, sdLen)) return false;
+
+        SdCard* sdCard = nullptr;
+
+        if (sdData) {
+            if (sdLen % SD_SECTOR_SIZE) {
+                cout << "sd card image has bad size" << endl;
+                return false;
+            }
+
+            sdCard = sdCardInitializeWithData(sdLen / SD_SECTOR_SIZE, sdData.get());
+        }
+
+        SoC* soc =
+            socInit(norData.get(), norLen, sdCard, nandData.get(), nandLen, 0, deviceGetSocRev());
+
+        if (options.loadState) {
+            size_t savestateLen{0};
+            unique_ptr<uint8_t[]> savestate;
+            if (!readFile(options.loadState, savestate, savestateLen)) return false;
+
+            if (!socLoad(soc, savestateLen, savestate.get())) {
+                cerr << "failed to load state from " << *options.loadState << endl;
+                return false;
+            }
+        }
+
+        FILE* frameRecording = nullptr;
+        if (options.recordFrames && !(frameRecording = openFrameRecording(*options.recordFrames)))
+            return false;
+
+        DeviceDisplayConfiguration displayConfiguration;
+        deviceGetDisplayConfiguration(&displayConfiguration);
+
+        const size_t frameSize = displayConfiguration.width * displayConfiguration.height * 4;
+
+        const uint64_t cyclesPerSecond = options.mips * 1000000ull;
+        const uint64_t cyclesPerSlice = (SLICE * cyclesPerSecond) / 1_sec;
+        const uint64_t cyclesTotal = (duration * cyclesPerSecond) / 1_sec;
+
+        uint64_t cycles = 0;
+        uint64_t frames = 0;
+        auto nextEvent = events.begin();
+
+        const auto start = chrono::steady_clock::now();
+
+        while (cycles < cyclesTotal) {
+            const uint64_t now = (cycles * 1_sec) / cyclesPerSecond;
+            for (; nextEvent != events.end() && nextEvent->time <= now; nextEvent++)
+                dispatchEvent(soc, *nextEvent);
+
+            uint64_t cyclesToRun = min(cyclesPerSlice, cyclesTotal - cycles);
+            if (nextEvent != events.end()) {
+                cyclesToRun = min(cyclesToRun,
+                                  ((nextEvent->time - now) * cyclesPerSecond) / 1_sec + 1);
+            }
+
+            cycles += socRun(soc, cyclesToRun, cyclesPerSecond);
+
+            if (uint32_t* frame = socGetPendingFrame(soc)) {
+                if (frameRecording) fwrite(frame, frameSize, 1, frameRecording);
+
+                frames++;
+                socResetPendingFrame(soc);
+            }
+        }
+
+        const double seconds =
+            chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        if (frameRecording) fclose(frameRecording);
+
+        // Cycles include idle time; ARM instructions take one cycle, 68k instructions ten
+        const uint64_t armInstructions = socGetArmInstructions(soc);
+        const uint64_t paceInstructions = socGetPaceInstructions(soc);
+        const uint64_t instructions = armInstructions + paceInstructions;
+
+        printf("emulated time:     %.3f sec\n", static_cast<double>(duration) / 1_sec);
+        printf("host time:         %.3f sec\n", seconds);
+        printf("cycles:            %llu\n", static_cast<unsigned long long>(cycles));
+        printf("ARM instructions:  %llu\n", static_cast<unsigned long long>(armInstructions));
+        printf("68k instructions:  %llu\n", static_cast<unsigned long long>(paceInstructions));
+        printf("emulated MIPS:     %.2f\n", instructions / seconds / 1e6);
+        printf("host ns / instr:   %.3f\n", seconds * 1e9 / instructions);
+        printf("frames:            %llu\n", static_cast<unsigned long long>(frames));
+        printf("dispatches:        %-12s %s\n", "count", "ticks");
+
+        for (uint32_t task = 0; task < sizeof(taskNames) / sizeof(*taskNames); task++) {
+            printf("  %-16s %-12llu %llu\n", taskNames[task],
+                   static_cast<unsigned long long>(socGetDispatchCount(soc, task)),
+                   static_cast<unsigned long long>(socGetDispatchedTicks(soc, task)));
+        }
+
+        if (options.profile && !writeProfile(*options.profile)) return false;
+
+        if (options.saveState && !writeSavestate(soc, *options.saveState)) return false;
+
+        return true;
+    }
+}  // namespace
+
+int main(int argc, const char** argv) {
+    argparse::ArgumentParser program("headless");
+
+    program.add_description("Run cp-uarm headless and unthrottled and report its speed");
+
+    program.add_argument("nor").help("NOR rom file").required();
+
+    program.add_argument("--nand", "-n").help("NAND rom file").metavar("<nand file>");
+
+    program.add_argument("--sd", "-s").help("SD card file").metavar("<SD card file>");
+
+    program.add_argument("--trace", "-t").help("input trace to replay").metavar("<trace file>");
+
+    program.add_argument("--seconds")
+        .help("emulated seconds to run; defaults to the length of the trace")
+        .metavar("<seconds>")
+        .scan<'u', unsigned int>();
+
+    program.add_argument("--mips")
+        .help("emulated speed in MIPS")
+        .metavar("<mips>")
+        .scan<'u', unsigned int>()
+        .default_value(100u);
+
+    program.add_argument("--load-state")
+        .help("restore a savestate on startup")
+        .metavar("<savestate file>");
+
+    program.add_argument("--save-state")
+        .help("write a savestate after running")
+        .metavar("<savestate file>");
+
+    program.add_argument("--profile")
+        .help("write an execution profile in flamegraph format (requires PROFILE_CPU=1)")
+        .metavar("<profile file>");
+
+    program.add_argument("--record-frames")
+        .help("record all frames for bench/framediff")
+        .metavar("<recording file>");
+
+    try {
+        program.parse_args(argc, argv);
+    } catch (const invalid_argument& e) {
+        cerr << "invalid argument" << endl << endl;
+        cerr << program;
+
+        exit(1);
+    } catch (const runtime_error& e) {
+        cerr << e.what() << endl << endl;
+        cerr << program;
+
+        exit(1);
+    }
+
+    Options options = {.nor = program.get("nor"),
+                       .nand = program.present("--nand"),
+                       .sd = program.present("--sd"),
+                       .trace = program.present("--trace"),
+                       .loadState = program.present("--load-state"),
+                       .saveState = program.present("--save-state"),
+                       .profile = program.present("--profile"),
+                       .recordFrames = program.present("--record-frames"),
+                       .seconds = program.present<unsigned int>("--seconds"),
+                       .mips = program.get<unsigned int>("--mips")};
+
+    if (!run(options)) exit(1);
+}
@@ -0,0 +1,208 @@
+// Replays a TLB trace recorded with RECORD_TLB_TRACE (see uarm/MMU.c) against the two level TLB
+// and against the flat 1M entry layout that it replaced, and reports hit rates and the time
+// spent per translation.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "tlb.h"
+
+using namespace std;
+
+namespace {
+    struct Record {
+        uint32_t va;
+        uint32_t op;
+    };
+
+    struct Stats {
+        uint64_t lookups{0};
+        uint64_t hits{0};
+        uint64_t frontHits{0};
+        uint64_t flushes{0};
+        uint64_t fills{0};
+        double nsecTotal{0};
+    };
+
+    // The flat layout that was used by MMU.c before: one entry per 4k page of the address space
+    class FlatTlb {
+       public:
+        FlatTlb() : tlb(new TlbEntry[1 << 20]) {
+            memset(tlb.get(), 0, sizeof(TlbEntry) * (1 << 20));
+            Flush();
+        }
+
+        void Flush() {
+            if (++revision != 0) return;
+
+            revision = 1;
+            for (size_t i = 0; i < (1 << 20); i++) tlb[i].revision = 0;
+        }
+
+        const TlbEntry* Lookup(uint32_t va) {
+            const TlbEntry* entry = tlb.get() + (va >> 12);
+
+            return entry->revision == revision ? entry : nullptr;
+        }
+
+        void Insert(uint32_t va, uint32_t pa) {
+            TlbEntry* entry = tlb.get() + (va >> 12);
+
+            entry->pa = pa;
+            entry->revision = revision;
+        }
+
+       private:
+        unique_ptr<TlbEntry[]> tlb;
+        uint16_t revision{0};
+    };
+
+    class TwoLevelTlb {
+       public:
+        TwoLevelTlb() { tlbInit(&tlb); }
+        ~TwoLevelTlb() { tlbDeinit(&tlb); }
+
+        void Flush() { tlbFlush(&tlb); }
+
+        const TlbEntry* Lookup(uint32_t va) { return tlbLookup(&tlb, va); }
+
+        void Insert(uint32_t va, uint32_t pa) { tlbInsert(&tlb, va, pa, 0, 0, false, false); }
+
+        bool IsFrontHit(uint32_t va) {
+            const TlbFrontEntry& frontEntry = tlb.front[(va >> 12) & ((1 << TLB_FRONT_BITS) - 1)];
+
+            return frontEntry.entry.revision == tlb.revision && frontEntry.page == va >> 12;
+        }
+
+        uint32_t SectionsAllocated() const { return tlb.sectionsAllocated; }
+
+       private:
+        Tlb tlb;
+    };
+
+    template <typename T>
+    void Replay(T& tlb, const vector<Record>& trace, Stats& stats, bool countFrontHits) {
+        uint32_t checksum = 0;
+        auto start = chrono::steady_clock::now();
+
+        for (const Record& record : trace) {
+            switch (record.op & 0x3ff) {
+                case TLB_TRACE_OP_READ:
+                case TLB_TRACE_OP_WRITE: {
+                    stats.lookups++;
+
+                    if constexpr (is_same_v<T, TwoLevelTlb>) {
+                        if (countFrontHits && tlb.IsFrontHit(record.va)) stats.frontHits++;
+                    }
+
+                    const TlbEntry* entry = tlb.Lookup(record.va);
+                    if (entry) {
+                        stats.hits++;
+                        checksum += entry->pa;
+                    }
+
+                    break;
+                }
+
+                case TLB_TRACE_OP_FLUSH:
+                    stats.flushes++;
+                    tlb.Flush();
+                    break;
+
+                case TLB_TRACE_OP_FILL: {
+                    const uint32_t size = record.op & ~0x3ff;
+                    stats.fills++;
+
+                    for (uint32_t offset = 0; offset < size; offset += 4096)
+                        tlb.Insert(record.va + offset, record.va + offset);
+
+                    break;
+                }
+
+                default:
+                    fprintf(stderr, "invalid trace record %#010x\n", record.op);
+                    exit(1);
+            }
+        }
+
+        stats.nsecTotal =
+            chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+        // keep the compiler from optimizing the lookups away
+        if (checksum == 0x12345678) fprintf(stderr, " ");
+    }
+
+    void PrintStats(const char* name, const Stats& stats, bool withFrontHits) {
+        printf("%s:\n", name);
+        printf("  lookups:        %llu\n", (unsigned long long)stats.lookups);
+        printf("  flushes:        %llu\n", (unsigned long long)stats.flushes);
+        printf("  fills:          %llu\n", (unsigned long long)stats.fills);
+        printf("  hit rate:       %.4f%%\n", 100. * stats.hits / stats.lookups);
+        if (withFrontHits)
+            printf("  front hit rate: %.4f%%\n", 100. * stats.frontHits / stats.lookups);
+        printf("  ns / lookup:    %.3f\n", stats.nsecTotal / stats.lookups);
+    }
+}  // namespace
+
+int main(int argc, const char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <trace>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (!file) {
+        fprintf(stderr, "unable to open %s\n", argv[1]);
+        return 1;
+    }
+
+    vector<Record> trace;
+    Record record;
+    while (fread(&record, sizeof(record), 1, file) == 1) trace.push_back(record);
+    fclose(file);
+
+    if (trace.empty()) {
+        fprintf(stderr, "trace is empty\n");
+        return 1;
+    }
+
+    Stats statsFlat, statsTwoLevel, statsTwoLevelFront;
+
+    {
+        FlatTlb tlb;
+        Replay(tlb, trace, statsFlat, false);
+    }
+
+    {
+        TwoLevelTlb tlb;
+        Replay(tlb, trace, statsTwoLevelFront, true);
+    }
+
+    uint32_t sectionsAllocated;
+    {
+        TwoLevelTlb tlb;
+        Replay(tlb, trace, statsTwoLevel, false);
+        sectionsAllocated = tlb.SectionsAllocated();
+    }
+
+    statsTwoLevel.frontHits = statsTwoLevelFront.frontHits;
+
+    PrintStats("flat", statsFlat, false);
+    printf("  size:           %zu bytes\n\n", sizeof(TlbEntry) << 20);
+
+    PrintStats("two level", statsTwoLevel, true);
+    printf("  size:           %zu bytes\n", sizeof(Tlb) + sectionsAllocated * sizeof(TlbEntry) *
+                                                             (1 << TLB_SECTION_PAGE_BITS));
+
+    if (statsFlat.hits != statsTwoLevel.hits) {
+        fprintf(stderr, "hit count mismatch between layouts\n");
+        return 1;
+    }
+
+    return 0;
+}
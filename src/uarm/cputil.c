@@ -16,6 +16,13 @@ uint64_t timestampUsec() {
     return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
 }
 
+uint64_t timestampNsec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
 void uarmAbort() {
 #ifdef __EMSCRIPTEN__
     __emscripten_abort();
@@ -3,12 +3,16 @@
 #include "Commands.h"
 
 #include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "Cli.h"
+#include "profiler.h"
+#include "sdcard.h"
+#include "syscall_trace.h"
 
 using namespace std;
 
@@ -37,13 +41,231 @@ namespace {
         static_cast<commands::Context*>(context)->audioDriver.Pause();
     }
 
+    void CmdMemStats(vector<string> args, cli::CommandEnvironment& env, void* context) {
+        if (args.size() > 1) return env.PrintUsage();
+
+        SoC* soc = static_cast<commands::Context*>(context)->soc;
+
+        if (args.empty()) {
+            socPrintMemoryStatistics(soc, stdout);
+            return;
+        }
+
+        if (args[0] != "reset") return env.PrintUsage();
+
+        socResetMemoryStatistics(soc);
+    }
+
+    void CmdSyscalls(vector<string> args, cli::CommandEnvironment& env, void* context) {
+        SoC* soc = static_cast<commands::Context*>(context)->soc;
+        size_t maxEntries = 20;
+
+        if (args.size() == 1 && args[0] == "reset") return socResetSyscallStatistics(soc);
+        if (args.size() > 1) return env.PrintUsage();
+
+        if (args.size() == 1) {
+            istringstream s(args[0]);
+            s >> maxEntries;
+
+            if (s.fail() || !s.eof()) return env.PrintUsage();
+        }
+
+        socPrintSyscallStatistics(soc, stdout, maxEntries);
+    }
+
+    bool ParseSortKey(const string& arg, SyscallTraceSortKey& key) {
+        if (arg == "calls")
+            key = SYSCALL_TRACE_SORT_CALLS;
+        else if (arg == "cycles")
+            key = SYSCALL_TRACE_SORT_CYCLES;
+        else if (arg == "max")
+            key = SYSCALL_TRACE_SORT_MAX_CYCLES;
+        else
+            return false;
+
+        return true;
+    }
+
+    bool WriteTrace(const string& filename, SyscallTrace* trace,
+                    void (*writer)(SyscallTrace*, FILE*)) {
+        FILE* file = fopen(filename.c_str(), "w");
+        if (!file) {
+            cout << "unable to open " << filename << endl;
+            return false;
+        }
+
+        writer(trace, file);
+        fclose(file);
+
+        return true;
+    }
+
+    void CmdSyscallTrace(vector<string> args, cli::CommandEnvironment& env, void* context) {
+        SoC* soc = static_cast<commands::Context*>(context)->soc;
+
+        if (args.empty()) {
+            cout << "syscall tracing is " << (socGetSyscallTracing(soc) ? "on" : "off") << endl;
+            return;
+        }
+
+        if (args[0] == "on" && args.size() == 1) return socSetSyscallTracing(soc, true);
+        if (args[0] == "off" && args.size() == 1) return socSetSyscallTracing(soc, false);
+
+        SyscallTrace* trace = socGetSyscallTrace(soc);
+        if (!trace) {
+            cout << "no trace recorded; start with syscall-trace on" << endl;
+            return;
+        }
+
+        if (args[0] == "reset" && args.size() == 1) return syscallTraceReset(trace);
+
+        if (args[0] == "report" && args.size() <= 3) {
+            SyscallTraceSortKey key = SYSCALL_TRACE_SORT_CYCLES;
+            size_t maxEntries = 20;
+
+            if (args.size() >= 2 && !ParseSortKey(args[1], key)) return env.PrintUsage();
+
+            if (args.size() == 3) {
+                istringstream s(args[2]);
+                s >> maxEntries;
+
+                if (s.fail() || !s.eof()) return env.PrintUsage();
+            }
+
+            return syscallTracePrintTable(trace, stdout, key, maxEntries);
+        }
+
+        if (args[0] == "json" && args.size() == 2) {
+            WriteTrace(args[1], trace, syscallTraceWriteJson);
+            return;
+        }
+
+        if (args[0] == "chrome" && args.size() == 2) {
+            WriteTrace(args[1], trace, syscallTraceWriteChromeTrace);
+            return;
+        }
+
+        env.PrintUsage();
+    }
+
+    void CmdFrameStream(vector<string> args, cli::CommandEnvironment& env, void* context) {
+        FrameStream& frameStream = static_cast<commands::Context*>(context)->frameStream;
+
+        if (args.empty()) {
+            if (!frameStream.IsActive()) {
+                cout << "frame stream is off" << endl;
+                return;
+            }
+
+            return frameStream.PrintStatistics();
+        }
+
+        if (args.size() != 1) return env.PrintUsage();
+
+        if (args[0] == "off") {
+            if (frameStream.IsActive()) frameStream.PrintStatistics();
+
+            return frameStream.Stop();
+        }
+
+        if (!frameStream.Start(args[0])) cout << "unable to open " << args[0] << endl;
+    }
+
+    void CmdCommit(vector<string> args, cli::CommandEnvironment& env, void* context) {
+        if (!args.empty()) return env.PrintUsage();
+
+        commands::Context* ctx = static_cast<commands::Context*>(context);
+
+        if (!ctx->nandImage && !ctx->sdImage) {
+            cout << "no mapped images; start with --image-mode" << endl;
+            return;
+        }
+
+        if (ctx->nandImage &&
+            !ctx->nandImage->Commit(
+                static_cast<const uint32_t*>(socGetNandDirtyPages(ctx->soc).data),
+                NAND_STORAGE_PAGE_SIZE))
+            cout << "failed to commit NAND image" << endl;
+
+        if (ctx->sdImage &&
+            !ctx->sdImage->Commit(static_cast<const uint32_t*>(sdCardDirtyPages(ctx->sdCard).data),
+                                  SD_DIRTY_PAGE_SIZE))
+            cout << "failed to commit SD card image" << endl;
+    }
+
+    void CmdProfile(vector<string> args, cli::CommandEnvironment& env, void* context) {
+        if (!profilerEnabled()) {
+            cout << "profiler not available; rebuild with PROFILE_CPU=1" << endl;
+            return;
+        }
+
+        if (args.empty()) return profilerPrintReport(stdout, 20);
+
+        if (args[0] == "reset" && args.size() == 1) return profilerReset();
+
+        if (args[0] == "report" && args.size() <= 2) {
+            size_t maxEntries = 20;
+
+            if (args.size() == 2) {
+                istringstream s(args[1]);
+                s >> maxEntries;
+
+                if (s.fail() || !s.eof()) {
+                    cout << "invalid argument" << endl;
+                    return;
+                }
+            }
+
+            return profilerPrintReport(stdout, maxEntries);
+        }
+
+        if (args[0] == "flamegraph" && args.size() == 2) {
+            FILE* file = fopen(args[1].c_str(), "w");
+            if (!file) {
+                cout << "unable to open " << args[1] << endl;
+                return;
+            }
+
+            profilerWriteFlamegraph(file);
+            fclose(file);
+
+            return;
+        }
+
+        env.PrintUsage();
+    }
+
     const vector<cli::Command> commandList(
         {{.name = "set-mips",
           .usage = "set-mips <mips>",
           .description = "Set target MIPS.",
           .cmd = CmdSetMips},
          {.name = "audio-on", .description = "Enable audio.", .cmd = CmdEnableAudio},
-         {.name = "audio-off", .description = "Disable audio.", .cmd = CmdDisableAudio}});
+         {.name = "audio-off", .description = "Disable audio.", .cmd = CmdDisableAudio},
+         {.name = "mem-stats",
+          .usage = "mem-stats [reset]",
+          .description = "Show or reset physical memory access counters per region.",
+          .cmd = CmdMemStats},
+         {.name = "syscalls",
+          .usage = "syscalls [entries | reset]",
+          .description = "Show or reset syscall counts and the time spent in native replacements.",
+          .cmd = CmdSyscalls},
+         {.name = "syscall-trace",
+          .usage = "syscall-trace [on | off | reset | report [calls | cycles | max] [entries] | "
+                   "json <file> | chrome <file>]",
+          .description = "Trace syscalls and export the statistics or a Chrome trace.",
+          .cmd = CmdSyscallTrace},
+         {.name = "frame-stream",
+          .usage = "frame-stream [<file> | off]",
+          .description = "Record the display as a stream of frame diff packets.",
+          .cmd = CmdFrameStream},
+         {.name = "commit",
+          .description = "Write modified NAND and SD card pages back to mapped images.",
+          .cmd = CmdCommit},
+         {.name = "profile",
+          .usage = "profile [reset | report [entries] | flamegraph <file>]",
+          .description = "Show, reset or export the execution profile (PROFILE_CPU builds).",
+          .cmd = CmdProfile}});
 }  // namespace
 
 void commands::Register() { cli::AddCommands(commandList); }
\ No newline at end of file
@@ -5,15 +5,23 @@
 #include <string>
 #include <vector>
 
+#include "FrameStream.h"
 #include "MainLoop.h"
+#include "MappedImage.h"
 #include "SdlAudioDriver.h"
 #include "SoC.h"
+#include "sdcard.h"
 
 namespace commands {
     struct Context {
         SoC* soc;
         MainLoop& mainLoop;
         SdlAudioDriver& audioDriver;
+        FrameStream& frameStream;
+
+        SdCard* sdCard;
+        MappedImage* nandImage;
+        MappedImage* sdImage;
     };
 
     void Register();
@@ -0,0 +1,107 @@
+#include "EmulationThread.h"
+
+#include <unistd.h>
+
+#include <cstring>
+
+#include "cputil.h"
+#include "device.h"
+
+using namespace std;
+
+namespace {
+    size_t frameSize() {
+        DeviceDisplayConfiguration displayConfiguration;
+        deviceGetDisplayConfiguration(&displayConfiguration);
+
+        return displayConfiguration.width * displayConfiguration.height;
+    }
+}  // namespace
+
+EmulationThread::EmulationThread(SoC* soc, MainLoop& mainLoop, function<bool()> onTimeslice,
+                                 function<void(const uint32_t*)> onFrame)
+    : soc(soc),
+      mainLoop(mainLoop),
+      onTimeslice(onTimeslice),
+      onFrame(onFrame),
+      frames(vector<uint32_t>(frameSize())) {}
+
+EmulationThread::~EmulationThread() { Stop(); }
+
+void EmulationThread::Start() {
+    if (thread.joinable()) return;
+
+    running = true;
+    thread = std::thread([this]() { Run(); });
+}
+
+void EmulationThread::Stop() {
+    running = false;
+
+    if (thread.joinable()) thread.join();
+}
+
+bool EmulationThread::IsRunning() const { return running; }
+
+void EmulationThread::Post(Task task) {
+    lock_guard<mutex> lock(taskMutex);
+
+    pendingTasks.push_back(move(task));
+}
+
+const uint32_t* EmulationThread::AcquireFrame() {
+    return frames.Acquire() ? frames.GetFrontBuffer().data() : nullptr;
+}
+
+uint32_t EmulationThread::GetCurrentIps() const { return currentIps; }
+
+uint32_t EmulationThread::GetCurrentIpsMax() const { return currentIpsMax; }
+
+void EmulationThread::Run() {
+    while (running) {
+        const uint64_t now = timestampUsec();
+
+        RunTasks();
+
+        if (onTimeslice && onTimeslice()) {
+            running = false;
+            break;
+        }
+
+        mainLoop.Cycle(now);
+        PublishFrame();
+
+        currentIps = mainLoop.GetCurrentIps();
+        currentIpsMax = mainLoop.GetCurrentIpsMax();
+
+        const int64_t timesliceRemaining =
+            mainLoop.GetTimesliceSizeUsec() - static_cast<int64_t>(timestampUsec() - now);
+
+        if (timesliceRemaining > 10) usleep(timesliceRemaining);
+    }
+}
+
+void EmulationThread::RunTasks() {
+    {
+        lock_guard<mutex> lock(taskMutex);
+
+        tasks.swap(pendingTasks);
+    }
+
+    for (auto& task : tasks) task(soc);
+
+    tasks.clear();
+}
+
+void EmulationThread::PublishFrame() {
+    const uint32_t* frame = socGetPendingFrame(soc);
+    if (!frame) return;
+
+    if (onFrame) onFrame(frame);
+
+    vector<uint32_t>& backBuffer = frames.GetBackBuffer();
+    memcpy(backBuffer.data(), frame, backBuffer.size() * sizeof(uint32_t));
+
+    frames.Publish();
+    socResetPendingFrame(soc);
+}
@@ -0,0 +1,73 @@
+#ifndef _EMULATION_THREAD_H_
+#define _EMULATION_THREAD_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MainLoop.h"
+#include "SoC.h"
+#include "TripleBuffer.h"
+
+// Runs the main loop on a dedicated thread. Completed frames are handed to the UI thread through
+// a triple buffer, so presenting never holds up emulation. The SoC is owned by the emulation
+// thread; other threads talk to it by posting tasks.
+class EmulationThread {
+   public:
+    using Task = std::function<void(SoC*)>;
+
+    // onTimeslice runs on the emulation thread before each timeslice; returning true stops it.
+    // onFrame sees every completed frame on the emulation thread.
+    EmulationThread(SoC* soc, MainLoop& mainLoop, std::function<bool()> onTimeslice,
+                    std::function<void(const uint32_t*)> onFrame = nullptr);
+    ~EmulationThread();
+
+    void Start();
+    void Stop();
+
+    // False once the thread was stopped or onTimeslice requested termination
+    bool IsRunning() const;
+
+    void Post(Task task);
+
+    // Returns the most recent frame, or nullptr if no frame was completed since the last call
+    const uint32_t* AcquireFrame();
+
+    uint32_t GetCurrentIps() const;
+    uint32_t GetCurrentIpsMax() const;
+
+   private:
+    void Run();
+    void RunTasks();
+    void PublishFrame();
+
+   private:
+    SoC* soc;
+    MainLoop& mainLoop;
+    std::function<bool()> onTimeslice;
+    std::function<void(const uint32_t*)> onFrame;
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    std::mutex taskMutex;
+    std::vector<Task> pendingTasks;
+    std::vector<Task> tasks;
+
+    TripleBuffer<std::vector<uint32_t>> frames;
+
+    std::atomic<uint32_t> currentIps{0};
+    std::atomic<uint32_t> currentIpsMax{0};
+
+   private:
+    EmulationThread();
+    EmulationThread(const EmulationThread&);
+    EmulationThread(EmulationThread&&);
+    EmulationThread& operator=(const EmulationThread&);
+    EmulationThread& operator=(EmulationThread&&);
+};
+
+#endif  // _EMULATION_THREAD_H_
@@ -0,0 +1,64 @@
+#include "FrameStream.h"
+
+#include <iostream>
+
+#include "device.h"
+
+using namespace std;
+
+FrameStream::~FrameStream() { Stop(); }
+
+bool FrameStream::Start(const string& file) {
+    Stop();
+
+    stream = fopen(file.c_str(), "wb");
+    if (!stream) return false;
+
+    frames = rawBytes = encodedBytes = 0;
+    encoder.RequestKeyframe();
+
+    return true;
+}
+
+void FrameStream::Stop() {
+    if (!stream) return;
+
+    fclose(stream);
+    stream = nullptr;
+}
+
+bool FrameStream::IsActive() const { return stream; }
+
+void FrameStream::OnFrame(const uint32_t* frame) {
+    if (!stream) return;
+
+    DeviceDisplayConfiguration displayConfiguration;
+    deviceGetDisplayConfiguration(&displayConfiguration);
+
+    const uint32_t bytesPerLine = displayConfiguration.width * 4;
+
+    encoder.Encode(frame, bytesPerLine, displayConfiguration.height, 32);
+
+    const uint32_t size = encoder.GetSize();
+    const uint8_t sizeBytes[] = {static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8),
+                                 static_cast<uint8_t>(size >> 16),
+                                 static_cast<uint8_t>(size >> 24)};
+
+    if (fwrite(sizeBytes, sizeof(sizeBytes), 1, stream) != 1 ||
+        fwrite(encoder.GetData(), size, 1, stream) != 1) {
+        cerr << "failed to write frame stream" << endl;
+        Stop();
+
+        return;
+    }
+
+    frames++;
+    rawBytes += bytesPerLine * displayConfiguration.height;
+    encodedBytes += sizeof(sizeBytes) + size;
+}
+
+void FrameStream::PrintStatistics() const {
+    cout << frames << " frames, " << rawBytes << " bytes raw, " << encodedBytes << " bytes encoded";
+    if (encodedBytes > 0) cout << " (1:" << rawBytes / encodedBytes << ")";
+    cout << endl;
+}
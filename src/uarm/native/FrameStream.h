@@ -0,0 +1,41 @@
+#ifndef _FRAME_STREAM_H_
+#define _FRAME_STREAM_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "FrameDiff.h"
+
+// Records the display to a file as a sequence of frame diff packets, each preceded by its size as
+// u32 little endian. Frames are fed by the emulation thread.
+class FrameStream {
+   public:
+    FrameStream() = default;
+    ~FrameStream();
+
+    bool Start(const std::string& file);
+    void Stop();
+
+    bool IsActive() const;
+
+    void OnFrame(const uint32_t* frame);
+
+    void PrintStatistics() const;
+
+   private:
+    FILE* stream{nullptr};
+    FrameDiffEncoder encoder;
+
+    uint64_t frames{0};
+    uint64_t rawBytes{0};
+    uint64_t encodedBytes{0};
+
+   private:
+    FrameStream(const FrameStream&) = delete;
+    FrameStream(FrameStream&&) = delete;
+    FrameStream& operator=(const FrameStream&) = delete;
+    FrameStream& operator=(FrameStream&&) = delete;
+};
+
+#endif  // _FRAME_STREAM_H_
@@ -0,0 +1,73 @@
+#include "MappedImage.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+using namespace std;
+
+unique_ptr<MappedImage> MappedImage::Open(const string& file, Mode mode) {
+    int fd = open(file.c_str(), mode == Mode::readOnly ? O_RDONLY : O_RDWR);
+    if (fd < 0) return nullptr;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    const size_t size = fileStat.st_size;
+    void* data = mmap(nullptr, size, mode == Mode::readOnly ? PROT_READ : PROT_READ | PROT_WRITE,
+                      mode == Mode::shared ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+
+    return unique_ptr<MappedImage>(
+        new MappedImage(fd, reinterpret_cast<uint8_t*>(data), size, mode));
+}
+
+MappedImage::MappedImage(int fd, uint8_t* data, size_t size, Mode mode)
+    : fd(fd), data(data), size(size), mode(mode) {}
+
+MappedImage::~MappedImage() {
+    if (mode == Mode::shared) msync(data, size, MS_SYNC);
+
+    munmap(data, size);
+    close(fd);
+}
+
+uint8_t* MappedImage::GetData() const { return data; }
+
+size_t MappedImage::GetSize() const { return size; }
+
+bool MappedImage::Commit(const uint32_t* dirtyPages, size_t pageSize) {
+    switch (mode) {
+        case Mode::readOnly:
+            return false;
+
+        case Mode::shared:
+            return msync(data, size, MS_SYNC) == 0;
+
+        case Mode::privateCopy:
+            break;
+    }
+
+    const size_t pages = (size + pageSize - 1) / pageSize;
+
+    for (size_t page = 0; page < pages; page++) {
+        if ((dirtyPages[page >> 5] & (1u << (page & 0x1f))) == 0) continue;
+
+        const size_t offset = page * pageSize;
+        const size_t len = min(pageSize, size - offset);
+
+        if (pwrite(fd, data + offset, len, offset) != static_cast<ssize_t>(len)) return false;
+    }
+
+    return fsync(fd) == 0;
+}
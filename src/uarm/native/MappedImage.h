@@ -0,0 +1,49 @@
+#ifndef _MAPPED_IMAGE_H_
+#define _MAPPED_IMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// An image file that is mapped into memory instead of being read. Only the pages that the
+// emulator touches are read from disk and become resident.
+class MappedImage {
+   public:
+    enum class Mode {
+        // Writes go to a private copy of the touched pages and reach the file on Commit only
+        privateCopy,
+        // Writes go straight to the file
+        shared,
+        // The image is never written
+        readOnly
+    };
+
+   public:
+    static std::unique_ptr<MappedImage> Open(const std::string& file, Mode mode);
+
+    ~MappedImage();
+
+    uint8_t* GetData() const;
+    size_t GetSize() const;
+
+    // Writes the blocks flagged in dirtyPages (one bit per pageSize bytes) back to the file. Shared
+    // images are synced instead.
+    bool Commit(const uint32_t* dirtyPages, size_t pageSize);
+
+   private:
+    MappedImage(int fd, uint8_t* data, size_t size, Mode mode);
+
+    MappedImage(const MappedImage&) = delete;
+    MappedImage(MappedImage&&) = delete;
+    MappedImage& operator=(const MappedImage&) = delete;
+    MappedImage& operator=(MappedImage&&) = delete;
+
+   private:
+    int fd;
+    uint8_t* data;
+    size_t size;
+    Mode mode;
+};
+
+#endif  // _MAPPED_IMAGE_H_
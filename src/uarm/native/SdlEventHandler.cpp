@@ -43,7 +43,8 @@ namespace {
     }
 }  // namespace
 
-SdlEventHandler::SdlEventHandler(struct SoC* soc, int scale) : soc(soc), scale(scale) {}
+SdlEventHandler::SdlEventHandler(EmulationThread& emulationThread, int scale)
+    : emulationThread(emulationThread), scale(scale) {}
 
 void SdlEventHandler::HandleEvents() {
     SDL_Event event;
@@ -51,38 +52,38 @@ void SdlEventHandler::HandleEvents() {
     while (SDL_PollEvent(&event)) {
         switch (event.type) {
             case SDL_QUIT:
-                exit(0);
+                quitRequested = true;
                 break;
 
             case SDL_MOUSEBUTTONDOWN:
                 if (event.button.button != SDL_BUTTON_LEFT) break;
                 penDown = true;
-                socPenDown(soc, event.button.x / scale, event.button.y / scale);
+                PenDown(event.button.x / scale, event.button.y / scale);
 
                 break;
 
             case SDL_MOUSEBUTTONUP:
                 if (event.button.button != SDL_BUTTON_LEFT) break;
                 penDown = false;
-                socPenUp(soc);
+                emulationThread.Post([](SoC* soc) { socPenUp(soc); });
 
                 break;
 
             case SDL_MOUSEMOTION:
                 if (!penDown) break;
-                socPenDown(soc, event.motion.x / scale, event.motion.y / scale);
+                PenDown(event.motion.x / scale, event.motion.y / scale);
 
                 break;
 
             case SDL_KEYDOWN: {
                 enum KeyId key = mapKey(event.key.keysym.sym);
-                if (key) socKeyDown(soc, key);
+                if (key) emulationThread.Post([=](SoC* soc) { socKeyDown(soc, key); });
                 break;
             }
 
             case SDL_KEYUP: {
                 enum KeyId key = mapKey(event.key.keysym.sym);
-                if (key) socKeyUp(soc, key);
+                if (key) emulationThread.Post([=](SoC* soc) { socKeyUp(soc, key); });
                 break;
             }
 
@@ -96,3 +97,9 @@ void SdlEventHandler::HandleEvents() {
 bool SdlEventHandler::RedrawRequested() const { return redrawRequested; }
 
 void SdlEventHandler::ClearRedrawRequested() { redrawRequested = false; }
+
+bool SdlEventHandler::QuitRequested() const { return quitRequested; }
+
+void SdlEventHandler::PenDown(int x, int y) {
+    emulationThread.Post([=](SoC* soc) { socPenDown(soc, x, y); });
+}
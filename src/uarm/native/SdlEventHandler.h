@@ -1,23 +1,29 @@
 #ifndef _SDL_EVENT_HANDLER_
 #define _SDL_EVENT_HANDLER_
 
-#include "SoC.h"
+#include "EmulationThread.h"
 
 class SdlEventHandler {
    public:
-    SdlEventHandler(struct SoC* soc, int scale);
+    SdlEventHandler(EmulationThread& emulationThread, int scale);
 
     void HandleEvents();
 
     bool RedrawRequested() const;
     void ClearRedrawRequested();
 
+    bool QuitRequested() const;
+
+   private:
+    void PenDown(int x, int y);
+
    private:
-    struct SoC* soc;
+    EmulationThread& emulationThread;
 
     bool penDown{false};
     int scale{1};
     bool redrawRequested{false};
+    bool quitRequested{false};
 
    private:
     SdlEventHandler();
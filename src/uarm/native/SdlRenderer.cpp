@@ -1,5 +1,7 @@
 #include "SdlRenderer.h"
 
+#include <cstring>
+
 #include "SDL_image.h"
 #include "Silkscreen.h"
 
@@ -17,8 +19,8 @@ namespace {
     }
 }  // namespace
 
-SdlRenderer::SdlRenderer(SDL_Window* window, SDL_Renderer* renderer, SoC* soc, int scale)
-    : window(window), renderer(renderer), soc(soc), scale(scale) {
+SdlRenderer::SdlRenderer(SDL_Window* window, SDL_Renderer* renderer, int scale)
+    : window(window), renderer(renderer), scale(scale) {
     deviceGetDisplayConfiguration(&displayConfiguration);
 
     frameTexture =
@@ -33,8 +35,7 @@ SdlRenderer::SdlRenderer(SDL_Window* window, SDL_Renderer* renderer, SoC* soc, i
     SDL_RenderPresent(renderer);
 }
 
-void SdlRenderer::Draw(bool forceRedraw) {
-    uint32_t* frame = socGetPendingFrame(soc);
+void SdlRenderer::Draw(const uint32_t* frame, bool forceRedraw) {
     if (!frame && !forceRedraw) return;
 
     if (frame) {
@@ -69,8 +70,6 @@ void SdlRenderer::Draw(bool forceRedraw) {
     }
 
     SDL_RenderPresent(renderer);
-
-    socResetPendingFrame(soc);
 }
 
 void SdlRenderer::DrawSilkscreen() {
@@ -3,14 +3,14 @@
 
 #include <SDL.h>
 
-#include "SoC.h"
 #include "device.h"
 
 class SdlRenderer {
    public:
-    SdlRenderer(SDL_Window* window, SDL_Renderer* renderer, SoC* soc, int scale);
+    SdlRenderer(SDL_Window* window, SDL_Renderer* renderer, int scale);
 
-    void Draw(bool forceRedraw);
+    // frame is nullptr if there is no new frame
+    void Draw(const uint32_t* frame, bool forceRedraw);
 
    private:
     void DrawSilkscreen();
@@ -24,8 +24,6 @@ class SdlRenderer {
 
     bool frameTextureValid{false};
 
-    SoC* soc{nullptr};
-
     const int scale;
     DeviceDisplayConfiguration displayConfiguration;
 
@@ -0,0 +1,51 @@
+#ifndef _TRIPLE_BUFFER_H_
+#define _TRIPLE_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free handoff between a single producer and a single consumer. The producer always owns a
+// buffer to write to, the consumer always owns the most recently published one, and the third
+// buffer is swapped between both sides atomically. Neither side ever waits; frames that are
+// published faster than they are consumed are dropped.
+template <typename T>
+class TripleBuffer {
+   public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) : buffers{initial, initial, initial} {}
+
+    T& GetBackBuffer() { return buffers[backIndex]; }
+
+    void Publish() {
+        backIndex = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Returns true and moves the front buffer forward if a buffer was published since the last call
+    bool Acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX_MASK;
+
+        return true;
+    }
+
+    const T& GetFrontBuffer() const { return buffers[frontIndex]; }
+
+   private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+    static constexpr uint8_t FRESH = 0x04;
+
+    T buffers[3];
+
+    uint8_t backIndex{0};
+    std::atomic<uint8_t> middle{1};
+    uint8_t frontIndex{2};
+
+   private:
+    TripleBuffer(const TripleBuffer&);
+    TripleBuffer(TripleBuffer&&);
+    TripleBuffer& operator=(const TripleBuffer&);
+    TripleBuffer& operator=(TripleBuffer&&);
+};
+
+#endif  // _TRIPLE_BUFFER_H_
@@ -11,8 +11,11 @@
 
 #include "Cli.h"
 #include "Commands.h"
+#include "EmulationThread.h"
 #include "FileUtil.h"
+#include "FrameStream.h"
 #include "MainLoop.h"
+#include "MappedImage.h"
 #include "SdlAudioDriver.h"
 #include "SdlEventHandler.h"
 #include "SdlRenderer.h"
@@ -29,6 +32,7 @@ struct Options {
     string nor;
     optional<string> nand;
     optional<string> sd;
+    optional<MappedImage::Mode> imageMode;
     optional<unsigned int> gdbPort;
     unsigned int mips;
     bool disableAudio;
@@ -49,6 +53,7 @@ extern "C" void socExtSerialWriteChar(int chr) {
 namespace {
     constexpr size_t AUDIO_QUEUE_SIZE = 44100 / MAIN_LOOP_FPS * 10;
     constexpr int SCALE = 2;
+    constexpr int64_t FRAME_INTERVAL_USEC = 1000000 / MAIN_LOOP_FPS;
     constexpr size_t NAND_SIZE = 34603008;
 
     bool readFile(const optional<string>& name, unique_ptr<uint8_t[]>& buffer, size_t& size) {
@@ -62,6 +67,37 @@ namespace {
         return true;
     }
 
+    // An image that was either read into a heap buffer or mapped from its file
+    struct Image {
+        unique_ptr<uint8_t[]> buffer;
+        unique_ptr<MappedImage> mapping;
+
+        uint8_t* data{nullptr};
+        size_t size{0};
+    };
+
+    bool loadImage(const optional<string>& name, optional<MappedImage::Mode> mode, Image& image) {
+        if (!name) return true;
+
+        if (!mode) {
+            if (!readFile(name, image.buffer, image.size)) return false;
+
+            image.data = image.buffer.get();
+            return true;
+        }
+
+        image.mapping = MappedImage::Open(*name, *mode);
+        if (!image.mapping) {
+            cerr << "unable to map " << *name << endl;
+            return false;
+        }
+
+        image.data = image.mapping->GetData();
+        image.size = image.mapping->GetSize();
+
+        return true;
+    }
+
     bool initSdl(struct DeviceDisplayConfiguration displayConfiguration, int scale,
                  SDL_Window*& window, SDL_Renderer*& renderer) {
         if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_AUDIO) < 0) {
@@ -92,40 +128,44 @@ namespace {
             return false;
         }
 
-        size_t norLen{0};
-        unique_ptr<uint8_t[]> norData;
-        if (!readFile(options.nor, norData, norLen)) return false;
+        // NOR is never written, so it can always be mapped read-only
+        Image nor;
+        if (!loadImage(options.nor,
+                       options.imageMode ? optional(MappedImage::Mode::readOnly) : nullopt, nor))
+            return false;
+
+        Image nand;
+        if (!loadImage(options.nand, options.imageMode, nand)) return false;
 
-        size_t nandLen{0};
-        unique_ptr<uint8_t[]> nandData;
-        if (!readFile(options.nand, nandData, nandLen)) return false;
+        if (!nand.data) {
+            nand.buffer = make_unique<uint8_t[]>(NAND_SIZE);
+            memset(nand.buffer.get(), 0xff, NAND_SIZE);
 
-        if (!nandData) {
-            nandData = make_unique<uint8_t[]>(NAND_SIZE);
-            memset(nandData.get(), 0xff, NAND_SIZE);
-            nandLen = NAND_SIZE;
+            nand.data = nand.buffer.get();
+            nand.size = NAND_SIZE;
         }
 
-        if (nandLen != NAND_SIZE) {
+        if (nand.size != NAND_SIZE) {
             cerr << "invalid NAND size; expected " << NAND_SIZE << " bytes" << endl;
             return false;
         }
 
-        size_t sdLen{0};
-        unique_ptr<uint8_t[]> sdData;
-        if (!readFile(options.sd, sdData, sdLen)) return false;
+        Image sd;
+        if (!loadImage(options.sd, options.imageMode, sd)) return false;
 
-        if (sdData) {
-            if (sdLen % SD_SECTOR_SIZE) {
+        SdCard* sdCard = nullptr;
+
+        if (sd.data) {
+            if (sd.size % SD_SECTOR_SIZE) {
                 cout << "sd card image has bad size" << endl;
                 return false;
             }
 
-            sdCardInitializeWithData(sdLen / SD_SECTOR_SIZE, sdData.get());
+            sdCard = sdCardInitializeWithData(sd.size / SD_SECTOR_SIZE, sd.data);
         }
 
-        SoC* soc = socInit(norData.get(), norLen, sdCardSectorCount(), sdCardRead, sdCardWrite,
-                           nandData.get(), nandLen, options.gdbPort.value_or(0), deviceGetSocRev());
+        SoC* soc = socInit(nor.data, nor.size, sdCard, nand.data, nand.size,
+                           options.gdbPort.value_or(0), deviceGetSocRev());
 
         AudioQueue* audioQueue = audioQueueCreate(AUDIO_QUEUE_SIZE);
         socSetAudioQueue(soc, audioQueue);
@@ -142,54 +182,72 @@ namespace {
 
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0xff);
         SDL_RenderClear(renderer);
-        SdlRenderer sdlRenderer(window, renderer, soc, SCALE);
-        SdlEventHandler sdlEventHandler(soc, SCALE);
+        SdlRenderer sdlRenderer(window, renderer, SCALE);
 
         SdlAudioDriver audioDriver(soc, audioQueue);
         if (!options.disableAudio) audioDriver.Start();
 
+        FrameStream frameStream;
+
         commands::Register();
         cli::Start(options.script);
-        commands::Context commandContext{
-            .soc = soc, .mainLoop = mainLoop, .audioDriver = audioDriver};
+        commands::Context commandContext{.soc = soc,
+                                         .mainLoop = mainLoop,
+                                         .audioDriver = audioDriver,
+                                         .frameStream = frameStream,
+                                         .sdCard = sdCard,
+                                         .nandImage = nand.mapping.get(),
+                                         .sdImage = sd.mapping.get()};
 
-        uint64_t lastSpeedDump = timestampUsec();
+        // Commands access the SoC, so they are executed on the emulation thread
+        EmulationThread emulationThread(
+            soc, mainLoop,
+            [&]() {
+                if (!options.disableAudio)
+                    socSetPcmSuspended(soc, audioDriver.GetAudioBackpressure());
 
-        while (true) {
-            uint64_t now = timestampUsec();
+                return cli::Execute(&commandContext);
+            },
+            [&](const uint32_t* frame) { frameStream.OnFrame(frame); });
 
-            if (!options.disableAudio) socSetPcmSuspended(soc, audioDriver.GetAudioBackpressure());
+        SdlEventHandler sdlEventHandler(emulationThread, SCALE);
 
-            mainLoop.Cycle(now);
+        emulationThread.Start();
 
-            sdlRenderer.Draw(sdlEventHandler.RedrawRequested());
-            sdlEventHandler.ClearRedrawRequested();
+        uint64_t lastSpeedDump = timestampUsec();
+
+        while (emulationThread.IsRunning()) {
+            uint64_t now = timestampUsec();
 
             sdlEventHandler.HandleEvents();
+            if (sdlEventHandler.QuitRequested()) break;
+
+            sdlRenderer.Draw(emulationThread.AcquireFrame(), sdlEventHandler.RedrawRequested());
+            sdlEventHandler.ClearRedrawRequested();
 
             if (now - lastSpeedDump > 1000000) {
-                const uint64_t currentIps = mainLoop.GetCurrentIps();
-                const uint64_t currentIpsMax = mainLoop.GetCurrentIpsMax();
+                const uint64_t currentIps = emulationThread.GetCurrentIps();
+                const uint64_t currentIpsMax = emulationThread.GetCurrentIpsMax();
                 lastSpeedDump = now;
 
                 ostringstream s;
                 s << "cp-uarm @ " << fixed << setprecision(2)
                   << static_cast<float>(currentIps) / 1000000 << " MIPS, limit "
                   << static_cast<float>(currentIpsMax) / 1000000 << " IPS -> "
-                  << (100 * currentIps) / currentIpsMax << "%" << endl
+                  << (currentIpsMax > 0 ? (100 * currentIps) / currentIpsMax : 0) << "%" << endl
                   << flush;
 
                 SDL_SetWindowTitle(window, s.str().c_str());
             }
 
-            const int64_t timesliceRemaining =
-                mainLoop.GetTimesliceSizeUsec() - static_cast<int64_t>(timestampUsec() - now);
+            const int64_t frameRemaining =
+                FRAME_INTERVAL_USEC - static_cast<int64_t>(timestampUsec() - now);
 
-            if (cli::Execute(&commandContext)) break;
-
-            if (timesliceRemaining > 10) usleep(timesliceRemaining);
+            if (frameRemaining > 10) usleep(frameRemaining);
         }
 
+        emulationThread.Stop();
+
         audioDriver.Pause();
         cli::Stop();
 
@@ -209,6 +267,12 @@ int main(int argc, const char** argv) {
 
     program.add_argument("--sd", "-s").help("SD card file").metavar("<SD card file>");
 
+    program.add_argument("--image-mode")
+        .help(
+            "map NOR, NAND and SD images instead of reading them; writes to NAND and SD either "
+            "stay private until committed or go straight to the image files")
+        .metavar("<private|shared>");
+
     program.add_argument("--no-sound", "-q")
         .help("start with audio off")
         .default_value(false)
@@ -241,9 +305,24 @@ int main(int argc, const char** argv) {
         exit(1);
     }
 
+    optional<MappedImage::Mode> imageMode;
+    if (auto mode = program.present("--image-mode")) {
+        if (*mode == "private")
+            imageMode = MappedImage::Mode::privateCopy;
+        else if (*mode == "shared")
+            imageMode = MappedImage::Mode::shared;
+        else {
+            cerr << "invalid image mode " << *mode << endl << endl;
+            cerr << program;
+
+            exit(1);
+        }
+    }
+
     Options options = {.nor = program.get("nor"),
                        .nand = program.present("--nand"),
                        .sd = program.present("--sd"),
+                       .imageMode = imageMode,
                        .gdbPort = program.present<unsigned int>("--gdb"),
                        .mips = program.get<unsigned int>("--mips"),
                        .disableAudio = program.get<bool>("--no-sound"),
@@ -0,0 +1,173 @@
+#include "../uarm/audio_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    struct AudioQueueDeleter {
+        void operator()(AudioQueue* queue) { audioQueueDestroy(queue); }
+    };
+
+    unique_ptr<AudioQueue, AudioQueueDeleter> createQueue(size_t capacity) {
+        return unique_ptr<AudioQueue, AudioQueueDeleter>(audioQueueCreate(capacity));
+    }
+}  // namespace
+
+TEST(AudioQueue, QueueStartsEmpty) {
+    auto queuePtr = createQueue(4);
+    AudioQueue* queue = queuePtr.get();
+    uint32_t sample;
+
+    EXPECT_EQ(audioQueuePendingSamples(queue), static_cast<size_t>(0));
+    EXPECT_EQ(audioQueuePopChunk(queue, &sample, 1), static_cast<size_t>(0));
+}
+
+TEST(AudioQueue, QueueIsFifoAcrossTheWrap) {
+    auto queuePtr = createQueue(4);
+    AudioQueue* queue = queuePtr.get();
+    const uint32_t samples[] = {1, 2, 3, 4, 5, 6};
+    uint32_t popped[4];
+
+    EXPECT_EQ(audioQueuePushChunk(queue, samples, 3), static_cast<size_t>(3));
+    EXPECT_EQ(audioQueuePopChunk(queue, popped, 2), static_cast<size_t>(2));
+    EXPECT_EQ(popped[0], 1u);
+    EXPECT_EQ(popped[1], 2u);
+
+    EXPECT_EQ(audioQueuePushChunk(queue, samples + 3, 3), static_cast<size_t>(3));
+    EXPECT_EQ(audioQueuePendingSamples(queue), static_cast<size_t>(4));
+
+    EXPECT_EQ(audioQueuePopChunk(queue, popped, 4), static_cast<size_t>(4));
+    EXPECT_EQ(popped[0], 3u);
+    EXPECT_EQ(popped[1], 4u);
+    EXPECT_EQ(popped[2], 5u);
+    EXPECT_EQ(popped[3], 6u);
+}
+
+TEST(AudioQueue, OverrunDropsNewSamples) {
+    auto queuePtr = createQueue(4);
+    AudioQueue* queue = queuePtr.get();
+    const uint32_t samples[] = {1, 2, 3, 4, 5, 6};
+    uint32_t popped[4];
+
+    EXPECT_EQ(audioQueuePushChunk(queue, samples, 5), static_cast<size_t>(4));
+    audioQueuePush(queue, 6);
+
+    EXPECT_EQ(audioQueueOverrunSamples(queue), static_cast<uint64_t>(2));
+    EXPECT_EQ(audioQueuePopChunk(queue, popped, 4), static_cast<size_t>(4));
+    EXPECT_EQ(popped[0], 1u);
+    EXPECT_EQ(popped[3], 4u);
+}
+
+TEST(AudioQueue, UnderrunIsCounted) {
+    auto queuePtr = createQueue(4);
+    AudioQueue* queue = queuePtr.get();
+    uint32_t popped[4];
+
+    audioQueuePush(queue, 1);
+
+    EXPECT_EQ(audioQueuePopChunk(queue, popped, 4), static_cast<size_t>(1));
+    EXPECT_EQ(audioQueueUnderrunSamples(queue), static_cast<uint64_t>(3));
+}
+
+TEST(AudioQueue, ClearDiscardsPendingSamples) {
+    auto queuePtr = createQueue(4);
+    AudioQueue* queue = queuePtr.get();
+    const uint32_t samples[] = {1, 2, 3, 4};
+    uint32_t popped[4];
+
+    audioQueuePushChunk(queue, samples, 4);
+    audioQueueClear(queue);
+
+    EXPECT_EQ(audioQueuePushChunk(queue, samples, 2), static_cast<size_t>(0));
+    EXPECT_EQ(audioQueuePendingSamples(queue), static_cast<size_t>(0));
+
+    EXPECT_EQ(audioQueuePushChunk(queue, samples, 2), static_cast<size_t>(2));
+    EXPECT_EQ(audioQueuePendingSamples(queue), static_cast<size_t>(2));
+    EXPECT_EQ(audioQueuePopChunk(queue, popped, 4), static_cast<size_t>(2));
+    EXPECT_EQ(popped[0], 1u);
+    EXPECT_EQ(popped[1], 2u);
+}
+
+TEST(AudioQueue, ConcurrentProducerAndConsumerSeeAllSamplesInOrder) {
+    constexpr uint32_t SAMPLE_COUNT = 100000;
+    auto queuePtr = createQueue(256);
+    AudioQueue* queue = queuePtr.get();
+
+    thread producer([&]() {
+        uint32_t chunk[17];
+
+        for (uint32_t next = 0; next < SAMPLE_COUNT;) {
+            size_t count = 0;
+            while (count < sizeof(chunk) / sizeof(*chunk) && next + count < SAMPLE_COUNT) {
+                chunk[count] = next + count;
+                count++;
+            }
+
+            const size_t pushed = audioQueuePushChunk(queue, chunk, count);
+
+            next += pushed;
+            if (pushed == 0) this_thread::yield();
+        }
+    });
+
+    vector<uint32_t> popped(13);
+    uint32_t expected = 0;
+    bool inOrder = true;
+
+    while (expected < SAMPLE_COUNT) {
+        const size_t count = audioQueuePopChunk(queue, popped.data(), popped.size());
+
+        for (size_t i = 0; i < count; i++) inOrder = inOrder && popped[i] == expected++;
+        if (count == 0) this_thread::yield();
+    }
+
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(audioQueuePendingSamples(queue), static_cast<size_t>(0));
+}
+
+TEST(AudioQueue, ClearRacingWithPopNeverCorruptsSamples) {
+    constexpr size_t POP_COUNT = 200000;
+    auto queuePtr = createQueue(16);
+    AudioQueue* queue = queuePtr.get();
+    atomic<bool> done{false};
+
+    // The producer writes a continuous sequence, so every pop must return consecutive values
+    thread producer([&]() {
+        uint32_t chunk[16];
+
+        for (uint32_t next = 1; !done.load(memory_order_relaxed);) {
+            for (size_t i = 0; i < sizeof(chunk) / sizeof(*chunk); i++) chunk[i] = next + i;
+
+            next += audioQueuePushChunk(queue, chunk, sizeof(chunk) / sizeof(*chunk));
+            audioQueueClear(queue);
+        }
+    });
+
+    vector<uint32_t> popped(16);
+    uint32_t last = 0;
+    bool consistent = true;
+
+    for (size_t i = 0; i < POP_COUNT; i++) {
+        const size_t count = audioQueuePopChunk(queue, popped.data(), popped.size());
+
+        for (size_t j = 0; j < count; j++) {
+            consistent = consistent && popped[j] > last && (j == 0 || popped[j] == last + 1);
+            last = popped[j];
+        }
+    }
+
+    done.store(true, memory_order_relaxed);
+    producer.join();
+
+    EXPECT_TRUE(consistent);
+}
@@ -0,0 +1,134 @@
+#include "../uarm/pxa270_WMMX_dp.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+
+namespace {
+    class Pxa270wmmxDataProcessing : public ::testing::Test {
+       protected:
+        uint64_t RandomRegister() {
+            static constexpr uint8_t edges[] = {0x00, 0x01, 0x7f, 0x80, 0x81, 0xff};
+            uint64_t value = 0;
+
+            // Mix uniform bytes with lane boundaries in order to hit saturation and the flags
+            for (int i = 0; i < 8; i++) {
+                uint64_t byte = (random() & 1) ? edges[random() % sizeof(edges)] : random() & 0xff;
+                value |= byte << (8 * i);
+            }
+
+            return value;
+        }
+
+        void Randomize(Pxa270wmmx& wmmx) {
+            for (auto& reg : wmmx.wR) reg.v64 = RandomRegister();
+            for (auto& reg : wmmx.wCGR) reg = random();
+
+            wmmx.wCASF = random();
+            wmmx.wCon = random();
+            wmmx.wCSSF = random();
+        }
+
+        void ExpectSameState(const Pxa270wmmx& actual, const Pxa270wmmx& expected, bool cp1,
+                             uint8_t op1, uint8_t op2) {
+            SCOPED_TRACE(testing::Message() << "cp" << cp1 << " op1 " << static_cast<int>(op1)
+                                            << " op2 " << static_cast<int>(op2));
+
+            for (int i = 0; i < 16; i++)
+                EXPECT_EQ(actual.wR[i].v64, expected.wR[i].v64) << "wR" << i;
+
+            EXPECT_EQ(actual.wCASF, expected.wCASF);
+            EXPECT_EQ(actual.wCon, expected.wCon);
+            EXPECT_EQ(actual.wCSSF, expected.wCSSF);
+        }
+
+        // Executes the instruction on both implementations with the operands in wR1 and wR2
+        uint64_t Execute(bool cp1, uint8_t op1, uint8_t op2, uint64_t n, uint64_t m) {
+            Pxa270wmmx wmmx{}, scalar{};
+
+            wmmx.wR[1].v64 = n;
+            wmmx.wR[2].v64 = m;
+            wmmx.wCGR[2] = m;
+            scalar = wmmx;
+
+            EXPECT_TRUE(pxa270wmmxDataProcessing(&wmmx, cp1, op1, 0, 1, 2, op2));
+            EXPECT_TRUE(pxa270wmmxDataProcessingScalar(&scalar, cp1, op1, 0, 1, 2, op2));
+            EXPECT_EQ(wmmx.wR[0].v64, scalar.wR[0].v64);
+
+            return wmmx.wR[0].v64;
+        }
+
+        std::mt19937_64 random{0x270};
+    };
+}  // namespace
+
+TEST_F(Pxa270wmmxDataProcessing, MatchesScalarImplementation) {
+    for (int round = 0; round < 200; round++) {
+        for (bool cp1 : {false, true}) {
+            for (uint8_t op2 = 0; op2 < 8; op2++) {
+                for (uint8_t op1 = 0; op1 < 16; op1++) {
+                    Pxa270wmmx expected;
+                    Randomize(expected);
+
+                    Pxa270wmmx actual = expected;
+                    const uint8_t CRd = random() & 15, CRn = random() & 15, CRm = random() & 15;
+
+                    const bool expectedValid = pxa270wmmxDataProcessingScalar(
+                        &expected, cp1, op1, CRd, CRn, CRm, op2);
+
+                    EXPECT_EQ(pxa270wmmxDataProcessing(&actual, cp1, op1, CRd, CRn, CRm, op2),
+                              expectedValid);
+                    ExpectSameState(actual, expected, cp1, op1, op2);
+
+                    if (HasFailure()) return;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(Pxa270wmmxDataProcessing, ShiftsClampLargeCounts) {
+    // halfword lanes 0x8001 0x7ffe 0x0001 0xffff, word lanes 0x80017ffe 0x0001ffff
+    constexpr uint64_t value = 0x80017ffe0001ffffull;
+    const struct {
+        uint8_t op1;
+        uint32_t by;
+        uint64_t expected;
+    } cases[] = {
+        {0b0100, 4, 0xf80007ff0000ffffull},    // WSRA.h
+        {0b0100, 16, 0xffff00000000ffffull},   // WSRA.h
+        {0b0100, 200, 0xffff00000000ffffull},  // WSRA.h
+        {0b0101, 4, 0x0010ffe00010fff0ull},    // WSLL.h
+        {0b0101, 16, 0},                       // WSLL.h
+        {0b0110, 4, 0x080007ff00000fffull},    // WSRL.h
+        {0b0110, 16, 0},                       // WSRL.h
+        {0b0111, 20, 0x1800e7ff1000ffffull},   // WROR.h
+        {0b1000, 32, 0xffffffff00000000ull},   // WSRA.w
+        {0b1001, 32, 0},                       // WSLL.w
+        {0b1010, 255, 0},                      // WSRL.w
+        {0b1011, 40, 0xfe80017fff0001ffull},   // WROR.w
+        {0b1100, 64, ~0ull},                   // WSRA.d
+        {0b1101, 64, 0},                       // WSLL.d
+        {0b1110, 100, 0},                      // WSRL.d
+        {0b1111, 72, 0xff80017ffe0001ffull},   // WROR.d
+    };
+
+    for (const auto& c : cases) {
+        SCOPED_TRACE(testing::Message() << "op1 " << static_cast<int>(c.op1) << " by " << c.by);
+
+        EXPECT_EQ(Execute(false, c.op1, 0b010, value, c.by), c.expected);
+        EXPECT_EQ(Execute(true, c.op1, 0b010, value, c.by), c.expected);
+    }
+}
+
+TEST_F(Pxa270wmmxDataProcessing, AlignExtractsFromRegisterPair) {
+    constexpr uint64_t lo = 0x0706050403020100ull, hi = 0x0f0e0d0c0b0a0908ull;
+
+    EXPECT_EQ(Execute(false, 0b0000, 0b001, lo, hi), lo);                     // WALIGNI #0
+    EXPECT_EQ(Execute(false, 0b0011, 0b001, lo, hi), 0x0a09080706050403ull);  // WALIGNI #3
+    EXPECT_EQ(Execute(false, 0b0111, 0b001, lo, hi), 0x0e0d0c0b0a090807ull);  // WALIGNI #7
+
+    // WALIGNR2 takes the byte offset from wCGR2, which Execute loads with wR2
+    EXPECT_EQ(Execute(false, 0b1010, 0b001, lo, 0x0f0e0d0c0b0a0905ull), 0x0c0b0a0905070605ull);
+}
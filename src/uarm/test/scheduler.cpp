@@ -0,0 +1,611 @@
+#include "../uarm/scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+    uint64_t operator""_mhz(unsigned long long valueMhz) { return valueMhz * 1000000; }
+
+    class DispatchDelegate {
+       public:
+        struct Invocation {
+            uint32_t taskType;
+            uint32_t batchedTicks;
+        };
+
+       public:
+        void Reset() { invocations.clear(); }
+
+        size_t GetInvocationCount() const { return invocations.size(); }
+
+        const Invocation& GetInvocation(size_t index) const { return invocations[index]; }
+
+        void ExpectInvocation(size_t index, uint32_t taskType, uint32_t batchedTicks) const {
+            ASSERT_LT(index, GetInvocationCount());
+            EXPECT_EQ(invocations[index].taskType, taskType);
+            EXPECT_EQ(invocations[index].batchedTicks, batchedTicks);
+        }
+
+        uint32_t DispatchTicks(uint32_t taskType, uint32_t batchedTicks) {
+            invocations.push_back({taskType, batchedTicks});
+
+            return BatchedTicksForInvocation(invocations.size() - 1);
+        }
+
+        virtual uint32_t BatchedTicksForInvocation(uint32_t invocationIndex) {
+            return invocations[invocationIndex].batchedTicks;
+        }
+
+       protected:
+        std::vector<Invocation> invocations;
+    };
+
+    class SaveLoadHelper {
+       public:
+        SaveLoadHelper& Do32(uint32_t& value) { return Do(value); }
+        SaveLoadHelper& Do64(uint64_t& value) { return Do(value); }
+
+        void Rewind() {
+            loading = true;
+            index = 0;
+        }
+
+       private:
+        template <typename T>
+        SaveLoadHelper& Do(T& value) {
+            if (loading)
+                value = values[index++];
+            else
+                values.push_back(value);
+
+            return *this;
+        }
+
+       private:
+        std::vector<uint64_t> values;
+        size_t index{0};
+        bool loading{false};
+    };
+
+    TEST(Scheduler, TasksAreScheduledInAppropiateOrder) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 110_usec, 1);
+
+        scheduler.Advance(49, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(49, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(9, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(39, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, BatchedTicksAreScheduledBatched) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 3);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 110_usec, 1);
+
+        scheduler.Advance(109, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(39, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 3);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, UnscheduleRemovesTaskFromTopOfQueue) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 110_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_LCD, 130_usec, 1);
+
+        scheduler.UnscheduleTask(SCHEDULER_TASK_TIMER);
+
+        scheduler.Advance(109, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(19, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_LCD, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(89, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, UnscheduleRemovesTaskFromMiddleOfQueue) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 110_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_LCD, 130_usec, 1);
+
+        scheduler.UnscheduleTask(SCHEDULER_TASK_RTC);
+
+        scheduler.Advance(49, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(49, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(29, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_LCD, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, UnscheduleRemovesTaskFromEndOfQueue) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 110_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_LCD, 130_usec, 1);
+
+        scheduler.UnscheduleTask(SCHEDULER_TASK_LCD);
+
+        scheduler.Advance(49, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(49, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(9, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(39, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, RescheduleTaskAtLeastBatchesOverdueTicks) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 10_usec, 10);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 55_usec, 1);
+
+        scheduler.Advance(42, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.RescheduleTaskAtLeast(SCHEDULER_TASK_TIMER, 1);
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 4);
+        dispatchDelegate.Reset();
+
+        scheduler.RescheduleTaskAtLeast(SCHEDULER_TASK_TIMER, 1);
+
+        scheduler.Advance(6, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(4, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, RescheduleTaskDoesNotBatchOverdueTicks) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 10_usec, 10);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 55_usec, 1);
+
+        scheduler.Advance(42, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.RescheduleTask(SCHEDULER_TASK_TIMER, 1);
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(4));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.ExpectInvocation(1, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.ExpectInvocation(2, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.ExpectInvocation(3, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.RescheduleTask(SCHEDULER_TASK_TIMER, 1);
+
+        scheduler.Advance(6, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(4, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, ReschedulingPrefersRequestedBatchSizeIfThereAreLessOverdueTicks) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 10_usec, 10);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 55_usec, 1);
+
+        scheduler.Advance(42, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.RescheduleTask(SCHEDULER_TASK_TIMER, 5);
+
+        scheduler.Advance(7, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 5);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, TicksAreBatchedAccordingToDispatcher) {
+        class CustomDispatchDelegate : public DispatchDelegate {
+           public:
+            uint32_t BatchedTicksForInvocation(uint32_t invocationIndex) override {
+                return invocations[invocationIndex].taskType == SCHEDULER_TASK_TIMER ? 2 : 1;
+            }
+        };
+
+        CustomDispatchDelegate dispatchDelegate;
+        Scheduler<CustomDispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 10_usec, 3);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 55_usec, 1);
+
+        scheduler.Advance(29, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 3);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(19, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 2);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(4, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(14, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 2);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, ZeroBatchedTicksDisablesTask) {
+        class CustomDispatchDelegate : public DispatchDelegate {
+           public:
+            uint32_t BatchedTicksForInvocation(uint32_t invocationIndex) override {
+                return invocations[invocationIndex].taskType == SCHEDULER_TASK_TIMER ? 0 : 1;
+            }
+        };
+
+        CustomDispatchDelegate dispatchDelegate;
+        Scheduler<CustomDispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 10_usec, 3);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 55_usec, 1);
+
+        scheduler.Advance(29, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 3);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(24, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.Advance(54, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, ReschedulingAnUnscheduledTaskConinuesFromTheLastTheoreticTick) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 50_usec, 1);
+
+        scheduler.Advance(49, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+
+        scheduler.UnscheduleTask(SCHEDULER_TASK_RTC);
+
+        scheduler.Advance(55, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.RescheduleTask(SCHEDULER_TASK_RTC, 1);
+
+        scheduler.Advance(44, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, ReschedulingDropsOverdueTicksOnBatchSizeZero) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 10_usec, 10);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 55_usec, 1);
+
+        scheduler.Advance(42, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.RescheduleTask(SCHEDULER_TASK_TIMER, 0);
+
+        scheduler.Advance(12, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.Reset();
+    }
+
+    TEST(Scheduler, AdvanceHonorsTheBatchSizeReturnedByDelegate) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 110_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_PCM, 70_usec, 2);
+
+        scheduler.Advance(160, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(5));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.ExpectInvocation(1, SCHEDULER_TASK_TIMER, 1);
+        dispatchDelegate.ExpectInvocation(2, SCHEDULER_TASK_RTC, 1);
+        dispatchDelegate.ExpectInvocation(3, SCHEDULER_TASK_PCM, 2);
+        dispatchDelegate.ExpectInvocation(4, SCHEDULER_TASK_TIMER, 1);
+    }
+
+    TEST(Scheduler, ElapsedTicksAreTakenFromTheBatchWithoutMovingTheDeadline) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 4);
+
+        EXPECT_EQ(scheduler.TakeElapsedTicks(SCHEDULER_TASK_TIMER, 49_usec), 0u);
+        EXPECT_EQ(scheduler.TakeElapsedTicks(SCHEDULER_TASK_TIMER, 120_usec), 2u);
+        EXPECT_EQ(scheduler.TakeElapsedTicks(SCHEDULER_TASK_TIMER, 199_usec), 1u);
+        EXPECT_EQ(scheduler.TakeElapsedTicks(SCHEDULER_TASK_TIMER, 199_usec), 0u);
+        EXPECT_EQ(scheduler.GetDispatchedTicks(SCHEDULER_TASK_TIMER), 3u);
+
+        scheduler.Advance(199, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+
+        scheduler.Advance(1, 1_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+        dispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        EXPECT_EQ(scheduler.GetDispatchCount(SCHEDULER_TASK_TIMER), 1u);
+        EXPECT_EQ(scheduler.GetDispatchedTicks(SCHEDULER_TASK_TIMER), 4u);
+    }
+
+    TEST(Scheduler, FractionalNanosecondsAccumulateAcrossAdvances) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 1000_usec, 1);
+
+        for (int i = 0; i < 2999; i++) scheduler.Advance(1, 3_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(0));
+        EXPECT_GE(scheduler.GetTime(1), 1000_usec - 1);
+
+        EXPECT_EQ(scheduler.CyclesToNextUpdate(3_mhz), 2u);
+        scheduler.Advance(2, 3_mhz);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(1));
+    }
+
+    TEST(Scheduler, CycleAndTimeStampsAreContinuousAcrossSlices) {
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 1);
+
+        // Take a stamp in the middle of a slice, as the syscall clock does, and another one in a
+        // later slice after crossing several task deadlines
+        scheduler.Advance(30, 1_mhz);
+
+        const uint64_t startCycles = scheduler.GetCycles(5);
+        const uint64_t startTime = scheduler.GetTime(5);
+
+        scheduler.Advance(40, 1_mhz);
+        scheduler.Advance(100, 1_mhz);
+
+        EXPECT_EQ(scheduler.GetCycles(7) - startCycles, 142u);
+        EXPECT_EQ(scheduler.GetTime(7) - startTime, 142_usec);
+        EXPECT_EQ(dispatchDelegate.GetInvocationCount(), static_cast<size_t>(3));
+    }
+
+    TEST(Scheduler, RestoredSchedulerContinuesWhereTheSavedSchedulerLeftOff) {
+        SaveLoadHelper helper;
+
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        scheduler.ScheduleTask(SCHEDULER_TASK_TIMER, 50_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_RTC, 110_usec, 1);
+        scheduler.ScheduleTask(SCHEDULER_TASK_PCM, 70_usec, 2);
+
+        scheduler.Advance(60, 1_mhz);
+        scheduler.DoSaveLoad(helper);
+
+        DispatchDelegate restoredDispatchDelegate;
+        Scheduler<DispatchDelegate> restoredScheduler(restoredDispatchDelegate);
+
+        helper.Rewind();
+        restoredScheduler.DoSaveLoad(helper);
+        EXPECT_EQ(restoredScheduler.GetTime(), scheduler.GetTime());
+
+        restoredScheduler.Advance(100, 1_mhz);
+        EXPECT_EQ(restoredDispatchDelegate.GetInvocationCount(), static_cast<size_t>(4));
+        restoredDispatchDelegate.ExpectInvocation(0, SCHEDULER_TASK_TIMER, 1);
+        restoredDispatchDelegate.ExpectInvocation(1, SCHEDULER_TASK_RTC, 1);
+        restoredDispatchDelegate.ExpectInvocation(2, SCHEDULER_TASK_PCM, 2);
+        restoredDispatchDelegate.ExpectInvocation(3, SCHEDULER_TASK_TIMER, 1);
+    }
+
+    TEST(Scheduler, RestoredSchedulerKeepsTheClockFraction) {
+        SaveLoadHelper helper;
+
+        DispatchDelegate dispatchDelegate;
+        Scheduler<DispatchDelegate> scheduler(dispatchDelegate);
+
+        // One cycle at 2GHz is half a nanosecond, so the saved time carries a fraction
+        scheduler.Advance(1, 2000_mhz);
+        scheduler.DoSaveLoad(helper);
+
+        DispatchDelegate restoredDispatchDelegate;
+        Scheduler<DispatchDelegate> restoredScheduler(restoredDispatchDelegate);
+
+        helper.Rewind();
+        restoredScheduler.DoSaveLoad(helper);
+
+        scheduler.Advance(1, 2000_mhz);
+        restoredScheduler.Advance(1, 2000_mhz);
+
+        EXPECT_EQ(restoredScheduler.GetTime(), 1u);
+        EXPECT_EQ(restoredScheduler.GetTime(), scheduler.GetTime());
+        EXPECT_EQ(restoredScheduler.GetCycles(0), scheduler.GetCycles(0));
+    }
+
+}  // namespace
\ No newline at end of file
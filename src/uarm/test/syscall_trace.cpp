@@ -0,0 +1,112 @@
+#include "../uarm/syscall_trace.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "../uarm/syscall.h"
+
+namespace {
+    class SyscallTraceTest : public ::testing::Test {
+       protected:
+        void SetUp() override { trace = syscallTraceInit(4); }
+
+        void TearDown() override { syscallTraceDestroy(trace); }
+
+        void Record(uint32_t syscall, uint64_t cycles, uint64_t startNsec = 0, uint8_t depth = 0) {
+            const SyscallTraceEvent event = {.syscall = syscall,
+                                             .stack = 0xa0010000,
+                                             .depth = depth,
+                                             .startNsec = startNsec,
+                                             .durationNsec = cycles * 10,
+                                             .cycles = cycles};
+
+            syscallTraceRecord(trace, &event);
+        }
+
+        std::string Export(void (*writer)(SyscallTrace*, FILE*)) {
+            char* buffer = nullptr;
+            size_t size = 0;
+
+            FILE* stream = open_memstream(&buffer, &size);
+            writer(trace, stream);
+            fclose(stream);
+
+            std::string result(buffer, size);
+            free(buffer);
+
+            return result;
+        }
+
+        SyscallTrace* trace{nullptr};
+    };
+
+    TEST_F(SyscallTraceTest, StatisticsAccumulatePerSyscall) {
+        Record(SYSCALL_MEM_MOVE, 100, 0, 1);
+        Record(SYSCALL_MEM_MOVE, 300, 0, 3);
+        Record(SYSCALL_STR_LEN, 5);
+
+        const SyscallTraceStatistics* memMove = syscallTraceGetStatistics(trace, SYSCALL_MEM_MOVE);
+        ASSERT_NE(memMove, nullptr);
+
+        EXPECT_EQ(memMove->calls, 2u);
+        EXPECT_EQ(memMove->cycles, 400u);
+        EXPECT_EQ(memMove->maxCycles, 300u);
+        EXPECT_EQ(memMove->maxDepth, 3u);
+
+        ASSERT_NE(syscallTraceGetStatistics(trace, SYSCALL_STR_LEN), nullptr);
+        EXPECT_EQ(syscallTraceGetStatistics(trace, SYSCALL_MEM_SET), nullptr);
+    }
+
+    TEST_F(SyscallTraceTest, HistogramBucketsArePowersOfTwo) {
+        Record(SYSCALL_MEM_SET, 0);
+        Record(SYSCALL_MEM_SET, 1);
+        Record(SYSCALL_MEM_SET, 2);
+        Record(SYSCALL_MEM_SET, 3);
+        Record(SYSCALL_MEM_SET, 1ull << 40);
+
+        const SyscallTraceStatistics* statistics =
+            syscallTraceGetStatistics(trace, SYSCALL_MEM_SET);
+        ASSERT_NE(statistics, nullptr);
+
+        EXPECT_EQ(statistics->histogram[0], 1u);
+        EXPECT_EQ(statistics->histogram[1], 1u);
+        EXPECT_EQ(statistics->histogram[2], 2u);
+        EXPECT_EQ(statistics->histogram[SYSCALL_TRACE_HISTOGRAM_BUCKETS - 1], 1u);
+    }
+
+    TEST_F(SyscallTraceTest, RingKeepsTheMostRecentEvents) {
+        for (uint64_t i = 1; i <= 6; i++) Record(SYSCALL_STR_COPY, i, i * 1000);
+
+        ASSERT_EQ(syscallTraceEventCount(trace), 4u);
+        EXPECT_EQ(syscallTraceGetEvent(trace, 0)->cycles, 3u);
+        EXPECT_EQ(syscallTraceGetEvent(trace, 3)->cycles, 6u);
+        EXPECT_EQ(syscallTraceGetEvent(trace, 4), nullptr);
+
+        EXPECT_EQ(syscallTraceGetStatistics(trace, SYSCALL_STR_COPY)->calls, 6u);
+    }
+
+    TEST_F(SyscallTraceTest, ResetDropsEventsAndStatistics) {
+        Record(SYSCALL_STR_COPY, 10);
+        syscallTraceReset(trace);
+
+        EXPECT_EQ(syscallTraceEventCount(trace), 0u);
+        EXPECT_EQ(syscallTraceGetStatistics(trace, SYSCALL_STR_COPY), nullptr);
+    }
+
+    TEST_F(SyscallTraceTest, ExportsContainTheRecordedEvents) {
+        Record(SYSCALL_MEM_MOVE, 42, 2500);
+
+        const std::string json = Export(syscallTraceWriteJson);
+        EXPECT_NE(json.find("\"name\":\"MemMove\""), std::string::npos);
+        EXPECT_NE(json.find("\"cycles\":42"), std::string::npos);
+
+        const std::string chromeTrace = Export(syscallTraceWriteChromeTrace);
+        EXPECT_NE(chromeTrace.find("\"name\":\"MemMove\""), std::string::npos);
+        EXPECT_NE(chromeTrace.find("\"ts\":2.500"), std::string::npos);
+        EXPECT_NE(chromeTrace.find("\"dur\":0.420"), std::string::npos);
+    }
+}  // namespace
@@ -0,0 +1,58 @@
+#include "../native/TripleBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+
+namespace {
+    TEST(TripleBuffer, AcquireReturnsTheLatestPublishedBuffer) {
+        TripleBuffer<int> buffer(0);
+
+        EXPECT_FALSE(buffer.Acquire());
+
+        buffer.GetBackBuffer() = 1;
+        buffer.Publish();
+        buffer.GetBackBuffer() = 2;
+        buffer.Publish();
+
+        ASSERT_TRUE(buffer.Acquire());
+        EXPECT_EQ(buffer.GetFrontBuffer(), 2);
+        EXPECT_FALSE(buffer.Acquire());
+        EXPECT_EQ(buffer.GetFrontBuffer(), 2);
+
+        buffer.GetBackBuffer() = 3;
+        buffer.Publish();
+
+        ASSERT_TRUE(buffer.Acquire());
+        EXPECT_EQ(buffer.GetFrontBuffer(), 3);
+    }
+
+    TEST(TripleBuffer, ConsumerNeverSeesPartialBuffers) {
+        using Frame = std::array<uint32_t, 256>;
+        constexpr uint32_t FRAMES = 100000;
+
+        TripleBuffer<Frame> buffer(Frame{});
+
+        std::thread producer([&]() {
+            for (uint32_t i = 1; i <= FRAMES; i++) {
+                buffer.GetBackBuffer().fill(i);
+                buffer.Publish();
+            }
+        });
+
+        uint32_t last = 0;
+        while (last < FRAMES) {
+            if (!buffer.Acquire()) continue;
+
+            const Frame& frame = buffer.GetFrontBuffer();
+            for (uint32_t value : frame) ASSERT_EQ(value, frame[0]);
+
+            ASSERT_GT(frame[0], last);
+            last = frame[0];
+        }
+
+        producer.join();
+    }
+}  // namespace
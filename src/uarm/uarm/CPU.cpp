@@ -11,11 +11,15 @@
 #include "cp15.h"
 #include "cputil.h"
 #include "gdbstub.h"
+#include "host_page_cache.h"
 #include "icache.h"
 #include "mem.h"
 #include "memcpy.h"
 #include "pace.h"
 #include "peephole.h"
+#include "profiler.h"
+#include "savestate_chunk.h"
+#include "uarm_endian.h"
 
 #define xstr(s) str(s)
 #define str(s) #s
@@ -60,11 +64,16 @@
 #define INJECTED_CALL_LR_MAGIC 0xfffffffc
 #define INJECTED_CALL_MAX_CYCLES 200000000
 
+#define PACE_CYCLES 10
+
 #define EXEC_FN_PREFIX_VALUE 0x53ae0000
 
 #ifdef __EMSCRIPTEN__
     #define PREFIX_EXEC_FN(...) (ExecFn((uint32_t)__VA_ARGS__ + EXEC_FN_PREFIX_VALUE))
     #define ATTR_EMCC_NOINLINE __attribute__((noinline))
+#elif defined(PROFILE_CPU)
+    #define PREFIX_EXEC_FN(...) (cpuPrvProfiledExecFn<__VA_ARGS__>())
+    #define ATTR_EMCC_NOINLINE
 #else
     #define PREFIX_EXEC_FN(...) (__VA_ARGS__)
     #define ATTR_EMCC_NOINLINE
@@ -74,6 +83,21 @@
 
 typedef void (*ExecFn)(struct ArmCpu *cpu, uint32_t instr, bool privileged);
 
+#if defined(PROFILE_CPU) && !defined(__EMSCRIPTEN__)
+// Registers the name of each handler with the profiler the first time it is decoded
+template <ExecFn execFn>
+static ExecFn cpuPrvProfiledExecFn() {
+    static bool registered = false;
+
+    if (unlikely(!registered)) {
+        profilerRegisterExecFn(reinterpret_cast<const void *>(execFn), __PRETTY_FUNCTION__);
+        registered = true;
+    }
+
+    return execFn;
+}
+#endif
+
 /*
 
         coprocessors:
@@ -124,11 +148,25 @@ struct ArmCpu {
     struct ArmMmu *mmu;
     struct ArmMem *mem;
     struct ArmCP15 *cp15;
+    struct HostPageCache *hostPageCache;
 
     struct PacePatch *pacePatch;
+    struct Pace *pace;
     uint32_t paceOffset;
     bool modePace;
     bool sleeping;
+    bool endBlock;
+    bool endCycle;
+    bool inCycle;
+
+    // progress of the cpuCycle call in progress, see cpuGetCycleProgress
+    uint32_t cycleProgress;
+    uint32_t cycleProgressPC;
+    uint32_t paceBatchProgress;
+
+    // instructions executed since init
+    uint64_t armInstructions;
+    uint64_t paceInstructions;
 
     struct stub *debugStub;
     struct PatchDispatch *patchDispatch;
@@ -330,12 +368,12 @@ static void cpuPrvException(struct ArmCpu *cpu, uint32_t vector_pc, uint32_t lr,
                 cpu->paceOffset + cpu->pacePatch->enterPace);
 #endif
 
-        if (!paceSave68kState()) {
+        if (!paceSave68kState(cpu->pace)) {
             uint32_t addr;
             bool wasWrite;
             uint_fast8_t fsr;
 
-            paceGetMemeryFault(&addr, &wasWrite, &fsr);
+            paceGetMemeryFault(cpu->pace, &addr, &wasWrite, &fsr);
 
             fprintf(stderr,
                     "ignoreing memory fault in PACE during save68kState: %s, addr=%#010x, "
@@ -637,6 +675,31 @@ static FORCE_INLINE int32_t cpuPrvMedia_signedSaturate32(int32_t sign) {
     return (sign < 0) ? -0x80000000L : 0x7fffffffl;
 }
 
+template <int size>
+static FORCE_INLINE void cpuPrvHostLoad(const uint8_t *host, void *buf) {
+    // our memory system is little-endian
+    if constexpr (size == 1)
+        *(uint8_t *)buf = *host;
+    else if constexpr (size == 2)
+        *(uint16_t *)buf = le16toh(*(const uint16_t *)host);
+    else if constexpr (size == 4)
+        *(uint32_t *)buf = le32toh(*(const uint32_t *)host);
+    else
+        *(uint64_t *)buf = le64toh(*(const uint64_t *)host);
+}
+
+template <int size>
+static FORCE_INLINE void cpuPrvHostStore(uint8_t *host, const void *buf) {
+    if constexpr (size == 1)
+        *host = *(const uint8_t *)buf;
+    else if constexpr (size == 2)
+        *(uint16_t *)host = htole16(*(const uint16_t *)buf);
+    else if constexpr (size == 4)
+        *(uint32_t *)host = htole32(*(const uint32_t *)buf);
+    else
+        *(uint64_t *)host = htole64(*(const uint64_t *)buf);
+}
+
 template <int size>
 static FORCE_INLINE bool cpuPrvMemOpEx(struct ArmCpu *cpu, void *buf, uint32_t vaddr, bool write,
                                        bool priviledged, uint_fast8_t *fsrP) {
@@ -654,6 +717,23 @@ static FORCE_INLINE bool cpuPrvMemOpEx(struct ArmCpu *cpu, void *buf, uint32_t v
     if (vaddr < 0x02000000UL) vaddr |= cpu->pid;
 #endif
 
+    // fast path: RAM that has been accessed through the same page before
+    if (write) {
+        uint8_t *host = hostPageCacheGetForWrite(cpu->hostPageCache, vaddr, priviledged);
+
+        if (host) {
+            cpuPrvHostStore<size>(host, buf);
+            return true;
+        }
+    } else {
+        const uint8_t *host = hostPageCacheGetForRead(cpu->hostPageCache, vaddr, priviledged);
+
+        if (host) {
+            cpuPrvHostLoad<size>(host, buf);
+            return true;
+        }
+    }
+
     MMUTranslateResult translateResult = mmuTranslate(cpu->mmu, vaddr, priviledged, write);
 
     if (!MMU_TRANSLATE_RESULT_OK(translateResult)) {
@@ -663,6 +743,9 @@ static FORCE_INLINE bool cpuPrvMemOpEx(struct ArmCpu *cpu, void *buf, uint32_t v
 
     uint32_t pa = MMU_TRANSLATE_RESULT_PA(translateResult);
 
+    hostPageCacheFill(cpu->hostPageCache, cpu->mem, vaddr, pa,
+                      MMU_TRANSLATE_RESULT_4K_PAGE(translateResult), write, priviledged);
+
     bool ok = memAccess(cpu->mem, pa, size, write, buf);
 
     if (!ok) {
@@ -823,7 +906,7 @@ static void cpuPrvHandlePaceMemoryFault(struct ArmCpu *cpu) {
     bool wasWrite;
     uint_fast8_t fsr;
 
-    paceGetMemeryFault(&addr, &wasWrite, &fsr);
+    paceGetMemeryFault(cpu->pace, &addr, &wasWrite, &fsr);
     cpuPrvHandleMemErr(cpu, addr, wasWrite, false, fsr);
 }
 
@@ -911,10 +994,10 @@ static void execFn_paceEnter(struct ArmCpu *cpu, uint32_t instr, bool privileged
     if (!cpuPrvMemOp<4>(cpu, &cpu->regs[0], cpu->regs[REG_NO_SP], true, privileged, &fsr))
         return cpuPrvHandleMemErr(cpu, cpu->regs[REG_NO_SP], true, false, fsr);
 
-    paceSetPriviledged(privileged);
-    paceSetStatePtr(cpu->regs[0]);
+    paceSetPriviledged(cpu->pace, privileged);
+    paceSetStatePtr(cpu->pace, cpu->regs[0]);
 
-    if (!paceLoad68kState()) return cpuPrvHandlePaceMemoryFault(cpu);
+    if (!paceLoad68kState(cpu->pace)) return cpuPrvHandlePaceMemoryFault(cpu);
 
     cpu->modePace = true;
     cpu->paceOffset = cpu->curInstrPC - cpu->pacePatch->enterPace;
@@ -928,10 +1011,10 @@ static void execFn_paceEnter(struct ArmCpu *cpu, uint32_t instr, bool privileged
 
 // PACE execution was resumed from ARM: resume after interrupt / exception
 static void execFn_paceResume(struct ArmCpu *cpu, uint32_t instr, bool privileged) {
-    paceSetPriviledged(cpu->M != ARM_SR_MODE_USR);
-    paceSetStatePtr(cpu->regs[0]);
+    paceSetPriviledged(cpu->pace, cpu->M != ARM_SR_MODE_USR);
+    paceSetStatePtr(cpu->pace, cpu->regs[0]);
 
-    if (!paceLoad68kState()) return cpuPrvHandlePaceMemoryFault(cpu);
+    if (!paceLoad68kState(cpu->pace)) return cpuPrvHandlePaceMemoryFault(cpu);
 
     cpu->modePace = true;
     cpu->paceOffset = cpu->curInstrPC - 4 - cpu->pacePatch->enterPace;
@@ -950,10 +1033,10 @@ static void execFn_paceReturnFromCallout(struct ArmCpu *cpu, uint32_t instr, boo
     if (!cpuPrvMemOp<4>(cpu, &cpu->regs[0], cpu->regs[REG_NO_SP], false, privileged, &fsr))
         return cpuPrvHandleMemErr(cpu, cpu->regs[REG_NO_SP], false, false, fsr);
 
-    paceSetPriviledged(privileged);
-    paceSetStatePtr(cpu->regs[0]);
+    paceSetPriviledged(cpu->pace, privileged);
+    paceSetStatePtr(cpu->pace, cpu->regs[0]);
 
-    if (!paceLoad68kState()) return cpuPrvHandlePaceMemoryFault(cpu);
+    if (!paceLoad68kState(cpu->pace)) return cpuPrvHandlePaceMemoryFault(cpu);
 
     cpu->modePace = true;
     cpu->paceOffset = cpu->curInstrPC - 8 - cpu->pacePatch->enterPace;
@@ -1802,13 +1885,19 @@ static void execFn_load_store_2(struct ArmCpu *cpu, uint32_t instr, bool privile
             // #define CALL_OSCALL(tab,num)	"LDR R12,[R9, #-" #tab "] \nLDR PC,[R12, #"
             // #num "]"
             if constexpr (mode & ARM_MODE_2_SYSCALL) {
-                if constexpr (destPc)
+                if constexpr (destPc) {
                     // syscall && destPc -> sourceReg == 9 && destReg == 12
-                    patchDispatchOnLoadPcFromR12(cpu->patchDispatch, addBefore ? increment : 0,
-                                                 cpu->regs);
-                else
+                    // A replaced syscall has already run natively, so return to the caller
+                    if (patchDispatchOnLoadPcFromR12(cpu->patchDispatch, addBefore ? increment : 0,
+                                                     cpu->regs, privileged))
+                        memVal32 = cpu->regs[REG_NO_LR];
+                } else {
                     // syscall && !destPc -> sourceReg == 12 && destReg == 15
                     patchDispatchOnLoadR12FromR9(cpu->patchDispatch, addBefore ? increment : 0);
+
+                    // patch dispatch needs to see the next instruction
+                    cpu->endBlock = true;
+                }
             }
 
             cpuPrvSetReg<destPc>(cpu, destReg, memVal32);
@@ -2716,6 +2805,22 @@ static void __attribute__((noinline)) cpuPrvDispatchExecFnThumb(ExecFn execFn, s
     ((ExecFn)((uint32_t)execFn & 0xffff))(cpu, instr, privileged);
 }
 
+#else
+
+static FORCE_INLINE void cpuPrvExecute(ExecFn execFn, struct ArmCpu *cpu, uint32_t instr,
+                                       bool privileged, bool thumb) {
+    #ifdef PROFILE_CPU
+    const uint64_t sampleStart = profilerSampleStart();
+    const uint32_t pc = cpu->curInstrPC;
+
+    execFn(cpu, instr, privileged);
+
+    profilerRecordExecFn(reinterpret_cast<const void *>(execFn), pc, thumb, sampleStart);
+    #else
+    execFn(cpu, instr, privileged);
+    #endif
+}
+
 #endif
 
 static void cpuPrvCycleArm(struct ArmCpu *cpu) {
@@ -2747,7 +2852,7 @@ static void cpuPrvCycleArm(struct ArmCpu *cpu) {
 #ifdef __EMSCRIPTEN__
     cpuPrvDispatchExecFnArm(cpuPrvDecompressExecFn(decoded), cpu, instr, privileged);
 #else
-    cpuPrvDecompressExecFn(decoded)(cpu, instr, privileged);
+    cpuPrvExecute(cpuPrvDecompressExecFn(decoded), cpu, instr, privileged, false);
 #endif
 }
 
@@ -2781,8 +2886,67 @@ static void cpuPrvCycleThumb(struct ArmCpu *cpu) {
 #ifdef __EMSCRIPTEN__
     cpuPrvDispatchExecFnThumb(cpuPrvDecompressExecFn(decoded), cpu, instr, privileged);
 #else
-    cpuPrvDecompressExecFn(decoded)(cpu, instr, privileged);
+    cpuPrvExecute(cpuPrvDecompressExecFn(decoded), cpu, instr, privileged, true);
+#endif
+}
+
+static FORCE_INLINE bool cpuPrvIrqDeliverable(struct ArmCpu *cpu) {
+    return !cpu->isInjectedCall &&
+           ((cpu->waitingFiqs && !cpu->F) || (cpu->waitingIrqs && !cpu->I));
+}
+
+// Run straight line code from the block cache. We leave the block as soon as PC does not
+// follow the block, the CPU changes state or an interrupt becomes deliverable. All per
+// instruction housekeeping in cpuCycle is either idle on entry or (in case of CP15 writes and
+// syscall dispatch) ends the block via endBlock.
+template <bool thumb>
+static uint32_t cpuPrvCycleBlock(struct ArmCpu *cpu, uint32_t maxInstructions) {
+    constexpr uint32_t sz = thumb ? 2 : 4;
+
+    const struct icacheBlock *block = icacheGetBlock<sz>(cpu->ic, cpu->regs[REG_NO_PC]);
+    if (!block) {
+        if (thumb)
+            cpuPrvCycleThumb(cpu);
+        else
+            cpuPrvCycleArm(cpu);
+
+        return 1;
+    }
+
+    const uint32_t length = block->length < maxInstructions ? block->length : maxInstructions;
+    uint32_t pc = block->pc;
+    uint32_t i = 0;
+
+    cpu->endBlock = false;
+
+    while (i < length) {
+        const struct icacheBlockInstruction *instruction = block->instructions + i++;
+        const bool privileged = cpu->M != ARM_SR_MODE_USR;
+
+        cpu->curInstrPC = pc;
+        pc += sz;
+        cpu->regs[REG_NO_PC] = pc;
+
+#ifdef __EMSCRIPTEN__
+        if (thumb)
+            cpuPrvDispatchExecFnThumb(cpuPrvDecompressExecFn(instruction->decoded), cpu,
+                                      instruction->instr, privileged);
+        else
+            cpuPrvDispatchExecFnArm(cpuPrvDecompressExecFn(instruction->decoded), cpu,
+                                    instruction->instr, privileged);
+#else
+        cpuPrvExecute(cpuPrvDecompressExecFn(instruction->decoded), cpu, instruction->instr,
+                      privileged, thumb);
 #endif
+
+        if (unlikely(cpu->regs[REG_NO_PC] != pc || cpu->T != thumb || cpu->modePace ||
+                     cpu->sleeping || cpu->endBlock))
+            break;
+
+        if (unlikely(cpu->waitingEventsTotal) && cpuPrvIrqDeliverable(cpu)) break;
+    }
+
+    return i;
 }
 
 static uint32_t translateThumb(uint16_t instrT) {
@@ -3198,10 +3362,7 @@ void cpuReset(struct ArmCpu *cpu, uint32_t pc) {
     mmuReset(cpu->mmu);
 }
 
-static void initStatic() {
-    static bool initialized = false;
-    if (initialized) return;
-
+static bool buildStaticTables() {
     table_thumb2arm = (uint32_t *)malloc(0x10000 * sizeof(uint32_t));
 
     for (uint32_t instr = 0; instr < 0x10000; instr++)
@@ -3210,6 +3371,15 @@ static void initStatic() {
     for (int i = 0; i < 256; i++) table_conditions[i] = !cpuPrvConditionTableEntry(i);
     for (int i = 0; i < 1024; i++) table_immShiftReg[i] = cpuPrvImmShiftRegTableEntry(i);
     for (int i = 0; i < 128; i++) table_immShiftImm[i] = cpuPrvImmShiftImmTableEntry(i);
+
+    return true;
+}
+
+// The tables are shared by all instances and built exactly once, even if several CPUs are
+// initialized concurrently
+static void initStatic() {
+    static const bool initialized = buildStaticTables();
+    (void)initialized;
 }
 
 struct ArmCpu *cpuInit(uint32_t pc, struct ArmMem *mem, bool xscale, bool omap, int debugPort,
@@ -3231,7 +3401,9 @@ struct ArmCpu *cpuInit(uint32_t pc, struct ArmMem *mem, bool xscale, bool omap,
     cpu->mmu = mmuInit(mem, xscale);
     if (!cpu->mmu) ERR("Cannot init MMU");
 
-    paceInit(cpu->mem, cpu->mmu);
+    cpu->hostPageCache = mmuGetHostPageCache(cpu->mmu);
+
+    cpu->pace = paceInit(cpu->mem, cpu->mmu);
 
     cpu->ic = icacheInit(mem, cpu->mmu);
     if (!cpu->ic) ERR("Cannot init icache");
@@ -3242,6 +3414,8 @@ struct ArmCpu *cpuInit(uint32_t pc, struct ArmMem *mem, bool xscale, bool omap,
     cpu->patchDispatch = patchDispatch;
     cpu->pacePatch = pacePatch;
 
+    if (patchDispatch) patchDispatchSetGuestMemory(patchDispatch, cpu->mem, cpu->mmu);
+
     cpuReset(cpu, pc);
 
     return cpu;
@@ -3288,7 +3462,7 @@ void cpuExecuteInjectedCall(struct ArmCpu *cpu, uint32_t syscall) {
 }
 
 static bool cpuPrvPaceCallout(struct ArmCpu *cpu, uint32_t destination) {
-    if (!paceSave68kState()) {
+    if (!paceSave68kState(cpu->pace)) {
         cpuPrvHandlePaceMemoryFault(cpu);
         return false;
     }
@@ -3302,8 +3476,8 @@ static bool cpuPrvPaceCallout(struct ArmCpu *cpu, uint32_t destination) {
 }
 
 static void cpuPrvPaceSyscall(struct ArmCpu *cpu) {
-    const uint16_t trapWord = paceReadTrapWord();
-    if (paceGetFsr() != 0) return cpuPrvHandlePaceMemoryFault(cpu);
+    const uint16_t trapWord = paceReadTrapWord(cpu->pace);
+    if (paceGetFsr(cpu->pace) != 0) return cpuPrvHandlePaceMemoryFault(cpu);
 
     cpu->regs[1] = trapWord;
 
@@ -3315,7 +3489,7 @@ static void cpuPrvPaceSyscall(struct ArmCpu *cpu) {
 }
 
 static void cpuPrvPaceDivisionByZero(struct ArmCpu *cpu) {
-    const uint16_t lastOpcode = paceGetLastOpcode();
+    const uint16_t lastOpcode = paceGetLastOpcode(cpu->pace);
 
     cpu->regs[1] = (lastOpcode >> 9) & 0x07;
     cpu->regs[2] = 0;
@@ -3381,7 +3555,7 @@ static void cpuPrvPaceReturn(struct ArmCpu *cpu) {
     bool privileged = cpu->M != ARM_SR_MODE_USR;
     uint_fast8_t fsr = 0;
 
-    if (!paceSave68kState()) return cpuPrvHandlePaceMemoryFault(cpu);
+    if (!paceSave68kState(cpu->pace)) return cpuPrvHandlePaceMemoryFault(cpu);
 
     cpu->regs[REG_NO_SP] += 4;
 
@@ -3399,10 +3573,30 @@ static void cpuPrvPaceReturn(struct ArmCpu *cpu) {
 #endif
 }
 
-static void cpuPrvCyclePace(struct ArmCpu *cpu) {
-    switch (paceExecute()) {
+static FORCE_INLINE enum paceStatus cpuPrvPaceExecute(struct ArmCpu *cpu,
+                                                      uint32_t maxInstructions,
+                                                      uint32_t *executed) {
+#ifdef PROFILE_CPU
+    // Single step so that every opcode is attributed
+    const uint64_t sampleStart = profilerSampleStart();
+    const enum paceStatus status = paceExecuteBatch(cpu->pace, 1, NULL, executed);
+
+    profilerRecordPaceOpcode(paceGetLastOpcode(cpu->pace), sampleStart);
+
+    return status;
+#else
+    // Pending interrupts end the batch so that they are delivered as before
+    return paceExecuteBatch(cpu->pace, maxInstructions, &cpu->waitingEventsTotal, executed);
+#endif
+}
+
+// Returns the number of 68k instructions executed
+static uint32_t cpuPrvCyclePace(struct ArmCpu *cpu, uint32_t maxInstructions) {
+    uint32_t &executed = cpu->paceBatchProgress;
+
+    switch (cpuPrvPaceExecute(cpu, maxInstructions, &executed)) {
         case pace_status_ok:
-            return;
+            return executed;
 
         case pace_status_division_by_zero:
             cpuPrvPaceDivisionByZero(cpu);
@@ -3446,12 +3640,18 @@ static void cpuPrvCyclePace(struct ArmCpu *cpu) {
             cpuPrvPaceUnimplementedlInstruction(cpu);
             break;
     }
+
+    return executed;
 }
 
 uint32_t cpuCycle(struct ArmCpu *cpu, uint32_t cycles) {
     uint32_t cycleAcc = 0;
+    uint32_t paceExecuted = 0;
+
+    cpu->endCycle = false;
+    cpu->inCycle = true;
 
-    while (cycleAcc < cycles && !cpu->sleeping) {
+    while (cycleAcc < cycles && !cpu->sleeping && !cpu->endCycle) {
         if (unlikely(cpu->waitingEventsTotal)) {
             if (unlikely(cpu->waitingFiqs && !cpu->F && !cpu->isInjectedCall))
                 cpuPrvException(cpu, cpu->vectorBase + ARM_VECTOR_OFFT_FIQ,
@@ -3462,11 +3662,27 @@ uint32_t cpuCycle(struct ArmCpu *cpu, uint32_t cycles) {
         }
 
         cp15Cycle(cpu->cp15);
-        patchOnBeforeExecute(cpu->patchDispatch, cpu->regs);
+        const bool patchDispatchPending = patchOnBeforeExecute(cpu->patchDispatch, cpu->regs);
+
+        cpu->cycleProgress = cycleAcc;
+        cpu->cycleProgressPC = cpu->regs[REG_NO_PC];
+        cpu->paceBatchProgress = 0;
 
         if (cpu->modePace) {
-            cpuPrvCyclePace(cpu);
-            cycleAcc += 10;
+            // Patch dispatch and MMU switches need to be serviced after every instruction
+            const uint32_t maxInstructions =
+                patchDispatchPending || cp15MmuSwitchPending(cpu->cp15)
+                    ? 1
+                    : (cycles - cycleAcc + PACE_CYCLES - 1) / PACE_CYCLES;
+
+            const uint32_t executed = cpuPrvCyclePace(cpu, maxInstructions);
+
+            paceExecuted += executed;
+            cycleAcc += PACE_CYCLES * executed;
+        } else if (!patchDispatchPending && !cp15MmuSwitchPending(cpu->cp15) &&
+                   !gdbStubEnabled(cpu->debugStub)) {
+            cycleAcc += cpu->T ? cpuPrvCycleBlock<true>(cpu, cycles - cycleAcc)
+                               : cpuPrvCycleBlock<false>(cpu, cycles - cycleAcc);
         } else if (cpu->T) {
             cpuPrvCycleThumb(cpu);
             cycleAcc += 1;
@@ -3476,9 +3692,35 @@ uint32_t cpuCycle(struct ArmCpu *cpu, uint32_t cycles) {
         }
     }
 
+    cpu->inCycle = false;
+
+    // All other cycles are ARM instructions, one cycle each
+    cpu->paceInstructions += paceExecuted;
+    cpu->armInstructions += cycleAcc - PACE_CYCLES * paceExecuted;
+
     return cycleAcc;
 }
 
+uint32_t cpuGetCycleProgress(struct ArmCpu *cpu) {
+    if (!cpu->inCycle) return 0;
+
+    // Blocks are straight line code, so the distance to the block start is the number of
+    // instructions the current block has executed. PACE batches count their instructions as they
+    // go.
+    return cpu->modePace ? cpu->cycleProgress + PACE_CYCLES * cpu->paceBatchProgress
+                         : cpu->cycleProgress +
+                               ((cpu->curInstrPC - cpu->cycleProgressPC) >> (cpu->T ? 1 : 2));
+}
+
+uint64_t cpuGetArmInstructions(struct ArmCpu *cpu) { return cpu->armInstructions; }
+
+uint64_t cpuGetPaceInstructions(struct ArmCpu *cpu) { return cpu->paceInstructions; }
+
+void cpuEndCycle(struct ArmCpu *cpu) {
+    cpu->endCycle = true;
+    cpu->endBlock = true;
+}
+
 void cpuIrq(struct ArmCpu *cpu, bool fiq, bool raise) {  // unraise when acknowledged
 
     if (fiq) {
@@ -3516,6 +3758,59 @@ void cpuSetSleeping(struct ArmCpu *cpu) { cpu->sleeping = true; }
 
 void cpuWakeup(struct ArmCpu *cpu) { cpu->sleeping = false; }
 
+void cpuEndBlock(struct ArmCpu *cpu) { cpu->endBlock = true; }
+
+void cpuInvalidateHostPages(struct ArmCpu *cpu) { hostPageCacheInvalidate(cpu->hostPageCache); }
+
 void cpuSetPid(struct ArmCpu *cpu, uint32_t pid) { cpu->pid = pid; }
 
 uint32_t cpuGetPid(struct ArmCpu *cpu) { return cpu->pid; }
+
+static void cpuPrvSerializeBankedRegs(struct ArmBankedRegs *bank, struct SavestateChunk *chunk) {
+    savestateChunkDo32(chunk, &bank->R13);
+    savestateChunkDo32(chunk, &bank->R14);
+    savestateChunkDo32(chunk, &bank->SPSR);
+}
+
+void cpuSerialize(struct ArmCpu *cpu, struct SavestateChunk *chunk) {
+    for (size_t i = 0; i < 16; i++) savestateChunkDo32(chunk, cpu->regs + i);
+    savestateChunkDo32(chunk, &cpu->SPSR);
+    savestateChunkDo32(chunk, &cpu->flags);
+    savestateChunkDoBool(chunk, &cpu->Q);
+    savestateChunkDoBool(chunk, &cpu->T);
+    savestateChunkDoBool(chunk, &cpu->I);
+    savestateChunkDoBool(chunk, &cpu->F);
+    savestateChunkDo8(chunk, &cpu->M);
+    savestateChunkDo32(chunk, &cpu->curInstrPC);
+
+    cpuPrvSerializeBankedRegs(&cpu->bank_usr, chunk);
+    cpuPrvSerializeBankedRegs(&cpu->bank_svc, chunk);
+    cpuPrvSerializeBankedRegs(&cpu->bank_abt, chunk);
+    cpuPrvSerializeBankedRegs(&cpu->bank_und, chunk);
+    cpuPrvSerializeBankedRegs(&cpu->bank_irq, chunk);
+    cpuPrvSerializeBankedRegs(&cpu->bank_fiq, chunk);
+    for (size_t i = 0; i < 5; i++) savestateChunkDo32(chunk, cpu->extra_regs + i);
+
+    savestateChunkDo16(chunk, &cpu->waitingIrqs);
+    savestateChunkDo16(chunk, &cpu->waitingFiqs);
+    savestateChunkDo16(chunk, &cpu->CPAR);
+
+    savestateChunkDo32(chunk, &cpu->vectorBase);
+    savestateChunkDo32(chunk, &cpu->pid);
+
+    savestateChunkDo32(chunk, &cpu->paceOffset);
+    savestateChunkDoBool(chunk, &cpu->modePace);
+    savestateChunkDoBool(chunk, &cpu->sleeping);
+
+    mmuSerialize(cpu->mmu, chunk);
+    cp15Serialize(cpu->cp15, chunk);
+    paceSerialize(cpu->pace, chunk);
+
+    if (!savestateChunkIsLoading(chunk)) return;
+
+    cpu->waitingEventsTotal = cpu->waitingIrqs + cpu->waitingFiqs;
+    cpu->isInjectedCall = false;
+    cpu->endBlock = false;
+
+    icacheInval(cpu->ic);
+}
@@ -62,6 +62,7 @@ typedef bool (*ArmCoprocTwoRegF)(struct ArmCpu *cpu, void *userData, bool MRRC,
                                  uint8_t Rd, uint8_t Rn, uint8_t CRm);
 
 struct PatchDispatch;
+struct SavestateChunk;
 
 struct ArmCoprocessor {
     ArmCoprocRegXferF regXfer;
@@ -83,6 +84,14 @@ void cpuExecuteInjectedCall(struct ArmCpu *cpu, uint32_t syscall);
 void cpuReset(struct ArmCpu *cpu, uint32_t pc);
 
 uint32_t cpuCycle(struct ArmCpu *cpu, uint32_t cycles);
+// Cycles executed so far by the cpuCycle call in progress (zero outside of cpuCycle)
+uint32_t cpuGetCycleProgress(struct ArmCpu *cpu);
+// Makes the cpuCycle call in progress return after the current instruction
+void cpuEndCycle(struct ArmCpu *cpu);
+// Instructions executed since init. ARM instructions take one cycle, 68k instructions executed
+// by PACE take ten.
+uint64_t cpuGetArmInstructions(struct ArmCpu *cpu);
+uint64_t cpuGetPaceInstructions(struct ArmCpu *cpu);
 void cpuIrq(struct ArmCpu *cpu, bool fiq, bool raise);  // unraise when acknowledged
 
 uint32_t cpuGetRegExternal(struct ArmCpu *cpu, uint_fast8_t reg);
@@ -102,6 +111,15 @@ void cpuSetCPAR(struct ArmCpu *cpu, uint16_t cpar);
 void cpuSetSleeping(struct ArmCpu *cpu);
 void cpuWakeup(struct ArmCpu *cpu);
 
+// Leave the currently executing block after the current instruction
+void cpuEndBlock(struct ArmCpu *cpu);
+
+// Drop cached host pointers to RAM, required if RAM write tracking changes
+void cpuInvalidateHostPages(struct ArmCpu *cpu);
+
+// Covers the core registers as well as MMU, CP15 and PACE state. Caches are flushed on load.
+void cpuSerialize(struct ArmCpu *cpu, struct SavestateChunk *chunk);
+
 uint32_t cpuDecodeArm(uint32_t instr);
 uint32_t cpuDecodeThumb(uint32_t instr);
 
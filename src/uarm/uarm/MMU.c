@@ -6,20 +6,13 @@
 #include <string.h>
 
 #include "cputil.h"
+#include "host_page_cache.h"
 #include "mem.h"
+#include "savestate_chunk.h"
+#include "tlb.h"
 
 #define TRANSLATE_RESULT_FAULT(fsr) ((1ull << 63) | ((uint64_t)(fsr) << 32))
-#define TLB_SIZE (1 << 20)
-
-struct TlbEntry {
-    uint32_t pa;
-
-    uint32_t revision : 16;
-    uint32_t ap : 2;
-    uint32_t domain : 4;
-    uint32_t c : 1;
-    uint32_t section : 1;
-};
+#define TRANSLATE_RESULT_4K_PAGE (1ull << 61)
 
 struct ArmMmu {
     struct ArmMem *mem;
@@ -29,18 +22,40 @@ struct ArmMmu {
     uint8_t xscale : 1;
     uint32_t domainCfg;
 
-    struct TlbEntry tlb[TLB_SIZE];
-    uint16_t revision;
+    struct Tlb tlb;
+    struct HostPageCache hostPageCache;
+
+    uint32_t generation;  // counts flushes, does not wrap with the TLB revision
 };
 
-void mmuTlbFlush(struct ArmMmu *mmu) {
-    mmu->revision++;
+#ifdef RECORD_TLB_TRACE
+
+// Records translations, TLB fills and flushes as pairs of (va, operation) to the file named by
+// UARM_TLB_TRACE. The trace can be replayed with bench/tlb.
+static FILE *tlbTraceFile = NULL;
 
-    if (mmu->revision == 0) {
-        mmu->revision = 1;
+static void mmuPrvRecordTlbTrace(uint32_t va, uint32_t op) {
+    if (!tlbTraceFile) {
+        const char *filename = getenv("UARM_TLB_TRACE");
 
-        for (size_t i = 0; i < TLB_SIZE; i++) mmu->tlb[i].revision = 0;
+        tlbTraceFile = fopen(filename ? filename : "tlb_trace.bin", "wb");
+        if (!tlbTraceFile) ERR("unable to open TLB trace file\n");
     }
+
+    const uint32_t record[2] = {va, op};
+    fwrite(record, sizeof(record), 1, tlbTraceFile);
+}
+
+#endif
+
+void mmuTlbFlush(struct ArmMmu *mmu) {
+    tlbFlush(&mmu->tlb);
+    hostPageCacheInvalidate(&mmu->hostPageCache);
+    mmu->generation++;
+
+#ifdef RECORD_TLB_TRACE
+    mmuPrvRecordTlbTrace(0, TLB_TRACE_OP_FLUSH);
+#endif
 }
 
 void mmuReset(struct ArmMmu *mmu) {
@@ -54,6 +69,9 @@ struct ArmMmu *mmuInit(struct ArmMem *mem, bool xscaleMode) {
     if (!mmu) ERR("cannot alloc MMU");
 
     memset(mmu, 0, sizeof(*mmu));
+    tlbInit(&mmu->tlb);
+    hostPageCacheInit(&mmu->hostPageCache);
+
     mmu->mem = mem;
     mmu->xscale = xscaleMode;
     mmuReset(mmu);
@@ -61,8 +79,17 @@ struct ArmMmu *mmuInit(struct ArmMem *mem, bool xscaleMode) {
     return mmu;
 }
 
+void mmuDeinit(struct ArmMmu *mmu) {
+    tlbDeinit(&mmu->tlb);
+    free(mmu);
+}
+
 bool mmuIsOn(struct ArmMmu *mmu) { return mmu->transTablPA != MMU_DISABLED_TTP; }
 
+uint32_t mmuGetGeneration(struct ArmMmu *mmu) { return mmu->generation; }
+
+struct HostPageCache *mmuGetHostPageCache(struct ArmMmu *mmu) { return &mmu->hostPageCache; }
+
 static inline uint8_t checkPermissionsForWrite(struct ArmMmu *mmu, uint_fast8_t ap,
                                                uint_fast8_t domain, bool section,
                                                bool priviledged) {
@@ -213,16 +240,12 @@ translated:
     pa = (adr - va) + paPage;
 
     if (sz > 1024) {
-        for (uint32_t offset = 0; offset < sz; offset += 4096) {
-            struct TlbEntry *tlbEntry = mmu->tlb + ((va + offset) >> 12);
-
-            tlbEntry->ap = ap;
-            tlbEntry->c = c;
-            tlbEntry->domain = dom;
-            tlbEntry->section = section;
-            tlbEntry->pa = paPage + offset;
-            tlbEntry->revision = mmu->revision;
-        }
+        for (uint32_t offset = 0; offset < sz; offset += 4096)
+            tlbInsert(&mmu->tlb, va + offset, paPage + offset, ap, dom, c, section);
+
+#ifdef RECORD_TLB_TRACE
+        mmuPrvRecordTlbTrace(va, TLB_TRACE_OP_FILL | sz);
+#endif
     }
 
     if (write) {
@@ -233,18 +256,21 @@ translated:
     result = pa;
 
     if (c) result |= (1ull << 62);
+    if (sz > 1024) result |= TRANSLATE_RESULT_4K_PAGE;
 
     return result;
 }
 
 MMUTranslateResult mmuTranslate(struct ArmMmu *mmu, uint32_t addr, bool priviledged, bool write) {
-    if (mmu->transTablPA == MMU_DISABLED_TTP) return addr;
+    if (mmu->transTablPA == MMU_DISABLED_TTP) return addr | TRANSLATE_RESULT_4K_PAGE;
 
-    struct TlbEntry *tlbEntry = mmu->tlb + (addr >> 12);
+#ifdef RECORD_TLB_TRACE
+    mmuPrvRecordTlbTrace(addr, write ? TLB_TRACE_OP_WRITE : TLB_TRACE_OP_READ);
+#endif
 
-    if (tlbEntry->revision != mmu->revision) {
-        return translateAndCache(mmu, addr, priviledged, write);
-    }
+    const struct TlbEntry *tlbEntry = tlbLookup(&mmu->tlb, addr);
+
+    if (!tlbEntry) return translateAndCache(mmu, addr, priviledged, write);
 
     if (write) {
         uint8_t fsr = checkPermissionsForWrite(mmu, tlbEntry->ap, tlbEntry->domain,
@@ -253,7 +279,7 @@ MMUTranslateResult mmuTranslate(struct ArmMmu *mmu, uint32_t addr, bool priviled
         if (fsr) return TRANSLATE_RESULT_FAULT(fsr);
     }
 
-    uint64_t result = (addr & 0xfff) + tlbEntry->pa;
+    uint64_t result = ((addr & 0xfff) + tlbEntry->pa) | TRANSLATE_RESULT_4K_PAGE;
 
     if (tlbEntry->c) result |= (1ull << 62);
 
@@ -277,7 +303,28 @@ bool mmuGetR(struct ArmMmu *mmu) { return mmu->R; }
 
 uint32_t mmuGetDomainCfg(struct ArmMmu *mmu) { return mmu->domainCfg; }
 
-void mmuSetDomainCfg(struct ArmMmu *mmu, uint32_t val) { mmu->domainCfg = val; }
+void mmuSetDomainCfg(struct ArmMmu *mmu, uint32_t val) {
+    // cached write permissions depend on the domain configuration
+    if (val != mmu->domainCfg) hostPageCacheInvalidate(&mmu->hostPageCache);
+
+    mmu->domainCfg = val;
+}
+
+void mmuSerialize(struct ArmMmu *mmu, struct SavestateChunk *chunk) {
+    bool S = mmu->S, R = mmu->R;
+
+    savestateChunkDo32(chunk, &mmu->transTablPA);
+    savestateChunkDoBool(chunk, &S);
+    savestateChunkDoBool(chunk, &R);
+    savestateChunkDo32(chunk, &mmu->domainCfg);
+
+    if (!savestateChunkIsLoading(chunk)) return;
+
+    mmu->S = S;
+    mmu->R = R;
+
+    mmuTlbFlush(mmu);
+}
 
 ///////////////////////////  debugging helpers  ///////////////////////////
 
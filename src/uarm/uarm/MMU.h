@@ -13,11 +13,14 @@ extern "C" {
 #endif
 
 struct ArmMmu;
+struct HostPageCache;
+struct SavestateChunk;
 
 typedef uint64_t MMUTranslateResult;
 
 #define MMU_TRANSLATE_RESULT_OK(x) (!(x & (1ull << 63)))
 #define MMU_TRANSLATE_RESULT_CACHEABLE(x) (x & (1ull << 62))
+#define MMU_TRANSLATE_RESULT_4K_PAGE(x) (x & (1ull << 61))  // valid for the whole 4k page
 #define MMU_TRANSLATE_RESULT_PA(x) ((uint32_t)x)
 #define MMU_TRANSLATE_RESULT_FSR(x) ((uint8_t)((x >> 32) & 0xff))
 
@@ -26,12 +29,19 @@ typedef uint64_t MMUTranslateResult;
 #define MMU_MAPPING_CACHEABLE 0x0001
 
 struct ArmMmu *mmuInit(struct ArmMem *mem, bool xscaleMode);
+void mmuDeinit(struct ArmMmu *mmu);
 void mmuReset(struct ArmMmu *mmu);
 
 MMUTranslateResult mmuTranslate(struct ArmMmu *mmu, uint32_t va, bool priviledged, bool write);
 
 bool mmuIsOn(struct ArmMmu *mmu);
 
+// Changes whenever cached translations become invalid
+uint32_t mmuGetGeneration(struct ArmMmu *mmu);
+
+// Host pointers for pages that are backed by RAM. Invalidated together with the TLB.
+struct HostPageCache *mmuGetHostPageCache(struct ArmMmu *mmu);
+
 uint32_t mmuGetTTP(struct ArmMmu *mmu);
 void mmuSetTTP(struct ArmMmu *mmu, uint32_t ttp);
 
@@ -45,6 +55,9 @@ void mmuSetDomainCfg(struct ArmMmu *mmu, uint32_t val);
 
 void mmuTlbFlush(struct ArmMmu *mmu);
 
+// Loading flushes the TLB
+void mmuSerialize(struct ArmMmu *mmu, struct SavestateChunk *chunk);
+
 void mmuDump(struct ArmMmu *mmu);  // for calling in GDB :)
 
 #ifdef __cplusplus
@@ -36,14 +36,14 @@ bool ramAccessF(void* userData, uint32_t pa, uint_fast8_t size, bool write, void
         switch (size) {
             case 1:
                 if (offset < ram->framebufferEnd && offset >= ram->framebufferStart)
-                    socSetFramebufferDirty(ram->soc);
+                    socSetFramebufferDirty(ram->soc, pa, size);
 
                 *((uint8_t*)addr) = *(uint8_t*)bufP;  // our memory system is little-endian
                 break;
 
             case 2:
                 if (offset < ram->framebufferEnd && offset >= ram->framebufferStart_2)
-                    socSetFramebufferDirty(ram->soc);
+                    socSetFramebufferDirty(ram->soc, pa, size);
 
                 *((uint16_t*)addr) =
                     htole16(*(uint16_t*)bufP);  // our memory system is little-endian
@@ -51,14 +51,14 @@ bool ramAccessF(void* userData, uint32_t pa, uint_fast8_t size, bool write, void
 
             case 4:
                 if (offset < ram->framebufferEnd && offset >= ram->framebufferStart_4)
-                    socSetFramebufferDirty(ram->soc);
+                    socSetFramebufferDirty(ram->soc, pa, size);
 
                 *((uint32_t*)addr) = htole32(*(uint32_t*)bufP);
                 break;
 
             case 64:
                 if (offset < ram->framebufferEnd && offset >= ram->framebufferStart_64)
-                    socSetFramebufferDirty(ram->soc);
+                    socSetFramebufferDirty(ram->soc, pa, size);
 
                 if (offset & 0x3f) RAM_BUFFER_MARK_DIRTY(ram->buf, offset + 0x3f);
 
@@ -74,7 +74,7 @@ bool ramAccessF(void* userData, uint32_t pa, uint_fast8_t size, bool write, void
 
             case 32:
                 if (offset < ram->framebufferEnd && offset >= ram->framebufferStart_32)
-                    socSetFramebufferDirty(ram->soc);
+                    socSetFramebufferDirty(ram->soc, pa, size);
 
                 if (offset & 0x1f) RAM_BUFFER_MARK_DIRTY(ram->buf, offset + 0x1f);
 
@@ -86,7 +86,7 @@ bool ramAccessF(void* userData, uint32_t pa, uint_fast8_t size, bool write, void
 
             case 16:
                 if (offset < ram->framebufferEnd && offset >= ram->framebufferStart_16)
-                    socSetFramebufferDirty(ram->soc);
+                    socSetFramebufferDirty(ram->soc, pa, size);
 
                 if (offset & 0x0f) RAM_BUFFER_MARK_DIRTY(ram->buf, offset + 0x0f);
 
@@ -96,7 +96,7 @@ bool ramAccessF(void* userData, uint32_t pa, uint_fast8_t size, bool write, void
 
             case 8:
                 if (offset < ram->framebufferEnd && offset >= ram->framebufferStart_8)
-                    socSetFramebufferDirty(ram->soc);
+                    socSetFramebufferDirty(ram->soc, pa, size);
 
                 *((uint64_t*)(addr + 0)) = htole64(((uint64_t*)bufP)[0]);
                 break;
@@ -171,6 +171,30 @@ void ramSetFramebuffer(struct ArmRam* ram, uint32_t base, uint32_t size) {
     }
 }
 
+bool ramGetHostPage(struct ArmRam* ram, uint32_t pa, bool write, struct MemHostPage* page) {
+    const uint32_t offset = (pa & ~0xfffu) - ram->adr;
+
+    if (write) {
+        // Writes to the framebuffer have to go through ramAccessF. Be conservative and refuse
+        // all pages that contain an address that might trigger framebuffer tracking.
+        uint32_t framebufferFirst = ram->framebufferStart;
+        const uint32_t thresholds[] = {ram->framebufferStart_2,  ram->framebufferStart_4,
+                                       ram->framebufferStart_8,  ram->framebufferStart_16,
+                                       ram->framebufferStart_32, ram->framebufferStart_64};
+
+        for (size_t i = 0; i < sizeof(thresholds) / sizeof(*thresholds); i++)
+            if (thresholds[i] < framebufferFirst) framebufferFirst = thresholds[i];
+
+        if (offset < ram->framebufferEnd && offset + 0x0fff >= framebufferFirst) return false;
+    }
+
+    page->data = (uint8_t*)ram->buf.buffer + offset;
+    page->dirtyPages = ram->buf.dirtyPages;
+    page->dirtyOffset = offset;
+
+    return true;
+}
+
 struct ArmRam* ramInit(struct ArmMem* mem, struct SoC* soc, uint32_t adr, uint32_t sz,
                        const struct RamBuffer* buf, bool primary) {
     struct ArmRam* ram = (struct ArmRam*)malloc(sizeof(*ram));
@@ -23,6 +23,8 @@ bool ramAccessF(void* userData, uint32_t pa, uint_fast8_t size, bool write, void
 
 void ramSetFramebuffer(struct ArmRam* ram, uint32_t base, uint32_t size);
 
+bool ramGetHostPage(struct ArmRam* ram, uint32_t pa, bool write, struct MemHostPage* page);
+
 #ifdef __cplusplus
 }
 #endif
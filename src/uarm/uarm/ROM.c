@@ -68,6 +68,16 @@ bool romAccessF(void *userData, uint32_t pa, uint_fast8_t size, bool write, void
     return access((uint8_t *)rom->data + (pa - rom->base), size, bufP);
 }
 
+bool romGetHostPage(struct ArmRom *rom, uint32_t pa, bool write, struct MemHostPage *page) {
+    if (write) return false;
+
+    page->data = (uint8_t *)rom->data + ((pa & ~0xfffu) - rom->base);
+    page->dirtyPages = NULL;
+    page->dirtyOffset = 0;
+
+    return true;
+}
+
 bool romInstructionFetch(void *userData, uint32_t pa, uint_fast8_t size, void *bufP) {
     struct ArmRom *rom = (struct ArmRom *)userData;
 
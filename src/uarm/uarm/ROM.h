@@ -22,6 +22,9 @@ bool romAccessF(void *userData, uint32_t pa, uint_fast8_t size, bool write, void
 
 bool romInstructionFetch(void *userData, uint32_t pa, uint_fast8_t size, void *bufP);
 
+// Read only; the page is not backed by a RamBuffer, so dirtyPages is NULL
+bool romGetHostPage(struct ArmRom *rom, uint32_t pa, bool write, struct MemHostPage *page);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,15 +18,17 @@ extern "C" {
 #define CHAR_CTL_C -1L
 #define CHAR_NONE -2L
 
+// Granularity of the NAND dirty page bitmap
+#define NAND_STORAGE_PAGE_SIZE 4224
+
 struct SoC;
 struct AudioQueue;
+struct SdCard;
+struct SyscallTrace;
 
-typedef bool (*SdSectorR)(uint32_t secNum, void *buf);
-typedef bool (*SdSectorW)(uint32_t secNum, const void *buf);
-
-struct SoC *socInit(void *romData, const uint32_t romSize, uint32_t sdNumSectors, SdSectorR sdR,
-                    SdSectorW sdW, uint8_t *nandContent, size_t nandSize, int gdbPort,
-                    uint_fast8_t socRev);
+// sdCard may be NULL if no card is inserted
+struct SoC *socInit(void *romData, const uint32_t romSize, struct SdCard *sdCard,
+                    uint8_t *nandContent, size_t nandSize, int gdbPort, uint_fast8_t socRev);
 uint64_t socRun(struct SoC *soc, uint64_t maxCycles, uint64_t cyclesPerSecond);
 
 void socBootload(struct SoC *soc, uint32_t method, void *param);  // soc-specific
@@ -46,7 +48,7 @@ void socWakeup(struct SoC *soc, uint8_t wakeupSource);
 void socExtSerialWriteChar(int ch);
 int socExtSerialReadChar(void);
 
-void socSetFramebufferDirty(struct SoC *soc);
+void socSetFramebufferDirty(struct SoC *soc, uint32_t pa, uint32_t size);
 bool socSetFramebuffer(struct SoC *soc, uint32_t start, uint32_t size);
 
 void socSetAudioQueue(struct SoC *soc, struct AudioQueue *audioQueue);
@@ -62,6 +64,33 @@ void socSetNandDirty(struct SoC *soc, bool isDirty);
 struct Buffer socGetRamData(struct SoC *soc);
 struct Buffer socGetRamDirtyPages(struct SoC *soc);
 
+// RAM and NAND are saved as the pages currently marked dirty, so a savestate must be loaded
+// into an instance whose memory matches the state at which the dirty bits were last cleared,
+// e.g. a fresh instance initialized from the same images.
+bool socSave(struct SoC *soc);
+struct Buffer socGetSavestate(struct SoC *soc);
+bool socLoad(struct SoC *soc, size_t size, void *buffer);
+
+// ARM and 68k instructions executed since init
+uint64_t socGetArmInstructions(struct SoC *soc);
+uint64_t socGetPaceInstructions(struct SoC *soc);
+
+// Number of times the scheduler has dispatched the task since init
+uint64_t socGetDispatchCount(struct SoC *soc, uint32_t taskType);
+// Number of ticks these dispatches covered (tasks may be dispatched in batches)
+uint64_t socGetDispatchedTicks(struct SoC *soc, uint32_t taskType);
+
+void socPrintMemoryStatistics(struct SoC *soc, FILE *stream);
+void socResetMemoryStatistics(struct SoC *soc);
+
+void socPrintSyscallStatistics(struct SoC *soc, FILE *stream, size_t maxEntries);
+void socResetSyscallStatistics(struct SoC *soc);
+
+void socSetSyscallTracing(struct SoC *soc, bool tracing);
+bool socGetSyscallTracing(struct SoC *soc);
+// NULL until tracing has been enabled for the first time
+struct SyscallTrace *socGetSyscallTrace(struct SoC *soc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,10 @@
 
 #include "audio_queue.h"
 #include "cputil.h"
+#include "savestate_chunk.h"
+
+// Playback samples are handed to the audio queue in batches of this size
+#define WM9712L_AUDIO_BATCH 32
 
 enum WM9712REG {
     RESET = 0x00,
@@ -94,6 +98,8 @@ struct WM9712L {
     uint16_t otherTwo[2];
 
     struct AudioQueue *audioQueue;
+    uint32_t audioBatch[WM9712L_AUDIO_BATCH];
+    uint8_t audioBatchSize;
 };
 
 static void wm9712LprvGpioRecalc(struct WM9712L *wm) {
@@ -432,8 +438,18 @@ struct WM9712L *wm9712LInit(struct SocAC97 *ac97, struct SocGpio *gpio, int8_t p
     return wm;
 }
 
+static void wm9712LprvFlushAudioPlayback(struct WM9712L *wm) {
+    if (wm->audioBatchSize == 0) return;
+
+    audioQueuePushChunk(wm->audioQueue, wm->audioBatch, wm->audioBatchSize);
+    wm->audioBatchSize = 0;
+}
+
 static void wm9712LprvNewAudioPlaybackSample(struct WM9712L *wm, uint32_t samp) {
-    if (wm->audioQueue) audioQueuePush(wm->audioQueue, samp);
+    if (!wm->audioQueue) return;
+
+    wm->audioBatch[wm->audioBatchSize++] = samp;
+    if (wm->audioBatchSize == WM9712L_AUDIO_BATCH) wm9712LprvFlushAudioPlayback(wm);
 }
 
 static bool wm9712LprvHaveAudioOutSample(struct WM9712L *wm, uint32_t *sampP) {
@@ -560,8 +576,11 @@ static bool wm9712LprvHaveModemOutSample(struct WM9712L *wm, uint32_t *sampP) {
 void wm9712Lperiodic(struct WM9712L *wm) {
     uint32_t val;
 
+    // The batch is flushed as soon as playback pauses
     if (socAC97clientClientWantData(wm->ac97, Ac97PrimaryAudio, &val))
         wm9712LprvNewAudioPlaybackSample(wm, val);
+    else
+        wm9712LprvFlushAudioPlayback(wm);
 
     if (wm9712LprvHaveAudioOutSample(wm, &val))
         socAC97clientClientHaveData(wm->ac97, Ac97PrimaryAudio, val);
@@ -606,4 +625,24 @@ void wm9712LsetPen(struct WM9712L *wm, int16_t x, int16_t y,
 
 void wm9712LsetAudioQueue(struct WM9712L *wm, struct AudioQueue *audioQueue) {
     wm->audioQueue = audioQueue;
+    wm->audioBatchSize = 0;
+}
+
+void wm9712LSerialize(struct WM9712L *wm, struct SavestateChunk *chunk) {
+    uint16_t *regs[] = {
+        &wm->digiRegs[0], &wm->digiRegs[1], &wm->digiRegs[2], &wm->addFunc1,   &wm->vendorTest,
+        &wm->addFunc2,    &wm->pdown1,      &wm->pdown2,      &wm->extdCtl,    &wm->recSel,
+        &wm->gpioCfg,     &wm->gpioPolTyp,  &wm->gpioSticky,  &wm->gpioWake,   &wm->gpioStatus,
+        &wm->gpioSharing, &wm->dacRate,     &wm->auxDacRate,  &wm->adcRate,    &wm->volOut2,
+        &wm->volHP,       &wm->volMono,     &wm->volPhone,    &wm->volMic,     &wm->volOut3,
+        &wm->volLineIn,   &wm->dacVol,      &wm->recGain,     &wm->volSidetone, &wm->vAux[0],
+        &wm->vAux[1],     &wm->vAux[2],     &wm->vAux[3],     &wm->penX,       &wm->penY,
+        &wm->penZ,        &wm->otherTwo[0], &wm->otherTwo[1]};
+
+    for (size_t i = 0; i < sizeof(regs) / sizeof(*regs); i++) savestateChunkDo16(chunk, regs[i]);
+
+    savestateChunkDoBool(chunk, &wm->penDown);
+    savestateChunkDoBool(chunk, &wm->haveUnreadPenData);
+    savestateChunkDo8(chunk, &wm->cooIdx);
+    savestateChunkDo8(chunk, &wm->numUnreadDatas);
 }
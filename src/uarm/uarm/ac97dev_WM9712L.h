@@ -14,6 +14,7 @@ extern "C" {
 #endif
 
 struct WM9712L;
+struct SavestateChunk;
 
 struct AudioQueue;
 
@@ -26,6 +27,9 @@ enum WM9712LauxPin {  // Vref is 3.3v,
 };
 
 struct WM9712L *wm9712LInit(struct SocAC97 *ac97, struct SocGpio *gpio, int8_t penDownPin);
+
+void wm9712LSerialize(struct WM9712L *wm, struct SavestateChunk *chunk);
+
 void wm9712Lperiodic(struct WM9712L *wm);
 
 void wm9712LsetAuxVoltage(struct WM9712L *wm, enum WM9712LauxPin which, uint32_t mV);
@@ -1,28 +1,67 @@
 #include "audio_queue.h"
 
-#include "queue.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
 
-#ifndef __EMSCRIPTEN__
-    #define AUDIO_QUEUE_THREADSAFE
-#endif
+using namespace std;
 
-#ifdef AUDIO_QUEUE_THREADSAFE
-    #include <mutex>
+namespace {
+    // Indices increase monotonically and wrap at the size of size_t. Capacity is a power of two,
+    // so the wrap is invisible when indices are masked.
+    bool isLater(size_t index1, size_t index2) {
+        return static_cast<ptrdiff_t>(index1 - index2) > 0;
+    }
 
-    #define AUDIO_QUEUE_LOCK std::lock_guard lock(audioQueue->mutex)
-#else
-    #define AUDIO_QUEUE_LOCK
-#endif
+    size_t roundToPowerOfTwo(size_t capacity) {
+        size_t roundedCapacity = 1;
+        while (roundedCapacity < capacity) roundedCapacity <<= 1;
+
+        return roundedCapacity;
+    }
+}  // namespace
 
 struct AudioQueue {
-    Queue<uint32_t> queue;
+    explicit AudioQueue(size_t capacity)
+        : capacity(roundToPowerOfTwo(capacity)),
+          mask(this->capacity - 1),
+          samples(make_unique<uint32_t[]>(this->capacity)) {}
+
+    const size_t capacity;
+    const size_t mask;
+    unique_ptr<uint32_t[]> samples;
+
+    // producer side
+    alignas(64) atomic<size_t> writeIndex{0};
+    atomic<size_t> clearIndex{0};
+    atomic<uint64_t> overrunSamples{0};
+
+    // consumer side
+    alignas(64) atomic<size_t> readIndex{0};
+    atomic<uint64_t> underrunSamples{0};
+};
 
-    AudioQueue(size_t capacity) : queue(capacity) {}
+// Clearing is requested by the producer and carried out by the consumer, which skips everything
+// written before the request. The producer only reuses slots once the consumer has published a read
+// index past them, so a pop that races with a clear never sees its samples overwritten.
+static size_t audioQueuePrvConsumerReadIndex(struct AudioQueue* audioQueue) {
+    size_t readIndex = audioQueue->readIndex.load(memory_order_relaxed);
+    const size_t clearIndex = audioQueue->clearIndex.load(memory_order_acquire);
 
-#ifdef AUDIO_QUEUE_THREADSAFE
-    std::mutex mutex;
-#endif
-};
+    if (isLater(clearIndex, readIndex)) {
+        readIndex = clearIndex;
+        audioQueue->readIndex.store(readIndex, memory_order_release);
+    }
+
+    return readIndex;
+}
+
+static void audioQueuePrvIncrement(atomic<uint64_t>& counter, uint64_t increment) {
+    // Only ever modified from one thread
+    counter.store(counter.load(memory_order_relaxed) + increment, memory_order_relaxed);
+}
 
 struct AudioQueue* audioQueueCreate(size_t capacity) {
     AudioQueue* audioQueue = new AudioQueue(capacity);
@@ -30,30 +69,65 @@ struct AudioQueue* audioQueueCreate(size_t capacity) {
     return audioQueue;
 }
 
+void audioQueueDestroy(struct AudioQueue* audioQueue) { delete audioQueue; }
+
 void audioQueuePush(struct AudioQueue* audioQueue, uint32_t sample) {
-    AUDIO_QUEUE_LOCK;
+    audioQueuePushChunk(audioQueue, &sample, 1);
+}
+
+size_t audioQueuePushChunk(struct AudioQueue* audioQueue, const uint32_t* samples, size_t count) {
+    const size_t writeIndex = audioQueue->writeIndex.load(memory_order_relaxed);
+    const size_t readIndex = audioQueue->readIndex.load(memory_order_acquire);
 
-    audioQueue->queue.Push(sample);
+    const size_t pushCount = min(count, audioQueue->capacity - (writeIndex - readIndex));
+    const size_t offset = writeIndex & audioQueue->mask;
+    const size_t firstCount = min(pushCount, audioQueue->capacity - offset);
+
+    memcpy(audioQueue->samples.get() + offset, samples, firstCount * sizeof(uint32_t));
+    memcpy(audioQueue->samples.get(), samples + firstCount,
+           (pushCount - firstCount) * sizeof(uint32_t));
+
+    audioQueue->writeIndex.store(writeIndex + pushCount, memory_order_release);
+
+    if (pushCount < count) audioQueuePrvIncrement(audioQueue->overrunSamples, count - pushCount);
+
+    return pushCount;
 }
 
 size_t audioQueuePopChunk(struct AudioQueue* audioQueue, uint32_t* destination, size_t count) {
-    AUDIO_QUEUE_LOCK;
+    const size_t readIndex = audioQueuePrvConsumerReadIndex(audioQueue);
+    const size_t writeIndex = audioQueue->writeIndex.load(memory_order_acquire);
+
+    const size_t popCount = min(count, writeIndex - readIndex);
+    const size_t offset = readIndex & audioQueue->mask;
+    const size_t firstCount = min(popCount, audioQueue->capacity - offset);
 
-    size_t actualCount = 0;
-    while (audioQueue->queue.GetSize() > 0 && actualCount < count)
-        destination[actualCount++] = audioQueue->queue.Pop();
+    memcpy(destination, audioQueue->samples.get() + offset, firstCount * sizeof(uint32_t));
+    memcpy(destination + firstCount, audioQueue->samples.get(),
+           (popCount - firstCount) * sizeof(uint32_t));
 
-    return actualCount;
+    audioQueue->readIndex.store(readIndex + popCount, memory_order_release);
+
+    if (popCount < count) audioQueuePrvIncrement(audioQueue->underrunSamples, count - popCount);
+
+    return popCount;
 }
 
 size_t audioQueuePendingSamples(struct AudioQueue* audioQueue) {
-    AUDIO_QUEUE_LOCK;
+    const size_t readIndex = audioQueuePrvConsumerReadIndex(audioQueue);
 
-    return audioQueue->queue.GetSize();
+    return audioQueue->writeIndex.load(memory_order_acquire) - readIndex;
 }
 
 void audioQueueClear(struct AudioQueue* audioQueue) {
-    AUDIO_QUEUE_LOCK;
+    audioQueue->clearIndex.store(audioQueue->writeIndex.load(memory_order_relaxed),
+                                 memory_order_release);
+}
+
+uint64_t audioQueueOverrunSamples(struct AudioQueue* audioQueue) {
+    return audioQueue->overrunSamples.load(memory_order_relaxed);
+}
 
-    audioQueue->queue.Clear();
+uint64_t audioQueueUnderrunSamples(struct AudioQueue* audioQueue) {
+    return audioQueue->underrunSamples.load(memory_order_relaxed);
 }
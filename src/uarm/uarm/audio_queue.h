@@ -8,20 +8,34 @@
 extern "C" {
 #endif
 
+// Wait-free single producer / single consumer ring of PCM samples. The emulator is the producer
+// (push, clear), the audio driver is the consumer (pop, pending samples). Samples that do not fit
+// are dropped and counted as overrun, samples that are requested but not available are counted as
+// underrun.
+
 struct AudioQueue;
 
 struct AudioQueue* audioQueueCreate(size_t capacity);
 
+void audioQueueDestroy(struct AudioQueue* audioQueue);
+
 void audioQueuePush(struct AudioQueue* audioQueue, uint32_t sample);
 
+// Returns the number of samples that were queued
+size_t audioQueuePushChunk(struct AudioQueue* audioQueue, const uint32_t* samples, size_t count);
+
 size_t audioQueuePopChunk(struct AudioQueue* audioQueue, uint32_t* destination, size_t count);
 
 size_t audioQueuePendingSamples(struct AudioQueue* audioQueue);
 
 void audioQueueClear(struct AudioQueue* audioQueue);
 
+uint64_t audioQueueOverrunSamples(struct AudioQueue* audioQueue);
+
+uint64_t audioQueueUnderrunSamples(struct AudioQueue* audioQueue);
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif  //  _AUDIO_QUEUE_H_
\ No newline at end of file
+#endif  //  _AUDIO_QUEUE_H_
@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include "cputil.h"
+#include "savestate_chunk.h"
 
 struct ArmCP15 {
     struct ArmCpu* cpu;
@@ -44,6 +45,8 @@ void cp15Cycle(struct ArmCP15* cp15)  // mmu on/off lags by a cycle
     }
 }
 
+bool cp15MmuSwitchPending(struct ArmCP15* cp15) { return cp15->mmuSwitchCy != 0; }
+
 static bool cp15prvCoprocRegXferFunc(struct ArmCpu* cpu, void* userData, bool two, bool read,
                                      uint8_t op1, uint8_t Rx, uint8_t CRn, uint8_t CRm,
                                      uint8_t op2) {
@@ -309,7 +312,11 @@ fail:
 
 success:
 
-    if (read) cpuSetReg(cpu, Rx, val);
+    if (read)
+        cpuSetReg(cpu, Rx, val);
+    else
+        cpuEndBlock(cpu);  // writes may change translation or invalidate the icache
+
     return true;
 }
 
@@ -345,3 +352,21 @@ void cp15SetFaultStatus(struct ArmCP15* cp15, uint32_t addr, uint_fast8_t faultS
     cp15->FAR = addr;
     cp15->FSR = faultStatus;
 }
+
+void cp15Serialize(struct ArmCP15* cp15, struct SavestateChunk* chunk) {
+    savestateChunkDo32(chunk, &cp15->control);
+    savestateChunkDo32(chunk, &cp15->ttb);
+    savestateChunkDo32(chunk, &cp15->FSR);
+    savestateChunkDo32(chunk, &cp15->FAR);
+    savestateChunkDo32(chunk, &cp15->mmuSwitchCy);
+
+    if (cp15->xscale) {
+        savestateChunkDo32(chunk, &cp15->CPAR);
+        savestateChunkDo32(chunk, &cp15->ACP);
+    } else if (cp15->omap) {
+        savestateChunkDo8(chunk, &cp15->cfg);
+        savestateChunkDo8(chunk, &cp15->iMin);
+        savestateChunkDo8(chunk, &cp15->iMax);
+        savestateChunkDo16(chunk, &cp15->tid);
+    }
+}
@@ -15,11 +15,15 @@ extern "C" {
 #endif
 
 struct ArmCP15;
+struct SavestateChunk;
 
 struct ArmCP15* cp15Init(struct ArmCpu* cpu, struct ArmMmu* mmu, struct icache* ic, uint32_t cpuid,
                          uint32_t cacheId, bool xscale, bool omap);
 void cp15SetFaultStatus(struct ArmCP15* cp15, uint32_t addr, uint_fast8_t faultStatus);
 void cp15Cycle(struct ArmCP15* cp15);
+bool cp15MmuSwitchPending(struct ArmCP15* cp15);
+
+void cp15Serialize(struct ArmCP15* cp15, struct SavestateChunk* chunk);
 
 #ifdef __cplusplus
 }
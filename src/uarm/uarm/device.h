@@ -68,6 +68,7 @@ enum RamTermination {  // what's after ram in phys map? (some devices probe)
 };
 
 struct Device;
+struct SavestateChunk;
 
 // simple queries
 uint32_t deviceGetRamSize(void);
@@ -77,6 +78,9 @@ uint_fast8_t deviceGetSocRev(void);
 // device handling
 struct Device *deviceSetup(struct SocPeriphs *sp, struct Reschedule reschedule, struct Keypad *kp,
                            struct VSD *vsd, uint8_t *nandContent, size_t nandSize);
+
+void deviceSerialize(struct Device *dev, struct SavestateChunk *chunk);
+
 void deviceKey(struct Device *dev, uint32_t key, bool down);
 void devicePeriodic(struct Device *dev, uint32_t tier);
 void devicePcmPeriodic(struct Device *dev);
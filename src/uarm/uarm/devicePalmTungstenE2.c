@@ -6,6 +6,7 @@
 #include "cputil.h"
 #include "device.h"
 #include "mmiodev_DirectNAND.h"
+#include "savestate_chunk.h"
 
 // clang-format off
 /*
@@ -224,4 +225,8 @@ void deviceSetAudioQueue(struct Device *dev, struct AudioQueue *audioQueue) {
     wm9712LsetAudioQueue(dev->wm9712L, audioQueue);
 }
 
-bool deviceI2sConnected() { return false; }
\ No newline at end of file
+bool deviceI2sConnected() { return false; }
+
+void deviceSerialize(struct Device *dev, struct SavestateChunk *chunk) {
+    wm9712LSerialize(dev->wm9712L, chunk);
+}
@@ -0,0 +1,58 @@
+#include "host_page_cache.h"
+
+#include <string.h>
+
+void hostPageCacheInit(struct HostPageCache* cache) {
+    memset(cache, 0, sizeof(*cache));
+
+    cache->revision = 1;
+}
+
+void hostPageCacheInvalidate(struct HostPageCache* cache) {
+    cache->revision++;
+
+    if (cache->revision != 0) return;
+
+    cache->revision = 1;
+
+    for (size_t i = 0; i < (1 << HOST_PAGE_CACHE_BITS); i++) cache->pages[i].revision = 0;
+}
+
+void hostPageCacheFill(struct HostPageCache* cache, struct ArmMem* mem, uint32_t va, uint32_t pa,
+                       bool fullPage, bool write, bool priviledged) {
+    if (!fullPage) return;
+
+    struct HostPage* page = cache->pages + ((va >> 12) & ((1 << HOST_PAGE_CACHE_BITS) - 1));
+
+    // A translation that permits writes permits reads in the same mode as well
+    const uint8_t readable = priviledged ? HOST_PAGE_READABLE_PRIVILEGED : HOST_PAGE_READABLE_USER;
+    const uint8_t access =
+        write ? (priviledged ? HOST_PAGE_WRITABLE_PRIVILEGED : HOST_PAGE_WRITABLE_USER) : readable;
+
+    if (page->page != va >> 12 || page->revision != cache->revision) {
+        page->page = va >> 12;
+        page->revision = cache->revision;
+        page->access = 0;
+
+        if (!memGetHostPage(mem, pa, false, &page->host)) page->host.data = NULL;
+    }
+
+    // Pages that are not backed by host memory are cached as well in order to keep them from
+    // being looked up over and over again.
+    if (!page->host.data || (page->access & access)) return;
+
+    if (write) {
+        if (page->access & HOST_PAGE_NO_DIRECT_WRITE) {
+            page->access |= readable;
+            return;
+        }
+
+        // Remember refused pages (framebuffer) in order to avoid retrying on every write
+        if (!memGetHostPage(mem, pa, true, &page->host)) {
+            page->access |= HOST_PAGE_NO_DIRECT_WRITE | readable;
+            return;
+        }
+    }
+
+    page->access |= access | readable;
+}
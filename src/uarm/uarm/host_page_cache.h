@@ -0,0 +1,87 @@
+#ifndef _HOST_PAGE_CACHE_H_
+#define _HOST_PAGE_CACHE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mem.h"
+#include "ram_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Direct mapped cache of virtual 4k pages that are backed by host memory. Loads and stores that
+// hit the cache bypass the MMU and the memory map. The cache is owned by the MMU and invalidated
+// whenever translations or permissions change.
+
+#define HOST_PAGE_CACHE_BITS 10
+
+#define HOST_PAGE_READABLE_USER 0x01
+#define HOST_PAGE_READABLE_PRIVILEGED 0x02
+#define HOST_PAGE_WRITABLE_USER 0x04
+#define HOST_PAGE_WRITABLE_PRIVILEGED 0x08
+#define HOST_PAGE_NO_DIRECT_WRITE 0x10
+
+struct HostPage {
+    uint32_t page;
+    uint32_t revision;
+
+    struct MemHostPage host;  // host.data is NULL if the page is not backed by host memory
+    uint8_t access;
+};
+
+struct HostPageCache {
+    uint32_t revision;
+
+    struct HostPage pages[1 << HOST_PAGE_CACHE_BITS];
+};
+
+void hostPageCacheInit(struct HostPageCache* cache);
+
+void hostPageCacheInvalidate(struct HostPageCache* cache);
+
+// Record a successful translation. fullPage has to be set if the translation is valid for the
+// whole 4k page containing va.
+void hostPageCacheFill(struct HostPageCache* cache, struct ArmMem* mem, uint32_t va, uint32_t pa,
+                       bool fullPage, bool write, bool priviledged);
+
+static inline const struct HostPage* hostPageCacheLookup(const struct HostPageCache* cache,
+                                                         uint32_t va) {
+    const struct HostPage* page =
+        cache->pages + ((va >> 12) & ((1 << HOST_PAGE_CACHE_BITS) - 1));
+
+    return (page->page == va >> 12 && page->revision == cache->revision) ? page : NULL;
+}
+
+static inline const uint8_t* hostPageCacheGetForRead(const struct HostPageCache* cache,
+                                                     uint32_t va, bool priviledged) {
+    const struct HostPage* page = hostPageCacheLookup(cache, va);
+
+    if (!page ||
+        !(page->access & (priviledged ? HOST_PAGE_READABLE_PRIVILEGED : HOST_PAGE_READABLE_USER)))
+        return NULL;
+
+    return page->host.data + (va & 0xfff);
+}
+
+// Marks the target as dirty, so the caller has to write if this returns non-NULL
+static inline uint8_t* hostPageCacheGetForWrite(const struct HostPageCache* cache, uint32_t va,
+                                                bool priviledged) {
+    const struct HostPage* page = hostPageCacheLookup(cache, va);
+
+    if (!page ||
+        !(page->access & (priviledged ? HOST_PAGE_WRITABLE_PRIVILEGED : HOST_PAGE_WRITABLE_USER)))
+        return NULL;
+
+    RAM_BUFFER_MARK_DIRTY_PAGES(page->host.dirtyPages, page->host.dirtyOffset + (va & 0xfff));
+
+    return page->host.data + (va & 0xfff);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _HOST_PAGE_CACHE_H_
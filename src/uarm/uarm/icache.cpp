@@ -23,6 +23,12 @@
 #define calculateLineIndex(va) (va & ~(0xffffffff << CACHE_LINE_WIDTH_BITS))
 #define maskLine(va) (va & (0xffffffff << CACHE_LINE_WIDTH_BITS))
 
+#define BLOCK_INDEX_BITS 11
+#define BLOCK_PAGE_BITS 12
+
+#define calculateBlockIndex(va) \
+    (((va >> 1) ^ (va >> (BLOCK_INDEX_BITS + 1))) & ~(0xffffffff << BLOCK_INDEX_BITS))
+
 #ifdef __EMSCRIPTEN__
     #define DECODED_INSTRUCTION_TYPE uint16_t
     #define DECODED_BITS 0xc000
@@ -51,8 +57,62 @@ struct icache {
 
     uint32_t revision;
     struct icacheline cache[1 << CACHE_INDEX_BITS];
+
+    // Blocks are only ever built from cached lines, so they are invalidated together
+    // with the lines they were built from. blockPages tracks the 4k pages that contain
+    // blocks and lets us skip the block scan for the vast majority of invalidations.
+    uint32_t blockRevision;
+    bool blockPagesDirty;
+    uint8_t blockPages[1 << (32 - BLOCK_PAGE_BITS - 3)];
+    struct icacheBlock blocks[1 << BLOCK_INDEX_BITS];
 };
 
+static void icachePrvInvalBlocks(struct icache* ic) {
+    ic->blockRevision++;
+
+    if (ic->blockRevision == 0) {
+        ic->blockRevision = 1;
+        for (size_t i = 0; i < (1 << BLOCK_INDEX_BITS); i++) ic->blocks[i].revision = 0;
+    }
+
+    if (ic->blockPagesDirty) {
+        memset(ic->blockPages, 0, sizeof(ic->blockPages));
+        ic->blockPagesDirty = false;
+    }
+}
+
+static void icachePrvInvalBlockRange(struct icache* ic, uint32_t addr, uint32_t size) {
+    if (size == 0 || !ic->blockPagesDirty) return;
+
+    bool hasBlocks = false;
+    for (uint32_t page = addr >> BLOCK_PAGE_BITS; page <= (addr + size - 1) >> BLOCK_PAGE_BITS;
+         page++) {
+        if (ic->blockPages[page >> 3] & (1 << (page & 0x07))) {
+            hasBlocks = true;
+            break;
+        }
+    }
+
+    if (!hasBlocks) return;
+
+    for (size_t i = 0; i < (1 << BLOCK_INDEX_BITS); i++) {
+        struct icacheBlock* block = ic->blocks + i;
+        if (block->revision != ic->blockRevision) continue;
+
+        const uint32_t blockSize = block->length << (block->thumb ? 1 : 2);
+
+        if (addr - block->pc < blockSize || block->pc - addr < size) block->revision = 0;
+    }
+}
+
+static void icachePrvMarkBlockPages(struct icache* ic, uint32_t addr, uint32_t size) {
+    for (uint32_t page = addr >> BLOCK_PAGE_BITS; page <= (addr + size - 1) >> BLOCK_PAGE_BITS;
+         page++)
+        ic->blockPages[page >> 3] |= (1 << (page & 0x07));
+
+    ic->blockPagesDirty = true;
+}
+
 void icacheInval(struct icache* ic) {
     ic->revision++;
 
@@ -60,6 +120,8 @@ void icacheInval(struct icache* ic) {
         ic->revision = 1;
         for (size_t i = 0; i < (1 << CACHE_INDEX_BITS); i++) ic->cache[i].revision = 0;
     }
+
+    icachePrvInvalBlocks(ic);
 }
 
 struct icache* icacheInit(struct ArmMem* mem, struct ArmMmu* mmu) {
@@ -77,7 +139,7 @@ struct icache* icacheInit(struct ArmMem* mem, struct ArmMmu* mmu) {
     return ic;
 }
 
-void icacheInvalAddr(struct icache* ic, uint32_t va) {
+static void icachePrvInvalLine(struct icache* ic, uint32_t va) {
     struct icacheline* line = ic->cache + calculateIndex(va);
 
     if (line->revision != ic->revision || line->tag != calculateTag(va)) return;
@@ -85,14 +147,24 @@ void icacheInvalAddr(struct icache* ic, uint32_t va) {
     line->revision = ic->revision - 1;
 }
 
+void icacheInvalAddr(struct icache* ic, uint32_t va) {
+    icachePrvInvalLine(ic, va);
+    icachePrvInvalBlockRange(ic, maskLine(va), 1 << CACHE_LINE_WIDTH_BITS);
+}
+
 void icacheInvalRange(struct icache* ic, uint32_t addr, uint32_t size) {
     for (uint32_t line = maskLine(addr); line < addr + size; line += (1 << CACHE_LINE_WIDTH_BITS)) {
-        icacheInvalAddr(ic, line);
+        icachePrvInvalLine(ic, line);
     }
+
+    icachePrvInvalBlockRange(ic, maskLine(addr), addr + size - maskLine(addr));
 }
 
-template <int sz>
-bool icacheFetch(struct icache* ic, uint32_t va, uint_fast8_t* fsrP, void* buf, uint32_t* decoded) {
+// cachedOnly: fail instead of fetching from uncacheable memory. Used for building blocks, which
+// must not touch memory speculatively.
+template <int sz, bool cachedOnly>
+static FORCE_INLINE bool icachePrvFetch(struct icache* ic, uint32_t va, uint_fast8_t* fsrP,
+                                       void* buf, uint32_t* decoded) {
     if (va & (sz - 1)) {  // alignment issue
 
         *fsrP = 3;
@@ -119,6 +191,8 @@ bool icacheFetch(struct icache* ic, uint32_t va, uint_fast8_t* fsrP, void* buf,
         }
 
         if (!cacheable) {
+            if (cachedOnly) return false;
+
             bool ok = memInstructionFetch(ic->mem, pa, sz, buf);
 
             if (!ok) {
@@ -210,7 +284,76 @@ bool icacheFetch(struct icache* ic, uint32_t va, uint_fast8_t* fsrP, void* buf,
     return true;
 }
 
+template <int sz>
+bool icacheFetch(struct icache* ic, uint32_t va, uint_fast8_t* fsrP, void* buf, uint32_t* decoded) {
+    return icachePrvFetch<sz, false>(ic, va, fsrP, buf, decoded);
+}
+
+// Unconditional branches and other unconditional writes to PC. The block would be left at
+// this point anyway, so there is no point in decoding further.
+static bool icachePrvEndsBlockArm(uint32_t instr) {
+    return (instr & 0xfe000000) == 0xea000000 ||  // B / BL
+           (instr & 0xfe000000) == 0xfa000000 ||  // BLX imm
+           (instr & 0xffffffd0) == 0xe12fff10 ||  // BX / BLX reg
+           (instr & 0xfe108000) == 0xe8108000 ||  // LDM {..., PC}
+           (instr & 0xfc10f000) == 0xe410f000 ||  // LDR PC, ...
+           (instr & 0xfc00f000) == 0xe000f000 ||  // data processing with Rd = PC
+           (instr & 0xff000000) == 0xef000000;    // SWI
+}
+
+static bool icachePrvEndsBlockThumb(uint32_t instr) {
+    return (instr & 0xf800) == 0xe000 ||  // B
+           (instr & 0xe800) == 0xe800 ||  // BL / BLX suffix
+           (instr & 0xff00) == 0x4700 ||  // BX / BLX reg
+           (instr & 0xff00) == 0xbd00 ||  // POP {..., PC}
+           (instr & 0xfd87) == 0x4487 ||  // ADD / MOV PC, Rm
+           (instr & 0xff00) == 0xdf00;    // SWI
+}
+
+template <int sz>
+const struct icacheBlock* icacheGetBlock(struct icache* ic, uint32_t va) {
+    struct icacheBlock* block = ic->blocks + calculateBlockIndex(va);
+    const uint32_t mmuGeneration = mmuGetGeneration(ic->mmu);
+
+    if (block->revision == ic->blockRevision && block->pc == va && block->thumb == (sz == 2) &&
+        block->mmuGeneration == mmuGeneration)
+        return block->length > 0 ? block : NULL;
+
+    // The block is built even if the code turns out to be uncacheable: an empty block
+    // caches this result until the next invalidation.
+    block->pc = va;
+    block->thumb = sz == 2;
+    block->mmuGeneration = mmuGeneration;
+    block->revision = ic->blockRevision;
+    block->length = 0;
+
+    if (!mmuIsOn(ic->mmu)) return NULL;
+
+    for (uint32_t i = 0; i < ICACHE_BLOCK_MAX_INSTRUCTIONS; i++) {
+        struct icacheBlockInstruction* instruction = block->instructions + i;
+        uint_fast8_t fsr;
+        uint32_t instr = 0;
+
+        if (!icachePrvFetch<sz, true>(ic, va + i * sz, &fsr, &instr, &instruction->decoded))
+            break;
+
+        instruction->instr = instr;
+        block->length++;
+
+        if (sz == 4 ? icachePrvEndsBlockArm(instr) : icachePrvEndsBlockThumb(instr)) break;
+    }
+
+    if (block->length == 0) return NULL;
+
+    icachePrvMarkBlockPages(ic, va, block->length * sz);
+
+    return block;
+}
+
 template bool icacheFetch<2>(struct icache* ic, uint32_t va, uint_fast8_t* fsrP, void* buf,
                              uint32_t* decoded);
 template bool icacheFetch<4>(struct icache* ic, uint32_t va, uint_fast8_t* fsrP, void* buf,
                              uint32_t* decoded);
+
+template const struct icacheBlock* icacheGetBlock<2>(struct icache* ic, uint32_t va);
+template const struct icacheBlock* icacheGetBlock<4>(struct icache* ic, uint32_t va);
@@ -26,9 +26,33 @@ void icacheInvalRange(struct icache* ic, uint32_t addr, uint32_t size);
 #ifdef __cplusplus
 }
 
+#define ICACHE_BLOCK_MAX_INSTRUCTIONS 32
+
+struct icacheBlockInstruction {
+    uint32_t instr;
+    uint32_t decoded;
+};
+
+// A straight line run of decoded instructions. Execution may leave the block at any point,
+// but can only ever enter at the first instruction.
+struct icacheBlock {
+    uint32_t pc;
+    uint32_t mmuGeneration;
+    uint32_t revision;
+    uint8_t thumb;
+    uint8_t length;
+
+    struct icacheBlockInstruction instructions[ICACHE_BLOCK_MAX_INSTRUCTIONS];
+};
+
 template <int sz>
 bool icacheFetch(struct icache* ic, uint32_t va, uint_fast8_t* fsr, void* buf, uint32_t* decoded);
 
+// Returns NULL if there is no cacheable code at va. In this case the instruction needs to be
+// fetched via icacheFetch.
+template <int sz>
+const struct icacheBlock* icacheGetBlock(struct icache* ic, uint32_t va);
+
 #endif
 
 #endif
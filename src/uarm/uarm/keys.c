@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include "cputil.h"
+#include "savestate_chunk.h"
 
 #define MAX_GPIO_KEYS 64
 #define MAX_KP_ROWS 12
@@ -222,3 +223,9 @@ bool keypadAddMatrixKey(struct Keypad *kp, enum KeyId key, unsigned row, unsigne
 
     return true;
 }
+
+void keypadSerialize(struct Keypad *kp, struct SavestateChunk *chunk) {
+    for (size_t r = 0; r < MAX_KP_ROWS; r++) {
+        for (size_t c = 0; c < MAX_KP_COLS; c++) savestateChunkDoBool(chunk, &kp->km[r][c].isDown);
+    }
+}
@@ -13,6 +13,7 @@ extern "C" {
 #endif
 
 struct Keypad;
+struct SavestateChunk;
 
 enum KeyId {
     keyInvalid = 0,
@@ -29,6 +30,9 @@ enum KeyId {
 };
 
 struct Keypad *keypadInit(struct SocGpio *gpio, bool matrixHasPullUps);
+
+void keypadSerialize(struct Keypad *kp, struct SavestateChunk *chunk);
+
 bool keypadDefineRow(struct Keypad *kp, unsigned rowIdx, int8_t gpio);
 bool keypadDefineCol(struct Keypad *kp, unsigned colIdx, int8_t gpio);
 bool keypadAddGpioKey(struct Keypad *kp, enum KeyId key, int8_t gpioNum, bool activeHigh);
@@ -15,15 +15,30 @@
 #define REGION_ROM 1
 #define REGION_BASE 2
 
+// Physical address space is dispatched through a two level radix with 4k pages: one lazily
+// allocated table of 256 page entries per 1MB section. A page entry holds the index of the region
+// that owns it plus one, zero for unmapped pages or PAGE_SHARED for pages that are split between
+// several regions (those fall back to a scan).
+#define PAGE_BITS 12
+#define SECTION_PAGE_BITS 8
+#define SECTION_PAGES (1 << SECTION_PAGE_BITS)
+#define NUM_SECTIONS (1 << (32 - PAGE_BITS - SECTION_PAGE_BITS))
+
+#define PAGE_UNMAPPED 0
+#define PAGE_SHARED 0xff
+
 struct ArmMemRegion {
     uint32_t pa;
     uint32_t sz;
     ArmMemAccessF aF;
     void *uD;
+
+    uint64_t accesses;
 };
 
 struct ArmMem {
     struct ArmMemRegion regions[NUM_MEM_REGIONS];
+    uint8_t *sections[NUM_SECTIONS];
 };
 
 struct ArmMem *memInit(void) {
@@ -36,7 +51,12 @@ struct ArmMem *memInit(void) {
     return mem;
 }
 
-void memDeinit(struct ArmMem *mem) { (void)mem; }
+void memDeinit(struct ArmMem *mem) {
+    for (size_t i = 0; i < NUM_SECTIONS; i++) {
+        free(mem->sections[i]);
+        mem->sections[i] = NULL;
+    }
+}
 
 static bool checkForIntersection(struct ArmMem *mem, uint32_t pa, uint32_t sz) {
     uint_fast8_t i;
@@ -51,6 +71,25 @@ static bool checkForIntersection(struct ArmMem *mem, uint32_t pa, uint32_t sz) {
     return false;
 }
 
+static void memPrvMapRegion(struct ArmMem *mem, uint_fast8_t region) {
+    const uint32_t firstPage = mem->regions[region].pa >> PAGE_BITS;
+    const uint32_t lastPage = (mem->regions[region].pa + mem->regions[region].sz - 1) >> PAGE_BITS;
+
+    for (uint32_t page = firstPage; page <= lastPage; page++) {
+        uint8_t **section = mem->sections + (page >> SECTION_PAGE_BITS);
+
+        if (!*section) {
+            *section = (uint8_t *)calloc(SECTION_PAGES, 1);
+            if (!*section) ERR("cannot alloc MEM section");
+        }
+
+        uint8_t *entry = *section + (page & (SECTION_PAGES - 1));
+        *entry = (*entry == PAGE_UNMAPPED || *entry == region + 1) ? region + 1 : PAGE_SHARED;
+
+        if (page == 0xfffff) break;
+    }
+}
+
 static bool memRegionAddFixed(struct ArmMem *mem, uint8_t region, uint32_t pa, uint32_t sz,
                               ArmMemAccessF af, void *uD) {
     mem->regions[region].pa = pa;
@@ -58,13 +97,15 @@ static bool memRegionAddFixed(struct ArmMem *mem, uint8_t region, uint32_t pa, u
     mem->regions[region].aF = af;
     mem->regions[region].uD = uD;
 
+    memPrvMapRegion(mem, region);
+
     return true;
 }
 
 bool memRegionAdd(struct ArmMem *mem, uint32_t pa, uint32_t sz, ArmMemAccessF aF, void *uD) {
     uint_fast8_t i;
 
-    if (checkForIntersection(mem, pa, sz)) return false;
+    if (!sz || checkForIntersection(mem, pa, sz)) return false;
 
     // find a free region and put it there
 
@@ -75,6 +116,8 @@ bool memRegionAdd(struct ArmMem *mem, uint32_t pa, uint32_t sz, ArmMemAccessF aF
             mem->regions[i].aF = aF;
             mem->regions[i].uD = uD;
 
+            memPrvMapRegion(mem, i);
+
             return true;
         }
     }
@@ -92,47 +135,113 @@ bool memRegionAddRom(struct ArmMem *mem, uint32_t pa, uint32_t sz, ArmMemAccessF
     return memRegionAddFixed(mem, REGION_ROM, pa, sz, af, uD);
 }
 
+static struct ArmMemRegion *memPrvFindRegion(struct ArmMem *mem, uint32_t addr) {
+    const uint8_t *section = mem->sections[addr >> (PAGE_BITS + SECTION_PAGE_BITS)];
+    if (!section) return NULL;
+
+    const uint8_t entry = section[(addr >> PAGE_BITS) & (SECTION_PAGES - 1)];
+    struct ArmMemRegion *region;
+
+    switch (entry) {
+        case PAGE_UNMAPPED:
+            return NULL;
+
+        case PAGE_SHARED:
+            for (region = mem->regions; region < mem->regions + NUM_MEM_REGIONS; region++)
+                if (addr - region->pa < region->sz) return region;
+
+            return NULL;
+
+        default:
+            region = mem->regions + entry - 1;
+
+            // the region may cover the page only partially
+            return addr - region->pa < region->sz ? region : NULL;
+    }
+}
+
 bool memAccess(struct ArmMem *mem, uint32_t addr, uint_fast8_t size, bool write, void *buf) {
-    if (mem->regions[REGION_RAM].pa <= addr &&
-        mem->regions[REGION_RAM].pa + mem->regions[REGION_RAM].sz > addr) {
+    if (addr - mem->regions[REGION_RAM].pa < mem->regions[REGION_RAM].sz) {
+        mem->regions[REGION_RAM].accesses++;
         return ramAccessF(mem->regions[REGION_RAM].uD, addr, size, write, buf);
     }
 
-    if (mem->regions[REGION_ROM].pa <= addr &&
-        mem->regions[REGION_ROM].pa + mem->regions[REGION_ROM].sz > addr)
+    if (addr - mem->regions[REGION_ROM].pa < mem->regions[REGION_ROM].sz) {
+        mem->regions[REGION_ROM].accesses++;
         return romAccessF(mem->regions[REGION_ROM].uD, addr, size, write, buf);
-
-    bool ret = false;
-    uint_fast8_t i;
-
-    for (i = REGION_BASE; i < NUM_MEM_REGIONS; i++) {
-        if (mem->regions[i].pa <= addr && mem->regions[i].pa + mem->regions[i].sz > addr) {
-            ret = mem->regions[i].aF(mem->regions[i].uD, addr, size, write, buf);
-            break;
-        }
     }
 
-    return ret;
+    struct ArmMemRegion *region = memPrvFindRegion(mem, addr);
+    if (!region) return false;
+
+    region->accesses++;
+    return region->aF(region->uD, addr, size, write, buf);
 }
 
 bool memInstructionFetch(struct ArmMem *mem, uint32_t addr, uint_fast8_t size, void *buf) {
-    if (mem->regions[REGION_RAM].pa <= addr &&
-        mem->regions[REGION_RAM].pa + mem->regions[REGION_RAM].sz > addr)
+    if (addr - mem->regions[REGION_RAM].pa < mem->regions[REGION_RAM].sz) {
+        mem->regions[REGION_RAM].accesses++;
         return ramAccessF(mem->regions[REGION_RAM].uD, addr, size, false, buf);
+    }
 
-    if (mem->regions[REGION_ROM].pa <= addr &&
-        mem->regions[REGION_ROM].pa + mem->regions[REGION_ROM].sz > addr)
+    if (addr - mem->regions[REGION_ROM].pa < mem->regions[REGION_ROM].sz) {
+        mem->regions[REGION_ROM].accesses++;
         return romInstructionFetch(mem->regions[REGION_ROM].uD, addr, size, buf);
+    }
 
-    bool ret = false;
-    uint_fast8_t i;
+    struct ArmMemRegion *region = memPrvFindRegion(mem, addr);
+    if (!region) return false;
 
-    for (i = REGION_BASE; i < NUM_MEM_REGIONS; i++) {
-        if (mem->regions[i].pa <= addr && mem->regions[i].pa + mem->regions[i].sz > addr) {
-            ret = mem->regions[i].aF(mem->regions[i].uD, addr, size, false, buf);
-            break;
-        }
+    region->accesses++;
+    return region->aF(region->uD, addr, size, false, buf);
+}
+
+bool memGetHostPage(struct ArmMem *mem, uint32_t pa, bool write, struct MemHostPage *page) {
+    const struct ArmMemRegion *ram = mem->regions + REGION_RAM;
+    const struct ArmMemRegion *rom = mem->regions + REGION_ROM;
+    const uint32_t pageBase = pa & ~0xfffu;
+
+    if (pageBase - ram->pa < ram->sz && pageBase - ram->pa + 0x1000 <= ram->sz)
+        return ramGetHostPage(ram->uD, pageBase, write, page);
+
+    if (pageBase - rom->pa < rom->sz && pageBase - rom->pa + 0x1000 <= rom->sz)
+        return romGetHostPage(rom->uD, pageBase, write, page);
+
+    return false;
+}
+
+static int memPrvCompareRegionsByAccesses(const void *a, const void *b) {
+    const struct ArmMemRegion *ra = *(const struct ArmMemRegion *const *)a;
+    const struct ArmMemRegion *rb = *(const struct ArmMemRegion *const *)b;
+
+    if (ra->accesses == rb->accesses) return ra->pa < rb->pa ? -1 : 1;
+
+    return ra->accesses > rb->accesses ? -1 : 1;
+}
+
+void memPrintStatistics(struct ArmMem *mem, FILE *stream) {
+    const struct ArmMemRegion *sorted[NUM_MEM_REGIONS];
+    size_t count = 0;
+    uint64_t total = 0;
+
+    for (size_t i = 0; i < NUM_MEM_REGIONS; i++) {
+        if (!mem->regions[i].sz) continue;
+
+        sorted[count++] = mem->regions + i;
+        total += mem->regions[i].accesses;
     }
 
-    return ret;
+    qsort(sorted, count, sizeof(*sorted), memPrvCompareRegionsByAccesses);
+
+    fprintf(stream, "physical memory accesses: %llu total\n", (unsigned long long)total);
+
+    for (size_t i = 0; i < count; i++)
+        fprintf(stream, "0x%08lx - 0x%08lx: %12llu (%5.2f%%)\n", (unsigned long)sorted[i]->pa,
+                (unsigned long)(sorted[i]->pa + sorted[i]->sz - 1),
+                (unsigned long long)sorted[i]->accesses,
+                total > 0 ? 100. * sorted[i]->accesses / total : 0.);
+}
+
+void memResetStatistics(struct ArmMem *mem) {
+    for (size_t i = 0; i < NUM_MEM_REGIONS; i++) mem->regions[i].accesses = 0;
 }
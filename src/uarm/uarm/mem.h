@@ -5,6 +5,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,13 @@ extern "C" {
 
 struct ArmMem;
 
+// A 4k page of physical memory that is backed by host memory
+struct MemHostPage {
+    uint8_t* data;
+    uint32_t* dirtyPages;  // RamBuffer dirty page bitmap
+    uint32_t dirtyOffset;  // offset of the page in the RamBuffer
+};
+
 typedef bool (*ArmMemAccessF)(void* userData, uint32_t pa, uint_fast8_t size, bool write,
                               void* buf);
 
@@ -26,6 +34,15 @@ bool memAccess(struct ArmMem* mem, uint32_t addr, uint_fast8_t size, bool write,
 
 bool memInstructionFetch(struct ArmMem* mem, uint32_t addr, uint_fast8_t size, void* buf);
 
+// Direct access to the page containing pa. Only the primary RAM and (for reading) the ROM are
+// eligible, and pages that require write tracking beyond dirty pages are refused for writing. page
+// is untouched on failure.
+bool memGetHostPage(struct ArmMem* mem, uint32_t pa, bool write, struct MemHostPage* page);
+
+// Per region access counters, sorted by access count
+void memPrintStatistics(struct ArmMem* mem, FILE* stream);
+void memResetStatistics(struct ArmMem* mem);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,9 +1,32 @@
 #include "memcpy.h"
 
+#include <cstring>
+
 #include "MMU.h"
 #include "mem.h"
+#include "ram_buffer.h"
 
 namespace {
+    bool transfer_host(uint8_t* host, uint32_t armPa, uint32_t size, bool write,
+                       struct ArmMem* mem) {
+        MemHostPage page;
+        if (!memGetHostPage(mem, armPa, write, &page)) return false;
+
+        const uint32_t offset = armPa & 0x0fff;
+
+        if (!write) {
+            memcpy(host, page.data + offset, size);
+            return true;
+        }
+
+        memcpy(page.data + offset, host, size);
+
+        for (uint32_t dirty = offset & ~0x01ff; dirty < offset + size; dirty += 0x0200)
+            RAM_BUFFER_MARK_DIRTY_PAGES(page.dirtyPages, page.dirtyOffset + dirty);
+
+        return true;
+    }
+
     template <int size>
     bool transfer_loop_pa(uint8_t*& host, uint32_t& armPa, uint32_t& sizeTotal, bool write,
                           struct ArmMem* mem, MemcpyResult* result) {
@@ -57,7 +80,7 @@ namespace {
                                       reinterpret_cast<unsigned long>(host) | 0x08);
 
         while (size > 0) {
-            MMUTranslateResult translateResult = mmuTranslate(mmu, arm, privileged, false);
+            MMUTranslateResult translateResult = mmuTranslate(mmu, arm, privileged, write);
             if (!MMU_TRANSLATE_RESULT_OK(translateResult)) {
                 result->ok = false;
                 result->fsr = MMU_TRANSLATE_RESULT_FSR(translateResult);
@@ -66,28 +89,30 @@ namespace {
                 return;
             }
 
-            // break loop at 1024k boundaries (smallest possible page size) and
-            // consult MMU for each chunk
+            // break loop at page boundaries (1k for tiny pages) and consult MMU for each chunk
             const uint32_t pa = MMU_TRANSLATE_RESULT_PA(translateResult);
-            const uint32_t pageBoundary = pa | 0x03ff;
+            const uint32_t pageBoundary =
+                pa | (MMU_TRANSLATE_RESULT_4K_PAGE(translateResult) ? 0x0fff : 0x03ff);
             const uint32_t chunkSize = pa + size > pageBoundary ? pageBoundary - pa + 1 : size;
 
-            switch (align) {
-                case 0:
-                    transfer_pa<0>(host, pa, chunkSize, write, mem, result);
-                    break;
+            if (!transfer_host(host, pa, chunkSize, write, mem)) {
+                switch (align) {
+                    case 0:
+                        transfer_pa<0>(host, pa, chunkSize, write, mem, result);
+                        break;
 
-                case 1:
-                    transfer_pa<1>(host, pa, chunkSize, write, mem, result);
-                    break;
+                    case 1:
+                        transfer_pa<1>(host, pa, chunkSize, write, mem, result);
+                        break;
 
-                case 2:
-                    transfer_pa<2>(host, pa, chunkSize, write, mem, result);
-                    break;
+                    case 2:
+                        transfer_pa<2>(host, pa, chunkSize, write, mem, result);
+                        break;
 
-                case 3:
-                    transfer_pa<3>(host, pa, chunkSize, write, mem, result);
-                    break;
+                    case 3:
+                        transfer_pa<3>(host, pa, chunkSize, write, mem, result);
+                        break;
+                }
             }
 
             if (!result->ok) {
@@ -114,9 +139,35 @@ void memcpy_hostToArm(uint32_t dest, uint8_t* src, uint32_t size, bool privilege
     transfer(src, dest, size, true, privileged, mem, mmu, result);
 }
 
+bool memcpy_probeArm(uint32_t addr, uint32_t size, bool write, bool privileged,
+                     struct ArmMmu* mmu, struct MemcpyResult* result) {
+    result->ok = true;
+    result->wasWrite = write;
+
+    while (size > 0) {
+        MMUTranslateResult translateResult = mmuTranslate(mmu, addr, privileged, write);
+        if (!MMU_TRANSLATE_RESULT_OK(translateResult)) {
+            result->ok = false;
+            result->fsr = MMU_TRANSLATE_RESULT_FSR(translateResult);
+            result->faultAddr = addr;
+
+            return false;
+        }
+
+        // tiny pages are the smallest unit of translation
+        const uint32_t chunkSize = 0x0400 - (addr & 0x03ff);
+        if (chunkSize >= size) break;
+
+        addr += chunkSize;
+        size -= chunkSize;
+    }
+
+    return true;
+}
+
 void memcpy_armToArm(uint32_t dest, uint32_t src, uint32_t size, bool privileged,
                      struct ArmMem* mem, struct ArmMmu* mmu, struct MemcpyResult* result) {
-    static uint64_t scratch[512];
+    static thread_local uint64_t scratch[512];
 
     result->ok = true;
 
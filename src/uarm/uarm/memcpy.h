@@ -23,6 +23,10 @@ void memcpy_armToHost(uint8_t* dest, uint32_t src, uint32_t size, bool privilege
 void memcpy_hostToArm(uint32_t dest, uint8_t* src, uint32_t size, bool privileged,
                       struct ArmMem* mem, struct ArmMmu* mmu, struct MemcpyResult* result);
 
+// Checks that the MMU permits accessing the whole range without touching memory
+bool memcpy_probeArm(uint32_t addr, uint32_t size, bool write, bool privileged,
+                     struct ArmMmu* mmu, struct MemcpyResult* result);
+
 void memcpy_armToArm(uint32_t dest, uint32_t src, uint32_t size, bool privileged,
                      struct ArmMem* mem, struct ArmMmu* mmu, struct MemcpyResult* result);
 
@@ -8,6 +8,7 @@
 #include "CPU.h"
 #include "cputil.h"
 #include "mem.h"
+#include "savestate_chunk.h"
 
 enum K9nandState {
     K9nandStateReset,
@@ -493,3 +494,21 @@ struct NAND *nandInit(uint8_t *nandContent, struct Reschedule reschedule, size_t
 
     return nand;
 }
+
+void nandSerialize(struct NAND *nand, struct SavestateChunk *chunk) {
+    uint32_t state = nand->state, area = nand->area;
+
+    savestateChunkDo32(chunk, &state);
+    savestateChunkDo32(chunk, &area);
+    savestateChunkDo8(chunk, &nand->addrBytesRxed);
+    savestateChunkDoBuffer(chunk, nand->addrBytes, sizeof(nand->addrBytes));
+    savestateChunkDo32(chunk, &nand->pageNo);
+    savestateChunkDo32(chunk, &nand->pageOfst);
+    savestateChunkDo32(chunk, &nand->busyCt);
+    savestateChunkDoBuffer(chunk, nand->pageBuf, nand->bytesPerPage);
+
+    if (state > K9nandStateStatusReading || area > K9nandAreaC) savestateChunkNotifyError(chunk);
+
+    nand->state = state;
+    nand->area = area;
+}
@@ -16,6 +16,7 @@ extern "C" {
 #endif
 
 struct NAND;
+struct SavestateChunk;
 
 typedef void (*NandReadyCbk)(void *userData, bool ready);
 
@@ -36,6 +37,9 @@ struct NandSpecs {
 struct NAND *nandInit(uint8_t *nandContent, struct Reschedule reschedule, size_t nandSize,
                       const struct NandSpecs *specs, NandReadyCbk readyCbk, void *readyCbkData);
 
+// Runtime state only, the content is saved separately
+void nandSerialize(struct NAND *nand, struct SavestateChunk *chunk);
+
 void nandSecondReadyCbkSet(struct NAND *nand, NandReadyCbk readyCbk, void *readyCbkData);
 
 bool nandWrite(struct NAND *nand, bool cle, bool ale, uint8_t val);
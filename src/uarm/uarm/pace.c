@@ -1,9 +1,14 @@
 #include "pace.h"
 
+#include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "cputil.h"
+#include "host_page_cache.h"
 #include "mem.h"
 #include "memcpy.h"
+#include "savestate_chunk.h"
 #include "uae/UAE.h"
 #include "uarm_endian.h"
 
@@ -11,86 +16,150 @@
     #include <emscripten.h>
 #endif
 
-static struct ArmMem* mem = NULL;
-static struct ArmMmu* mmu = NULL;
+struct Pace {
+    struct ArmMem* mem;
+    struct ArmMmu* mmu;
+    struct HostPageCache* hostPageCache;
 
-static uint_fast8_t fsr = 0;
-static uint32_t lastAddr = 0;
-static bool wasWrite = false;
+    uint_fast8_t fsr;
+    uint32_t lastAddr;
+    bool wasWrite;
 
-static uint32_t pendingStatus = 0;
-static uint32_t statePtr;
-static bool priviledged = false;
+    uint32_t pendingStatus;
+    uint32_t statePtr;
+    bool priviledged;
 
+    // The 68k registers while the instance is not bound to a thread
+    regstruct regs;
+    struct flag_struct regflags;
+};
+
+// The UAE core keeps the 68k registers in the thread local globals regs and regflags and calls
+// back into the memory accessors below. Every entry point that runs the core binds its instance
+// to the calling thread for the duration of the call.
+static _Thread_local struct Pace* activePace = NULL;
+
+static pthread_once_t staticInitOnce = PTHREAD_ONCE_INIT;
+
+// The opcode table is built once and shared by all instances
 #ifdef __EMSCRIPTEN__
 static cpuop_func* cpufunctbl_base;
 #else
 static cpuop_func* cpufunctbl[65536];  // (normally in newcpu.c)
 #endif
 
-static uint32_t pace_get_le(uint32_t addr, uint8_t size) {
-    if (fsr != 0) return 0;
+static void pacePrvBind(struct Pace* pace) {
+    activePace = pace;
+
+    regs = pace->regs;
+    regflags = pace->regflags;
+}
 
-    lastAddr = addr;
-    wasWrite = false;
+static void pacePrvUnbind(struct Pace* pace) {
+    pace->regs = regs;
+    pace->regflags = regflags;
 
-    MMUTranslateResult translateResult = mmuTranslate(mmu, addr, priviledged, false);
+    activePace = NULL;
+}
+
+// Fast path: pages that have been translated before are accessed through the host page cache
+// of the MMU. The cache is invalidated whenever translations or permissions change.
+static FORCE_INLINE const uint8_t* pace_host_for_read(uint32_t addr) {
+    return activePace->fsr == 0 ? hostPageCacheGetForRead(activePace->hostPageCache, addr,
+                                                          activePace->priviledged)
+                                : NULL;
+}
+
+static FORCE_INLINE uint8_t* pace_host_for_write(uint32_t addr) {
+    return activePace->fsr == 0 ? hostPageCacheGetForWrite(activePace->hostPageCache, addr,
+                                                           activePace->priviledged)
+                                : NULL;
+}
+
+static FORCE_INLINE bool pace_in_page(uint32_t addr, uint8_t size) {
+    return (addr & 0xfff) <= 0x1000u - size;
+}
+
+static bool pace_translate(uint32_t addr, bool write, uint32_t* pa) {
+    activePace->lastAddr = addr;
+    activePace->wasWrite = write;
+
+    MMUTranslateResult translateResult =
+        mmuTranslate(activePace->mmu, addr, activePace->priviledged, write);
 
     if (!MMU_TRANSLATE_RESULT_OK(translateResult)) {
-        fsr = MMU_TRANSLATE_RESULT_FSR(translateResult);
-        return 0;
+        activePace->fsr = MMU_TRANSLATE_RESULT_FSR(translateResult);
+        return false;
     }
 
-    const uint32_t pa = MMU_TRANSLATE_RESULT_PA(translateResult);
+    *pa = MMU_TRANSLATE_RESULT_PA(translateResult);
+
+    hostPageCacheFill(activePace->hostPageCache, activePace->mem, addr, *pa,
+                      MMU_TRANSLATE_RESULT_4K_PAGE(translateResult), write,
+                      activePace->priviledged);
+
+    return true;
+}
+
+static uint32_t pace_get_le(uint32_t addr, uint8_t size) {
+    if (activePace->fsr != 0) return 0;
+
+    uint32_t pa;
+    if (!pace_translate(addr, false, &pa)) return 0;
 
     uint32_t result = 0;
-    bool ok = memAccess(mem, pa, size, false, &result);
+    bool ok = memAccess(activePace->mem, pa, size, false, &result);
 
     if (!ok) {
-        fsr = 10;  // external abort on non-linefetch
+        activePace->fsr = 10;  // external abort on non-linefetch
         return 0;
     }
 
     return result;
 }
 
-uint8_t uae_get8(uint32_t addr) { return pace_get_le(addr, 1); }
+uint8_t uae_get8(uint32_t addr) {
+    const uint8_t* host = pace_host_for_read(addr);
+
+    return host ? *host : pace_get_le(addr, 1);
+}
 
 uint16_t uae_get16(uint32_t addr) {
-    if (!fsr && addr & 0x01) {
-        fsr = 10;
+    if (!activePace->fsr && addr & 0x01) {
+        activePace->fsr = 10;
         return 0;
     }
 
+    const uint8_t* host = pace_host_for_read(addr);
+
+    if (host) {
+        uint16_t value;
+        memcpy(&value, host, 2);
+
+        return be16toh(value);
+    }
+
     return htobe16(pace_get_le(addr, 2));
 }
 
 static uint32_t uae_get32_split(uint32_t addr) {
     if ((addr & 0x3ff) <= (0x3ff - 4)) {
-        if (fsr != 0) return 0;
-
-        lastAddr = addr;
-        wasWrite = false;
-
-        MMUTranslateResult translateResult = mmuTranslate(mmu, addr, priviledged, false);
+        if (activePace->fsr != 0) return 0;
 
-        if (!MMU_TRANSLATE_RESULT_OK(translateResult)) {
-            fsr = MMU_TRANSLATE_RESULT_FSR(translateResult);
-            return 0;
-        }
+        uint32_t pa;
+        if (!pace_translate(addr, false, &pa)) return 0;
 
-        const uint32_t pa = MMU_TRANSLATE_RESULT_PA(translateResult);
         uint32_t val_le;
 
-        if (!memAccess(mem, pa, 2, false, &val_le)) {
-            fsr = 10;
+        if (!memAccess(activePace->mem, pa, 2, false, &val_le)) {
+            activePace->fsr = 10;
             return 0;
         }
 
-        lastAddr += 2;
+        activePace->lastAddr += 2;
 
-        if (!memAccess(mem, pa + 2, 2, false, (uint8_t*)(&val_le) + 2)) {
-            fsr = 10;
+        if (!memAccess(activePace->mem, pa + 2, 2, false, (uint8_t*)(&val_le) + 2)) {
+            activePace->fsr = 10;
             return 0;
         }
 
@@ -101,50 +170,62 @@ static uint32_t uae_get32_split(uint32_t addr) {
 }
 
 uint32_t uae_get32(uint32_t addr) {
-    switch (__builtin_ctz(addr)) {
-        case 0:
-            fsr = 1;
-            lastAddr = addr;
-            wasWrite = false;
-            return 0;
+    if (addr & 0x01) {
+        activePace->fsr = 1;
+        activePace->lastAddr = addr;
+        activePace->wasWrite = false;
+        return 0;
+    }
+
+    // Word aligned accesses are done in one go if they do not cross a page
+    const uint8_t* host = pace_in_page(addr, 4) ? pace_host_for_read(addr) : NULL;
 
-        case 1:
-            return uae_get32_split(addr);
+    if (host) {
+        uint32_t value;
+        memcpy(&value, host, 4);
 
-        default:
-            return htobe32(pace_get_le(addr, 4));
+        return be32toh(value);
     }
+
+    return (addr & 0x02) ? uae_get32_split(addr) : htobe32(pace_get_le(addr, 4));
 }
 
 static void pace_put_le(uint32_t addr, uint32_t value, uint8_t size) {
-    if (fsr != 0) return;
-
-    lastAddr = addr;
-    wasWrite = true;
+    if (activePace->fsr != 0) return;
 
     // fprintf(stderr, "%u byte write %#010x to %#010x\n", (uint32_t)size, value, addr);
 
-    MMUTranslateResult translateResult = mmuTranslate(mmu, addr, priviledged, true);
+    uint32_t pa;
+    if (!pace_translate(addr, true, &pa)) return;
 
-    if (!MMU_TRANSLATE_RESULT_OK(translateResult)) {
-        fsr = MMU_TRANSLATE_RESULT_FSR(translateResult);
-        return;
-    }
-
-    uint32_t pa = MMU_TRANSLATE_RESULT_PA(translateResult);
-
-    bool ok = memAccess(mem, pa, size, true, &value);
+    bool ok = memAccess(activePace->mem, pa, size, true, &value);
 
     if (!ok) {
-        fsr = 10;  // external abort on non-linefetch
+        activePace->fsr = 10;  // external abort on non-linefetch
     }
 }
 
-void uae_put8(uint32_t addr, uint8_t value) { pace_put_le(addr, value, 1); };
+void uae_put8(uint32_t addr, uint8_t value) {
+    uint8_t* host = pace_host_for_write(addr);
+
+    if (host)
+        *host = value;
+    else
+        pace_put_le(addr, value, 1);
+};
 
 void uae_put16(uint32_t addr, uint16_t value) {
-    if (!fsr && addr & 0x01) {
-        fsr = 1;
+    if (!activePace->fsr && addr & 0x01) {
+        activePace->fsr = 1;
+        return;
+    }
+
+    uint8_t* host = pace_host_for_write(addr);
+
+    if (host) {
+        value = htobe16(value);
+        memcpy(host, &value, 2);
+
         return;
     }
 
@@ -155,28 +236,20 @@ static void uae_put32_split(uint32_t addr, uint32_t value) {
     value = htobe32(value);
 
     if ((addr & 0x3ff) <= (0x3ff - 4)) {
-        if (fsr != 0) return;
-
-        lastAddr = addr;
-        wasWrite = true;
+        if (activePace->fsr != 0) return;
 
-        MMUTranslateResult translateResult = mmuTranslate(mmu, addr, priviledged, false);
+        uint32_t pa;
+        if (!pace_translate(addr, true, &pa)) return;
 
-        if (!MMU_TRANSLATE_RESULT_OK(translateResult)) {
-            fsr = MMU_TRANSLATE_RESULT_FSR(translateResult);
+        if (!memAccess(activePace->mem, pa, 2, true, &value)) {
+            activePace->fsr = 10;
             return;
         }
 
-        const uint32_t pa = MMU_TRANSLATE_RESULT_PA(translateResult);
+        activePace->lastAddr += 2;
 
-        if (!memAccess(mem, pa, 2, true, &value)) {
-            fsr = 10;
-            return;
-        }
-
-        lastAddr += 2;
-
-        if (!memAccess(mem, pa + 2, 2, true, (uint8_t*)(&value) + 2)) fsr = 10;
+        if (!memAccess(activePace->mem, pa + 2, 2, true, (uint8_t*)(&value) + 2))
+            activePace->fsr = 10;
     } else {
         pace_put_le(addr, value, 2);
         pace_put_le(addr + 2, value >> 16, 2);
@@ -184,62 +257,65 @@ static void uae_put32_split(uint32_t addr, uint32_t value) {
 }
 
 void uae_put32(uint32_t addr, uint32_t value) {
-    switch (__builtin_ctz(addr)) {
-        case 0:
-            fsr = 1;
-            lastAddr = addr;
-            wasWrite = true;
-            break;
-
-        case 1:
-            uae_put32_split(addr, value);
-            break;
-
-        default:
-            pace_put_le(addr, be32toh(value), 4);
-            break;
+    if (addr & 0x01) {
+        activePace->fsr = 1;
+        activePace->lastAddr = addr;
+        activePace->wasWrite = true;
+        return;
     }
+
+    // The second lookup marks the upper half dirty if the access straddles two dirty pages
+    uint8_t* host = pace_in_page(addr, 4) ? pace_host_for_write(addr) : NULL;
+
+    if (host && ((addr & 0x02) == 0 || pace_host_for_write(addr + 2))) {
+        value = htobe32(value);
+        memcpy(host, &value, 4);
+
+        return;
+    }
+
+    if (addr & 0x02)
+        uae_put32_split(addr, value);
+    else
+        pace_put_le(addr, be32toh(value), 4);
 }
 
 void Exception(int exception, uaecptr lastPc) {
-    pendingStatus = exception;
+    activePace->pendingStatus = exception;
     if (exception == pace_status_syscall) regs.pc += 2;
 }
 
 unsigned long op_unimplemented(uint32_t opcode) REGPARAM {
-    pendingStatus = pace_status_unimplemented_instr;
+    activePace->pendingStatus = pace_status_unimplemented_instr;
     regs.pc += 2;
 
     return 0;
 }
 
 unsigned long op_illg(uint32_t opcode) REGPARAM {
-    pendingStatus = pace_status_illegal_instr;
+    activePace->pendingStatus = pace_status_illegal_instr;
     regs.pc += 2;
 
     return 0;
 }
 
 unsigned long op_line1111(uint32_t opcode) REGPARAM {
-    pendingStatus = pace_status_line_1111;
+    activePace->pendingStatus = pace_status_line_1111;
     regs.pc += 2;
 
     return 0;
 }
 
 unsigned long op_line1010(uint32_t opcode) REGPARAM {
-    pendingStatus = pace_status_line_1010;
+    activePace->pendingStatus = pace_status_line_1010;
     regs.pc += 2;
 
     return 0;
 }
 
-void notifiyReturn() { pendingStatus = pace_status_return; }
+void notifiyReturn() { activePace->pendingStatus = pace_status_return; }
 
 static void staticInit() {
-    static bool initialized = false;
-    if (initialized) return;
-
     int i, j;
     for (i = 0; i < 256; i++) {
         for (j = 0; j < 8; j++) {
@@ -314,37 +390,48 @@ static void staticInit() {
 
     // (hey readcpu doesn't free this guy!)
     free(table68k);
-
-    initialized = true;
 }
 
-void paceInit(struct ArmMem* _mem, struct ArmMmu* _mmu) {
-    staticInit();
+struct Pace* paceInit(struct ArmMem* mem, struct ArmMmu* mmu) {
+    pthread_once(&staticInitOnce, staticInit);
+
+    struct Pace* pace = (struct Pace*)malloc(sizeof(*pace));
+    if (!pace) ERR("cannot alloc PACE");
+
+    memset(pace, 0, sizeof(*pace));
 
-    mem = _mem;
-    mmu = _mmu;
+    pace->mem = mem;
+    pace->mmu = mmu;
+    pace->hostPageCache = mmuGetHostPageCache(mmu);
+
+    return pace;
 }
 
-void paceSetStatePtr(uint32_t addr) { statePtr = addr; }
+void paceSetStatePtr(struct Pace* pace, uint32_t addr) { pace->statePtr = addr; }
+
+uint8_t paceGetFsr(struct Pace* pace) { return pace->fsr; }
 
-uint8_t paceGetFsr() { return fsr; }
+uint16_t paceGetLastOpcode(struct Pace* pace) { return pace->regs.lastOpcode; }
 
-uint16_t paceGetLastOpcode() { return regs.lastOpcode; }
+bool paceLoad68kState(struct Pace* pace) {
+    uint32_t stateScratchBuffer[19];
 
-bool paceLoad68kState() {
-    static uint32_t stateScratchBuffer[19];
+    pacePrvBind(pace);
 
     uint8_t* state = (sizeof(struct regstruct) == sizeof(stateScratchBuffer))
                          ? (uint8_t*)&regs
                          : (uint8_t*)stateScratchBuffer;
 
     struct MemcpyResult result;
-    memcpy_armToHost(state, statePtr, sizeof(stateScratchBuffer), priviledged, mem, mmu, &result);
+    memcpy_armToHost(state, pace->statePtr, sizeof(stateScratchBuffer), pace->priviledged,
+                     pace->mem, pace->mmu, &result);
 
     if (!result.ok) {
-        lastAddr = result.faultAddr;
-        fsr = result.fsr;
-        wasWrite = result.wasWrite;
+        pace->lastAddr = result.faultAddr;
+        pace->fsr = result.fsr;
+        pace->wasWrite = result.wasWrite;
+
+        pacePrvUnbind(pace);
 
         return false;
     }
@@ -358,13 +445,17 @@ bool paceLoad68kState() {
 
     MakeFromSR();
 
+    pacePrvUnbind(pace);
+
     return true;
 }
 
-bool paceSave68kState() {
-    static uint32_t stateScratchBuffer[19];
+bool paceSave68kState(struct Pace* pace) {
+    uint32_t stateScratchBuffer[19];
     uint8_t* state;
 
+    pacePrvBind(pace);
+
     MakeSR();
 
     if (sizeof(struct regstruct) != sizeof(stateScratchBuffer)) {
@@ -381,12 +472,15 @@ bool paceSave68kState() {
     }
 
     struct MemcpyResult result;
-    memcpy_hostToArm(statePtr, state, sizeof(stateScratchBuffer), priviledged, mem, mmu, &result);
+    memcpy_hostToArm(pace->statePtr, state, sizeof(stateScratchBuffer), pace->priviledged,
+                     pace->mem, pace->mmu, &result);
+
+    pacePrvUnbind(pace);
 
     if (!result.ok) {
-        lastAddr = result.faultAddr;
-        fsr = result.fsr;
-        wasWrite = result.wasWrite;
+        pace->lastAddr = result.faultAddr;
+        pace->fsr = result.fsr;
+        pace->wasWrite = result.wasWrite;
 
         return false;
     }
@@ -394,29 +488,44 @@ bool paceSave68kState() {
     return true;
 }
 
-void paceGetMemeryFault(uint32_t* _addr, bool* _wasWrite, uint_fast8_t* _fsr) {
-    *_addr = lastAddr;
-    *_wasWrite = wasWrite;
-    *_fsr = fsr;
+void paceGetMemeryFault(struct Pace* pace, uint32_t* addr, bool* wasWrite, uint_fast8_t* fsr) {
+    *addr = pace->lastAddr;
+    *wasWrite = pace->wasWrite;
+    *fsr = pace->fsr;
 }
 
-uint16_t paceReadTrapWord() {
-    fsr = 0;
-    return uae_get16(regs.pc - 2);
+uint16_t paceReadTrapWord(struct Pace* pace) {
+    pace->fsr = 0;
+
+    pacePrvBind(pace);
+    const uint16_t trapWord = uae_get16(regs.pc - 2);
+    pacePrvUnbind(pace);
+
+    return trapWord;
 }
 
-void paceSetPriviledged(bool _priviledged) { priviledged = _priviledged; }
+void paceSetPriviledged(struct Pace* pace, bool priviledged) { pace->priviledged = priviledged; }
 
-enum paceStatus paceExecute() {
-    fsr = 0;
-    pendingStatus = pace_status_ok;
+void paceSerialize(struct Pace* pace, struct SavestateChunk* chunk) {
+    pacePrvBind(pace);
 
-    uint16_t opcode = uae_get16(regs.pc);
-    regs.lastOpcode = opcode;
+    MakeSR();
+
+    savestateChunkDo32(chunk, &pace->statePtr);
+    savestateChunkDoBool(chunk, &pace->priviledged);
+
+    savestateChunkDo32(chunk, &regs.lastOpcode);
+    for (size_t i = 0; i < 16; i++) savestateChunkDo32(chunk, regs.regs + i);
+    savestateChunkDo32(chunk, &regs.pc);
+    savestateChunkDo16(chunk, &regs.sr);
 
-    if (fsr != 0) return pace_status_memory_fault;
+    if (savestateChunkIsLoading(chunk)) MakeFromSR();
 
-        // fprintf(stderr, "execute m68k opcode %#06x at %#010x\n", opcode, regs.pc);
+    pacePrvUnbind(pace);
+}
+
+static FORCE_INLINE void pacePrvDispatch(uint16_t opcode) {
+    // fprintf(stderr, "execute m68k opcode %#06x at %#010x\n", opcode, regs.pc);
 
 #ifdef __EMSCRIPTEN__
     ((cpuop_func*)((long)cpufunctbl_base + opcode))(opcode);
@@ -426,6 +535,36 @@ enum paceStatus paceExecute() {
 
     //    fprintf(stderr, "a7 now %#010x, top of stack is %#010x\n", m68k_areg(regs, 7),
     //            uae_get32(m68k_areg(regs, 7)));
+}
+
+enum paceStatus paceExecuteBatch(struct Pace* pace, uint32_t maxInstructions,
+                                 const uint16_t* breakCondition, uint32_t* executed) {
+    // Both are only ever set by a failing instruction, and that instruction ends the batch
+    pace->fsr = 0;
+    pace->pendingStatus = pace_status_ok;
+
+    pacePrvBind(pace);
+
+    uint32_t i = 0;
+
+    while (i < maxInstructions) {
+        *executed = i;
+
+        const uint16_t opcode = uae_get16(regs.pc);
+        regs.lastOpcode = opcode;
+        i++;
+
+        if (pace->fsr != 0) break;
+
+        pacePrvDispatch(opcode);
+
+        if (pace->fsr != 0 || pace->pendingStatus != pace_status_ok) break;
+        if (breakCondition && *breakCondition) break;
+    }
+
+    pacePrvUnbind(pace);
+
+    *executed = i;
 
-    return fsr == 0 ? pendingStatus : pace_status_memory_fault;
+    return pace->fsr == 0 ? pace->pendingStatus : pace_status_memory_fault;
 }
@@ -11,6 +11,9 @@
 extern "C" {
 #endif
 
+struct Pace;
+struct SavestateChunk;
+
 enum paceStatus {
     pace_status_ok = 0,
     pace_status_illegal_instr = 4,
@@ -26,21 +29,30 @@ enum paceStatus {
     pace_status_return = 50,
 };
 
-void paceInit(struct ArmMem* mem, struct ArmMmu* mmu);
+// Each instance carries the 68k state of one emulator. The generated UAE core works on thread local
+// registers, so an instance may be used from any thread, but only from one thread at a time.
+struct Pace* paceInit(struct ArmMem* mem, struct ArmMmu* mmu);
+
+void paceSetStatePtr(struct Pace* pace, uint32_t addr);
+uint8_t paceGetFsr(struct Pace* pace);
+uint16_t paceGetLastOpcode(struct Pace* pace);
 
-void paceSetStatePtr(uint32_t addr);
-uint8_t paceGetFsr();
-uint16_t paceGetLastOpcode();
+void paceSetPriviledged(struct Pace* pace, bool priviledged);
 
-void paceSetPriviledged(bool priviledged);
+void paceSerialize(struct Pace* pace, struct SavestateChunk* chunk);
 
-bool paceLoad68kState();
-bool paceSave68kState();
+bool paceLoad68kState(struct Pace* pace);
+bool paceSave68kState(struct Pace* pace);
 
-void paceGetMemeryFault(uint32_t* addr, bool* wasWrite, uint_fast8_t* fsr);
-uint16_t paceReadTrapWord();
+void paceGetMemeryFault(struct Pace* pace, uint32_t* addr, bool* wasWrite, uint_fast8_t* fsr);
+uint16_t paceReadTrapWord(struct Pace* pace);
 
-enum paceStatus paceExecute();
+// Executes up to maxInstructions 68k instructions. The batch ends early on the first instruction
+// that does not complete with pace_status_ok, or once *breakCondition (if not NULL) becomes
+// nonzero. executed receives the number of instructions that were attempted; while the batch runs,
+// it holds the number of instructions completed so far.
+enum paceStatus paceExecuteBatch(struct Pace* pace, uint32_t maxInstructions,
+                                 const uint16_t* breakCondition, uint32_t* executed);
 
 #ifdef __cplusplus
 }
@@ -5,9 +5,15 @@
 #include <string.h>
 
 #include "cputil.h"
+#include "savestate_chunk.h"
 #include "syscall.h"
+#include "syscall_trace.h"
 
 #define MAX_PENDING_TAILPATCH 32
+#define MAX_PENDING_RETURNS 64
+#define TRACE_CAPACITY 65536
+// Calls whose stack pointers are this close are assumed to run on the same stack
+#define TRACE_STACK_WINDOW 0x10000
 #define MAX_PATCHES 50
 #define PATCH_TABLE_SIZE 0xc00  // 3 * 0x400
 
@@ -17,6 +23,10 @@ struct Patch {
     void* ctx;
     HeadpatchF headpatch;
     TailpatchF tailpatch;
+    ReplacementF replacement;
+
+    uint64_t replacedCalls;
+    uint64_t replacementNsec;
 };
 
 struct PendingTailpatch {
@@ -26,6 +36,16 @@ struct PendingTailpatch {
     const struct Patch* patch;
 };
 
+struct PendingReturn {
+    uint32_t syscall;
+    uint32_t returnAddress;
+    uint32_t sp;
+    uint8_t depth;
+
+    uint64_t startCycles;
+    uint64_t startNsec;
+};
+
 struct PatchDispatch {
     int8_t table;
     uint8_t countdown;
@@ -37,8 +57,30 @@ struct PatchDispatch {
 
     struct PendingTailpatch pendingTailpatches[MAX_PENDING_TAILPATCH];
     size_t nPendingTailpatches;
+
+    struct PatchGuestMemory guestMemory;
+
+    uint64_t calls[PATCH_TABLE_SIZE];
+
+    bool tracing;
+    struct SyscallTrace* trace;
+    PatchDispatchClockF clock;
+    void* clockCtx;
+
+    struct PendingReturn pendingReturns[MAX_PENDING_RETURNS];
+    size_t nPendingReturns;
 };
 
+struct SyscallStatistics {
+    uint32_t syscall;
+    uint64_t calls;
+    const struct Patch* patch;
+};
+
+static uint32_t patchDispatchPrvKeyToSyscall(uint32_t key) {
+    return packSyscall((((key >> 10) + 1) << 2), ((key & 0x3ff) << 2));
+}
+
 struct PatchDispatch* initPatchDispatch() {
     struct PatchDispatch* pd = malloc(sizeof(*pd));
 
@@ -50,7 +92,16 @@ struct PatchDispatch* initPatchDispatch() {
     return pd;
 }
 
-void destroyPatchDispatch(struct PatchDispatch* pd) { free(pd); }
+void destroyPatchDispatch(struct PatchDispatch* pd) {
+    if (pd->trace) syscallTraceDestroy(pd->trace);
+
+    free(pd);
+}
+
+void patchDispatchSetGuestMemory(struct PatchDispatch* pd, struct ArmMem* mem, struct ArmMmu* mmu) {
+    pd->guestMemory.mem = mem;
+    pd->guestMemory.mmu = mmu;
+}
 
 void patchDispatchOnLoadR12FromR9(struct PatchDispatch* pd, int32_t offset) {
     pd->table = -1;
@@ -65,8 +116,90 @@ void patchDispatchOnLoadR12FromR9(struct PatchDispatch* pd, int32_t offset) {
     pd->countdown = 2;
 }
 
-void patchDispatchOnLoadPcFromR12(struct PatchDispatch* pd, int32_t offset, uint32_t* registers) {
-    if (pd->countdown != 1 || offset < 0 || offset & 0x03 || offset > 0xfff) return;
+void patchDispatchSetClock(struct PatchDispatch* pd, PatchDispatchClockF clock, void* ctx) {
+    pd->clock = clock;
+    pd->clockCtx = ctx;
+}
+
+void patchDispatchSetTracing(struct PatchDispatch* pd, bool tracing) {
+    if (tracing && !pd->trace) pd->trace = syscallTraceInit(TRACE_CAPACITY);
+
+    pd->tracing = tracing && pd->clock;
+    pd->nPendingReturns = 0;
+}
+
+bool patchDispatchGetTracing(struct PatchDispatch* pd) { return pd->tracing; }
+
+struct SyscallTrace* patchDispatchGetTrace(struct PatchDispatch* pd) { return pd->trace; }
+
+static bool patchDispatchPrvSameStack(uint32_t sp1, uint32_t sp2) {
+    return (sp1 > sp2 ? sp1 - sp2 : sp2 - sp1) < TRACE_STACK_WINDOW;
+}
+
+static void patchDispatchPrvTraceCall(struct PatchDispatch* pd, uint32_t syscall,
+                                      const uint32_t* registers) {
+    // Calls that never return (exceptions, resets) are dropped once the ring is full
+    if (pd->nPendingReturns == MAX_PENDING_RETURNS) {
+        memmove(pd->pendingReturns, pd->pendingReturns + 1,
+                (MAX_PENDING_RETURNS - 1) * sizeof(*pd->pendingReturns));
+        pd->nPendingReturns--;
+    }
+
+    struct PendingReturn* pendingReturn = &pd->pendingReturns[pd->nPendingReturns++];
+
+    pendingReturn->syscall = syscall;
+    pendingReturn->returnAddress = registers[14] & ~0x01;
+    pendingReturn->sp = registers[13];
+    pendingReturn->depth = 0;
+
+    for (size_t i = 0; i < pd->nPendingReturns - 1; i++)
+        if (pd->pendingReturns[i].sp >= registers[13] &&
+            patchDispatchPrvSameStack(pd->pendingReturns[i].sp, registers[13]) &&
+            pendingReturn->depth < 0xff)
+            pendingReturn->depth++;
+
+    pd->clock(pd->clockCtx, &pendingReturn->startCycles, &pendingReturn->startNsec);
+}
+
+static void patchDispatchPrvTraceReturns(struct PatchDispatch* pd, const uint32_t* registers) {
+    for (size_t i = pd->nPendingReturns; i > 0; i--) {
+        const struct PendingReturn* pendingReturn = &pd->pendingReturns[i - 1];
+
+        if (pendingReturn->returnAddress != registers[15] || pendingReturn->sp != registers[13])
+            continue;
+
+        struct SyscallTraceEvent event = {.syscall = pendingReturn->syscall,
+                                          .stack = pendingReturn->sp & ~(TRACE_STACK_WINDOW - 1),
+                                          .depth = pendingReturn->depth,
+                                          .startNsec = pendingReturn->startNsec};
+        uint64_t cycles, nsec;
+
+        pd->clock(pd->clockCtx, &cycles, &nsec);
+        event.cycles = cycles - pendingReturn->startCycles;
+        event.durationNsec = nsec - pendingReturn->startNsec;
+
+        syscallTraceRecord(pd->trace, &event);
+
+        // Deeper calls on the same stack have been unwound without returning
+        size_t retained = 0;
+        for (size_t j = 0; j < pd->nPendingReturns; j++) {
+            const struct PendingReturn* candidate = &pd->pendingReturns[j];
+
+            if (j == i - 1 || (candidate->sp < registers[13] &&
+                               patchDispatchPrvSameStack(candidate->sp, registers[13])))
+                continue;
+
+            pd->pendingReturns[retained++] = *candidate;
+        }
+
+        pd->nPendingReturns = retained;
+        return;
+    }
+}
+
+bool patchDispatchOnLoadPcFromR12(struct PatchDispatch* pd, int32_t offset, uint32_t* registers,
+                                  bool privileged) {
+    if (pd->countdown != 1 || offset < 0 || offset & 0x03 || offset > 0xfff) return false;
 
 #ifdef TRACE_SYSCALLS
     const char* syscallName = getSyscallName(packSyscall(pd->table, offset));
@@ -76,16 +209,33 @@ void patchDispatchOnLoadPcFromR12(struct PatchDispatch* pd, int32_t offset, uint
 
     const uint32_t key = (((pd->table >> 2) - 1) << 10) | (offset >> 2);
     const uint8_t patchIdx = pd->patchTable[key];
-    if (patchIdx == 0xff) return;
+    pd->calls[key]++;
 
-    const struct Patch* patch = &pd->patches[patchIdx];
+    if (pd->tracing) patchDispatchPrvTraceCall(pd, packSyscall(pd->table, offset), registers);
+
+    if (patchIdx == 0xff) return false;
+
+    struct Patch* patch = &pd->patches[patchIdx];
+
+    if (patch->replacement) {
+        const uint64_t start = timestampNsec();
+
+        pd->guestMemory.privileged = privileged;
+        if (!patch->replacement(patch->ctx, patch->syscall, registers, &pd->guestMemory))
+            return false;
+
+        patch->replacementNsec += timestampNsec() - start;
+        patch->replacedCalls++;
+
+        return true;
+    }
 
     if (patch->headpatch) patch->headpatch(patch->ctx, patch->syscall, registers);
     if (patch->tailpatch) {
         if (pd->nPendingTailpatches == MAX_PENDING_TAILPATCH) {
             fprintf(stderr, "too many pending tailpatches, skipping tailpatch for %#10x\n",
                     packSyscall(pd->table, offset));
-            return;
+            return false;
         }
 
         uint8_t tailpatchIdx = pd->nPendingTailpatches++;
@@ -96,11 +246,14 @@ void patchDispatchOnLoadPcFromR12(struct PatchDispatch* pd, int32_t offset, uint
         memcpy(tailpatch->registersAtInvocation, registers,
                sizeof(tailpatch->registersAtInvocation));
     }
+
+    return false;
 }
 
-void patchOnBeforeExecute(struct PatchDispatch* pd, uint32_t* registers) {
+bool patchOnBeforeExecute(struct PatchDispatch* pd, uint32_t* registers) {
     if (pd->countdown != 0) pd->countdown--;
-    if (pd->nPendingTailpatches == 0) return;
+    if (pd->nPendingReturns != 0) patchDispatchPrvTraceReturns(pd, registers);
+    if (pd->nPendingTailpatches == 0) return pd->countdown != 0;
 
     for (size_t i = 0; i < pd->nPendingTailpatches; i++) {
         const struct PendingTailpatch* pendingTailpatch = &pd->pendingTailpatches[i];
@@ -119,6 +272,8 @@ void patchOnBeforeExecute(struct PatchDispatch* pd, uint32_t* registers) {
 
         pd->nPendingTailpatches--;
     }
+
+    return pd->countdown != 0;
 }
 
 void patchDispatchAddPatch(struct PatchDispatch* pd, uint32_t syscall, HeadpatchF headpatch,
@@ -142,4 +297,109 @@ void patchDispatchAddPatch(struct PatchDispatch* pd, uint32_t syscall, Headpatch
     patch->ctx = ctx;
     patch->headpatch = headpatch;
     patch->tailpatch = tailpatch;
+    patch->replacement = NULL;
+}
+
+void patchDispatchAddReplacement(struct PatchDispatch* pd, uint32_t syscall,
+                                 ReplacementF replacement, void* ctx) {
+    patchDispatchAddPatch(pd, syscall, NULL, NULL, ctx);
+
+    const uint32_t key = (((syscall >> 14) - 1) << 10) | ((syscall & 0xfff) >> 2);
+    if (key < PATCH_TABLE_SIZE) pd->patches[pd->patchTable[key]].replacement = replacement;
+}
+
+static int patchDispatchPrvCompareStatistics(const void* a, const void* b) {
+    const struct SyscallStatistics* sa = a;
+    const struct SyscallStatistics* sb = b;
+
+    if (sa->calls == sb->calls) return sa->syscall < sb->syscall ? -1 : 1;
+
+    return sa->calls > sb->calls ? -1 : 1;
+}
+
+void patchDispatchPrintStatistics(struct PatchDispatch* pd, FILE* stream, size_t maxEntries) {
+    struct SyscallStatistics* sorted = malloc(PATCH_TABLE_SIZE * sizeof(*sorted));
+    if (!sorted) ERR("unable to allocate syscall statistics\n");
+
+    size_t count = 0;
+    uint64_t total = 0;
+
+    for (uint32_t key = 0; key < PATCH_TABLE_SIZE; key++) {
+        if (!pd->calls[key]) continue;
+
+        sorted[count].syscall = patchDispatchPrvKeyToSyscall(key);
+        sorted[count].calls = pd->calls[key];
+        sorted[count].patch =
+            pd->patchTable[key] == 0xff ? NULL : &pd->patches[pd->patchTable[key]];
+
+        total += sorted[count++].calls;
+    }
+
+    qsort(sorted, count, sizeof(*sorted), patchDispatchPrvCompareStatistics);
+
+    fprintf(stream, "syscalls: %llu total\n", (unsigned long long)total);
+    fprintf(stream, "%-32s %12s %8s %12s %10s\n", "syscall", "calls", "%", "replaced",
+            "nsec/call");
+
+    for (size_t i = 0; i < count && i < maxEntries; i++) {
+        const char* name = getSyscallName(sorted[i].syscall);
+        const struct Patch* patch = sorted[i].patch;
+
+        fprintf(stream, "%-32s %12llu %8.2f", name ? name : "[unknown]",
+                (unsigned long long)sorted[i].calls, 100. * sorted[i].calls / total);
+
+        if (patch && patch->replacement)
+            fprintf(stream, " %12llu %10.1f\n", (unsigned long long)patch->replacedCalls,
+                    patch->replacedCalls ? (double)patch->replacementNsec / patch->replacedCalls
+                                         : 0.);
+        else
+            fprintf(stream, " %12s %10s\n", "-", "-");
+    }
+
+    free(sorted);
+}
+
+void patchDispatchResetStatistics(struct PatchDispatch* pd) {
+    memset(pd->calls, 0, sizeof(pd->calls));
+
+    for (size_t i = 0; i < pd->nPatches; i++) {
+        pd->patches[i].replacedCalls = 0;
+        pd->patches[i].replacementNsec = 0;
+    }
+}
+
+void patchDispatchSerialize(struct PatchDispatch* pd, struct SavestateChunk* chunk) {
+    uint8_t table = pd->table;
+    uint32_t nPendingTailpatches = pd->nPendingTailpatches;
+
+    savestateChunkDo8(chunk, &table);
+    savestateChunkDo8(chunk, &pd->countdown);
+    savestateChunkDo32(chunk, &nPendingTailpatches);
+
+    if (nPendingTailpatches > MAX_PENDING_TAILPATCH) {
+        savestateChunkNotifyError(chunk);
+        return;
+    }
+
+    // Pending tailpatches refer to patches by index; patches are registered during setup, so
+    // the indices are stable.
+    for (size_t i = 0; i < nPendingTailpatches; i++) {
+        struct PendingTailpatch* tailpatch = &pd->pendingTailpatches[i];
+        uint32_t patchIdx = tailpatch->patch ? tailpatch->patch - pd->patches : 0;
+
+        for (size_t j = 0; j < 16; j++)
+            savestateChunkDo32(chunk, tailpatch->registersAtInvocation + j);
+        savestateChunkDo32(chunk, &tailpatch->returnAddress);
+        savestateChunkDo32(chunk, &patchIdx);
+
+        if (patchIdx >= pd->nPatches) {
+            savestateChunkNotifyError(chunk);
+            return;
+        }
+
+        tailpatch->patch = &pd->patches[patchIdx];
+    }
+
+    pd->table = table;
+    pd->nPendingTailpatches = nPendingTailpatches;
 }
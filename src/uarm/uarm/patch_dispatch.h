@@ -1,7 +1,10 @@
 #ifndef _PATCH_DISPATCH_H_
 #define _PATCH_DISPATCH_H_
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include "CPU.h"
 
@@ -9,22 +12,65 @@
 extern "C" {
 #endif
 
+struct ArmMem;
+struct ArmMmu;
+
+struct PatchGuestMemory {
+    struct ArmMem* mem;
+    struct ArmMmu* mmu;
+    bool privileged;
+};
+
 typedef void (*HeadpatchF)(void* ctx, uint32_t syscall, uint32_t* registers);
 typedef void (*TailpatchF)(void* ctx, uint32_t syscall, const uint32_t* registersAtinvocation,
                            uint32_t* registers);
 
+// Runs natively instead of the syscall, with the result in registers[0]. Returning false falls
+// back to the guest implementation, so guest memory must not be modified before the replacement
+// knows that it can complete.
+typedef bool (*ReplacementF)(void* ctx, uint32_t syscall, uint32_t* registers,
+                             const struct PatchGuestMemory* memory);
+
+// Reports the emulated cycles and nanoseconds that have elapsed since the start of the session
+typedef void (*PatchDispatchClockF)(void* ctx, uint64_t* cycles, uint64_t* nsec);
+
 struct PatchDispatch;
+struct SavestateChunk;
+struct SyscallTrace;
 
 struct PatchDispatch* initPatchDispatch();
+
+void patchDispatchSerialize(struct PatchDispatch* pd, struct SavestateChunk* chunk);
+
 void destroyPatchDispatch(struct PatchDispatch* pd);
 
+void patchDispatchSetGuestMemory(struct PatchDispatch* pd, struct ArmMem* mem, struct ArmMmu* mmu);
+
 void patchDispatchOnLoadR12FromR9(struct PatchDispatch* pd, int32_t offset);
-void patchDispatchOnLoadPcFromR12(struct PatchDispatch* pd, int32_t offset, uint32_t* registers);
-void patchOnBeforeExecute(struct PatchDispatch* pd, uint32_t* registers);
+// Returns true if the syscall has been replaced and the CPU should return to LR
+bool patchDispatchOnLoadPcFromR12(struct PatchDispatch* pd, int32_t offset, uint32_t* registers,
+                                  bool privileged);
+// Returns true if the dispatcher needs to observe the next instruction
+bool patchOnBeforeExecute(struct PatchDispatch* pd, uint32_t* registers);
 
 void patchDispatchAddPatch(struct PatchDispatch* pd, uint32_t syscall, HeadpatchF headpatch,
                            TailpatchF tailpatch, void* ctx);
 
+void patchDispatchAddReplacement(struct PatchDispatch* pd, uint32_t syscall,
+                                 ReplacementF replacement, void* ctx);
+
+void patchDispatchSetClock(struct PatchDispatch* pd, PatchDispatchClockF clock, void* ctx);
+
+// While tracing, every call is followed until it returns to its caller and then recorded in the
+// trace. The trace is created on first use and kept when tracing stops. Requires a clock.
+void patchDispatchSetTracing(struct PatchDispatch* pd, bool tracing);
+bool patchDispatchGetTracing(struct PatchDispatch* pd);
+struct SyscallTrace* patchDispatchGetTrace(struct PatchDispatch* pd);
+
+// Per syscall call counts and the host time spent in replacements, sorted by calls
+void patchDispatchPrintStatistics(struct PatchDispatch* pd, FILE* stream, size_t maxEntries);
+void patchDispatchResetStatistics(struct PatchDispatch* pd);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,9 +1,16 @@
 #include "patches.h"
 
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
+#include "memcpy.h"
 #include "syscall.h"
 
+#define SCRATCH_SIZE 1024
+// Longer strings are left to the guest
+#define MAX_STRING_LENGTH 0xffff
+
 static void tailpatch_UIInitialize(void* ctx, uint32_t syscall,
                                    const uint32_t* registersAtinvocation, uint32_t* registers) {
     fprintf(stderr, "UI initialized\n");
@@ -16,10 +23,141 @@ static void headpatch_SysSetAutoOffTime(void* ctx, uint32_t syscall, uint32_t* r
     registers[0] = 0;
 }
 
+static bool patchesPrvStrLen(const struct PatchGuestMemory* memory, uint32_t str, uint32_t* len) {
+    uint8_t scratch[SCRATCH_SIZE];
+    struct MemcpyResult result;
+
+    *len = 0;
+
+    while (*len <= MAX_STRING_LENGTH) {
+        // don't read beyond the end of the current tiny page, it may not be mapped
+        const uint32_t chunkSize = SCRATCH_SIZE - (str & (SCRATCH_SIZE - 1));
+
+        memcpy_armToHost(scratch, str, chunkSize, memory->privileged, memory->mem, memory->mmu,
+                         &result);
+        if (!result.ok) return false;
+
+        const uint8_t* terminator = memchr(scratch, 0, chunkSize);
+        if (terminator) {
+            *len += terminator - scratch;
+            return *len <= MAX_STRING_LENGTH;
+        }
+
+        *len += chunkSize;
+        str += chunkSize;
+    }
+
+    return false;
+}
+
+static bool patchesPrvMove(const struct PatchGuestMemory* memory, uint32_t dest, uint32_t src,
+                           uint32_t size) {
+    uint8_t scratch[SCRATCH_SIZE];
+    struct MemcpyResult result;
+
+    if (!memcpy_probeArm(src, size, false, memory->privileged, memory->mmu, &result) ||
+        !memcpy_probeArm(dest, size, true, memory->privileged, memory->mmu, &result))
+        return false;
+
+    // copy backwards if the destination overlaps the tail of the source
+    const bool backwards = dest > src && dest - src < size;
+
+    for (uint32_t done = 0; done < size;) {
+        const uint32_t chunkSize = size - done > SCRATCH_SIZE ? SCRATCH_SIZE : size - done;
+        const uint32_t offset = backwards ? size - done - chunkSize : done;
+
+        memcpy_armToHost(scratch, src + offset, chunkSize, memory->privileged, memory->mem,
+                         memory->mmu, &result);
+        if (!result.ok) return false;
+
+        memcpy_hostToArm(dest + offset, scratch, chunkSize, memory->privileged, memory->mem,
+                         memory->mmu, &result);
+        if (!result.ok) return false;
+
+        done += chunkSize;
+    }
+
+    return true;
+}
+
+// Calls with NULL pointers are left to the guest so that its error handling applies.
+
+// Err MemMove(void* dstP, const void* sP, Int32 numBytes)
+static bool replacement_MemMove(void* ctx, uint32_t syscall, uint32_t* registers,
+                                const struct PatchGuestMemory* memory) {
+    const int32_t size = registers[2];
+
+    if (size < 0 || (size > 0 && (!registers[0] || !registers[1]))) return false;
+    if (size > 0 && registers[0] != registers[1] &&
+        !patchesPrvMove(memory, registers[0], registers[1], size))
+        return false;
+
+    registers[0] = 0;
+    return true;
+}
+
+// Err MemSet(void* dstP, Int32 numBytes, UInt8 value)
+static bool replacement_MemSet(void* ctx, uint32_t syscall, uint32_t* registers,
+                               const struct PatchGuestMemory* memory) {
+    uint8_t scratch[SCRATCH_SIZE];
+    struct MemcpyResult result;
+
+    uint32_t dest = registers[0];
+    const int32_t size = registers[1];
+
+    if (size < 0 || (size > 0 && !dest) ||
+        !memcpy_probeArm(dest, size, true, memory->privileged, memory->mmu, &result))
+        return false;
+
+    memset(scratch, registers[2], size < SCRATCH_SIZE ? size : SCRATCH_SIZE);
+
+    for (uint32_t remaining = size; remaining > 0;) {
+        const uint32_t chunkSize = remaining > SCRATCH_SIZE ? SCRATCH_SIZE : remaining;
+
+        memcpy_hostToArm(dest, scratch, chunkSize, memory->privileged, memory->mem, memory->mmu,
+                         &result);
+        if (!result.ok) return false;
+
+        dest += chunkSize;
+        remaining -= chunkSize;
+    }
+
+    registers[0] = 0;
+    return true;
+}
+
+// Char* StrCopy(Char* dst, const Char* src)
+static bool replacement_StrCopy(void* ctx, uint32_t syscall, uint32_t* registers,
+                                const struct PatchGuestMemory* memory) {
+    uint32_t len;
+
+    if (!registers[0] || !registers[1] || !patchesPrvStrLen(memory, registers[1], &len))
+        return false;
+
+    return registers[0] == registers[1] ||
+           patchesPrvMove(memory, registers[0], registers[1], len + 1);
+}
+
+// UInt16 StrLen(const Char* src)
+static bool replacement_StrLen(void* ctx, uint32_t syscall, uint32_t* registers,
+                               const struct PatchGuestMemory* memory) {
+    uint32_t len;
+
+    if (!registers[0] || !patchesPrvStrLen(memory, registers[0], &len)) return false;
+
+    registers[0] = len;
+    return true;
+}
+
 void registerPatches(struct PatchDispatch* patchDispatch, struct SyscallDispatch* syscallDispatch) {
     patchDispatchAddPatch(patchDispatch, SYSCALL_UI_INITIALIZE, NULL, tailpatch_UIInitialize,
                           syscallDispatch);
 
     patchDispatchAddPatch(patchDispatch, SYSCALL_SYS_SET_AUTO_OFF_TIME, headpatch_SysSetAutoOffTime,
                           NULL, NULL);
+
+    patchDispatchAddReplacement(patchDispatch, SYSCALL_MEM_MOVE, replacement_MemMove, NULL);
+    patchDispatchAddReplacement(patchDispatch, SYSCALL_MEM_SET, replacement_MemSet, NULL);
+    patchDispatchAddReplacement(patchDispatch, SYSCALL_STR_COPY, replacement_StrCopy, NULL);
+    patchDispatchAddReplacement(patchDispatch, SYSCALL_STR_LEN, replacement_StrLen, NULL);
 }
@@ -0,0 +1,242 @@
+#include "profiler.h"
+
+#ifdef PROFILE_CPU
+
+    #include <algorithm>
+    #include <string>
+    #include <unordered_map>
+    #include <vector>
+
+using namespace std;
+
+uint32_t profilerSampleCountdown = PROFILER_SAMPLE_INTERVAL;
+
+namespace {
+    struct Counters {
+        uint64_t executions{0};
+        uint64_t samples{0};
+        uint64_t sampledTicks{0};
+
+        // Executions that were not sampled are assumed to take the average sampled time
+        uint64_t EstimatedTicks() const {
+            return samples ? (sampledTicks * static_cast<double>(executions)) / samples : 0;
+        }
+
+        void Record(bool sampled, uint64_t ticks) {
+            executions++;
+            if (!sampled) return;
+
+            samples++;
+            sampledTicks += ticks;
+        }
+    };
+
+    struct Entry {
+        string name;
+        const Counters* counters;
+    };
+
+    const char* modeNames[] = {"arm", "thumb"};
+
+    unordered_map<const void*, string> execFnNames;
+    unordered_map<const void*, Counters> execFnCounters[2];
+    unordered_map<uint32_t, Counters> pcCounters[2];
+    Counters paceOpcodeCounters[0x10000];
+
+    const void* lastExecFn[2];
+    Counters* lastExecFnCounters[2];
+
+    // Extract the template argument from __PRETTY_FUNCTION__ of the registering template
+    string parseExecFnName(const char* prettyFunction) {
+        string name(prettyFunction);
+
+        size_t start = name.find("= ");
+        if (start == string::npos) return name;
+        start += 2;
+        if (name[start] == '&') start++;
+
+        size_t end = start;
+        for (int depth = 0; end < name.size(); end++) {
+            const char c = name[end];
+
+            if (c == '<') depth++;
+            if (c == '>') depth--;
+            if (depth == 0 && (c == ';' || c == ']')) break;
+        }
+
+        return name.substr(start, end - start);
+    }
+
+    string execFnName(const void* execFn) {
+        auto it = execFnNames.find(execFn);
+        if (it != execFnNames.end()) return it->second;
+
+        char name[32];
+        snprintf(name, sizeof(name), "%p", execFn);
+
+        return name;
+    }
+
+    string hex(uint32_t value, int digits) {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "0x%0*x", digits, value);
+
+        return buffer;
+    }
+
+    vector<Entry> collectExecFns(size_t mode) {
+        vector<Entry> entries;
+
+        for (auto& [execFn, counters] : execFnCounters[mode])
+            entries.push_back({execFnName(execFn), &counters});
+
+        return entries;
+    }
+
+    vector<Entry> collectPcs(size_t mode) {
+        vector<Entry> entries;
+
+        for (auto& [pc, counters] : pcCounters[mode]) entries.push_back({hex(pc, 8), &counters});
+
+        return entries;
+    }
+
+    vector<Entry> collectPaceOpcodes() {
+        vector<Entry> entries;
+
+        for (uint32_t opcode = 0; opcode < 0x10000; opcode++) {
+            if (paceOpcodeCounters[opcode].executions > 0)
+                entries.push_back({hex(opcode, 4), &paceOpcodeCounters[opcode]});
+        }
+
+        return entries;
+    }
+
+    void printSection(FILE* stream, const char* title, vector<Entry> entries, size_t maxEntries,
+                      bool sampledOnly) {
+        uint64_t totalTicks = 0;
+        uint64_t totalExecutions = 0;
+
+        for (auto& entry : entries) {
+            totalTicks += entry.counters->EstimatedTicks();
+            totalExecutions += entry.counters->executions;
+        }
+
+        sort(entries.begin(), entries.end(), [](const Entry& e1, const Entry& e2) {
+            return e1.counters->EstimatedTicks() > e2.counters->EstimatedTicks();
+        });
+
+        fprintf(stream, "%s\n\n", title);
+
+        if (sampledOnly)
+            fprintf(stream, "%8s %12s %12s  %s\n", "ticks %", "samples", "ticks/exec", "pc");
+        else
+            fprintf(stream, "%8s %8s %14s %12s  %s\n", "ticks %", "execs %", "executions",
+                    "ticks/exec", "name");
+
+        for (size_t i = 0; i < entries.size() && i < maxEntries; i++) {
+            const Counters& counters(*entries[i].counters);
+            const double ticksPercent =
+                totalTicks ? (100. * counters.EstimatedTicks()) / totalTicks : 0;
+            const double ticksPerExecution =
+                counters.samples ? static_cast<double>(counters.sampledTicks) / counters.samples
+                                 : 0;
+
+            if (sampledOnly) {
+                fprintf(stream, "%7.2f%% %12llu %12.1f  %s\n", ticksPercent,
+                        static_cast<unsigned long long>(counters.samples), ticksPerExecution,
+                        entries[i].name.c_str());
+            } else {
+                fprintf(stream, "%7.2f%% %7.2f%% %14llu %12.1f  %s\n", ticksPercent,
+                        (100. * counters.executions) / totalExecutions,
+                        static_cast<unsigned long long>(counters.executions), ticksPerExecution,
+                        entries[i].name.c_str());
+            }
+        }
+
+        fprintf(stream, "\n");
+    }
+
+    void writeFolded(FILE* stream, const char* prefix, const vector<Entry>& entries) {
+        for (auto& entry : entries) {
+            const uint64_t ticks = entry.counters->EstimatedTicks();
+
+            if (ticks > 0)
+                fprintf(stream, "%s;%s %llu\n", prefix, entry.name.c_str(),
+                        static_cast<unsigned long long>(ticks));
+        }
+    }
+}  // namespace
+
+void profilerRegisterExecFn(const void* execFn, const char* name) {
+    execFnNames.emplace(execFn, parseExecFnName(name));
+}
+
+void profilerRecordExecFn(const void* execFn, uint32_t pc, bool thumb, uint64_t sampleStart) {
+    const uint64_t ticks = sampleStart ? profilerTicks() - sampleStart : 0;
+
+    if (execFn != lastExecFn[thumb]) {
+        lastExecFn[thumb] = execFn;
+        lastExecFnCounters[thumb] = &execFnCounters[thumb][execFn];
+    }
+
+    lastExecFnCounters[thumb]->Record(sampleStart, ticks);
+
+    if (sampleStart) {
+        Counters& counters(pcCounters[thumb][pc]);
+
+        counters.Record(true, ticks);
+        counters.executions = counters.samples;
+    }
+}
+
+void profilerRecordPaceOpcode(uint16_t opcode, uint64_t sampleStart) {
+    paceOpcodeCounters[opcode].Record(sampleStart, sampleStart ? profilerTicks() - sampleStart : 0);
+}
+
+bool profilerEnabled() { return true; }
+
+void profilerReset() {
+    for (size_t mode = 0; mode < 2; mode++) {
+        execFnCounters[mode].clear();
+        pcCounters[mode].clear();
+
+        lastExecFn[mode] = nullptr;
+        lastExecFnCounters[mode] = nullptr;
+    }
+
+    fill(paceOpcodeCounters, paceOpcodeCounters + 0x10000, Counters());
+}
+
+void profilerPrintReport(FILE* stream, size_t maxEntries) {
+    for (size_t mode = 0; mode < 2; mode++) {
+        const string title = string(modeNames[mode]) + " handlers";
+        printSection(stream, title.c_str(), collectExecFns(mode), maxEntries, false);
+    }
+
+    for (size_t mode = 0; mode < 2; mode++) {
+        const string title = string(modeNames[mode]) + " hotspots (sampled)";
+        printSection(stream, title.c_str(), collectPcs(mode), maxEntries, true);
+    }
+
+    printSection(stream, "PACE opcodes", collectPaceOpcodes(), maxEntries, false);
+}
+
+void profilerWriteFlamegraph(FILE* stream) {
+    for (size_t mode = 0; mode < 2; mode++)
+        writeFolded(stream, modeNames[mode], collectExecFns(mode));
+
+    writeFolded(stream, "pace", collectPaceOpcodes());
+}
+
+#else
+
+bool profilerEnabled() { return false; }
+
+void profilerReset() {}
+
+void profilerPrintReport(FILE* stream, size_t maxEntries) {}
+
+void profilerWriteFlamegraph(FILE* stream) {}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+// Execution profiler for the ARM core, enabled by building with PROFILE_CPU (make
+// PROFILE_CPU=1). Executions are counted per ExecFn and per PACE opcode; every
+// PROFILER_SAMPLE_INTERVAL instructions the host ticks spent in the handler are sampled and
+// attributed to the handler, the PC and the opcode.
+
+#include <cstdint>
+#include <cstdio>
+
+#ifdef PROFILE_CPU
+
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #else
+        #include <chrono>
+    #endif
+
+    #define PROFILER_SAMPLE_INTERVAL 64
+
+extern uint32_t profilerSampleCountdown;
+
+static inline uint64_t profilerTicks() {
+    #if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+    #else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+    #endif
+}
+
+// Returns the start timestamp if this execution is sampled and 0 otherwise
+static inline uint64_t profilerSampleStart() {
+    if (--profilerSampleCountdown) return 0;
+
+    profilerSampleCountdown = PROFILER_SAMPLE_INTERVAL;
+    return profilerTicks();
+}
+
+void profilerRegisterExecFn(const void* execFn, const char* name);
+
+void profilerRecordExecFn(const void* execFn, uint32_t pc, bool thumb, uint64_t sampleStart);
+void profilerRecordPaceOpcode(uint16_t opcode, uint64_t sampleStart);
+
+#endif
+
+bool profilerEnabled();
+
+void profilerReset();
+
+// Human readable report, sorted by estimated host ticks
+void profilerPrintReport(FILE* stream, size_t maxEntries);
+
+// Folded stacks as consumed by flamegraph.pl
+void profilerWriteFlamegraph(FILE* stream);
+
+#endif  // _PROFILER_H_
@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include "cputil.h"
+#include "savestate_chunk.h"
 
 struct Pxa255dsp {
     uint64_t acc0;
@@ -86,3 +87,7 @@ struct Pxa255dsp* pxa255dspInit(struct ArmCpu* cpu) {
 
     return dsp;
 }
+
+void pxa255dspSerialize(struct Pxa255dsp *dsp, struct SavestateChunk *chunk) {
+    savestateChunkDo64(chunk, &dsp->acc0);
+}
@@ -11,9 +11,12 @@ extern "C" {
 #endif
 
 struct Pxa255dsp;
+struct SavestateChunk;
 
 struct Pxa255dsp* pxa255dspInit(struct ArmCpu* cpu);
 
+void pxa255dspSerialize(struct Pxa255dsp* dsp, struct SavestateChunk* chunk);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,7 @@
 
 #include "cputil.h"
 #include "mem.h"
+#include "savestate_chunk.h"
 
 #define PXA_UDC_BASE 0x40600000UL
 #define PXA_UDC_SIZE 0x00001000UL
@@ -101,3 +102,10 @@ struct Pxa255Udc *pxa255UdcInit(struct ArmMem *physMem, struct SocIc *ic, struct
 
     return udc;
 }
+
+void pxa255UdcSerialize(struct Pxa255Udc *udc, struct SavestateChunk *chunk) {
+    savestateChunkDo32(chunk, &udc->reg4);
+    savestateChunkDo8(chunk, &udc->ccr);
+    savestateChunkDo8(chunk, &udc->uicr0);
+    savestateChunkDo8(chunk, &udc->uicr1);
+}
@@ -15,9 +15,12 @@ extern "C" {
 #endif
 
 struct Pxa255Udc;
+struct SavestateChunk;
 
 struct Pxa255Udc *pxa255UdcInit(struct ArmMem *physMem, struct SocIc *ic, struct SocDma *dma);
 
+void pxa255UdcSerialize(struct Pxa255Udc *udc, struct SavestateChunk *chunk);
+
 #ifdef __cplusplus
 }
 #endif
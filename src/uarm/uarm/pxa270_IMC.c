@@ -7,6 +7,7 @@
 
 #include "cputil.h"
 #include "mem.h"
+#include "savestate_chunk.h"
 
 #define PXA270_IMC_BASE 0x58000000ul
 #define PXA270_IMC_SIZE 0x0c
@@ -64,3 +65,8 @@ struct PxaImc* pxaImcInit(struct ArmMem* physMem) {
 
     return imc;
 }
+
+void pxaImcSerialize(struct PxaImc *imc, struct SavestateChunk *chunk) {
+    savestateChunkDo32(chunk, &imc->mcr);
+    savestateChunkDo8(chunk, &imc->impmsr);
+}
@@ -10,9 +10,12 @@ extern "C" {
 #endif
 
 struct PxaImc;
+struct SavestateChunk;
 
 struct PxaImc* pxaImcInit(struct ArmMem* physMem);
 
+void pxaImcSerialize(struct PxaImc* imc, struct SavestateChunk* chunk);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,7 @@
 
 #include "cputil.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
 
 #define PXA270_KPC_BASE 0x41500000ul
 #define PXA270_KPC_SIZE 0x4c
@@ -315,3 +316,23 @@ void pxaKpcJogInput(struct PxaKpc *kpc, uint_fast8_t jogIdx, bool up) {
     }
     pxaKpcPrvJogRecalcRecalc(kpc);
 }
+
+void pxaKpcSerialize(struct PxaKpc *kpc, struct SavestateChunk *chunk) {
+    bool kpdkChanged = kpc->kpdkChanged;
+
+    savestateChunkDo32(chunk, &kpc->kpc);
+    savestateChunkDo32(chunk, &kpc->kpmk);
+    savestateChunkDo32(chunk, &kpc->kpas);
+    for (size_t i = 0; i < 4; i++) savestateChunkDo32(chunk, kpc->kpasmkp + i);
+    savestateChunkDo16(chunk, &kpc->kpkdi);
+    savestateChunkDoBool(chunk, &kpdkChanged);
+
+    savestateChunkDo64(chunk, &kpc->prevKeys);
+    savestateChunkDoBuffer(chunk, kpc->matrixKeys, sizeof(kpc->matrixKeys));
+    savestateChunkDo8(chunk, &kpc->directKeys);
+    savestateChunkDo8(chunk, &kpc->numMatrixKeysPressed);
+    savestateChunkDo16(chunk, kpc->jogSta + 0);
+    savestateChunkDo16(chunk, kpc->jogSta + 1);
+
+    kpc->kpdkChanged = kpdkChanged;
+}
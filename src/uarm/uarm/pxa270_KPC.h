@@ -14,9 +14,12 @@ extern "C" {
 #endif
 
 struct PxaKpc;
+struct SavestateChunk;
 
 struct PxaKpc *pxaKpcInit(struct ArmMem *physMem, struct SocIc *ic);
 
+void pxaKpcSerialize(struct PxaKpc *kpc, struct SavestateChunk *chunk);
+
 // keep in mind that colums are out and rows are in
 void pxaKpcMatrixKeyChange(struct PxaKpc *kpc, uint_fast8_t row, uint_fast8_t col, bool isDown);
 void pxaKpcDirectKeyChange(struct PxaKpc *kpc, uint_fast8_t keyIdx, bool isDown);
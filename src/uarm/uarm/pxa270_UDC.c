@@ -7,6 +7,7 @@
 
 #include "cputil.h"
 #include "mem.h"
+#include "savestate_chunk.h"
 
 #define PXA_UDC_BASE 0x40600000UL
 #define PXA_UDC_SIZE 0x00001000UL
@@ -167,3 +168,19 @@ struct Pxa270Udc *pxa270UdcInit(struct ArmMem *physMem, struct SocIc *ic, struct
 
     return udc;
 }
+
+void pxa270UdcSerialize(struct Pxa270Udc *udc, struct SavestateChunk *chunk) {
+    for (size_t i = 0; i < 24; i++) {
+        savestateChunkDo32(chunk, &udc->ep[i].ccra);
+        savestateChunkDo16(chunk, &udc->ep[i].csr);
+        savestateChunkDo16(chunk, &udc->ep[i].bcr);
+    }
+
+    uint32_t *regs[] = {&udc->udccr,     &udc->udcicr[0], &udc->udcicr[1], &udc->udcisr[0],
+                        &udc->udcisr[1], &udc->udcotgicr, &udc->udcotgisr, &udc->up2ocr};
+
+    for (size_t i = 0; i < sizeof(regs) / sizeof(*regs); i++) savestateChunkDo32(chunk, regs[i]);
+
+    savestateChunkDo16(chunk, &udc->udcfnr);
+    savestateChunkDo8(chunk, &udc->up3ocr);
+}
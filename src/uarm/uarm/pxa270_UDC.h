@@ -15,9 +15,12 @@ extern "C" {
 #endif
 
 struct Pxa270Udc;
+struct SavestateChunk;
 
 struct Pxa270Udc *pxa270UdcInit(struct ArmMem *physMem, struct SocIc *ic, struct SocDma *dma);
 
+void pxa270UdcSerialize(struct Pxa270Udc *udc, struct SavestateChunk *chunk);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,1582 +6,22 @@
 #include <string.h>
 
 #include "cputil.h"
+#include "pxa270_WMMX_dp.h"
+#include "savestate_chunk.h"
 #include "uarm_endian.h"
 
-union REG64 {
-    uint64_t v64;
-    int64_t s64;
-    uint32_t v32[2];
-    int32_t s32[2];
-    uint16_t v16[4];
-    int16_t s16[4];
-    uint8_t v8[8];
-    int8_t s8[8];
-};
-
-struct Pxa270wmmx {
-    union REG64 wR[16];
-    uint32_t wCGR[4], wCASF;  // NZCV
-    uint8_t wCon, wCSSF;
-};
-
-#define pxa270wmmxPrvDataRegsChanged(_wmmx) \
-    do {                                    \
-        _wmmx->wCon |= 2;                   \
-    } while (0)
-#define pxa270wmmxPrvControlRegsChanged(_wmmx) \
-    do {                                       \
-        _wmmx->wCon |= 1;                      \
-    } while (0)
-
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-    #define ACCESS_REG_8(_idx) (_idx)
-    #define ACCESS_REG_16(_idx) (_idx)
-    #define ACCESS_REG_32(_idx) (_idx)
-#else
-    #define ACCESS_REG_8(_idx) (7 - (_idx))
-    #define ACCESS_REG_16(_idx) (3 - (_idx))
-    #define ACCESS_REG_32(_idx) (1 - (_idx))
-#endif
-
-static void pxa270wmmxPrvSetFlagsForLogical64(struct Pxa270wmmx *wmmx, uint64_t val) {
-    wmmx->wCASF = ((val >> 63) ? 0x80000000ul : 0) | (val ? 0 : 0x40000000ul);
-    pxa270wmmxPrvControlRegsChanged(wmmx);
-}
-
-static void pxa270wmmxPrvAlign(struct Pxa270wmmx *wmmx, uint_fast8_t CRd, uint_fast8_t CRn,
-                               uint_fast8_t CRm, uint_fast8_t by) {
-    union REG64 ret;
-    uint_fast8_t i;
-
-    for (i = 0; i < 8 - by; i++) ret.v8[ACCESS_REG_8(i)] = wmmx->wR[CRn].v8[ACCESS_REG_8(i + by)];
-    for (; i < 8; i++) ret.v8[ACCESS_REG_8(i)] = wmmx->wR[CRn].v8[ACCESS_REG_8(i - 8 + by)];
-    wmmx->wR[CRd].v64 = ret.v64;
-    pxa270wmmxPrvDataRegsChanged(wmmx);
-}
-
-static bool pxa270wmmxPrvDataProcessingMisc(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                            uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
-    uint_fast8_t i, tf8;
-    uint_fast16_t tf16;
-    uint64_t tmp;
-
-    switch (op1) {
-        case 0b0000:  // WOR
-            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 | wmmx->wR[CRm].v64;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
-            break;
-
-        case 0b0001:  // WXOR
-            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 ^ wmmx->wR[CRm].v64;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
-            break;
-
-        case 0b0010:  // WAND
-            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 & wmmx->wR[CRm].v64;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
-            break;
-
-        case 0b0011:  // WANDN
-            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 & ~wmmx->wR[CRm].v64;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
-            break;
-
-        case 0b1000:  // WAVG2 (byte size)
-        case 0b1001:
-            wmmx->wCASF = 0;
-            for (i = 0, tmp = 0x04; i < 8; i++, tmp <<= 4) {
-                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] = tf8 =
-                    (wmmx->wR[CRn].v8[ACCESS_REG_8(i)] + wmmx->wR[CRm].v8[ACCESS_REG_8(i)] +
-                     (op1 & 1)) /
-                    2;
-                if (!tf8) wmmx->wCASF |= tmp;
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1100:  // WAVG2 (halfword size)
-        case 0b1101:
-            wmmx->wCASF = 0;
-            for (i = 0, tmp = 0x40; i < 4; i++, tmp <<= 8) {
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
-                    (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] + wmmx->wR[CRm].v16[ACCESS_REG_16(i)] +
-                     (op1 & 1)) /
-                    2;
-                if (!tf16) wmmx->wCASF |= tmp;
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingAlign(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                             uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
-    switch (op1) {
-        case 0b0000:  // WALIGNI
-        case 0b0001:
-        case 0b0010:
-        case 0b0011:
-        case 0b0100:
-        case 0b0101:
-        case 0b0110:
-        case 0b0111:
-            pxa270wmmxPrvAlign(wmmx, CRd, CRn, CRm, (op1 & 7));
-            break;
-
-        case 0b1000:  // WALIGNR
-        case 0b1001:
-        case 0b1010:
-        case 0b1011:
-            pxa270wmmxPrvAlign(wmmx, CRd, CRn, CRm, wmmx->wCGR[op1 & 3] & 7);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingShift(struct Pxa270wmmx *wmmx, bool cp1, uint_fast8_t op1,
-                                             uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
-    uint_fast8_t i, by;
-    uint_fast16_t tf16;
-    uint_fast32_t tf32;
-    uint64_t tmp;
-
-    switch (op1) {
-        case 0b0100:  // WSRA.h
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
-                    wmmx->wR[CRn].s16[ACCESS_REG_16(i)] >> by;
-                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
-                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1000:  // WSRA.w
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
-                    wmmx->wR[CRn].s32[ACCESS_REG_32(i)] >> by;
-                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
-                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1100:  // WSRA.d
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].s64 >> by;
-            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0101:  // WSLL.h
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 = wmmx->wR[CRn].v16[ACCESS_REG_16(i)]
-                                                             << by;
-                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
-                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1001:  // WSLL.w
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 = wmmx->wR[CRn].v32[ACCESS_REG_32(i)]
-                                                             << by;
-                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
-                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1101:  // WSLL.d
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 << by;
-            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0110:  // WSRL.h
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
-                    wmmx->wR[CRn].v16[ACCESS_REG_16(i)] >> by;
-                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
-                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1010:  // WSRL.w
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
-                    wmmx->wR[CRn].v32[ACCESS_REG_32(i)] >> by;
-                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
-                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1110:  // WSRL.d
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 >> by;
-            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0111:  // WROR.h
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                if (by)
-                    tf16 = (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] >> by) |
-                           (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] << (16 - by));
-                else
-                    tf16 = wmmx->wR[CRn].v16[ACCESS_REG_16(i)];
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16;
-                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
-                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1011:  // WROR.w
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                if (by)
-                    tf32 = (wmmx->wR[CRn].v32[ACCESS_REG_32(i)] >> by) |
-                           (wmmx->wR[CRn].v32[ACCESS_REG_32(i)] << (32 - by));
-                else
-                    tf32 = wmmx->wR[CRn].v32[ACCESS_REG_32(i)];
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32;
-                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
-                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1111:  // WROR.d
-            if (!cp1)
-                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
-            else if (CRm >= 4)
-                return false;
-            else
-                by = wmmx->wCGR[CRm];
-
-            if (by)
-                tmp = (wmmx->wR[CRn].v64 >> by) | (wmmx->wR[CRn].v64 << (64 - by));
-            else
-                tmp = wmmx->wR[CRn].v64;
-            wmmx->wR[CRd].v64 = tmp;
-            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingCompare(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                               uint_fast8_t CRd, uint_fast8_t CRn,
-                                               uint_fast8_t CRm) {
-    uint_fast8_t i, tf8;
-    uint_fast16_t tf16;
-    uint_fast32_t tf32;
-
-    switch (op1) {
-        case 0b0000:  // WCMPEQ.b
-            wmmx->wCASF = 0;
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] = tf8 =
-                    (wmmx->wR[CRn].v8[ACCESS_REG_8(i)] == wmmx->wR[CRm].v8[ACCESS_REG_8(i)]) ? 0xFF
-                                                                                             : 0x00;
-                if (tf8)
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                else
-                    wmmx->wCASF |= 0x4ul << (i * 4);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0100:  // WCMPEQ.h
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
-                    (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] == wmmx->wR[CRm].v16[ACCESS_REG_16(i)])
-                        ? 0xFFFF
-                        : 0x00;
-                if (tf16)
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                else
-                    wmmx->wCASF |= 0x40ul << (i * 8);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1000:  // WCMPEQ.w
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
-                    (wmmx->wR[CRn].v32[ACCESS_REG_32(i)] == wmmx->wR[CRm].v32[ACCESS_REG_32(i)])
-                        ? 0xFFFFFFFFUL
-                        : 0x00;
-                if (tf32)
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                else
-                    wmmx->wCASF |= 0x4000ul << (i * 16);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0001:  // WCMPGTU.b
-            wmmx->wCASF = 0;
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] = tf8 =
-                    (wmmx->wR[CRn].v8[ACCESS_REG_8(i)] > wmmx->wR[CRm].v8[ACCESS_REG_8(i)]) ? 0xFF
-                                                                                            : 0x00;
-                if (tf8)
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                else
-                    wmmx->wCASF |= 0x4ul << (i * 4);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0101:  // WCMPGTU.h
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
-                    (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] > wmmx->wR[CRm].v16[ACCESS_REG_16(i)])
-                        ? 0xFFFF
-                        : 0x00;
-                if (tf16)
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                else
-                    wmmx->wCASF |= 0x40ul << (i * 8);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1001:  // WCMPGTU.w
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
-                    (wmmx->wR[CRn].v32[ACCESS_REG_32(i)] > wmmx->wR[CRm].v32[ACCESS_REG_32(i)])
-                        ? 0xFFFFFFFFUL
-                        : 0x00;
-                if (tf32)
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                else
-                    wmmx->wCASF |= 0x4000ul << (i * 16);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0011:  // WCMPGTS.b
-            wmmx->wCASF = 0;
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] = tf8 =
-                    (wmmx->wR[CRn].s8[ACCESS_REG_8(i)] > wmmx->wR[CRm].s8[ACCESS_REG_8(i)]) ? 0xFF
-                                                                                            : 0x00;
-                if (tf8)
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                else
-                    wmmx->wCASF |= 0x4ul << (i * 4);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0111:  // WCMPGTS.h
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
-                    (wmmx->wR[CRn].s16[ACCESS_REG_16(i)] > wmmx->wR[CRm].s16[ACCESS_REG_16(i)])
-                        ? 0xFFFF
-                        : 0x00;
-                if (tf16)
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                else
-                    wmmx->wCASF |= 0x40ul << (i * 8);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1011:  // WCMPGTS.w
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
-                    (wmmx->wR[CRn].s32[ACCESS_REG_32(i)] > wmmx->wR[CRm].s32[ACCESS_REG_32(i)])
-                        ? 0xFFFFFFFFUL
-                        : 0x00;
-                if (tf32)
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                else
-                    wmmx->wCASF |= 0x4000ul << (i * 16);
-            }
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingPack(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                            uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
-    uint_fast8_t i, j, from;
-    int_fast16_t ts16;
-    int_fast32_t ts32;
-    int_fast64_t ts64;
-    union REG64 ret;
-
-    switch (op1) {
-        case 0b0101:  // WPACKUS.h
-            wmmx->wCASF = 0;
-            for (i = 0; i < 8; i++) {
-                from = i < 4 ? CRn : CRm;
-                j = i % 4;
-
-                ts16 = wmmx->wR[from].s16[ACCESS_REG_16(j)];
-                if (ts16 < 0) {
-                    ts16 = 0;
-                    wmmx->wCSSF |= 1 << i;
-                    wmmx->wCASF |= 0x4ul << (i * 4);
-                } else if (ts16 > 0xff) {
-                    ts16 = 0xff;
-                    wmmx->wCSSF |= 1 << i;
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                } else {
-                    if (!ts16) wmmx->wCASF |= 0x4ul << (i * 4);
-                    if (ts16 & 0x80) wmmx->wCASF |= 0x8ul << (i * 4);
-                }
-
-                ret.v8[ACCESS_REG_8(i)] = ts16;
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1001:  // WPACKUS.w
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                from = i < 2 ? CRn : CRm;
-                j = i % 2;
-
-                ts32 = wmmx->wR[from].s32[ACCESS_REG_32(j)];
-                if (ts32 < 0) {
-                    ts32 = 0;
-                    wmmx->wCSSF |= 1 << (i * 2);
-                    wmmx->wCASF |= 0x40ul << (i * 8);
-                } else if (ts32 > 0xffffl) {
-                    ts32 = 0xffff;
-                    wmmx->wCSSF |= 1 << (i * 2);
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                } else {
-                    if (!ts32) wmmx->wCASF |= 0x40ul << (i * 8);
-                    if (ts32 & 0x8000u) wmmx->wCASF |= 0x80ul << (i * 8);
-                }
-
-                ret.v16[ACCESS_REG_16(i)] = ts32;
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1101:  // WPACKUS.d
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                ts64 = wmmx->wR[i ? CRm : CRn].s64;
-                if (ts64 < 0) {
-                    ts64 = 0;
-                    wmmx->wCSSF |= 1 << (i * 4);
-                    wmmx->wCASF |= 0x4000ul << (i * 16);
-                } else if (ts64 > 0xffffffffll) {
-                    ts64 = 0xffffffffll;
-                    wmmx->wCSSF |= 1 << (i * 4);
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                } else {
-                    if (!ts64) wmmx->wCASF |= 0x4000ul << (i * 16);
-                    if (ts64 & 0x800000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
-                }
-
-                ret.v32[ACCESS_REG_32(i)] = ts64;
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0111:  // WPACKSS.h
-            wmmx->wCASF = 0;
-            for (i = 0; i < 8; i++) {
-                from = i < 4 ? CRn : CRm;
-                j = i % 4;
-
-                ts16 = wmmx->wR[from].s16[ACCESS_REG_16(j)];
-                if (ts16 < -0x80) {
-                    ts16 = -0x80;
-                    wmmx->wCSSF |= 1 << i;
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                } else if (ts16 > 0x7f) {
-                    ts16 = 0x7f;
-                    wmmx->wCSSF |= 1 << i;
-                } else {
-                    if (!ts16) wmmx->wCASF |= 0x4ul << (i * 4);
-                    if (ts16 < 0) wmmx->wCASF |= 0x8ul << (i * 4);
-                }
-
-                ret.v8[ACCESS_REG_8(i)] = ts16;
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1011:  // WPACKSS.w
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                from = i < 2 ? CRn : CRm;
-                j = i % 2;
-
-                ts32 = wmmx->wR[from].s32[ACCESS_REG_32(j)];
-                if (ts32 < -0x8000) {
-                    ts32 = -0x8000;
-                    wmmx->wCSSF |= 1 << (i * 2);
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                } else if (ts32 > 0x7fff) {
-                    ts32 = 0x7fff;
-                    wmmx->wCSSF |= 1 << (i * 2);
-                } else {
-                    if (!ts32) wmmx->wCASF |= 0x40ul << (i * 8);
-                    if (ts32 < 0) wmmx->wCASF |= 0x80ul << (i * 8);
-                }
-
-                ret.v16[ACCESS_REG_16(i)] = ts32;
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1111:  // WPACKSS.d
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                ts64 = wmmx->wR[i ? CRm : CRn].s64;
-                if (ts64 < -0x80000000ll) {
-                    ts64 = -0x80000000ll;
-                    wmmx->wCSSF |= 1 << (i * 4);
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                } else if (ts64 > 0x7fffffffll) {
-                    ts64 = 0x7fffffffll;
-                    wmmx->wCSSF |= 1 << (i * 4);
-                } else {
-                    if (!ts64) wmmx->wCASF |= 0x4000ul << (i * 16);
-                    if (ts64 < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
-                }
-
-                ret.v32[ACCESS_REG_32(i)] = ts64;
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingUnpack(struct Pxa270wmmx *wmmx, bool hi, uint_fast8_t op1,
-                                              uint_fast8_t CRd, uint_fast8_t CRn,
-                                              uint_fast8_t CRm) {
-    uint_fast8_t i, tf8;
-    uint_fast32_t tf32;
-    uint_fast16_t tf16;
-    int_fast64_t ts64;
-    int_fast32_t ts32;
-    int_fast16_t ts16;
-    union REG64 ret;
-
-    switch (op1) {
-        case 0b0010:  // WUNPACKESx.b
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                ret.s16[ACCESS_REG_16(i)] = ts16 = wmmx->wR[CRn].s8[ACCESS_REG_8(i + (hi ? 4 : 0))];
-                if (!ts16) wmmx->wCASF |= 0x40ul << (i * 8);
-                if (ts16 < 0) wmmx->wCASF |= 0x80ul << (i * 8);
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0110:  // WUNPACKESx.h
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                ret.s32[ACCESS_REG_32(i)] = ts32 =
-                    wmmx->wR[CRn].s16[ACCESS_REG_16(i + (hi ? 2 : 0))];
-                if (!ts32) wmmx->wCASF |= 0x4000ul << (i * 16);
-                if (ts32 < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1010:  // WUNPACKESx.w
-            wmmx->wCASF = 0;
-            wmmx->wR[CRd].s64 = ts64 = wmmx->wR[CRn].s32[ACCESS_REG_32(hi ? 1 : 0)];
-            if (!ts64) wmmx->wCASF |= 0x40000000ul;
-            if (ts64 < 0) wmmx->wCASF |= 0x80000000ul;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0000:  // WUNPACKEUx.b
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                ret.v16[ACCESS_REG_16(i)] = tf8 = wmmx->wR[CRn].v8[ACCESS_REG_8(i + (hi ? 4 : 0))];
-                if (!tf8) wmmx->wCASF |= 0x40ul << (i * 8);
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0100:  // WUNPACKEUx.h
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                ret.v32[ACCESS_REG_32(i)] = tf16 =
-                    wmmx->wR[CRn].v16[ACCESS_REG_16(i + (hi ? 2 : 0))];
-                if (!tf16) wmmx->wCASF |= 0x4000ul << (i * 16);
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1000:  // WUNPACKEUx.w
-            wmmx->wCASF = 0;
-            wmmx->wR[CRd].v64 = tf32 = wmmx->wR[CRn].v32[ACCESS_REG_32(hi ? 1 : 0)];
-            if (!tf32) wmmx->wCASF |= 0x40000000ul;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0001:  // WUNPACKIx.b
-            wmmx->wCASF = 0;
-            for (i = 0; i < 8; i++) {
-                ret.v8[ACCESS_REG_8(i)] = tf8 =
-                    wmmx->wR[(i & 1) ? CRm : CRn].v8[ACCESS_REG_8(i / 2 + (hi ? 4 : 0))];
-                if (!tf8) wmmx->wCASF |= 0x4ul << (i * 4);
-                if (tf8 & 0x80) wmmx->wCASF |= 0x8ul << (i * 4);
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0101:  // WUNPACKIx.h
-            wmmx->wCASF = 0;
-            for (i = 0; i < 4; i++) {
-                ret.v16[ACCESS_REG_16(i)] = tf16 =
-                    wmmx->wR[(i & 1) ? CRm : CRn].v16[ACCESS_REG_16(i / 2 + (hi ? 2 : 0))];
-                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
-                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1001:  // WUNPACKIx.w
-            wmmx->wCASF = 0;
-            for (i = 0; i < 2; i++) {
-                ret.v32[ACCESS_REG_32(i)] = tf32 =
-                    wmmx->wR[(i & 1) ? CRm : CRn].v32[ACCESS_REG_32(hi ? 1 : 0)];
-                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
-                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
-            }
-            wmmx->wR[CRd].v64 = ret.v64;
-            pxa270wmmxPrvControlRegsChanged(wmmx);
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingMultiply(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                                uint_fast8_t CRd, uint_fast8_t CRn,
-                                                uint_fast8_t CRm) {
-    uint64_t sum = wmmx->wR[CRd].v64;
-    uint_fast8_t i;
-
-    switch (op1) {
-        case 0b0000:  // WMULUL		//When L is specified the U and S qualifiers produce the
-                      // same result
-        case 0b0010:  // WMULSL
-            for (i = 0; i < 4; i++)
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] =
-                    wmmx->wR[CRn].v16[ACCESS_REG_16(i)] * wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0001:  // WMULUM
-            for (i = 0; i < 4; i++)
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] =
-                    ((uint_fast32_t)wmmx->wR[CRn].v16[ACCESS_REG_16(i)] *
-                     (uint_fast32_t)wmmx->wR[CRm].v16[ACCESS_REG_16(i)]) >>
-                    16;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0011:  // WMULSM
-            for (i = 0; i < 4; i++)
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] =
-                    ((int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] *
-                     (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)]) >>
-                    16;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0101:  // WMACUZ
-            sum = 0;
-            // fallthrough
-        case 0b0100:  // WMACU
-            for (i = 0; i < 4; i++) {
-                sum += (uint_fast32_t)wmmx->wR[CRn].v16[ACCESS_REG_16(i)] *
-                       (uint_fast32_t)wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
-            }
-            wmmx->wR[CRd].v64 = sum;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0111:  // WMACSZ
-            sum = 0;
-            // fallthrough
-        case 0b0110:  // WMACS
-            for (i = 0; i < 4; i++) {
-                sum += (int64_t)((int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] *
-                                 (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)]);
-            }
-            wmmx->wR[CRd].v64 = sum;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1000:  // WMADDU
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] =
-                    (uint_fast32_t)wmmx->wR[CRn].v16[ACCESS_REG_16(i * 2 + 0)] *
-                        (uint_fast32_t)wmmx->wR[CRm].v16[ACCESS_REG_16(i * 2 + 0)] +
-                    (uint_fast32_t)wmmx->wR[CRn].v16[ACCESS_REG_16(i * 2 + 1)] *
-                        (uint_fast32_t)wmmx->wR[CRm].v16[ACCESS_REG_16(i * 2 + 1)];
-            }
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1010:  // WMADDS
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] =
-                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i * 2 + 0)] *
-                        (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i * 2 + 0)] +
-                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i * 2 + 1)] *
-                        (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i * 2 + 1)];
-            }
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingDifference(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                                  uint_fast8_t CRd, uint_fast8_t CRn,
-                                                  uint_fast8_t CRm) {
-    uint_fast32_t sum = wmmx->wR[CRd].v32[ACCESS_REG_32(0)];
-    uint_fast8_t i, t;
-
-    switch (op1) {
-        case 0b0001:  // WSADBZ
-            sum = 0;
-            // fallthrough
-        case 0b0000:  // WSADB
-            for (i = 0; i < 8; i++) {
-                t = wmmx->wR[CRn].v8[ACCESS_REG_8(i)] - wmmx->wR[CRm].v8[ACCESS_REG_8(i)];
-                if (t & 0x80) t = -t;
-                sum += (uint8_t)t;
-            }
-            wmmx->wR[CRd].v32[ACCESS_REG_32(1)] = 0;
-            wmmx->wR[CRd].v32[ACCESS_REG_32(0)] = sum;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0101:  // WSADHZ
-            sum = 0;
-            // fallthrough
-        case 0b0100:  // WSADH
-            for (i = 0; i < 4; i++) {
-                t = wmmx->wR[CRn].v16[ACCESS_REG_16(i)] - wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
-                if (t & 0x8000) t = -t;
-                sum += (uint16_t)t;
-            }
-            wmmx->wR[CRd].v32[ACCESS_REG_32(1)] = 0;
-            wmmx->wR[CRd].v32[ACCESS_REG_32(0)] = sum;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingMinMax(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                              uint_fast8_t CRd, uint_fast8_t CRn,
-                                              uint_fast8_t CRm) {
-    uint_fast8_t i;
-
-    switch (op1) {
-        case 0b0000:  // WMAXUB
-            for (i = 0; i < 8; i++)
-                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] =
-                    wmmx->wR[CRn].v8[ACCESS_REG_8(i)] > wmmx->wR[CRm].v8[ACCESS_REG_8(i)]
-                        ? wmmx->wR[CRn].v8[ACCESS_REG_8(i)]
-                        : wmmx->wR[CRm].v8[ACCESS_REG_8(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0100:  // WMAXUH
-            for (i = 0; i < 4; i++)
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] =
-                    wmmx->wR[CRn].v16[ACCESS_REG_16(i)] > wmmx->wR[CRm].v16[ACCESS_REG_16(i)]
-                        ? wmmx->wR[CRn].v16[ACCESS_REG_16(i)]
-                        : wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1000:  // WMAXUW
-            for (i = 0; i < 2; i++)
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] =
-                    wmmx->wR[CRn].v32[ACCESS_REG_32(i)] > wmmx->wR[CRm].v32[ACCESS_REG_32(i)]
-                        ? wmmx->wR[CRn].v32[ACCESS_REG_32(i)]
-                        : wmmx->wR[CRm].v32[ACCESS_REG_32(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0010:  // WMAXSB
-            for (i = 0; i < 8; i++)
-                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] =
-                    wmmx->wR[CRn].s8[ACCESS_REG_8(i)] > wmmx->wR[CRm].s8[ACCESS_REG_8(i)]
-                        ? wmmx->wR[CRn].s8[ACCESS_REG_8(i)]
-                        : wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0110:  // WMAXSH
-            for (i = 0; i < 4; i++)
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] =
-                    wmmx->wR[CRn].s16[ACCESS_REG_16(i)] > wmmx->wR[CRm].s16[ACCESS_REG_16(i)]
-                        ? wmmx->wR[CRn].s16[ACCESS_REG_16(i)]
-                        : wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1010:  // WMAXSW
-            for (i = 0; i < 2; i++)
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] =
-                    wmmx->wR[CRn].s32[ACCESS_REG_32(i)] > wmmx->wR[CRm].s32[ACCESS_REG_32(i)]
-                        ? wmmx->wR[CRn].s32[ACCESS_REG_32(i)]
-                        : wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0001:  // WMINUB
-            for (i = 0; i < 8; i++)
-                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] =
-                    wmmx->wR[CRn].v8[ACCESS_REG_8(i)] < wmmx->wR[CRm].v8[ACCESS_REG_8(i)]
-                        ? wmmx->wR[CRn].v8[ACCESS_REG_8(i)]
-                        : wmmx->wR[CRm].v8[ACCESS_REG_8(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0101:  // WMINUH
-            for (i = 0; i < 4; i++)
-                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] =
-                    wmmx->wR[CRn].v16[ACCESS_REG_16(i)] < wmmx->wR[CRm].v16[ACCESS_REG_16(i)]
-                        ? wmmx->wR[CRn].v16[ACCESS_REG_16(i)]
-                        : wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1001:  // WMINUW
-            for (i = 0; i < 2; i++)
-                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] =
-                    wmmx->wR[CRn].v32[ACCESS_REG_32(i)] < wmmx->wR[CRm].v32[ACCESS_REG_32(i)]
-                        ? wmmx->wR[CRn].v32[ACCESS_REG_32(i)]
-                        : wmmx->wR[CRm].v32[ACCESS_REG_32(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0011:  // WMINSB
-            for (i = 0; i < 8; i++)
-                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] =
-                    wmmx->wR[CRn].s8[ACCESS_REG_8(i)] < wmmx->wR[CRm].s8[ACCESS_REG_8(i)]
-                        ? wmmx->wR[CRn].s8[ACCESS_REG_8(i)]
-                        : wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0111:  // WMINSH
-            for (i = 0; i < 4; i++)
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] =
-                    wmmx->wR[CRn].s16[ACCESS_REG_16(i)] < wmmx->wR[CRm].s16[ACCESS_REG_16(i)]
-                        ? wmmx->wR[CRn].s16[ACCESS_REG_16(i)]
-                        : wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1011:  // WMINSW
-            for (i = 0; i < 2; i++)
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] =
-                    wmmx->wR[CRn].s32[ACCESS_REG_32(i)] < wmmx->wR[CRm].s32[ACCESS_REG_32(i)]
-                        ? wmmx->wR[CRn].s32[ACCESS_REG_32(i)]
-                        : wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingAccumulate(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                                  uint_fast8_t CRd, uint_fast8_t CRn,
-                                                  uint_fast8_t CRm) {
-    uint64_t sum = 0;
-    uint_fast8_t i;
-
-    switch (op1) {
-        case 0b0000:  // WACC.b
-            for (i = 0; i < 8; i++) sum += wmmx->wR[CRn].v8[ACCESS_REG_8(i)];
-            wmmx->wR[CRd].v64 = sum;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b0100:  // WACC.h
-            for (i = 0; i < 4; i++) sum += wmmx->wR[CRn].v16[ACCESS_REG_16(i)];
-            wmmx->wR[CRd].v64 = sum;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        case 0b1000:  // WACC.w
-            for (i = 0; i < 2; i++) sum += wmmx->wR[CRn].v32[ACCESS_REG_32(i)];
-            wmmx->wR[CRd].v64 = sum;
-            pxa270wmmxPrvDataRegsChanged(wmmx);
-            break;
-
-        default:
-            return false;
-    }
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingShuffle(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                               uint_fast8_t CRd, uint_fast8_t CRn,
-                                               uint_fast8_t CRm) {
-    uint_fast8_t i, which = (op1 << 4) + CRm;
-    uint_fast16_t tf16;
-    union REG64 ret;
-
-    wmmx->wCASF = 0;
-    for (i = 0; i < 4; i++, which >>= 2) {
-        ret.v16[ACCESS_REG_16(i)] = tf16 = wmmx->wR[CRn].v16[ACCESS_REG_16(which & 3)];
-        if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
-        if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
-    }
-    wmmx->wR[CRd].v64 = ret.v64;
-    pxa270wmmxPrvControlRegsChanged(wmmx);
-    pxa270wmmxPrvDataRegsChanged(wmmx);
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingAddition(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                                uint_fast8_t CRd, uint_fast8_t CRn,
-                                                uint_fast8_t CRm) {
-    uint_fast8_t i;
-    int_fast16_t sf16;
-    int_fast32_t sf32;
-    int_fast64_t sf64;
-
-    wmmx->wCASF = 0;
-    switch (op1) {
-        case 0b0000:  // WADD.b
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
-                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] +
-                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
-                if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
-                if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
-                if (sf16 & 0x0100) wmmx->wCASF |= 0x2ul << (i * 4);
-                sf16 >>= 7;
-                sf16 &= 3;
-                if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
-            }
-            break;
-
-        case 0b0100:  // WADD.h
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
-                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] +
-                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
-                if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
-                if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
-                if (sf32 & 0x010000l) wmmx->wCASF |= 0x20ul << (i * 8);
-                sf32 >>= 15;
-                sf32 &= 3;
-                if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
-            }
-            break;
-
-        case 0b1000:  // WADD.w
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
-                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] +
-                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
-                if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
-                if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
-                if (sf64 & 0x0100000000ll) wmmx->wCASF |= 0x2000ul << (i * 16);
-                sf64 >>= 31;
-                sf64 &= 3;
-                if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
-            }
-            break;
-
-        case 0b0001:  // WADDUS.b
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
-                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] +
-                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
-
-                if (sf16 >> 8) {
-                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = 0xff;
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                    wmmx->wCSSF |= 1 << i;
-                } else {
-                    if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
-                    if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
-                    if (sf16 & 0x0100) wmmx->wCASF |= 0x2ul << (i * 4);
-                    sf16 >>= 7;
-                    sf16 &= 3;
-                    if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
-                }
-            }
-            break;
-
-        case 0b0101:  // WADDUS.h
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
-                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] +
-                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
-
-                if (sf32 >> 16) {
-                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = 0xffff;
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                    wmmx->wCSSF |= 1 << (2 * i);
-                } else {
-                    if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
-                    if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
-                    if (sf32 & 0x010000l) wmmx->wCASF |= 0x20ul << (i * 8);
-                    sf32 >>= 15;
-                    sf32 &= 3;
-                    if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
-                }
-            }
-            break;
-
-        case 0b1001:  // WADDUS.w
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
-                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] +
-                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
-
-                if (sf64 >> 32) {
-                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = 0xffffffl;
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                    wmmx->wCSSF |= 1 << (4 * i);
-                } else {
-                    if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
-                    if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
-                    if (sf64 & 0x0100000000ll) wmmx->wCASF |= 0x2000ul << (i * 16);
-                    sf64 >>= 31;
-                    sf64 &= 3;
-                    if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
-                }
-            }
-            break;
-
-        case 0b0011:  // WADDSS.b
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
-                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] +
-                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
-
-                if (sf16 > 0x7f) {
-                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = 0x7f;
-                    wmmx->wCSSF |= 1 << i;
-                } else if (sf16 < -0x80) {
-                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = -0x80;
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                    wmmx->wCSSF |= 1 << i;
-                } else {
-                    if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
-                    if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
-                    if (sf16 & 0x0100) wmmx->wCASF |= 0x2ul << (i * 4);
-                    sf16 >>= 7;
-                    sf16 &= 3;
-                    if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
-                }
-            }
-            break;
-
-        case 0b0111:  // WADDSS.h
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
-                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] +
-                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
-
-                if (sf32 > 0x7fff) {
-                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = 0x7fff;
-                    wmmx->wCSSF |= 1 << (2 * i);
-                } else if (sf32 < -0x8000) {
-                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = -0x8000;
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                    wmmx->wCSSF |= 1 << (2 * i);
-                } else {
-                    if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
-                    if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
-                    if (sf32 & 0x010000l) wmmx->wCASF |= 0x20ul << (i * 8);
-                    sf32 >>= 15;
-                    sf32 &= 3;
-                    if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
-                }
-            }
-            break;
-
-        case 0b1011:  // WADDSS.w
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
-                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] +
-                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
-
-                if (sf64 > 0x7fffffffl) {
-                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = 0x7fffffffl;
-                    wmmx->wCSSF |= 1 << (4 * i);
-                } else if (sf64 < -0x80000000l) {
-                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = -0x80000000l;
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                    wmmx->wCSSF |= 1 << (4 * i);
-                } else {
-                    if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
-                    if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
-                    if (sf64 & 0x0100000000ll) wmmx->wCASF |= 0x2000ul << (i * 16);
-                    sf64 >>= 31;
-                    sf64 &= 3;
-                    if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
-                }
-            }
-            break;
-
-        default:
-            return false;
-    }
-    pxa270wmmxPrvControlRegsChanged(wmmx);
-    pxa270wmmxPrvDataRegsChanged(wmmx);
-    return true;
-}
-
-static bool pxa270wmmxPrvDataProcessingSubtraction(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
-                                                   uint_fast8_t CRd, uint_fast8_t CRn,
-                                                   uint_fast8_t CRm) {
-    uint_fast8_t i;
-    int_fast16_t sf16;
-    int_fast32_t sf32;
-    int_fast64_t sf64;
-
-    wmmx->wCASF = 0;
-    switch (op1) {
-        case 0b0000:  // WSUB.b
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
-                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] -
-                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
-                if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
-                if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
-                if (!(sf16 & 0x0100)) wmmx->wCASF |= 0x2ul << (i * 4);
-                sf16 >>= 7;
-                sf16 &= 3;
-                if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
-            }
-            break;
-
-        case 0b0100:  // WSUB.h
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
-                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] -
-                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
-                if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
-                if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
-                if (!(sf32 & 0x010000l)) wmmx->wCASF |= 0x20ul << (i * 8);
-                sf32 >>= 15;
-                sf32 &= 3;
-                if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
-            }
-            break;
-
-        case 0b1000:  // WSUB.w
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
-                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] -
-                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
-                if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
-                if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
-                if (!(sf64 & 0x0100000000ll)) wmmx->wCASF |= 0x2000ul << (i * 16);
-                sf64 >>= 31;
-                sf64 &= 3;
-                if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
-            }
-            break;
-
-        case 0b0001:  // WSUBUS.b
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
-                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] -
-                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
-
-                if (sf16 >> 8) {
-                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = 0xff;
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                    wmmx->wCSSF |= 1 << i;
-                } else {
-                    if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
-                    if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
-                    if (!(sf16 & 0x0100)) wmmx->wCASF |= 0x2ul << (i * 4);
-                    sf16 >>= 7;
-                    sf16 &= 3;
-                    if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
-                }
-            }
-            break;
-
-        case 0b0101:  // WSUBUS.h
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
-                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] -
-                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
-
-                if (sf32 >> 16) {
-                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = 0xffff;
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                    wmmx->wCSSF |= 1 << (2 * i);
-                } else {
-                    if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
-                    if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
-                    if (!(sf32 & 0x010000l)) wmmx->wCASF |= 0x20ul << (i * 8);
-                    sf32 >>= 15;
-                    sf32 &= 3;
-                    if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
-                }
-            }
-            break;
-
-        case 0b1001:  // WSUBUS.w
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
-                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] -
-                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
-
-                if (sf64 >> 32) {
-                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = 0xffffffl;
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                    wmmx->wCSSF |= 1 << (4 * i);
-                } else {
-                    if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
-                    if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
-                    if (!(sf64 & 0x0100000000ll)) wmmx->wCASF |= 0x2000ul << (i * 16);
-                    sf64 >>= 31;
-                    sf64 &= 3;
-                    if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
-                }
-            }
-            break;
-
-        case 0b0011:  // WSUBSS.b
-            for (i = 0; i < 8; i++) {
-                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
-                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] -
-                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
-
-                if (sf16 > 0x7f) {
-                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = 0x7f;
-                    wmmx->wCSSF |= 1 << i;
-                } else if (sf16 < -0x80) {
-                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = -0x80;
-                    wmmx->wCASF |= 0x8ul << (i * 4);
-                    wmmx->wCSSF |= 1 << i;
-                } else {
-                    if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
-                    if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
-                    if (!(sf16 & 0x0100)) wmmx->wCASF |= 0x2ul << (i * 4);
-                    sf16 >>= 7;
-                    sf16 &= 3;
-                    if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
-                }
-            }
-            break;
-
-        case 0b0111:  // WSUBSS.h
-            for (i = 0; i < 4; i++) {
-                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
-                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] -
-                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
-
-                if (sf32 > 0x7fff) {
-                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = 0x7fff;
-                    wmmx->wCSSF |= 1 << (2 * i);
-                } else if (sf32 < -0x8000) {
-                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = -0x8000;
-                    wmmx->wCASF |= 0x80ul << (i * 8);
-                    wmmx->wCSSF |= 1 << (2 * i);
-                } else {
-                    if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
-                    if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
-                    if (!(sf32 & 0x010000l)) wmmx->wCASF |= 0x20ul << (i * 8);
-                    sf32 >>= 15;
-                    sf32 &= 3;
-                    if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
-                }
-            }
-            break;
-
-        case 0b1011:  // WSUBSS.w
-            for (i = 0; i < 2; i++) {
-                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
-                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] -
-                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
-
-                if (sf64 > 0x7fffffffl) {
-                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = 0x7fffffffl;
-                    wmmx->wCSSF |= 1 << (4 * i);
-                } else if (sf64 < -0x80000000l) {
-                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = -0x80000000l;
-                    wmmx->wCASF |= 0x8000ul << (i * 16);
-                    wmmx->wCSSF |= 1 << (4 * i);
-                } else {
-                    if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
-                    if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
-                    if (!(sf64 & 0x0100000000ll)) wmmx->wCASF |= 0x2000ul << (i * 16);
-                    sf64 >>= 31;
-                    sf64 &= 3;
-                    if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
-                }
-            }
-            break;
-
-        default:
-            return false;
-    }
-    pxa270wmmxPrvControlRegsChanged(wmmx);
-    pxa270wmmxPrvDataRegsChanged(wmmx);
-    return true;
-}
-
 static bool pxa270wmmxPrvDataProcessing0(struct ArmCpu *cpu, void *userData, bool two, uint8_t op1,
                                          uint8_t CRd, uint8_t CRn, uint8_t CRm, uint8_t op2) {
-    struct Pxa270wmmx *wmmx = (struct Pxa270wmmx *)userData;
-
     if (two) return false;
 
-    switch (op2) {
-        case 0b000:
-            return pxa270wmmxPrvDataProcessingMisc(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b001:
-            return pxa270wmmxPrvDataProcessingAlign(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b010:
-            return pxa270wmmxPrvDataProcessingShift(wmmx, false, op1, CRd, CRn, CRm);
-
-        case 0b011:
-            return pxa270wmmxPrvDataProcessingCompare(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b100:
-            return pxa270wmmxPrvDataProcessingPack(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b110:
-            return pxa270wmmxPrvDataProcessingUnpack(wmmx, false, op1, CRd, CRn, CRm);
-
-        case 0b111:
-            return pxa270wmmxPrvDataProcessingUnpack(wmmx, true, op1, CRd, CRn, CRm);
-
-        default:
-            return false;
-    }
-    return true;
+    return pxa270wmmxDataProcessing((struct Pxa270wmmx *)userData, false, op1, CRd, CRn, CRm, op2);
 }
 
 static bool pxa270wmmxPrvDataProcessing1(struct ArmCpu *cpu, void *userData, bool two, uint8_t op1,
                                          uint8_t CRd, uint8_t CRn, uint8_t CRm, uint8_t op2) {
-    struct Pxa270wmmx *wmmx = (struct Pxa270wmmx *)userData;
-
     if (two) return false;
 
-    switch (op2) {
-        case 0b000:
-            return pxa270wmmxPrvDataProcessingMultiply(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b001:
-            return pxa270wmmxPrvDataProcessingDifference(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b010:
-            return pxa270wmmxPrvDataProcessingShift(wmmx, true, op1, CRd, CRn, CRm);
-
-        case 0b011:
-            return pxa270wmmxPrvDataProcessingMinMax(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b100:
-            return pxa270wmmxPrvDataProcessingAddition(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b101:
-            return pxa270wmmxPrvDataProcessingSubtraction(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b110:
-            return pxa270wmmxPrvDataProcessingAccumulate(wmmx, op1, CRd, CRn, CRm);
-
-        case 0b111:
-            return pxa270wmmxPrvDataProcessingShuffle(wmmx, op1, CRd, CRn, CRm);
-
-        default:
-            return false;
-    }
+    return pxa270wmmxDataProcessing((struct Pxa270wmmx *)userData, true, op1, CRd, CRn, CRm, op2);
 }
 
 static void pxa270wmmxPrvSetCoreReg(struct ArmCpu *cpu, uint_fast8_t reg, uint32_t val) {
@@ -2143,3 +583,12 @@ struct Pxa270wmmx *pxa270wmmxInit(struct ArmCpu *cpu) {
 
     return wmmx;
 }
+
+void pxa270wmmxSerialize(struct Pxa270wmmx *wmmx, struct SavestateChunk *chunk) {
+    for (size_t i = 0; i < 16; i++) savestateChunkDo64(chunk, &wmmx->wR[i].v64);
+    for (size_t i = 0; i < 4; i++) savestateChunkDo32(chunk, wmmx->wCGR + i);
+
+    savestateChunkDo32(chunk, &wmmx->wCASF);
+    savestateChunkDo8(chunk, &wmmx->wCon);
+    savestateChunkDo8(chunk, &wmmx->wCSSF);
+}
@@ -11,9 +11,12 @@ extern "C" {
 #endif
 
 struct Pxa270wmmx;
+struct SavestateChunk;
 
 struct Pxa270wmmx* pxa270wmmxInit(struct ArmCpu* cpu);
 
+void pxa270wmmxSerialize(struct Pxa270wmmx* wmmx, struct SavestateChunk* chunk);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,1990 @@
+#include "pxa270_WMMX_dp.h"
+
+#include "cputil.h"
+
+static void pxa270wmmxPrvSetFlagsForLogical64(struct Pxa270wmmx *wmmx, uint64_t val) {
+    wmmx->wCASF = ((val >> 63) ? 0x80000000ul : 0) | (val ? 0 : 0x40000000ul);
+    pxa270wmmxPrvControlRegsChanged(wmmx);
+}
+
+static void pxa270wmmxPrvAlign(struct Pxa270wmmx *wmmx, uint_fast8_t CRd, uint_fast8_t CRn,
+                               uint_fast8_t CRm, uint_fast8_t by) {
+    union REG64 ret;
+    uint_fast8_t i;
+
+    for (i = 0; i < 8 - by; i++) ret.v8[ACCESS_REG_8(i)] = wmmx->wR[CRn].v8[ACCESS_REG_8(i + by)];
+    for (; i < 8; i++) ret.v8[ACCESS_REG_8(i)] = wmmx->wR[CRm].v8[ACCESS_REG_8(i - 8 + by)];
+    wmmx->wR[CRd].v64 = ret.v64;
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+}
+
+static bool pxa270wmmxPrvDataProcessingMisc(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                            uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
+    uint_fast8_t i, tf8;
+    uint_fast16_t tf16;
+    uint64_t tmp;
+
+    switch (op1) {
+        case 0b0000:  // WOR
+            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 | wmmx->wR[CRm].v64;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
+            break;
+
+        case 0b0001:  // WXOR
+            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 ^ wmmx->wR[CRm].v64;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
+            break;
+
+        case 0b0010:  // WAND
+            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 & wmmx->wR[CRm].v64;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
+            break;
+
+        case 0b0011:  // WANDN
+            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].v64 & ~wmmx->wR[CRm].v64;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
+            break;
+
+        case 0b1000:  // WAVG2 (byte size)
+        case 0b1001:
+            wmmx->wCASF = 0;
+            for (i = 0, tmp = 0x04; i < 8; i++, tmp <<= 4) {
+                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] = tf8 =
+                    (wmmx->wR[CRn].v8[ACCESS_REG_8(i)] + wmmx->wR[CRm].v8[ACCESS_REG_8(i)] +
+                     (op1 & 1)) /
+                    2;
+                if (!tf8) wmmx->wCASF |= tmp;
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1100:  // WAVG2 (halfword size)
+        case 0b1101:
+            wmmx->wCASF = 0;
+            for (i = 0, tmp = 0x40; i < 4; i++, tmp <<= 8) {
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
+                    (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] + wmmx->wR[CRm].v16[ACCESS_REG_16(i)] +
+                     (op1 & 1)) /
+                    2;
+                if (!tf16) wmmx->wCASF |= tmp;
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingAlign(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                             uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
+    switch (op1) {
+        case 0b0000:  // WALIGNI
+        case 0b0001:
+        case 0b0010:
+        case 0b0011:
+        case 0b0100:
+        case 0b0101:
+        case 0b0110:
+        case 0b0111:
+            pxa270wmmxPrvAlign(wmmx, CRd, CRn, CRm, (op1 & 7));
+            break;
+
+        case 0b1000:  // WALIGNR
+        case 0b1001:
+        case 0b1010:
+        case 0b1011:
+            pxa270wmmxPrvAlign(wmmx, CRd, CRn, CRm, wmmx->wCGR[op1 & 3] & 7);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+// Counts of the lane width and above clear logical shifts, fill arithmetic shifts with the sign
+// and wrap around for rotations
+static bool pxa270wmmxPrvDataProcessingShift(struct Pxa270wmmx *wmmx, bool cp1, uint_fast8_t op1,
+                                             uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
+    uint_fast8_t i, by;
+    uint_fast16_t tf16;
+    uint_fast32_t tf32;
+    uint64_t tmp;
+
+    switch (op1) {
+        case 0b0100:  // WSRA.h
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
+                    wmmx->wR[CRn].s16[ACCESS_REG_16(i)] >> (by < 16 ? by : 15);
+                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
+                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1000:  // WSRA.w
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
+                    wmmx->wR[CRn].s32[ACCESS_REG_32(i)] >> (by < 32 ? by : 31);
+                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
+                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1100:  // WSRA.d
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wR[CRd].v64 = tmp = wmmx->wR[CRn].s64 >> (by < 64 ? by : 63);
+            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0101:  // WSLL.h
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
+                    by < 16 ? wmmx->wR[CRn].v16[ACCESS_REG_16(i)] << by : 0;
+                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
+                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1001:  // WSLL.w
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
+                    by < 32 ? wmmx->wR[CRn].v32[ACCESS_REG_32(i)] << by : 0;
+                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
+                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1101:  // WSLL.d
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wR[CRd].v64 = tmp = by < 64 ? wmmx->wR[CRn].v64 << by : 0;
+            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0110:  // WSRL.h
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
+                    by < 16 ? wmmx->wR[CRn].v16[ACCESS_REG_16(i)] >> by : 0;
+                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
+                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1010:  // WSRL.w
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
+                    by < 32 ? wmmx->wR[CRn].v32[ACCESS_REG_32(i)] >> by : 0;
+                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
+                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1110:  // WSRL.d
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+
+            wmmx->wR[CRd].v64 = tmp = by < 64 ? wmmx->wR[CRn].v64 >> by : 0;
+            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0111:  // WROR.h
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+            by &= 15;
+
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                if (by)
+                    tf16 = (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] >> by) |
+                           (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] << (16 - by));
+                else
+                    tf16 = wmmx->wR[CRn].v16[ACCESS_REG_16(i)];
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16;
+                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
+                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1011:  // WROR.w
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+            by &= 31;
+
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                if (by)
+                    tf32 = (wmmx->wR[CRn].v32[ACCESS_REG_32(i)] >> by) |
+                           (wmmx->wR[CRn].v32[ACCESS_REG_32(i)] << (32 - by));
+                else
+                    tf32 = wmmx->wR[CRn].v32[ACCESS_REG_32(i)];
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32;
+                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
+                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1111:  // WROR.d
+            if (!cp1)
+                by = wmmx->wR[CRm].v8[ACCESS_REG_8(0)];
+            else if (CRm >= 4)
+                return false;
+            else
+                by = wmmx->wCGR[CRm];
+            by &= 63;
+
+            if (by)
+                tmp = (wmmx->wR[CRn].v64 >> by) | (wmmx->wR[CRn].v64 << (64 - by));
+            else
+                tmp = wmmx->wR[CRn].v64;
+            wmmx->wR[CRd].v64 = tmp;
+            pxa270wmmxPrvSetFlagsForLogical64(wmmx, tmp);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingCompare(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                               uint_fast8_t CRd, uint_fast8_t CRn,
+                                               uint_fast8_t CRm) {
+    uint_fast8_t i, tf8;
+    uint_fast16_t tf16;
+    uint_fast32_t tf32;
+
+    switch (op1) {
+        case 0b0000:  // WCMPEQ.b
+            wmmx->wCASF = 0;
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] = tf8 =
+                    (wmmx->wR[CRn].v8[ACCESS_REG_8(i)] == wmmx->wR[CRm].v8[ACCESS_REG_8(i)]) ? 0xFF
+                                                                                             : 0x00;
+                if (tf8)
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                else
+                    wmmx->wCASF |= 0x4ul << (i * 4);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0100:  // WCMPEQ.h
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
+                    (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] == wmmx->wR[CRm].v16[ACCESS_REG_16(i)])
+                        ? 0xFFFF
+                        : 0x00;
+                if (tf16)
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                else
+                    wmmx->wCASF |= 0x40ul << (i * 8);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1000:  // WCMPEQ.w
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
+                    (wmmx->wR[CRn].v32[ACCESS_REG_32(i)] == wmmx->wR[CRm].v32[ACCESS_REG_32(i)])
+                        ? 0xFFFFFFFFUL
+                        : 0x00;
+                if (tf32)
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                else
+                    wmmx->wCASF |= 0x4000ul << (i * 16);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0001:  // WCMPGTU.b
+            wmmx->wCASF = 0;
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] = tf8 =
+                    (wmmx->wR[CRn].v8[ACCESS_REG_8(i)] > wmmx->wR[CRm].v8[ACCESS_REG_8(i)]) ? 0xFF
+                                                                                            : 0x00;
+                if (tf8)
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                else
+                    wmmx->wCASF |= 0x4ul << (i * 4);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0101:  // WCMPGTU.h
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
+                    (wmmx->wR[CRn].v16[ACCESS_REG_16(i)] > wmmx->wR[CRm].v16[ACCESS_REG_16(i)])
+                        ? 0xFFFF
+                        : 0x00;
+                if (tf16)
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                else
+                    wmmx->wCASF |= 0x40ul << (i * 8);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1001:  // WCMPGTU.w
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
+                    (wmmx->wR[CRn].v32[ACCESS_REG_32(i)] > wmmx->wR[CRm].v32[ACCESS_REG_32(i)])
+                        ? 0xFFFFFFFFUL
+                        : 0x00;
+                if (tf32)
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                else
+                    wmmx->wCASF |= 0x4000ul << (i * 16);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0011:  // WCMPGTS.b
+            wmmx->wCASF = 0;
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] = tf8 =
+                    (wmmx->wR[CRn].s8[ACCESS_REG_8(i)] > wmmx->wR[CRm].s8[ACCESS_REG_8(i)]) ? 0xFF
+                                                                                            : 0x00;
+                if (tf8)
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                else
+                    wmmx->wCASF |= 0x4ul << (i * 4);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0111:  // WCMPGTS.h
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] = tf16 =
+                    (wmmx->wR[CRn].s16[ACCESS_REG_16(i)] > wmmx->wR[CRm].s16[ACCESS_REG_16(i)])
+                        ? 0xFFFF
+                        : 0x00;
+                if (tf16)
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                else
+                    wmmx->wCASF |= 0x40ul << (i * 8);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1011:  // WCMPGTS.w
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] = tf32 =
+                    (wmmx->wR[CRn].s32[ACCESS_REG_32(i)] > wmmx->wR[CRm].s32[ACCESS_REG_32(i)])
+                        ? 0xFFFFFFFFUL
+                        : 0x00;
+                if (tf32)
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                else
+                    wmmx->wCASF |= 0x4000ul << (i * 16);
+            }
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingPack(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                            uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
+    uint_fast8_t i, j, from;
+    int_fast16_t ts16;
+    int_fast32_t ts32;
+    int_fast64_t ts64;
+    union REG64 ret;
+
+    switch (op1) {
+        case 0b0101:  // WPACKUS.h
+            wmmx->wCASF = 0;
+            for (i = 0; i < 8; i++) {
+                from = i < 4 ? CRn : CRm;
+                j = i % 4;
+
+                ts16 = wmmx->wR[from].s16[ACCESS_REG_16(j)];
+                if (ts16 < 0) {
+                    ts16 = 0;
+                    wmmx->wCSSF |= 1 << i;
+                    wmmx->wCASF |= 0x4ul << (i * 4);
+                } else if (ts16 > 0xff) {
+                    ts16 = 0xff;
+                    wmmx->wCSSF |= 1 << i;
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                } else {
+                    if (!ts16) wmmx->wCASF |= 0x4ul << (i * 4);
+                    if (ts16 & 0x80) wmmx->wCASF |= 0x8ul << (i * 4);
+                }
+
+                ret.v8[ACCESS_REG_8(i)] = ts16;
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1001:  // WPACKUS.w
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                from = i < 2 ? CRn : CRm;
+                j = i % 2;
+
+                ts32 = wmmx->wR[from].s32[ACCESS_REG_32(j)];
+                if (ts32 < 0) {
+                    ts32 = 0;
+                    wmmx->wCSSF |= 1 << (i * 2);
+                    wmmx->wCASF |= 0x40ul << (i * 8);
+                } else if (ts32 > 0xffffl) {
+                    ts32 = 0xffff;
+                    wmmx->wCSSF |= 1 << (i * 2);
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                } else {
+                    if (!ts32) wmmx->wCASF |= 0x40ul << (i * 8);
+                    if (ts32 & 0x8000u) wmmx->wCASF |= 0x80ul << (i * 8);
+                }
+
+                ret.v16[ACCESS_REG_16(i)] = ts32;
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1101:  // WPACKUS.d
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                ts64 = wmmx->wR[i ? CRm : CRn].s64;
+                if (ts64 < 0) {
+                    ts64 = 0;
+                    wmmx->wCSSF |= 1 << (i * 4);
+                    wmmx->wCASF |= 0x4000ul << (i * 16);
+                } else if (ts64 > 0xffffffffll) {
+                    ts64 = 0xffffffffll;
+                    wmmx->wCSSF |= 1 << (i * 4);
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                } else {
+                    if (!ts64) wmmx->wCASF |= 0x4000ul << (i * 16);
+                    if (ts64 & 0x800000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
+                }
+
+                ret.v32[ACCESS_REG_32(i)] = ts64;
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0111:  // WPACKSS.h
+            wmmx->wCASF = 0;
+            for (i = 0; i < 8; i++) {
+                from = i < 4 ? CRn : CRm;
+                j = i % 4;
+
+                ts16 = wmmx->wR[from].s16[ACCESS_REG_16(j)];
+                if (ts16 < -0x80) {
+                    ts16 = -0x80;
+                    wmmx->wCSSF |= 1 << i;
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                } else if (ts16 > 0x7f) {
+                    ts16 = 0x7f;
+                    wmmx->wCSSF |= 1 << i;
+                } else {
+                    if (!ts16) wmmx->wCASF |= 0x4ul << (i * 4);
+                    if (ts16 < 0) wmmx->wCASF |= 0x8ul << (i * 4);
+                }
+
+                ret.v8[ACCESS_REG_8(i)] = ts16;
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1011:  // WPACKSS.w
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                from = i < 2 ? CRn : CRm;
+                j = i % 2;
+
+                ts32 = wmmx->wR[from].s32[ACCESS_REG_32(j)];
+                if (ts32 < -0x8000) {
+                    ts32 = -0x8000;
+                    wmmx->wCSSF |= 1 << (i * 2);
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                } else if (ts32 > 0x7fff) {
+                    ts32 = 0x7fff;
+                    wmmx->wCSSF |= 1 << (i * 2);
+                } else {
+                    if (!ts32) wmmx->wCASF |= 0x40ul << (i * 8);
+                    if (ts32 < 0) wmmx->wCASF |= 0x80ul << (i * 8);
+                }
+
+                ret.v16[ACCESS_REG_16(i)] = ts32;
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1111:  // WPACKSS.d
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                ts64 = wmmx->wR[i ? CRm : CRn].s64;
+                if (ts64 < -0x80000000ll) {
+                    ts64 = -0x80000000ll;
+                    wmmx->wCSSF |= 1 << (i * 4);
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                } else if (ts64 > 0x7fffffffll) {
+                    ts64 = 0x7fffffffll;
+                    wmmx->wCSSF |= 1 << (i * 4);
+                } else {
+                    if (!ts64) wmmx->wCASF |= 0x4000ul << (i * 16);
+                    if (ts64 < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
+                }
+
+                ret.v32[ACCESS_REG_32(i)] = ts64;
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingUnpack(struct Pxa270wmmx *wmmx, bool hi, uint_fast8_t op1,
+                                              uint_fast8_t CRd, uint_fast8_t CRn,
+                                              uint_fast8_t CRm) {
+    uint_fast8_t i, tf8;
+    uint_fast32_t tf32;
+    uint_fast16_t tf16;
+    int_fast64_t ts64;
+    int_fast32_t ts32;
+    int_fast16_t ts16;
+    union REG64 ret;
+
+    switch (op1) {
+        case 0b0010:  // WUNPACKESx.b
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                ret.s16[ACCESS_REG_16(i)] = ts16 = wmmx->wR[CRn].s8[ACCESS_REG_8(i + (hi ? 4 : 0))];
+                if (!ts16) wmmx->wCASF |= 0x40ul << (i * 8);
+                if (ts16 < 0) wmmx->wCASF |= 0x80ul << (i * 8);
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0110:  // WUNPACKESx.h
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                ret.s32[ACCESS_REG_32(i)] = ts32 =
+                    wmmx->wR[CRn].s16[ACCESS_REG_16(i + (hi ? 2 : 0))];
+                if (!ts32) wmmx->wCASF |= 0x4000ul << (i * 16);
+                if (ts32 < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1010:  // WUNPACKESx.w
+            wmmx->wCASF = 0;
+            wmmx->wR[CRd].s64 = ts64 = wmmx->wR[CRn].s32[ACCESS_REG_32(hi ? 1 : 0)];
+            if (!ts64) wmmx->wCASF |= 0x40000000ul;
+            if (ts64 < 0) wmmx->wCASF |= 0x80000000ul;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0000:  // WUNPACKEUx.b
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                ret.v16[ACCESS_REG_16(i)] = tf8 = wmmx->wR[CRn].v8[ACCESS_REG_8(i + (hi ? 4 : 0))];
+                if (!tf8) wmmx->wCASF |= 0x40ul << (i * 8);
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0100:  // WUNPACKEUx.h
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                ret.v32[ACCESS_REG_32(i)] = tf16 =
+                    wmmx->wR[CRn].v16[ACCESS_REG_16(i + (hi ? 2 : 0))];
+                if (!tf16) wmmx->wCASF |= 0x4000ul << (i * 16);
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1000:  // WUNPACKEUx.w
+            wmmx->wCASF = 0;
+            wmmx->wR[CRd].v64 = tf32 = wmmx->wR[CRn].v32[ACCESS_REG_32(hi ? 1 : 0)];
+            if (!tf32) wmmx->wCASF |= 0x40000000ul;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0001:  // WUNPACKIx.b
+            wmmx->wCASF = 0;
+            for (i = 0; i < 8; i++) {
+                ret.v8[ACCESS_REG_8(i)] = tf8 =
+                    wmmx->wR[(i & 1) ? CRm : CRn].v8[ACCESS_REG_8(i / 2 + (hi ? 4 : 0))];
+                if (!tf8) wmmx->wCASF |= 0x4ul << (i * 4);
+                if (tf8 & 0x80) wmmx->wCASF |= 0x8ul << (i * 4);
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0101:  // WUNPACKIx.h
+            wmmx->wCASF = 0;
+            for (i = 0; i < 4; i++) {
+                ret.v16[ACCESS_REG_16(i)] = tf16 =
+                    wmmx->wR[(i & 1) ? CRm : CRn].v16[ACCESS_REG_16(i / 2 + (hi ? 2 : 0))];
+                if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
+                if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1001:  // WUNPACKIx.w
+            wmmx->wCASF = 0;
+            for (i = 0; i < 2; i++) {
+                ret.v32[ACCESS_REG_32(i)] = tf32 =
+                    wmmx->wR[(i & 1) ? CRm : CRn].v32[ACCESS_REG_32(hi ? 1 : 0)];
+                if (!tf32) wmmx->wCASF |= 0x4000ul << (i * 16);
+                if (tf32 & 0x80000000ul) wmmx->wCASF |= 0x8000ul << (i * 16);
+            }
+            wmmx->wR[CRd].v64 = ret.v64;
+            pxa270wmmxPrvControlRegsChanged(wmmx);
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingMultiply(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                                uint_fast8_t CRd, uint_fast8_t CRn,
+                                                uint_fast8_t CRm) {
+    uint64_t sum = wmmx->wR[CRd].v64;
+    uint_fast8_t i;
+
+    switch (op1) {
+        case 0b0000:  // WMULUL		//When L is specified the U and S qualifiers produce the
+                      // same result
+        case 0b0010:  // WMULSL
+            for (i = 0; i < 4; i++)
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] =
+                    wmmx->wR[CRn].v16[ACCESS_REG_16(i)] * wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0001:  // WMULUM
+            for (i = 0; i < 4; i++)
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] =
+                    ((uint_fast32_t)wmmx->wR[CRn].v16[ACCESS_REG_16(i)] *
+                     (uint_fast32_t)wmmx->wR[CRm].v16[ACCESS_REG_16(i)]) >>
+                    16;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0011:  // WMULSM
+            for (i = 0; i < 4; i++)
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] =
+                    ((int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] *
+                     (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)]) >>
+                    16;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0101:  // WMACUZ
+            sum = 0;
+            // fallthrough
+        case 0b0100:  // WMACU
+            for (i = 0; i < 4; i++) {
+                sum += (uint_fast32_t)wmmx->wR[CRn].v16[ACCESS_REG_16(i)] *
+                       (uint_fast32_t)wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
+            }
+            wmmx->wR[CRd].v64 = sum;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0111:  // WMACSZ
+            sum = 0;
+            // fallthrough
+        case 0b0110:  // WMACS
+            for (i = 0; i < 4; i++) {
+                sum += (int64_t)((int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] *
+                                 (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)]);
+            }
+            wmmx->wR[CRd].v64 = sum;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1000:  // WMADDU
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] =
+                    (uint_fast32_t)wmmx->wR[CRn].v16[ACCESS_REG_16(i * 2 + 0)] *
+                        (uint_fast32_t)wmmx->wR[CRm].v16[ACCESS_REG_16(i * 2 + 0)] +
+                    (uint_fast32_t)wmmx->wR[CRn].v16[ACCESS_REG_16(i * 2 + 1)] *
+                        (uint_fast32_t)wmmx->wR[CRm].v16[ACCESS_REG_16(i * 2 + 1)];
+            }
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1010:  // WMADDS
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] =
+                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i * 2 + 0)] *
+                        (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i * 2 + 0)] +
+                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i * 2 + 1)] *
+                        (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i * 2 + 1)];
+            }
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingDifference(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                                  uint_fast8_t CRd, uint_fast8_t CRn,
+                                                  uint_fast8_t CRm) {
+    uint_fast32_t sum = wmmx->wR[CRd].v32[ACCESS_REG_32(0)];
+    uint_fast8_t i, t;
+
+    switch (op1) {
+        case 0b0001:  // WSADBZ
+            sum = 0;
+            // fallthrough
+        case 0b0000:  // WSADB
+            for (i = 0; i < 8; i++) {
+                t = wmmx->wR[CRn].v8[ACCESS_REG_8(i)] - wmmx->wR[CRm].v8[ACCESS_REG_8(i)];
+                if (t & 0x80) t = -t;
+                sum += (uint8_t)t;
+            }
+            wmmx->wR[CRd].v32[ACCESS_REG_32(1)] = 0;
+            wmmx->wR[CRd].v32[ACCESS_REG_32(0)] = sum;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0101:  // WSADHZ
+            sum = 0;
+            // fallthrough
+        case 0b0100:  // WSADH
+            for (i = 0; i < 4; i++) {
+                t = wmmx->wR[CRn].v16[ACCESS_REG_16(i)] - wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
+                if (t & 0x8000) t = -t;
+                sum += (uint16_t)t;
+            }
+            wmmx->wR[CRd].v32[ACCESS_REG_32(1)] = 0;
+            wmmx->wR[CRd].v32[ACCESS_REG_32(0)] = sum;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingMinMax(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                              uint_fast8_t CRd, uint_fast8_t CRn,
+                                              uint_fast8_t CRm) {
+    uint_fast8_t i;
+
+    switch (op1) {
+        case 0b0000:  // WMAXUB
+            for (i = 0; i < 8; i++)
+                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] =
+                    wmmx->wR[CRn].v8[ACCESS_REG_8(i)] > wmmx->wR[CRm].v8[ACCESS_REG_8(i)]
+                        ? wmmx->wR[CRn].v8[ACCESS_REG_8(i)]
+                        : wmmx->wR[CRm].v8[ACCESS_REG_8(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0100:  // WMAXUH
+            for (i = 0; i < 4; i++)
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] =
+                    wmmx->wR[CRn].v16[ACCESS_REG_16(i)] > wmmx->wR[CRm].v16[ACCESS_REG_16(i)]
+                        ? wmmx->wR[CRn].v16[ACCESS_REG_16(i)]
+                        : wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1000:  // WMAXUW
+            for (i = 0; i < 2; i++)
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] =
+                    wmmx->wR[CRn].v32[ACCESS_REG_32(i)] > wmmx->wR[CRm].v32[ACCESS_REG_32(i)]
+                        ? wmmx->wR[CRn].v32[ACCESS_REG_32(i)]
+                        : wmmx->wR[CRm].v32[ACCESS_REG_32(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0010:  // WMAXSB
+            for (i = 0; i < 8; i++)
+                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] =
+                    wmmx->wR[CRn].s8[ACCESS_REG_8(i)] > wmmx->wR[CRm].s8[ACCESS_REG_8(i)]
+                        ? wmmx->wR[CRn].s8[ACCESS_REG_8(i)]
+                        : wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0110:  // WMAXSH
+            for (i = 0; i < 4; i++)
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] =
+                    wmmx->wR[CRn].s16[ACCESS_REG_16(i)] > wmmx->wR[CRm].s16[ACCESS_REG_16(i)]
+                        ? wmmx->wR[CRn].s16[ACCESS_REG_16(i)]
+                        : wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1010:  // WMAXSW
+            for (i = 0; i < 2; i++)
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] =
+                    wmmx->wR[CRn].s32[ACCESS_REG_32(i)] > wmmx->wR[CRm].s32[ACCESS_REG_32(i)]
+                        ? wmmx->wR[CRn].s32[ACCESS_REG_32(i)]
+                        : wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0001:  // WMINUB
+            for (i = 0; i < 8; i++)
+                wmmx->wR[CRd].v8[ACCESS_REG_8(i)] =
+                    wmmx->wR[CRn].v8[ACCESS_REG_8(i)] < wmmx->wR[CRm].v8[ACCESS_REG_8(i)]
+                        ? wmmx->wR[CRn].v8[ACCESS_REG_8(i)]
+                        : wmmx->wR[CRm].v8[ACCESS_REG_8(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0101:  // WMINUH
+            for (i = 0; i < 4; i++)
+                wmmx->wR[CRd].v16[ACCESS_REG_16(i)] =
+                    wmmx->wR[CRn].v16[ACCESS_REG_16(i)] < wmmx->wR[CRm].v16[ACCESS_REG_16(i)]
+                        ? wmmx->wR[CRn].v16[ACCESS_REG_16(i)]
+                        : wmmx->wR[CRm].v16[ACCESS_REG_16(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1001:  // WMINUW
+            for (i = 0; i < 2; i++)
+                wmmx->wR[CRd].v32[ACCESS_REG_32(i)] =
+                    wmmx->wR[CRn].v32[ACCESS_REG_32(i)] < wmmx->wR[CRm].v32[ACCESS_REG_32(i)]
+                        ? wmmx->wR[CRn].v32[ACCESS_REG_32(i)]
+                        : wmmx->wR[CRm].v32[ACCESS_REG_32(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0011:  // WMINSB
+            for (i = 0; i < 8; i++)
+                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] =
+                    wmmx->wR[CRn].s8[ACCESS_REG_8(i)] < wmmx->wR[CRm].s8[ACCESS_REG_8(i)]
+                        ? wmmx->wR[CRn].s8[ACCESS_REG_8(i)]
+                        : wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0111:  // WMINSH
+            for (i = 0; i < 4; i++)
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] =
+                    wmmx->wR[CRn].s16[ACCESS_REG_16(i)] < wmmx->wR[CRm].s16[ACCESS_REG_16(i)]
+                        ? wmmx->wR[CRn].s16[ACCESS_REG_16(i)]
+                        : wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1011:  // WMINSW
+            for (i = 0; i < 2; i++)
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] =
+                    wmmx->wR[CRn].s32[ACCESS_REG_32(i)] < wmmx->wR[CRm].s32[ACCESS_REG_32(i)]
+                        ? wmmx->wR[CRn].s32[ACCESS_REG_32(i)]
+                        : wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingAccumulate(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                                  uint_fast8_t CRd, uint_fast8_t CRn,
+                                                  uint_fast8_t CRm) {
+    uint64_t sum = 0;
+    uint_fast8_t i;
+
+    switch (op1) {
+        case 0b0000:  // WACC.b
+            for (i = 0; i < 8; i++) sum += wmmx->wR[CRn].v8[ACCESS_REG_8(i)];
+            wmmx->wR[CRd].v64 = sum;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b0100:  // WACC.h
+            for (i = 0; i < 4; i++) sum += wmmx->wR[CRn].v16[ACCESS_REG_16(i)];
+            wmmx->wR[CRd].v64 = sum;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        case 0b1000:  // WACC.w
+            for (i = 0; i < 2; i++) sum += wmmx->wR[CRn].v32[ACCESS_REG_32(i)];
+            wmmx->wR[CRd].v64 = sum;
+            pxa270wmmxPrvDataRegsChanged(wmmx);
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingShuffle(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                               uint_fast8_t CRd, uint_fast8_t CRn,
+                                               uint_fast8_t CRm) {
+    uint_fast8_t i, which = (op1 << 4) + CRm;
+    uint_fast16_t tf16;
+    union REG64 ret;
+
+    wmmx->wCASF = 0;
+    for (i = 0; i < 4; i++, which >>= 2) {
+        ret.v16[ACCESS_REG_16(i)] = tf16 = wmmx->wR[CRn].v16[ACCESS_REG_16(which & 3)];
+        if (!tf16) wmmx->wCASF |= 0x40ul << (i * 8);
+        if (tf16 & 0x8000) wmmx->wCASF |= 0x80ul << (i * 8);
+    }
+    wmmx->wR[CRd].v64 = ret.v64;
+    pxa270wmmxPrvControlRegsChanged(wmmx);
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingAddition(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                                uint_fast8_t CRd, uint_fast8_t CRn,
+                                                uint_fast8_t CRm) {
+    uint_fast8_t i;
+    int_fast16_t sf16;
+    int_fast32_t sf32;
+    int_fast64_t sf64;
+
+    wmmx->wCASF = 0;
+    switch (op1) {
+        case 0b0000:  // WADD.b
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
+                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] +
+                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
+                if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
+                if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
+                if (sf16 & 0x0100) wmmx->wCASF |= 0x2ul << (i * 4);
+                sf16 >>= 7;
+                sf16 &= 3;
+                if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
+            }
+            break;
+
+        case 0b0100:  // WADD.h
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
+                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] +
+                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
+                if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
+                if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
+                if (sf32 & 0x010000l) wmmx->wCASF |= 0x20ul << (i * 8);
+                sf32 >>= 15;
+                sf32 &= 3;
+                if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
+            }
+            break;
+
+        case 0b1000:  // WADD.w
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
+                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] +
+                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
+                if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
+                if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
+                if (sf64 & 0x0100000000ll) wmmx->wCASF |= 0x2000ul << (i * 16);
+                sf64 >>= 31;
+                sf64 &= 3;
+                if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
+            }
+            break;
+
+        case 0b0001:  // WADDUS.b
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
+                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] +
+                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
+
+                if (sf16 >> 8) {
+                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = 0xff;
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                    wmmx->wCSSF |= 1 << i;
+                } else {
+                    if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
+                    if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
+                    if (sf16 & 0x0100) wmmx->wCASF |= 0x2ul << (i * 4);
+                    sf16 >>= 7;
+                    sf16 &= 3;
+                    if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
+                }
+            }
+            break;
+
+        case 0b0101:  // WADDUS.h
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
+                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] +
+                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
+
+                if (sf32 >> 16) {
+                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = 0xffff;
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                    wmmx->wCSSF |= 1 << (2 * i);
+                } else {
+                    if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
+                    if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
+                    if (sf32 & 0x010000l) wmmx->wCASF |= 0x20ul << (i * 8);
+                    sf32 >>= 15;
+                    sf32 &= 3;
+                    if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
+                }
+            }
+            break;
+
+        case 0b1001:  // WADDUS.w
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
+                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] +
+                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
+
+                if (sf64 >> 32) {
+                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = 0xffffffl;
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                    wmmx->wCSSF |= 1 << (4 * i);
+                } else {
+                    if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
+                    if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
+                    if (sf64 & 0x0100000000ll) wmmx->wCASF |= 0x2000ul << (i * 16);
+                    sf64 >>= 31;
+                    sf64 &= 3;
+                    if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
+                }
+            }
+            break;
+
+        case 0b0011:  // WADDSS.b
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
+                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] +
+                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
+
+                if (sf16 > 0x7f) {
+                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = 0x7f;
+                    wmmx->wCSSF |= 1 << i;
+                } else if (sf16 < -0x80) {
+                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = -0x80;
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                    wmmx->wCSSF |= 1 << i;
+                } else {
+                    if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
+                    if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
+                    if (sf16 & 0x0100) wmmx->wCASF |= 0x2ul << (i * 4);
+                    sf16 >>= 7;
+                    sf16 &= 3;
+                    if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
+                }
+            }
+            break;
+
+        case 0b0111:  // WADDSS.h
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
+                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] +
+                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
+
+                if (sf32 > 0x7fff) {
+                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = 0x7fff;
+                    wmmx->wCSSF |= 1 << (2 * i);
+                } else if (sf32 < -0x8000) {
+                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = -0x8000;
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                    wmmx->wCSSF |= 1 << (2 * i);
+                } else {
+                    if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
+                    if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
+                    if (sf32 & 0x010000l) wmmx->wCASF |= 0x20ul << (i * 8);
+                    sf32 >>= 15;
+                    sf32 &= 3;
+                    if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
+                }
+            }
+            break;
+
+        case 0b1011:  // WADDSS.w
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
+                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] +
+                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
+
+                if (sf64 > 0x7fffffffl) {
+                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = 0x7fffffffl;
+                    wmmx->wCSSF |= 1 << (4 * i);
+                } else if (sf64 < -0x80000000l) {
+                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = -0x80000000l;
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                    wmmx->wCSSF |= 1 << (4 * i);
+                } else {
+                    if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
+                    if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
+                    if (sf64 & 0x0100000000ll) wmmx->wCASF |= 0x2000ul << (i * 16);
+                    sf64 >>= 31;
+                    sf64 &= 3;
+                    if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
+                }
+            }
+            break;
+
+        default:
+            return false;
+    }
+    pxa270wmmxPrvControlRegsChanged(wmmx);
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingSubtraction(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                                   uint_fast8_t CRd, uint_fast8_t CRn,
+                                                   uint_fast8_t CRm) {
+    uint_fast8_t i;
+    int_fast16_t sf16;
+    int_fast32_t sf32;
+    int_fast64_t sf64;
+
+    wmmx->wCASF = 0;
+    switch (op1) {
+        case 0b0000:  // WSUB.b
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
+                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] -
+                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
+                if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
+                if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
+                if (!(sf16 & 0x0100)) wmmx->wCASF |= 0x2ul << (i * 4);
+                sf16 >>= 7;
+                sf16 &= 3;
+                if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
+            }
+            break;
+
+        case 0b0100:  // WSUB.h
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
+                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] -
+                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
+                if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
+                if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
+                if (!(sf32 & 0x010000l)) wmmx->wCASF |= 0x20ul << (i * 8);
+                sf32 >>= 15;
+                sf32 &= 3;
+                if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
+            }
+            break;
+
+        case 0b1000:  // WSUB.w
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
+                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] -
+                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
+                if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
+                if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
+                if (!(sf64 & 0x0100000000ll)) wmmx->wCASF |= 0x2000ul << (i * 16);
+                sf64 >>= 31;
+                sf64 &= 3;
+                if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
+            }
+            break;
+
+        case 0b0001:  // WSUBUS.b
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
+                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] -
+                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
+
+                if (sf16 >> 8) {
+                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = 0xff;
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                    wmmx->wCSSF |= 1 << i;
+                } else {
+                    if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
+                    if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
+                    if (!(sf16 & 0x0100)) wmmx->wCASF |= 0x2ul << (i * 4);
+                    sf16 >>= 7;
+                    sf16 &= 3;
+                    if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
+                }
+            }
+            break;
+
+        case 0b0101:  // WSUBUS.h
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
+                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] -
+                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
+
+                if (sf32 >> 16) {
+                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = 0xffff;
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                    wmmx->wCSSF |= 1 << (2 * i);
+                } else {
+                    if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
+                    if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
+                    if (!(sf32 & 0x010000l)) wmmx->wCASF |= 0x20ul << (i * 8);
+                    sf32 >>= 15;
+                    sf32 &= 3;
+                    if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
+                }
+            }
+            break;
+
+        case 0b1001:  // WSUBUS.w
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
+                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] -
+                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
+
+                if (sf64 >> 32) {
+                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = 0xffffffl;
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                    wmmx->wCSSF |= 1 << (4 * i);
+                } else {
+                    if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
+                    if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
+                    if (!(sf64 & 0x0100000000ll)) wmmx->wCASF |= 0x2000ul << (i * 16);
+                    sf64 >>= 31;
+                    sf64 &= 3;
+                    if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
+                }
+            }
+            break;
+
+        case 0b0011:  // WSUBSS.b
+            for (i = 0; i < 8; i++) {
+                wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = sf16 =
+                    (int_fast16_t)wmmx->wR[CRn].s8[ACCESS_REG_8(i)] -
+                    (int_fast16_t)wmmx->wR[CRm].s8[ACCESS_REG_8(i)];
+
+                if (sf16 > 0x7f) {
+                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = 0x7f;
+                    wmmx->wCSSF |= 1 << i;
+                } else if (sf16 < -0x80) {
+                    wmmx->wR[CRd].s8[ACCESS_REG_8(i)] = -0x80;
+                    wmmx->wCASF |= 0x8ul << (i * 4);
+                    wmmx->wCSSF |= 1 << i;
+                } else {
+                    if (((int8_t)sf16) < 0) wmmx->wCASF |= 0x8ul << (i * 4);
+                    if (!(int8_t)sf16) wmmx->wCASF |= 0x4ul << (i * 4);
+                    if (!(sf16 & 0x0100)) wmmx->wCASF |= 0x2ul << (i * 4);
+                    sf16 >>= 7;
+                    sf16 &= 3;
+                    if (sf16 != 0 && sf16 != 3) wmmx->wCASF |= 0x1ul << (i * 4);
+                }
+            }
+            break;
+
+        case 0b0111:  // WSUBSS.h
+            for (i = 0; i < 4; i++) {
+                wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = sf32 =
+                    (int_fast32_t)wmmx->wR[CRn].s16[ACCESS_REG_16(i)] -
+                    (int_fast32_t)wmmx->wR[CRm].s16[ACCESS_REG_16(i)];
+
+                if (sf32 > 0x7fff) {
+                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = 0x7fff;
+                    wmmx->wCSSF |= 1 << (2 * i);
+                } else if (sf32 < -0x8000) {
+                    wmmx->wR[CRd].s16[ACCESS_REG_16(i)] = -0x8000;
+                    wmmx->wCASF |= 0x80ul << (i * 8);
+                    wmmx->wCSSF |= 1 << (2 * i);
+                } else {
+                    if (((int16_t)sf32) < 0) wmmx->wCASF |= 0x80ul << (i * 8);
+                    if (!(int16_t)sf32) wmmx->wCASF |= 0x40ul << (i * 8);
+                    if (!(sf32 & 0x010000l)) wmmx->wCASF |= 0x20ul << (i * 8);
+                    sf32 >>= 15;
+                    sf32 &= 3;
+                    if (sf32 != 0 && sf32 != 3) wmmx->wCASF |= 0x10ul << (i * 8);
+                }
+            }
+            break;
+
+        case 0b1011:  // WSUBSS.w
+            for (i = 0; i < 2; i++) {
+                wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = sf64 =
+                    (int_fast64_t)wmmx->wR[CRn].s32[ACCESS_REG_32(i)] -
+                    (int_fast64_t)wmmx->wR[CRm].s32[ACCESS_REG_32(i)];
+
+                if (sf64 > 0x7fffffffl) {
+                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = 0x7fffffffl;
+                    wmmx->wCSSF |= 1 << (4 * i);
+                } else if (sf64 < -0x80000000l) {
+                    wmmx->wR[CRd].s32[ACCESS_REG_32(i)] = -0x80000000l;
+                    wmmx->wCASF |= 0x8000ul << (i * 16);
+                    wmmx->wCSSF |= 1 << (4 * i);
+                } else {
+                    if (((int32_t)sf64) < 0) wmmx->wCASF |= 0x8000ul << (i * 16);
+                    if (!(int32_t)sf64) wmmx->wCASF |= 0x4000ul << (i * 16);
+                    if (!(sf64 & 0x0100000000ll)) wmmx->wCASF |= 0x2000ul << (i * 16);
+                    sf64 >>= 31;
+                    sf64 &= 3;
+                    if (sf64 != 0 && sf64 != 3) wmmx->wCASF |= 0x1000ul << (i * 16);
+                }
+            }
+            break;
+
+        default:
+            return false;
+    }
+    pxa270wmmxPrvControlRegsChanged(wmmx);
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessing0(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                         uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm,
+                                         uint_fast8_t op2) {
+    switch (op2) {
+        case 0b000:
+            return pxa270wmmxPrvDataProcessingMisc(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b001:
+            return pxa270wmmxPrvDataProcessingAlign(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b010:
+            return pxa270wmmxPrvDataProcessingShift(wmmx, false, op1, CRd, CRn, CRm);
+
+        case 0b011:
+            return pxa270wmmxPrvDataProcessingCompare(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b100:
+            return pxa270wmmxPrvDataProcessingPack(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b110:
+            return pxa270wmmxPrvDataProcessingUnpack(wmmx, false, op1, CRd, CRn, CRm);
+
+        case 0b111:
+            return pxa270wmmxPrvDataProcessingUnpack(wmmx, true, op1, CRd, CRn, CRm);
+
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessing1(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                         uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm,
+                                         uint_fast8_t op2) {
+    switch (op2) {
+        case 0b000:
+            return pxa270wmmxPrvDataProcessingMultiply(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b001:
+            return pxa270wmmxPrvDataProcessingDifference(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b010:
+            return pxa270wmmxPrvDataProcessingShift(wmmx, true, op1, CRd, CRn, CRm);
+
+        case 0b011:
+            return pxa270wmmxPrvDataProcessingMinMax(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b100:
+            return pxa270wmmxPrvDataProcessingAddition(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b101:
+            return pxa270wmmxPrvDataProcessingSubtraction(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b110:
+            return pxa270wmmxPrvDataProcessingAccumulate(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b111:
+            return pxa270wmmxPrvDataProcessingShuffle(wmmx, op1, CRd, CRn, CRm);
+
+        default:
+            return false;
+    }
+}
+
+#ifdef PXA270_WMMX_VECTOR
+
+static FORCE_INLINE uint64_t pxa270wmmxPrvLaneTop(uint_fast8_t laneBits) {
+    switch (laneBits) {
+        case 8:
+            return 0x8080808080808080ull;
+
+        case 16:
+            return 0x8000800080008000ull;
+
+        case 32:
+            return 0x8000000080000000ull;
+
+        default:
+            return 0x8000000000000000ull;
+    }
+}
+
+// Expands a mask holding (at most) the top bit of each lane to full lanes
+static FORCE_INLINE uint64_t pxa270wmmxPrvFillLanes(uint64_t topBits, uint_fast8_t laneBits) {
+    return (topBits >> (laneBits - 1)) * (laneBits == 64 ? ~0ull : (1ull << laneBits) - 1);
+}
+
+static FORCE_INLINE uint64_t pxa270wmmxPrvZeroLanes(union REG64 val, uint_fast8_t laneBits) {
+    union REG64 zero;
+
+    switch (laneBits) {
+        case 8:
+            zero.s8x8 = (Pxa270wmmxS8)(val.u8x8 == 0);
+            break;
+
+        case 16:
+            zero.s16x4 = (Pxa270wmmxS16)(val.u16x4 == 0);
+            break;
+
+        case 32:
+            zero.s32x2 = (Pxa270wmmxS32)(val.u32x2 == 0);
+            break;
+
+        default:
+            zero.v64 = val.v64 ? 0 : ~0ull;
+            break;
+    }
+
+    return zero.v64;
+}
+
+// Gathers the top bit of byte i into bit i
+static FORCE_INLINE uint_fast8_t pxa270wmmxPrvByteSigns(uint64_t val) {
+    return (((val >> 7) & 0x0101010101010101ull) * 0x0102040810204080ull) >> 56;
+}
+
+// Builds wCASF from N, Z, C and V lane masks; only the top bit of each lane is considered
+static FORCE_INLINE uint32_t pxa270wmmxPrvFlags(uint_fast8_t laneBits, uint64_t n, uint64_t z,
+                                                uint64_t c, uint64_t v) {
+    const uint64_t laneTop = pxa270wmmxPrvLaneTop(laneBits);
+
+    // one NZCV nibble in the low half of every byte, then the nibbles are packed
+    uint64_t flags = (((n & laneTop) >> 4) | ((z & laneTop) >> 5) | ((c & laneTop) >> 6) |
+                      ((v & laneTop) >> 7));
+
+    flags = (flags | (flags >> 4)) & 0x00ff00ff00ff00ffull;
+    flags = (flags | (flags >> 8)) & 0x0000ffff0000ffffull;
+    return flags | (flags >> 16);
+}
+
+static bool pxa270wmmxPrvVectorMisc(struct Pxa270wmmx *wmmx, uint_fast8_t op1, uint_fast8_t CRd,
+                                    uint_fast8_t CRn, uint_fast8_t CRm) {
+    const union REG64 a = wmmx->wR[CRn], b = wmmx->wR[CRm];
+    const bool round = op1 & 1;
+    union REG64 r;
+    uint_fast8_t laneBits;
+
+    switch (op1) {
+        case 0b1000:  // WAVG2 (byte size)
+        case 0b1001:
+            laneBits = 8;
+            r.u8x8 = round ? (a.u8x8 | b.u8x8) - ((a.u8x8 ^ b.u8x8) >> 1)
+                           : (a.u8x8 & b.u8x8) + ((a.u8x8 ^ b.u8x8) >> 1);
+            break;
+
+        case 0b1100:  // WAVG2 (halfword size)
+        case 0b1101:
+            laneBits = 16;
+            r.u16x4 = round ? (a.u16x4 | b.u16x4) - ((a.u16x4 ^ b.u16x4) >> 1)
+                            : (a.u16x4 & b.u16x4) + ((a.u16x4 ^ b.u16x4) >> 1);
+            break;
+
+        default:
+            return false;
+    }
+
+    wmmx->wR[CRd].v64 = r.v64;
+    wmmx->wCASF = pxa270wmmxPrvFlags(laneBits, 0, pxa270wmmxPrvZeroLanes(r, laneBits), 0, 0);
+    pxa270wmmxPrvControlRegsChanged(wmmx);
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+// Extracts eight bytes from the 128 bit value wRm:wRn
+static bool pxa270wmmxPrvVectorAlign(struct Pxa270wmmx *wmmx, uint_fast8_t op1, uint_fast8_t CRd,
+                                     uint_fast8_t CRn, uint_fast8_t CRm) {
+    const uint64_t lo = wmmx->wR[CRn].v64, hi = wmmx->wR[CRm].v64;
+    uint_fast8_t by;
+
+    if (op1 < 0b1000)  // WALIGNI
+        by = op1 & 7;
+    else if (op1 < 0b1100)  // WALIGNR
+        by = wmmx->wCGR[op1 & 3] & 7;
+    else
+        return false;
+
+    wmmx->wR[CRd].v64 = by ? (lo >> (8 * by)) | (hi << (64 - 8 * by)) : lo;
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+static bool pxa270wmmxPrvVectorCompare(struct Pxa270wmmx *wmmx, uint_fast8_t op1, uint_fast8_t CRd,
+                                       uint_fast8_t CRn, uint_fast8_t CRm) {
+    const union REG64 a = wmmx->wR[CRn], b = wmmx->wR[CRm];
+    union REG64 r;
+    uint_fast8_t laneBits;
+
+    switch (op1) {
+        case 0b0000:  // WCMPEQ.b
+            r.s8x8 = (Pxa270wmmxS8)(a.u8x8 == b.u8x8);
+            laneBits = 8;
+            break;
+
+        case 0b0100:  // WCMPEQ.h
+            r.s16x4 = (Pxa270wmmxS16)(a.u16x4 == b.u16x4);
+            laneBits = 16;
+            break;
+
+        case 0b1000:  // WCMPEQ.w
+            r.s32x2 = (Pxa270wmmxS32)(a.u32x2 == b.u32x2);
+            laneBits = 32;
+            break;
+
+        case 0b0001:  // WCMPGTU.b
+            r.s8x8 = (Pxa270wmmxS8)(a.u8x8 > b.u8x8);
+            laneBits = 8;
+            break;
+
+        case 0b0101:  // WCMPGTU.h
+            r.s16x4 = (Pxa270wmmxS16)(a.u16x4 > b.u16x4);
+            laneBits = 16;
+            break;
+
+        case 0b1001:  // WCMPGTU.w
+            r.s32x2 = (Pxa270wmmxS32)(a.u32x2 > b.u32x2);
+            laneBits = 32;
+            break;
+
+        case 0b0011:  // WCMPGTS.b
+            r.s8x8 = (Pxa270wmmxS8)(a.s8x8 > b.s8x8);
+            laneBits = 8;
+            break;
+
+        case 0b0111:  // WCMPGTS.h
+            r.s16x4 = (Pxa270wmmxS16)(a.s16x4 > b.s16x4);
+            laneBits = 16;
+            break;
+
+        case 0b1011:  // WCMPGTS.w
+            r.s32x2 = (Pxa270wmmxS32)(a.s32x2 > b.s32x2);
+            laneBits = 32;
+            break;
+
+        default:
+            return false;
+    }
+
+    wmmx->wR[CRd].v64 = r.v64;
+    wmmx->wCASF = pxa270wmmxPrvFlags(laneBits, r.v64, ~r.v64, 0, 0);
+    pxa270wmmxPrvControlRegsChanged(wmmx);
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+// Places the four bytes (or two halfwords) of val in the low half of halfword (word) lanes
+static FORCE_INLINE uint64_t pxa270wmmxPrvWiden(uint32_t val, uint_fast8_t laneBits) {
+    uint64_t ret = val;
+
+    if (laneBits == 64) return ret;
+
+    ret = (ret | (ret << 16)) & 0x0000ffff0000ffffull;
+    if (laneBits == 32) return ret;
+
+    return (ret | (ret << 8)) & 0x00ff00ff00ff00ffull;
+}
+
+static bool pxa270wmmxPrvVectorUnpack(struct Pxa270wmmx *wmmx, bool hi, uint_fast8_t op1,
+                                      uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
+    if (op1 >> 2 > 2) return false;
+
+    // lanes of the unpacked result: halfwords for .b, words for .h and a doubleword for .w
+    uint_fast8_t laneBits = 16 << (op1 >> 2);
+    const uint_fast8_t shift = hi ? 32 : 0;
+    const uint64_t n = pxa270wmmxPrvWiden(wmmx->wR[CRn].v64 >> shift, laneBits);
+    const uint64_t srcTop = pxa270wmmxPrvLaneTop(laneBits / 2) & ~pxa270wmmxPrvLaneTop(laneBits);
+    union REG64 r;
+    bool sign = true;
+
+    switch (op1 & 3) {
+        case 0b00:  // WUNPACKEUx
+            r.v64 = n;
+            sign = false;
+            break;
+
+        case 0b10:  // WUNPACKESx
+            r.v64 = n | (pxa270wmmxPrvFillLanes((n & srcTop) << (laneBits / 2), laneBits) &
+                         ~pxa270wmmxPrvFillLanes(srcTop, laneBits / 2));
+            break;
+
+        case 0b01:  // WUNPACKIx
+            r.v64 = n |
+                    (pxa270wmmxPrvWiden(wmmx->wR[CRm].v64 >> shift, laneBits) << (laneBits / 2));
+            laneBits /= 2;
+            break;
+
+        default:
+            return false;
+    }
+
+    wmmx->wR[CRd].v64 = r.v64;
+    wmmx->wCASF =
+        pxa270wmmxPrvFlags(laneBits, sign ? r.v64 : 0, pxa270wmmxPrvZeroLanes(r, laneBits), 0, 0);
+    pxa270wmmxPrvControlRegsChanged(wmmx);
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+static bool pxa270wmmxPrvVectorMinMax(struct Pxa270wmmx *wmmx, uint_fast8_t op1, uint_fast8_t CRd,
+                                      uint_fast8_t CRn, uint_fast8_t CRm) {
+    const union REG64 a = wmmx->wR[CRn], b = wmmx->wR[CRm];
+    union REG64 takeA;
+
+    // bit 0 selects minimum, bit 1 signed lanes, bits 2 - 3 the lane size
+    switch (op1) {
+        case 0b0000:  // WMAXUB
+            takeA.s8x8 = (Pxa270wmmxS8)(a.u8x8 > b.u8x8);
+            break;
+
+        case 0b0100:  // WMAXUH
+            takeA.s16x4 = (Pxa270wmmxS16)(a.u16x4 > b.u16x4);
+            break;
+
+        case 0b1000:  // WMAXUW
+            takeA.s32x2 = (Pxa270wmmxS32)(a.u32x2 > b.u32x2);
+            break;
+
+        case 0b0010:  // WMAXSB
+            takeA.s8x8 = (Pxa270wmmxS8)(a.s8x8 > b.s8x8);
+            break;
+
+        case 0b0110:  // WMAXSH
+            takeA.s16x4 = (Pxa270wmmxS16)(a.s16x4 > b.s16x4);
+            break;
+
+        case 0b1010:  // WMAXSW
+            takeA.s32x2 = (Pxa270wmmxS32)(a.s32x2 > b.s32x2);
+            break;
+
+        case 0b0001:  // WMINUB
+            takeA.s8x8 = (Pxa270wmmxS8)(a.u8x8 < b.u8x8);
+            break;
+
+        case 0b0101:  // WMINUH
+            takeA.s16x4 = (Pxa270wmmxS16)(a.u16x4 < b.u16x4);
+            break;
+
+        case 0b1001:  // WMINUW
+            takeA.s32x2 = (Pxa270wmmxS32)(a.u32x2 < b.u32x2);
+            break;
+
+        case 0b0011:  // WMINSB
+            takeA.s8x8 = (Pxa270wmmxS8)(a.s8x8 < b.s8x8);
+            break;
+
+        case 0b0111:  // WMINSH
+            takeA.s16x4 = (Pxa270wmmxS16)(a.s16x4 < b.s16x4);
+            break;
+
+        case 0b1011:  // WMINSW
+            takeA.s32x2 = (Pxa270wmmxS32)(a.s32x2 < b.s32x2);
+            break;
+
+        default:
+            return false;
+    }
+
+    wmmx->wR[CRd].v64 = (a.v64 & takeA.v64) | (b.v64 & ~takeA.v64);
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+// WADD, WADDSS, WSUB and WSUBSS. The unsigned saturating forms stay on the scalar path.
+static bool pxa270wmmxPrvVectorAddSub(struct Pxa270wmmx *wmmx, bool sub, uint_fast8_t op1,
+                                      uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm) {
+    const union REG64 a = wmmx->wR[CRn], b = wmmx->wR[CRm];
+    const bool saturate = op1 & 1;
+    union REG64 r;
+    uint_fast8_t laneBits;
+    uint64_t carry, bit8, n, z, c, v;
+
+    if ((op1 & 3) != 0b00 && (op1 & 3) != 0b11) return false;
+
+    switch (op1 >> 2) {
+        case 0:
+            r.u8x8 = sub ? a.u8x8 - b.u8x8 : a.u8x8 + b.u8x8;
+            laneBits = 8;
+            break;
+
+        case 1:
+            r.u16x4 = sub ? a.u16x4 - b.u16x4 : a.u16x4 + b.u16x4;
+            laneBits = 16;
+            break;
+
+        case 2:
+            r.u32x2 = sub ? a.u32x2 - b.u32x2 : a.u32x2 + b.u32x2;
+            laneBits = 32;
+            break;
+
+        default:
+            return false;
+    }
+
+    // Carry (borrow) out of each lane's top bit. C and V follow the scalar code, which derives them
+    // from bit 8 (16, 32) of the sign extended result.
+    if (sub)
+        carry = (~a.v64 & b.v64) | (~(a.v64 ^ b.v64) & r.v64);
+    else
+        carry = (a.v64 & b.v64) | ((a.v64 | b.v64) & ~r.v64);
+
+    bit8 = carry ^ a.v64 ^ b.v64;
+    n = r.v64;
+    z = pxa270wmmxPrvZeroLanes(r, laneBits);
+    c = sub ? ~bit8 : bit8;
+    v = r.v64 ^ bit8;
+
+    if (saturate) {
+        const uint64_t laneTop = pxa270wmmxPrvLaneTop(laneBits);
+        const uint64_t overflow = pxa270wmmxPrvFillLanes(v & laneTop, laneBits);
+        const uint64_t limit = ~laneTop ^ pxa270wmmxPrvFillLanes(a.v64 & laneTop, laneBits);
+
+        r.v64 = (r.v64 & ~overflow) | (limit & overflow);
+        n = (n & ~overflow) | (a.v64 & overflow);
+        z &= ~overflow;
+        c &= ~overflow;
+        v = 0;
+
+        wmmx->wCSSF |= pxa270wmmxPrvByteSigns(overflow & (laneTop >> (laneBits - 8)));
+    }
+
+    wmmx->wR[CRd].v64 = r.v64;
+    wmmx->wCASF = pxa270wmmxPrvFlags(laneBits, n, z, c, v);
+    pxa270wmmxPrvControlRegsChanged(wmmx);
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+static bool pxa270wmmxPrvVectorAccumulate(struct Pxa270wmmx *wmmx, uint_fast8_t op1,
+                                          uint_fast8_t CRd, uint_fast8_t CRn) {
+    uint64_t sum = wmmx->wR[CRn].v64;
+
+    // pairwise lane sums
+    switch (op1) {
+        case 0b0000:  // WACC.b
+            sum = (sum & 0x00ff00ff00ff00ffull) + ((sum >> 8) & 0x00ff00ff00ff00ffull);
+            // fallthrough
+        case 0b0100:  // WACC.h
+            sum = (sum & 0x0000ffff0000ffffull) + ((sum >> 16) & 0x0000ffff0000ffffull);
+            // fallthrough
+        case 0b1000:  // WACC.w
+            sum = (sum & 0xffffffffull) + (sum >> 32);
+            break;
+
+        default:
+            return false;
+    }
+
+    wmmx->wR[CRd].v64 = sum;
+    pxa270wmmxPrvDataRegsChanged(wmmx);
+    return true;
+}
+
+static bool pxa270wmmxPrvDataProcessingVector(struct Pxa270wmmx *wmmx, bool cp1, uint_fast8_t op1,
+                                              uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm,
+                                              uint_fast8_t op2) {
+    if (cp1) {
+        switch (op2) {
+            case 0b011:
+                return pxa270wmmxPrvVectorMinMax(wmmx, op1, CRd, CRn, CRm);
+
+            case 0b100:
+                return pxa270wmmxPrvVectorAddSub(wmmx, false, op1, CRd, CRn, CRm);
+
+            case 0b101:
+                return pxa270wmmxPrvVectorAddSub(wmmx, true, op1, CRd, CRn, CRm);
+
+            case 0b110:
+                return pxa270wmmxPrvVectorAccumulate(wmmx, op1, CRd, CRn);
+
+            default:
+                return false;
+        }
+    }
+
+    switch (op2) {
+        case 0b000:
+            return pxa270wmmxPrvVectorMisc(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b001:
+            return pxa270wmmxPrvVectorAlign(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b011:
+            return pxa270wmmxPrvVectorCompare(wmmx, op1, CRd, CRn, CRm);
+
+        case 0b110:
+            return pxa270wmmxPrvVectorUnpack(wmmx, false, op1, CRd, CRn, CRm);
+
+        case 0b111:
+            return pxa270wmmxPrvVectorUnpack(wmmx, true, op1, CRd, CRn, CRm);
+
+        default:
+            return false;
+    }
+}
+
+#endif
+
+bool pxa270wmmxDataProcessingScalar(struct Pxa270wmmx *wmmx, bool cp1, uint_fast8_t op1,
+                                    uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm,
+                                    uint_fast8_t op2) {
+    return cp1 ? pxa270wmmxPrvDataProcessing1(wmmx, op1, CRd, CRn, CRm, op2)
+               : pxa270wmmxPrvDataProcessing0(wmmx, op1, CRd, CRn, CRm, op2);
+}
+
+bool pxa270wmmxDataProcessing(struct Pxa270wmmx *wmmx, bool cp1, uint_fast8_t op1, uint_fast8_t CRd,
+                              uint_fast8_t CRn, uint_fast8_t CRm, uint_fast8_t op2) {
+#ifdef PXA270_WMMX_VECTOR
+    if (pxa270wmmxPrvDataProcessingVector(wmmx, cp1, op1, CRd, CRn, CRm, op2)) return true;
+#endif
+
+    return pxa270wmmxDataProcessingScalar(wmmx, cp1, op1, CRd, CRn, CRm, op2);
+}
@@ -0,0 +1,86 @@
+#ifndef _PXA270_WMMX_DP_H_
+#define _PXA270_WMMX_DP_H_
+
+// Register file and data processing (CDP) instructions of the WMMX coprocessor, kept free of CPU
+// dependencies so they can be tested on their own.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "uarm_endian.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 64 bit host vectors (SSE2, NEON, wasm simd128) via the GCC / clang vector extension
+#if defined(__GNUC__) && !defined(PXA270_WMMX_SCALAR)
+    #define PXA270_WMMX_VECTOR
+
+typedef uint8_t Pxa270wmmxU8 __attribute__((vector_size(8)));
+typedef int8_t Pxa270wmmxS8 __attribute__((vector_size(8)));
+typedef uint16_t Pxa270wmmxU16 __attribute__((vector_size(8)));
+typedef int16_t Pxa270wmmxS16 __attribute__((vector_size(8)));
+typedef uint32_t Pxa270wmmxU32 __attribute__((vector_size(8)));
+typedef int32_t Pxa270wmmxS32 __attribute__((vector_size(8)));
+#endif
+
+union REG64 {
+    uint64_t v64;
+    int64_t s64;
+    uint32_t v32[2];
+    int32_t s32[2];
+    uint16_t v16[4];
+    int16_t s16[4];
+    uint8_t v8[8];
+    int8_t s8[8];
+
+#ifdef PXA270_WMMX_VECTOR
+    Pxa270wmmxU8 u8x8;
+    Pxa270wmmxS8 s8x8;
+    Pxa270wmmxU16 u16x4;
+    Pxa270wmmxS16 s16x4;
+    Pxa270wmmxU32 u32x2;
+    Pxa270wmmxS32 s32x2;
+#endif
+};
+
+struct Pxa270wmmx {
+    union REG64 wR[16];
+    uint32_t wCGR[4], wCASF;  // NZCV
+    uint8_t wCon, wCSSF;
+};
+
+#define pxa270wmmxPrvDataRegsChanged(_wmmx) \
+    do {                                    \
+        _wmmx->wCon |= 2;                   \
+    } while (0)
+#define pxa270wmmxPrvControlRegsChanged(_wmmx) \
+    do {                                       \
+        _wmmx->wCon |= 1;                      \
+    } while (0)
+
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+    #define ACCESS_REG_8(_idx) (_idx)
+    #define ACCESS_REG_16(_idx) (_idx)
+    #define ACCESS_REG_32(_idx) (_idx)
+#else
+    #define ACCESS_REG_8(_idx) (7 - (_idx))
+    #define ACCESS_REG_16(_idx) (3 - (_idx))
+    #define ACCESS_REG_32(_idx) (1 - (_idx))
+#endif
+
+// Executes a CDP on coprocessor 0 (cp1 == false) or 1. Returns false for undefined instructions.
+bool pxa270wmmxDataProcessing(struct Pxa270wmmx *wmmx, bool cp1, uint_fast8_t op1, uint_fast8_t CRd,
+                              uint_fast8_t CRn, uint_fast8_t CRm, uint_fast8_t op2);
+
+// Lane by lane implementation of the same instructions; the reference for the vector paths
+bool pxa270wmmxDataProcessingScalar(struct Pxa270wmmx *wmmx, bool cp1, uint_fast8_t op1,
+                                    uint_fast8_t CRd, uint_fast8_t CRn, uint_fast8_t CRm,
+                                    uint_fast8_t op2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -7,6 +7,7 @@
 #include "mem.h"
 #include "pxa_DMA.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
 #include "soc_AC97.h"
 
 #define PXA_AC97_BASE 0x40500000UL
@@ -143,6 +144,42 @@ static bool socAC97PrvModemFifoR(struct SocAC97 *ac97, uint32_t *valP) {
     return socAC97PrvFifoR(ac97, &ac97->primaryModem, valP);
 }
 
+static uint32_t socAC97PrvDmaFifo(struct SocAC97 *ac97, struct Ac97CodecStruct *codec, bool write,
+                                  uint_fast8_t size, uint32_t *items, uint32_t count) {
+    uint32_t i;
+
+    if (size != 4 && size != 2) return 0;
+
+    for (i = 0; i < count; i++) {
+        if (!(write ? socAC97PrvFifoW(ac97, codec, items[i])
+                    : socAC97PrvFifoR(ac97, codec, items + i)))
+            break;
+    }
+
+    return i;
+}
+
+static uint32_t socAC97PrvPcmDmaFifo(void *userData, bool write, uint_fast8_t size,
+                                     uint32_t *items, uint32_t count) {
+    struct SocAC97 *ac97 = (struct SocAC97 *)userData;
+
+    return socAC97PrvDmaFifo(ac97, &ac97->primaryAudio, write, size, items, count);
+}
+
+static uint32_t socAC97PrvMicDmaFifo(void *userData, bool write, uint_fast8_t size,
+                                     uint32_t *items, uint32_t count) {
+    struct SocAC97 *ac97 = (struct SocAC97 *)userData;
+
+    return write ? 0 : socAC97PrvDmaFifo(ac97, &ac97->secondaryAudio, false, size, items, count);
+}
+
+static uint32_t socAC97PrvModemDmaFifo(void *userData, bool write, uint_fast8_t size,
+                                       uint32_t *items, uint32_t count) {
+    struct SocAC97 *ac97 = (struct SocAC97 *)userData;
+
+    return socAC97PrvDmaFifo(ac97, &ac97->primaryModem, write, size, items, count);
+}
+
 static bool socAC97PrvMemAccessF(void *userData, uint32_t pa, uint_fast8_t size, bool write,
                                  void *buf) {
     struct SocAC97 *ac97 = (struct SocAC97 *)userData;
@@ -365,6 +402,10 @@ struct SocAC97 *socAC97Init(struct ArmMem *physMem, struct SocIc *ic, struct Soc
     if (!memRegionAdd(physMem, PXA_AC97_BASE, PXA_AC97_SIZE, socAC97PrvMemAccessF, ac97))
         ERR("cannot add AC97 to MEM\n");
 
+    socDmaAddFifo(dma, PXA_AC97_BASE + 0x40, socAC97PrvPcmDmaFifo, ac97);
+    socDmaAddFifo(dma, PXA_AC97_BASE + 0x60, socAC97PrvMicDmaFifo, ac97);
+    socDmaAddFifo(dma, PXA_AC97_BASE + 0x140, socAC97PrvModemDmaFifo, ac97);
+
     return ac97;
 }
 
@@ -414,3 +455,34 @@ void socAC97clientClientHaveData(struct SocAC97 *ac97, enum Ac97Codec which, uin
 
     (void)socAC97PrvFifoAdd(ac97, &cd->rxFifo, data);
 }
+
+static void socAC97PrvSerializeFifo(struct AC97Fifo *fifo, struct SavestateChunk *chunk) {
+    savestateChunkDo8(chunk, &fifo->readPtr);
+    savestateChunkDo8(chunk, &fifo->numItems);
+    for (size_t i = 0; i < 16; i++) savestateChunkDo32(chunk, fifo->data + i);
+}
+
+static void socAC97PrvSerializeCodec(struct Ac97CodecStruct *codec,
+                                     struct SavestateChunk *chunk) {
+    savestateChunkDo16(chunk, &codec->prevReadVal);
+    socAC97PrvSerializeFifo(&codec->txFifo, chunk);
+    socAC97PrvSerializeFifo(&codec->rxFifo, chunk);
+}
+
+void socAC97Serialize(struct SocAC97 *ac97, struct SavestateChunk *chunk) {
+    uint8_t *regs8[] = {&ac97->pocr, &ac97->picr, &ac97->mccr, &ac97->posr,
+                        &ac97->pisr, &ac97->mcsr, &ac97->car,  &ac97->mocr,
+                        &ac97->mosr, &ac97->micr, &ac97->misr};
+
+    for (size_t i = 0; i < sizeof(regs8) / sizeof(*regs8); i++)
+        savestateChunkDo8(chunk, regs8[i]);
+
+    savestateChunkDo32(chunk, &ac97->gcr);
+    savestateChunkDo32(chunk, &ac97->gsr);
+    savestateChunkDo32(chunk, &ac97->pcdr);
+
+    socAC97PrvSerializeCodec(&ac97->primaryAudio, chunk);
+    socAC97PrvSerializeCodec(&ac97->secondaryAudio, chunk);
+    socAC97PrvSerializeCodec(&ac97->primaryModem, chunk);
+    socAC97PrvSerializeCodec(&ac97->secondaryModem, chunk);
+}
@@ -8,6 +8,9 @@
 #include "cputil.h"
 #include "mem.h"
 #include "pxa_IC.h"
+#include "ram_buffer.h"
+#include "savestate_chunk.h"
+#include "uarm_endian.h"
 
 #define PXA_DMA_BASE 0x40000000UL
 #define PXA_DMA_SIZE 0x00002000UL
@@ -18,6 +21,9 @@
 #define REG_CR 3   // command
 #define REG_CSR 4  // status
 
+#define MAX_FIFOS 16
+#define MAX_FIFO_ITEMS 32
+
 struct PxaDmaChannel {
     uint32_t DAR;  // descriptor address register
     uint32_t SAR;  // source address register
@@ -30,6 +36,12 @@ struct PxaDmaChannel {
     uint8_t dcmdAddrWritten : 1;
 };
 
+struct SocDmaFifo {
+    uint32_t pa;
+    SocDmaFifoF fifoF;
+    void* userData;
+};
+
 struct SocDma {
     struct SocIc* ic;
     struct ArmMem* mem;
@@ -39,6 +51,11 @@ struct SocDma {
     uint32_t DINT;
     struct PxaDmaChannel channels[32];
     uint8_t CMR[75];  // channel map registers	[  we store lower 8 bits only :-)  ]
+
+    uint32_t activeChannels;  // bitmask of running channels
+
+    struct SocDmaFifo fifos[MAX_FIFOS];
+    uint8_t numFifos;
 };
 
 static void socDmaPrvChannelIrqRecalc(struct SocDma* dma, uint_fast8_t channel) {
@@ -156,6 +173,121 @@ static bool socDmaPrvChannelCheckForEnd(
     return irqUpdate;
 }
 
+static void socDmaPrvUpdateActive(struct SocDma* dma, uint_fast8_t channel) {
+    if (socDmaPrvChannelRunning(dma, dma->channels + channel))
+        dma->activeChannels |= 1u << channel;
+    else
+        dma->activeChannels &= ~(1u << channel);
+}
+
+static const struct SocDmaFifo* socDmaPrvFindFifo(struct SocDma* dma, uint32_t pa) {
+    for (uint_fast8_t i = 0; i < dma->numFifos; i++)
+        if (dma->fifos[i].pa == pa) return dma->fifos + i;
+
+    return NULL;
+}
+
+// Resolve a span of memory to host memory. Fails unless the span is contained in a single page.
+static uint8_t* socDmaPrvHostSpan(struct SocDma* dma, uint32_t addr, uint32_t len, bool write) {
+    const uint32_t offset = addr & 0xfff;
+    struct MemHostPage page;
+
+    if (offset + len > 0x1000 || !memGetHostPage(dma->mem, addr, write, &page)) return NULL;
+
+    if (write) {
+        for (uint32_t dirty = offset & ~0x1ff; dirty < offset + len; dirty += 0x200)
+            RAM_BUFFER_MARK_DIRTY_PAGES(page.dirtyPages, page.dirtyOffset + dirty);
+    }
+
+    return page.data + offset;
+}
+
+static uint32_t socDmaPrvLoadItem(const uint8_t* src, uint32_t each) {
+    switch (each) {
+        case 1:
+            return *src;
+
+        case 2:
+            return le16toh(*(const uint16_t*)src);
+
+        default:
+            return le32toh(*(const uint32_t*)src);
+    }
+}
+
+static void socDmaPrvStoreItem(uint8_t* dst, uint32_t each, uint32_t item) {
+    switch (each) {
+        case 1:
+            *dst = item;
+            break;
+
+        case 2:
+            *(uint16_t*)dst = htole16(item);
+            break;
+
+        default:
+            *(uint32_t*)dst = htole32(item);
+            break;
+    }
+}
+
+// Move a block of items without going through memAccess for each of them. Handles RAM to RAM
+// copies and transfers between memory and a registered FIFO. Returns the number of items moved,
+// zero if the transfer has to be done item by item.
+static uint32_t socDmaPrvBlockXfer(struct SocDma* dma, struct PxaDmaChannel* ch, uint32_t each,
+                                   uint32_t num) {
+    const bool srcInc = ch->CR & 0x80000000ul, dstInc = ch->CR & 0x40000000ul;
+    const struct SocDmaFifo* fifo;
+    uint32_t items[MAX_FIFO_ITEMS];
+    uint8_t *src, *dst;
+    uint32_t count, len;
+
+    if (srcInc && dstInc) {
+        len = num * each;
+        if (len > 0x1000 - (ch->SAR & 0xfff)) len = 0x1000 - (ch->SAR & 0xfff);
+        if (len > 0x1000 - (ch->TAR & 0xfff)) len = 0x1000 - (ch->TAR & 0xfff);
+        len -= len % each;
+
+        // overlapping copies have to replicate the item by item semantics
+        if (!len || (ch->SAR < ch->TAR + len && ch->TAR < ch->SAR + len)) return 0;
+
+        if (!(src = socDmaPrvHostSpan(dma, ch->SAR, len, false)) ||
+            !(dst = socDmaPrvHostSpan(dma, ch->TAR, len, true)))
+            return 0;
+
+        memcpy(dst, src, len);
+
+        return len / each;
+    }
+
+    count = num < MAX_FIFO_ITEMS ? num : MAX_FIFO_ITEMS;
+
+    if (dstInc && (fifo = socDmaPrvFindFifo(dma, ch->SAR))) {
+        if (count > (0x1000 - (ch->TAR & 0xfff)) / each)
+            count = (0x1000 - (ch->TAR & 0xfff)) / each;
+
+        if (!count || !(dst = socDmaPrvHostSpan(dma, ch->TAR, count * each, true))) return 0;
+
+        count = fifo->fifoF(fifo->userData, false, each, items, count);
+        for (uint32_t i = 0; i < count; i++) socDmaPrvStoreItem(dst + i * each, each, items[i]);
+
+        return count;
+    }
+
+    if (srcInc && (fifo = socDmaPrvFindFifo(dma, ch->TAR))) {
+        if (count > (0x1000 - (ch->SAR & 0xfff)) / each)
+            count = (0x1000 - (ch->SAR & 0xfff)) / each;
+
+        if (!count || !(src = socDmaPrvHostSpan(dma, ch->SAR, count * each, false))) return 0;
+
+        for (uint32_t i = 0; i < count; i++) items[i] = socDmaPrvLoadItem(src + i * each, each);
+
+        return fifo->fifoF(fifo->userData, true, each, items, count);
+    }
+
+    return 0;
+}
+
 static bool socDmaPrvChannelDoBurst(
     struct SocDma* dma, uint_fast8_t channel)  // return true if irq need updating after what we did
 {
@@ -169,6 +301,9 @@ static bool socDmaPrvChannelDoBurst(
         while (1);
     }
 
+    // without flow control the burst size is irrelevant: move everything at once
+    if (!(ch->CR & 0x30000000ul)) num = ch->CR & 0x1fff;
+
     // we never transfer more than there is left
     if (num > (ch->CR & 0x1fff)) num = ch->CR & 0x1fff;
 
@@ -184,22 +319,27 @@ static bool socDmaPrvChannelDoBurst(
 
     // fprintf(stderr, "dma ch %u burst, %u bytes left before it\n", channel, ch->CR & 0x1fff);
 
-    while (num--) {
-        uint32_t src = ch->SAR;
-        uint32_t dst = ch->TAR;
-        uint32_t t;
+    while (num) {
+        uint32_t xfered = socDmaPrvBlockXfer(dma, ch, each, num);
 
-        if (!memAccess(dma->mem, src, each, false, &t) ||
-            !memAccess(dma->mem, dst, each, true, &t)) {
-            fprintf(stderr, "DMA xfer bus error\n");
-            dma->channels[channel].CSR |= 1;  // signl bus error, not running
-            socDmaPrvChannelStop(dma, ch);
-            return true;
+        if (!xfered) {
+            uint32_t t;
+
+            if (!memAccess(dma->mem, ch->SAR, each, false, &t) ||
+                !memAccess(dma->mem, ch->TAR, each, true, &t)) {
+                fprintf(stderr, "DMA xfer bus error\n");
+                dma->channels[channel].CSR |= 1;  // signl bus error, not running
+                socDmaPrvChannelStop(dma, ch);
+                return true;
+            }
+
+            xfered = 1;
         }
 
-        if (ch->CR & 0x80000000ul) ch->SAR += each;
-        if (ch->CR & 0x40000000ul) ch->TAR += each;
-        ch->CR -= each;
+        if (ch->CR & 0x80000000ul) ch->SAR += xfered * each;
+        if (ch->CR & 0x40000000ul) ch->TAR += xfered * each;
+        ch->CR -= xfered * each;
+        num -= xfered;
     }
 
     // check for end
@@ -210,8 +350,10 @@ static void socDmaPrvChannelActIfNeeded(struct SocDma* dma, uint_fast8_t channel
     bool irqUpdate = false, doWork = false, justOne = true;
     struct PxaDmaChannel* ch = &dma->channels[channel];
 
-    if (!socDmaPrvChannelRunning(dma, ch))  // stopped? not much to do...
+    if (!socDmaPrvChannelRunning(dma, ch)) {  // stopped? not much to do...
+        socDmaPrvUpdateActive(dma, channel);
         return;
+    }
 
     // check for end
     if (socDmaPrvChannelCheckForEnd(dma, channel)) irqUpdate = true;
@@ -239,6 +381,8 @@ static void socDmaPrvChannelActIfNeeded(struct SocDma* dma, uint_fast8_t channel
     }
 
     if (irqUpdate) socDmaPrvChannelIrqRecalc(dma, channel);
+
+    socDmaPrvUpdateActive(dma, channel);
 }
 
 static void socDmaPrvChannelMaybeStart(struct SocDma* dma, struct PxaDmaChannel* ch,
@@ -322,6 +466,8 @@ static bool socDmaPrvChannelRegWrite(struct SocDma* dma, uint_fast8_t channel, u
         socDmaPrvChannelMaybeStart(dma, ch, prevCsr);
     }
 
+    socDmaPrvUpdateActive(dma, channel);
+
     return true;
 }
 
@@ -372,9 +518,23 @@ void socDmaExternalReq(struct SocDma* dma, uint_fast8_t chNum, bool requested) {
 }
 
 void socDmaPeriodic(struct SocDma* dma) {
-    uint32_t i;
+    uint32_t active = dma->activeChannels;
+
+    while (active) {
+        const uint_fast8_t channel = __builtin_ctz(active);
+        active &= active - 1;
+
+        socDmaPrvChannelActIfNeeded(dma, channel);
+    }
+}
 
-    for (i = 0; i < 32; i++) socDmaPrvChannelActIfNeeded(dma, i);
+void socDmaAddFifo(struct SocDma* dma, uint32_t pa, SocDmaFifoF fifoF, void* userData) {
+    if (dma->numFifos == MAX_FIFOS) ERR("too many DMA FIFOs");
+
+    dma->fifos[dma->numFifos].pa = pa;
+    dma->fifos[dma->numFifos].fifoF = fifoF;
+    dma->fifos[dma->numFifos].userData = userData;
+    dma->numFifos++;
 }
 
 static bool socDmaPrvMemAccessF(void* userData, uint32_t pa, uint_fast8_t size, bool write,
@@ -506,10 +666,31 @@ struct SocDma* socDmaInit(struct ArmMem* physMem, struct Reschedule reschedule,
     return dma;
 }
 
-bool socDmaTaskRequired(struct SocDma* dma) {
-    for (int i = 0; i < 32; i++) {
-        if (socDmaPrvChannelRunning(dma, dma->channels + i)) return true;
+bool socDmaTaskRequired(struct SocDma* dma) { return dma->activeChannels != 0; }
+
+void socDmaSerialize(struct SocDma *dma, struct SavestateChunk *chunk) {
+    savestateChunkDo32(chunk, &dma->dalgn);
+    savestateChunkDo32(chunk, &dma->dpcsr);
+    savestateChunkDo32(chunk, &dma->DINT);
+
+    for (size_t i = 0; i < 32; i++) {
+        struct PxaDmaChannel *ch = dma->channels + i;
+        uint8_t addrWritten =
+            ch->dsAddrWriten | (ch->dtAddrWriten << 1) | (ch->dcmdAddrWritten << 2);
+
+        savestateChunkDo32(chunk, &ch->DAR);
+        savestateChunkDo32(chunk, &ch->SAR);
+        savestateChunkDo32(chunk, &ch->TAR);
+        savestateChunkDo32(chunk, &ch->CR);
+        savestateChunkDo32(chunk, &ch->CSR);
+        savestateChunkDo8(chunk, &addrWritten);
+
+        ch->dsAddrWriten = addrWritten;
+        ch->dtAddrWriten = addrWritten >> 1;
+        ch->dcmdAddrWritten = addrWritten >> 2;
+
+        socDmaPrvUpdateActive(dma, i);
     }
 
-    return false;
+    savestateChunkDoBuffer(chunk, dma->CMR, sizeof(dma->CMR));
 }
@@ -6,6 +6,7 @@
 #include "cputil.h"
 #include "mem.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
 #include "soc_GPIO.h"
 
 #define PXA_GPIO_BASE 0x40E00000UL
@@ -376,3 +377,17 @@ void socGpioSetDirsChangedNotif(struct SocGpio *gpio, GpioDirsChangedF notifF, v
     gpio->dirNotifF = notifF;
     gpio->dirNotifD = userData;
 }
+
+void socGpioSerialize(struct SocGpio *gpio, struct SavestateChunk *chunk) {
+    for (size_t i = 0; i < 4; i++) {
+        savestateChunkDo32(chunk, gpio->latches + i);
+        savestateChunkDo32(chunk, gpio->inputs + i);
+        savestateChunkDo32(chunk, gpio->levels + i);
+        savestateChunkDo32(chunk, gpio->dirs + i);
+        savestateChunkDo32(chunk, gpio->riseDet + i);
+        savestateChunkDo32(chunk, gpio->fallDet + i);
+        savestateChunkDo32(chunk, gpio->detStatus + i);
+    }
+
+    for (size_t i = 0; i < 8; i++) savestateChunkDo32(chunk, gpio->AFRs + i);
+}
@@ -6,6 +6,7 @@
 #include "cputil.h"
 #include "mem.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
 #include "soc_I2C.h"
 
 #define PXA_I2C_SIZE 0x00000024UL
@@ -223,3 +224,16 @@ struct SocI2c *socI2cInit(struct ArmMem *physMem, struct SocIc *ic, struct SocDm
 
     return i2c;
 }
+
+void socI2cSerialize(struct SocI2c *i2c, struct SavestateChunk *chunk) {
+    uint8_t flags = i2c->waitForAddr | (i2c->latentBusy << 1);
+
+    savestateChunkDo16(chunk, &i2c->icr);
+    savestateChunkDo16(chunk, &i2c->isr);
+    savestateChunkDo8(chunk, &i2c->db);
+    savestateChunkDo8(chunk, &i2c->isa);
+    savestateChunkDo8(chunk, &flags);
+
+    i2c->waitForAddr = flags;
+    i2c->latentBusy = flags >> 1;
+}
@@ -6,6 +6,7 @@
 #include "cputil.h"
 #include "pxa_DMA.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
 #include "soc_I2S.h"
 
 #define PXA_I2S_BASE 0x40400000UL
@@ -79,6 +80,20 @@ static bool socI2sPrvFifoR(struct SocI2s *i2s, uint32_t *valP) {
     return true;
 }
 
+static uint32_t socI2sPrvDmaFifo(void *userData, bool write, uint_fast8_t size, uint32_t *items,
+                                 uint32_t count) {
+    struct SocI2s *i2s = (struct SocI2s *)userData;
+    uint32_t i;
+
+    if (size != 4) return 0;
+
+    for (i = 0; i < count; i++) {
+        if (!(write ? socI2sPrvFifoW(i2s, items[i]) : socI2sPrvFifoR(i2s, items + i))) break;
+    }
+
+    return i;
+}
+
 static bool socI2sPrvMemAccessF(void *userData, uint32_t pa, uint_fast8_t size, bool write,
                                 void *buf) {
     struct SocI2s *i2s = (struct SocI2s *)userData;
@@ -168,6 +183,8 @@ struct SocI2s *socI2sInit(struct ArmMem *physMem, struct SocIc *ic, struct SocDm
     if (!memRegionAdd(physMem, PXA_I2S_BASE, PXA_I2S_SIZE, socI2sPrvMemAccessF, i2s))
         ERR("cannot add I2S to MEM\n");
 
+    socDmaAddFifo(dma, PXA_I2S_BASE + 0x80, socI2sPrvDmaFifo, i2s);
+
     return i2s;
 }
 
@@ -194,3 +211,19 @@ void socI2sPeriodic(struct SocI2s *i2s) {
     socI2sPrvTxFifoRecalc(i2s);
     socI2sPrvRxFifoRecalc(i2s);
 }
+
+void socI2sSerialize(struct SocI2s *i2s, struct SavestateChunk *chunk) {
+    savestateChunkDo16(chunk, &i2s->sacr0);
+    savestateChunkDo16(chunk, &i2s->sasr0);
+    savestateChunkDo8(chunk, &i2s->sacr1);
+    savestateChunkDo8(chunk, &i2s->sadiv);
+    savestateChunkDo8(chunk, &i2s->saimr);
+
+    for (size_t i = 0; i < 16; i++) {
+        savestateChunkDo32(chunk, i2s->txFifo + i);
+        savestateChunkDo32(chunk, i2s->rxFifo + i);
+    }
+
+    savestateChunkDo8(chunk, &i2s->txFifoEnts);
+    savestateChunkDo8(chunk, &i2s->rxFifoEnts);
+}
@@ -9,6 +9,7 @@
 #include "SoC.h"
 #include "cputil.h"
 #include "mem.h"
+#include "savestate_chunk.h"
 
 #define PXA_IC_BASE 0x40D00000UL
 #define PXA_IC_SIZE 0x00010000UL
@@ -326,3 +327,16 @@ void socIcInt(struct SocIc *ic, uint_fast8_t intNum,
 
     if (ic->ICPR[intNum / 32] != old) socIcPrvHandleChanges(ic);
 }
+
+void socIcSerialize(struct SocIc *ic, struct SavestateChunk *chunk) {
+    for (size_t i = 0; i < 2; i++) {
+        savestateChunkDo32(chunk, ic->ICMR + i);
+        savestateChunkDo32(chunk, ic->ICLR + i);
+        savestateChunkDo32(chunk, ic->ICPR + i);
+    }
+
+    savestateChunkDo32(chunk, &ic->ICCR);
+    savestateChunkDoBuffer(chunk, ic->prio, sizeof(ic->prio));
+    savestateChunkDoBool(chunk, &ic->wasIrq);
+    savestateChunkDoBool(chunk, &ic->wasFiq);
+}
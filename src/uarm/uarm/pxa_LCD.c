@@ -10,6 +10,19 @@
 #include "cputil.h"
 #include "mem.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
+#include "uarm_endian.h"
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define LCD_SIMD_SSE2
+#elif defined(__ARM_NEON) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #include <arm_neon.h>
+    #define LCD_SIMD_NEON
+#elif defined(__wasm_simd128__)
+    #include <wasm_simd128.h>
+    #define LCD_SIMD_WASM
+#endif
 
 #define PXA_LCD_BASE 0x44000000UL
 #define PXA_LCD_SIZE 0x00001000UL
@@ -20,6 +33,13 @@
 
 #define UNMASKABLE_INTS 0x7C8E
 
+// The framebuffer is converted once every LCD_SCANOUT_INTERVAL frames (~120Hz)
+#define LCD_SCANOUT_INTERVAL 32
+
+// Granularity of change tracking in the framebuffer
+#define LCD_TILE_SHIFT 9
+#define LCD_TILE_SIZE (1u << LCD_TILE_SHIFT)
+
 struct PxaLcd {
     struct SocIc *ic;
     struct ArmMem *mem;
@@ -54,8 +74,16 @@ struct PxaLcd {
     uint32_t framebufferBase;
     uint32_t framebufferSize;
     uint8_t framebufferBpp;
-    bool framebufferDirty;
     bool framebufferTrackingActive;
+
+    // Tiles written since the last scanout and tiles converted by the last scanout. The back
+    // buffer is one scanout behind, so it needs both.
+    uint32_t *dirtyTiles;
+    uint32_t *lastDirtyTiles;
+    uint32_t tileWords;
+
+    uint8_t tileScratch[LCD_TILE_SIZE] __attribute__((aligned(16)));
+    uint32_t *pixelScratch;
 };
 
 static uint32_t unpack_rgb16(uint16_t rgb16) {
@@ -307,6 +335,11 @@ static void pxaLcdPrvDma(struct PxaLcd *lcd, void *dest, uint32_t addr, int32_t
     }
 }
 
+static void pxaLcdPrvInvalidateFramebuffer(struct PxaLcd *lcd) {
+    memset(lcd->dirtyTiles, 0xff, lcd->tileWords * sizeof(uint32_t));
+    memset(lcd->lastDirtyTiles, 0xff, lcd->tileWords * sizeof(uint32_t));
+}
+
 static void pxaLcdUpdatePalette(struct PxaLcd *lcd, int32_t len) {
     const uint32_t n_entries = len >> 1;
     uint16_t *entry = (uint16_t *)lcd->palette;
@@ -321,25 +354,225 @@ static void pxaLcdUpdatePalette(struct PxaLcd *lcd, int32_t len) {
         if (dirty) *entry_mapped = unpack_rgb16(*entry);
     }
 
-    if (dirty) socSetFramebufferDirty(lcd->soc);
+    if (dirty) pxaLcdPrvInvalidateFramebuffer(lcd);
 }
 
-static void pxaLcdPrvScreenDataPixel(struct PxaLcd *lcd, uint32_t color) {
-    lcd->back_buffer[lcd->i_pixel++] = color;
+static void pxaLcdPrvConvertRgb16(const uint8_t *src, uint32_t pixels, uint32_t *dst) {
+    uint32_t i = 0;
 
-    if (lcd->i_pixel == lcd->width * lcd->height) {
-        lcd->i_pixel = 0;
-        lcd->frame_pending = true;
+#if defined(LCD_SIMD_SSE2)
+    const __m128i mask5 = _mm_set1_epi16(0x1f);
+    const __m128i mask6 = _mm_set1_epi16(0x3f);
+    const __m128i alpha = _mm_set1_epi16((short)0xff00);
 
-        uint32_t *front_buffer = lcd->front_buffer;
-        lcd->front_buffer = lcd->back_buffer;
-        lcd->back_buffer = front_buffer;
+    for (; i + 8 <= pixels; i += 8) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)(src + 2 * i));
+        const __m128i r = _mm_srli_epi16(p, 11);
+        const __m128i g = _mm_and_si128(_mm_srli_epi16(p, 5), mask6);
+        const __m128i b = _mm_and_si128(p, mask5);
+
+        const __m128i r8 = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+        const __m128i g8 = _mm_or_si128(_mm_slli_epi16(g, 2), _mm_srli_epi16(g, 4));
+        const __m128i b8 = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+
+        const __m128i rg = _mm_or_si128(r8, _mm_slli_epi16(g8, 8));
+        const __m128i ba = _mm_or_si128(b8, alpha);
+
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128((__m128i *)(dst + i + 4), _mm_unpackhi_epi16(rg, ba));
+    }
+#elif defined(LCD_SIMD_NEON)
+    const uint16x8_t mask5 = vdupq_n_u16(0x1f);
+    const uint16x8_t mask6 = vdupq_n_u16(0x3f);
+    const uint16x8_t alpha = vdupq_n_u16(0xff00);
+
+    for (; i + 8 <= pixels; i += 8) {
+        const uint16x8_t p = vreinterpretq_u16_u8(vld1q_u8(src + 2 * i));
+        const uint16x8_t r = vshrq_n_u16(p, 11);
+        const uint16x8_t g = vandq_u16(vshrq_n_u16(p, 5), mask6);
+        const uint16x8_t b = vandq_u16(p, mask5);
+
+        const uint16x8_t r8 = vorrq_u16(vshlq_n_u16(r, 3), vshrq_n_u16(r, 2));
+        const uint16x8_t g8 = vorrq_u16(vshlq_n_u16(g, 2), vshrq_n_u16(g, 4));
+        const uint16x8_t b8 = vorrq_u16(vshlq_n_u16(b, 3), vshrq_n_u16(b, 2));
+
+        const uint16x8_t rg = vorrq_u16(r8, vshlq_n_u16(g8, 8));
+        const uint16x8_t ba = vorrq_u16(b8, alpha);
+        const uint16x8x2_t rgba = vzipq_u16(rg, ba);
+
+        vst1q_u32(dst + i, vreinterpretq_u32_u16(rgba.val[0]));
+        vst1q_u32(dst + i + 4, vreinterpretq_u32_u16(rgba.val[1]));
+    }
+#elif defined(LCD_SIMD_WASM)
+    const v128_t mask5 = wasm_i16x8_splat(0x1f);
+    const v128_t mask6 = wasm_i16x8_splat(0x3f);
+    const v128_t alpha = wasm_i16x8_splat((int16_t)0xff00);
+
+    for (; i + 8 <= pixels; i += 8) {
+        const v128_t p = wasm_v128_load(src + 2 * i);
+        const v128_t r = wasm_u16x8_shr(p, 11);
+        const v128_t g = wasm_v128_and(wasm_u16x8_shr(p, 5), mask6);
+        const v128_t b = wasm_v128_and(p, mask5);
+
+        const v128_t r8 = wasm_v128_or(wasm_i16x8_shl(r, 3), wasm_u16x8_shr(r, 2));
+        const v128_t g8 = wasm_v128_or(wasm_i16x8_shl(g, 2), wasm_u16x8_shr(g, 4));
+        const v128_t b8 = wasm_v128_or(wasm_i16x8_shl(b, 3), wasm_u16x8_shr(b, 2));
+
+        const v128_t rg = wasm_v128_or(r8, wasm_i16x8_shl(g8, 8));
+        const v128_t ba = wasm_v128_or(b8, alpha);
+
+        wasm_v128_store(dst + i, wasm_i16x8_shuffle(rg, ba, 0, 8, 1, 9, 2, 10, 3, 11));
+        wasm_v128_store(dst + i + 4, wasm_i16x8_shuffle(rg, ba, 4, 12, 5, 13, 6, 14, 7, 15));
+    }
+#endif
+
+    for (; i < pixels; i++) dst[i] = unpack_rgb16(le16toh(*(const uint16_t *)(src + 2 * i)));
+}
+
+// Convert a span of framebuffer data in the given depth. Returns the number of pixels written.
+static uint32_t pxaLcdPrvConvert(struct PxaLcd *lcd, uint8_t bpp, const uint8_t *src,
+                                 uint32_t len, uint32_t *dst) {
+    const uint32_t *palette = lcd->palette_mapped;
+    uint32_t i;
+
+    switch (bpp) {
+        case 0:  // 1BPP
+            for (i = 0; i < len; i++, dst += 8) {
+                const uint8_t byte = src[i];
+
+                for (uint32_t j = 0; j < 8; j++) dst[j] = palette[(byte >> j) & 1];
+            }
+
+            return len << 3;
+
+        case 1:  // 2BPP
+            for (i = 0; i < len; i++, dst += 4) {
+                const uint8_t byte = src[i];
+
+                for (uint32_t j = 0; j < 4; j++) dst[j] = palette[(byte >> (2 * j)) & 3];
+            }
+
+            return len << 2;
+
+        case 2:  // 4BPP
+            for (i = 0; i < len; i++, dst += 2) {
+                dst[0] = palette[src[i] & 15];
+                dst[1] = palette[src[i] >> 4];
+            }
+
+            return len << 1;
+
+        case 3:  // 8BPP
+            for (i = 0; i < len; i++) dst[i] = palette[src[i]];
+
+            return len;
+
+        case 4:  // 16BPP
+            pxaLcdPrvConvertRgb16(src, len >> 1, dst);
+
+            return len >> 1;
+
+        default:  // BAD
+            return 0;
+    }
+}
+
+// Returns a pointer to len bytes of framebuffer data. The data is read directly from host memory
+// if it is contained in a single page, and assembled in the scratch buffer otherwise.
+static const uint8_t *pxaLcdPrvFetch(struct PxaLcd *lcd, uint32_t addr /*PA*/, uint32_t len) {
+    struct MemHostPage page;
+    uint8_t *scratch = lcd->tileScratch;
+    uint32_t copied = 0;
+
+    while (copied < len) {
+        const uint32_t pageOffset = (addr + copied) & 0xfff;
+        const uint32_t chunk = len - copied < 0x1000 - pageOffset ? len - copied
+                                                                  : 0x1000 - pageOffset;
+
+        if (memGetHostPage(lcd->mem, addr + copied, false, &page)) {
+            if (chunk == len) return page.data + pageOffset;
+
+            memcpy(scratch + copied, page.data + pageOffset, chunk);
+        } else
+            pxaLcdPrvDma(lcd, scratch + copied, addr + copied, chunk);
+
+        copied += chunk;
+    }
+
+    return scratch;
+}
+
+static void pxaLcdPrvSwapBuffers(struct PxaLcd *lcd) {
+    uint32_t *front_buffer = lcd->front_buffer;
+
+    lcd->front_buffer = lcd->back_buffer;
+    lcd->back_buffer = front_buffer;
+
+    lcd->i_pixel = 0;
+    lcd->frame_pending = true;
+}
+
+// Tracked framebuffer: convert the tiles that changed since the back buffer was last drawn
+static void pxaLcdPrvScanoutTracked(struct PxaLcd *lcd) {
+    const uint8_t bpp = lcd->framebufferBpp;
+    const uint32_t tiles = (lcd->framebufferSize + LCD_TILE_SIZE - 1) >> LCD_TILE_SHIFT;
+    bool dirty = false;
+
+    for (uint32_t i = 0; i < lcd->tileWords; i++) dirty = dirty || lcd->dirtyTiles[i];
+    if (!dirty) return;
+
+    for (uint32_t word = 0; word < lcd->tileWords; word++) {
+        uint32_t pending = lcd->dirtyTiles[word] | lcd->lastDirtyTiles[word];
+
+        lcd->lastDirtyTiles[word] = lcd->dirtyTiles[word];
+        lcd->dirtyTiles[word] = 0;
+
+        while (pending) {
+            const uint32_t tile = (word << 5) + __builtin_ctz(pending);
+            pending &= pending - 1;
+
+            if (tile >= tiles) break;
+
+            const uint32_t offset = tile << LCD_TILE_SHIFT;
+            const uint32_t len = lcd->framebufferSize - offset < LCD_TILE_SIZE
+                                     ? lcd->framebufferSize - offset
+                                     : LCD_TILE_SIZE;
+
+            pxaLcdPrvConvert(lcd, bpp, pxaLcdPrvFetch(lcd, lcd->framebufferBase + offset, len),
+                             len, lcd->back_buffer + ((offset << 3) >> bpp));
+        }
+    }
+
+    pxaLcdPrvSwapBuffers(lcd);
+}
+
+// Untracked (segmented) framebuffer: convert everything and fill the frame as data arrives
+static void pxaLcdPrvScanoutSegment(struct PxaLcd *lcd, uint32_t addr /*PA*/, uint32_t len) {
+    const uint8_t bpp = lcd->framebufferBpp;
+    const uint32_t framePixels = lcd->width * lcd->height;
+
+    len &= ~3u;
+
+    for (uint32_t offset = 0; offset < len; offset += LCD_TILE_SIZE) {
+        const uint32_t chunk = len - offset < LCD_TILE_SIZE ? len - offset : LCD_TILE_SIZE;
+        const uint32_t pixels =
+            pxaLcdPrvConvert(lcd, bpp, pxaLcdPrvFetch(lcd, addr + offset, chunk), chunk,
+                             lcd->pixelScratch);
+
+        for (uint32_t i = 0; i < pixels;) {
+            const uint32_t count =
+                pixels - i < framePixels - lcd->i_pixel ? pixels - i : framePixels - lcd->i_pixel;
+
+            memcpy(lcd->back_buffer + lcd->i_pixel, lcd->pixelScratch + i, count * 4);
+            lcd->i_pixel += count;
+            i += count;
+
+            if (lcd->i_pixel == framePixels) pxaLcdPrvSwapBuffers(lcd);
+        }
     }
 }
 
 static void pxaLcdPrvScreenDataDma(struct PxaLcd *lcd, uint32_t addr /*PA*/, uint32_t len) {
-    uint8_t data[4];
-    uint32_t i, j;
     const uint8_t bpp = (lcd->lccr3 >> 24) & 7;
 
     if (addr != lcd->framebufferBase || len != lcd->framebufferSize || bpp != lcd->framebufferBpp) {
@@ -347,11 +580,11 @@ static void pxaLcdPrvScreenDataDma(struct PxaLcd *lcd, uint32_t addr /*PA*/, uin
         lcd->framebufferSize = len;
         lcd->framebufferBpp = bpp;
 
-        if (len == ((uint32_t)(lcd->width * lcd->height) << bpp) >> 3) {
+        // The dirty tile bitmaps are sized for 16bpp (bpp == 4), so deeper modes are not tracked
+        if (bpp <= 4 && len == ((uint32_t)(lcd->width * lcd->height) << bpp) >> 3) {
             fprintf(stderr, "framebuffer now at 0x%08x , size %u bytes, %d bpp\n", addr, len,
                     (int)(1 << bpp));
 
-            lcd->framebufferDirty = true;
             lcd->framebufferTrackingActive = socSetFramebuffer(lcd->soc, addr, len);
         } else {
             fprintf(stderr,
@@ -360,62 +593,17 @@ static void pxaLcdPrvScreenDataDma(struct PxaLcd *lcd, uint32_t addr /*PA*/, uin
                     len, (int)(1 << bpp));
 
             socSetFramebuffer(lcd->soc, 0, 0);
-            lcd->framebufferDirty = true;
             lcd->framebufferTrackingActive = false;
         }
-    }
-
-    if (lcd->framebufferTrackingActive && !lcd->framebufferDirty) return;
-
-    len /= 4;
-    while (len--) {
-        pxaLcdPrvDma(lcd, data, addr, 4);
-        addr += 4;
-
-        switch (bpp) {
-            case 0:  // 1BPP
-
-                for (i = 0; i < 4; i++) {
-                    for (j = 0; j < 8; j++)
-                        pxaLcdPrvScreenDataPixel(lcd, lcd->palette_mapped[((data[i] >> j) & 1)]);
-                }
-                break;
-
-            case 1:  // 2BPP
-
-                for (i = 0; i < 4; i++) {
-                    for (j = 0; j < 8; j += 2)
-                        pxaLcdPrvScreenDataPixel(lcd, lcd->palette_mapped[((data[i] >> j) & 3)]);
-                }
-                break;
-
-            case 2:  // 4BPP
-
-                for (i = 0; i < 4; i++) {
-                    for (j = 0; j < 8; j += 4)
-                        pxaLcdPrvScreenDataPixel(lcd, lcd->palette_mapped[((data[i] >> j) & 15)]);
-                }
-                break;
-
-            case 3:  // 8BPP
-
-                for (i = 0; i < 4; i++) pxaLcdPrvScreenDataPixel(lcd, lcd->palette_mapped[data[i]]);
 
-                break;
-
-            case 4:  // 16BPP
-
-                pxaLcdPrvScreenDataPixel(lcd, unpack_rgb16(*(uint16_t *)(&data[0])));
-                pxaLcdPrvScreenDataPixel(lcd, unpack_rgb16(*(uint16_t *)(&data[2])));
-                break;
-
-            default:
-
-                ;  // BAD
-        }
+        pxaLcdPrvInvalidateFramebuffer(lcd);
+        lcd->i_pixel = 0;
     }
 
-    lcd->framebufferDirty = false;
+    if (lcd->framebufferTrackingActive)
+        pxaLcdPrvScanoutTracked(lcd);
+    else
+        pxaLcdPrvScanoutSegment(lcd, addr, len);
 }
 
 void pxaLcdTick(struct PxaLcd *lcd) {
@@ -477,7 +665,8 @@ void pxaLcdTick(struct PxaLcd *lcd) {
                     } else {
                         lcd->frameNum++;
 
-                        if (!(lcd->frameNum & 63)) pxaLcdPrvScreenDataDma(lcd, lcd->fsadr[0], len);
+                        if (!(lcd->frameNum % LCD_SCANOUT_INTERVAL))
+                            pxaLcdPrvScreenDataDma(lcd, lcd->fsadr[0], len);
                     }
 
                     lcd->state = LCD_STATE_DMA_0_END;
@@ -500,7 +689,20 @@ uint32_t *pxaLcdGetPendingFrame(struct PxaLcd *lcd) {
 
 void pxaLcdResetPendingFrame(struct PxaLcd *lcd) { lcd->frame_pending = false; }
 
-void pxaLcdSetFramebufferDirty(struct PxaLcd *lcd) { lcd->framebufferDirty = true; }
+void pxaLcdSetFramebufferDirty(struct PxaLcd *lcd, uint32_t pa, uint32_t size) {
+    if (!lcd->framebufferTrackingActive) return;
+
+    if (pa + size <= lcd->framebufferBase || pa >= lcd->framebufferBase + lcd->framebufferSize)
+        return;
+
+    const uint32_t first = pa > lcd->framebufferBase ? pa - lcd->framebufferBase : 0;
+    const uint32_t last = pa + size - lcd->framebufferBase - 1 < lcd->framebufferSize
+                              ? pa + size - lcd->framebufferBase - 1
+                              : lcd->framebufferSize - 1;
+
+    for (uint32_t tile = first >> LCD_TILE_SHIFT; tile <= last >> LCD_TILE_SHIFT; tile++)
+        lcd->dirtyTiles[tile >> 5] |= 1u << (tile & 31);
+}
 
 struct PxaLcd *pxaLcdInit(struct ArmMem *physMem, struct SoC *soc, struct SocIc *ic, uint16_t width,
                           uint16_t height) {
@@ -518,6 +720,18 @@ struct PxaLcd *pxaLcdInit(struct ArmMem *physMem, struct SoC *soc, struct SocIc
 
     lcd->front_buffer = (uint32_t *)malloc(width * height * 4);
     lcd->back_buffer = (uint32_t *)malloc(width * height * 4);
+    lcd->pixelScratch = (uint32_t *)malloc(LCD_TILE_SIZE * 8 * 4);
+
+    // 16bpp is the deepest mode
+    lcd->tileWords = (((width * height * 2 + LCD_TILE_SIZE - 1) >> LCD_TILE_SHIFT) + 31) >> 5;
+    lcd->dirtyTiles = (uint32_t *)malloc(lcd->tileWords * sizeof(uint32_t));
+    lcd->lastDirtyTiles = (uint32_t *)malloc(lcd->tileWords * sizeof(uint32_t));
+
+    if (!lcd->front_buffer || !lcd->back_buffer || !lcd->pixelScratch || !lcd->dirtyTiles ||
+        !lcd->lastDirtyTiles)
+        ERR("cannot alloc LCD buffers");
+
+    pxaLcdPrvInvalidateFramebuffer(lcd);
 
     if (!memRegionAdd(physMem, PXA_LCD_BASE, PXA_LCD_SIZE, pxaLcdPrvMemAccessF, lcd))
         ERR("cannot add LCD to MEM\n");
@@ -526,3 +740,48 @@ struct PxaLcd *pxaLcdInit(struct ArmMem *physMem, struct SoC *soc, struct SocIc
 
     return lcd;
 }
+
+void pxaLcdSerialize(struct PxaLcd *lcd, struct SavestateChunk *chunk) {
+    uint32_t *regs[] = {&lcd->lccr0, &lcd->lccr1, &lcd->lccr2, &lcd->lccr3, &lcd->lccr4,
+                        &lcd->lccr5, &lcd->liicr, &lcd->trgbr, &lcd->tcr};
+    uint8_t state = lcd->state, intWasPending = lcd->intWasPending,
+            enbChanged = lcd->enbChanged;
+
+    for (size_t i = 0; i < sizeof(regs) / sizeof(*regs); i++) savestateChunkDo32(chunk, regs[i]);
+
+    for (size_t i = 0; i < 7; i++) {
+        savestateChunkDo32(chunk, lcd->fbr + i);
+        savestateChunkDo32(chunk, lcd->fdadr + i);
+        savestateChunkDo32(chunk, lcd->fsadr + i);
+        savestateChunkDo32(chunk, lcd->fidr + i);
+        savestateChunkDo32(chunk, lcd->ldcmd + i);
+    }
+
+    savestateChunkDo16(chunk, &lcd->lcsr);
+    savestateChunkDo16(chunk, &lcd->intMask);
+    savestateChunkDo8(chunk, &state);
+    savestateChunkDo8(chunk, &intWasPending);
+    savestateChunkDo8(chunk, &enbChanged);
+
+    savestateChunkDoBuffer(chunk, lcd->palette, sizeof(lcd->palette));
+    for (size_t i = 0; i < 512; i++) savestateChunkDo32(chunk, lcd->palette_mapped + i);
+
+    savestateChunkDo32(chunk, &lcd->frameNum);
+
+    if (!savestateChunkIsLoading(chunk)) return;
+
+    lcd->state = state;
+    lcd->intWasPending = intWasPending;
+    lcd->enbChanged = enbChanged;
+
+    // Forget the framebuffer configuration. The next scanout will set up tracking again and
+    // redraw the frame.
+    lcd->framebufferBase = 0;
+    lcd->framebufferSize = 0;
+    lcd->framebufferBpp = 0xff;
+    lcd->framebufferTrackingActive = false;
+    pxaLcdPrvInvalidateFramebuffer(lcd);
+
+    lcd->i_pixel = 0;
+    lcd->frame_pending = false;
+}
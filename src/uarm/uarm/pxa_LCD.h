@@ -12,17 +12,22 @@ extern "C" {
 #endif
 
 struct PxaLcd;
+struct SavestateChunk;
 struct SoC;
 
 struct PxaLcd *pxaLcdInit(struct ArmMem *physMem, struct SoC *soc, struct SocIc *ic, uint16_t width,
                           uint16_t heigh);
 
+// The framebuffer is rendered and tracked again from scratch after loading
+void pxaLcdSerialize(struct PxaLcd *lcd, struct SavestateChunk *chunk);
+
 void pxaLcdTick(struct PxaLcd *lcd);
 
 uint32_t *pxaLcdGetPendingFrame(struct PxaLcd *lcd);
 void pxaLcdResetPendingFrame(struct PxaLcd *lcd);
 
-void pxaLcdSetFramebufferDirty(struct PxaLcd *lcd);
+// Called for writes that touch the tracked framebuffer
+void pxaLcdSetFramebufferDirty(struct PxaLcd *lcd, uint32_t pa, uint32_t size);
 
 #ifdef __cplusplus
 }
@@ -8,6 +8,7 @@
 #include "cputil.h"
 #include "mem.h"
 #include "pxa_DMA.h"
+#include "savestate_chunk.h"
 
 #define PXA_MMC_BASE 0x41100000UL
 #define PXA_MMC_SIZE 0x00001000UL
@@ -259,6 +260,30 @@ static bool mmcSendCommand(struct PxaMmc *mmc) {
     return true;
 }
 
+static uint32_t pxaMmcPrvDmaFifoRx(void *userData, bool write, uint_fast8_t size, uint32_t *items,
+                                   uint32_t count) {
+    struct PxaMmc *mmc = (struct PxaMmc *)userData;
+    uint32_t i;
+
+    if (size != 4 || write) return 0;
+
+    for (i = 0; i < count && pxaMmcPrvDataFifoR(mmc, items + i); i++);
+
+    return i;
+}
+
+static uint32_t pxaMmcPrvDmaFifoTx(void *userData, bool write, uint_fast8_t size, uint32_t *items,
+                                   uint32_t count) {
+    struct PxaMmc *mmc = (struct PxaMmc *)userData;
+    uint32_t i;
+
+    if (size != 4 || !write) return 0;
+
+    for (i = 0; i < count && pxaMmcPrvDataFifoW(mmc, items[i]); i++);
+
+    return i;
+}
+
 static bool pxaMmcPrvMemAccessF(void *userData, uint32_t pa, uint_fast8_t size, bool write,
                                 void *buf) {
     struct PxaMmc *mmc = (struct PxaMmc *)userData;
@@ -477,7 +502,33 @@ struct PxaMmc *pxaMmcInit(struct ArmMem *physMem, struct SocIc *ic, struct SocDm
     if (!memRegionAdd(physMem, PXA_MMC_BASE, PXA_MMC_SIZE, pxaMmcPrvMemAccessF, mmc))
         ERR("cannot add MMC to MEM\n");
 
+    socDmaAddFifo(dma, PXA_MMC_BASE + 0x40, pxaMmcPrvDmaFifoRx, mmc);
+    socDmaAddFifo(dma, PXA_MMC_BASE + 0x44, pxaMmcPrvDmaFifoTx, mmc);
+
     return mmc;
 }
 
 void pxaMmcInsert(struct PxaMmc *mmc, struct VSD *vsd) { mmc->vsd = vsd; }
+
+void pxaMmcSerialize(struct PxaMmc *mmc, struct SavestateChunk *chunk) {
+    uint8_t *regs8[] = {&mmc->spi,        &mmc->iMask, &mmc->iReg,  &mmc->cmdat,
+                        &mmc->clockSpeed, &mmc->resTo, &mmc->cmdReg};
+
+    savestateChunkDo32(chunk, &mmc->arg);
+    savestateChunkDo16(chunk, &mmc->stat);
+    savestateChunkDo16(chunk, &mmc->readTo);
+    savestateChunkDo16(chunk, &mmc->blkLen);
+    savestateChunkDo16(chunk, &mmc->numBlks);
+
+    for (size_t i = 0; i < sizeof(regs8) / sizeof(*regs8); i++)
+        savestateChunkDo8(chunk, regs8[i]);
+    for (size_t i = 0; i < 8; i++) savestateChunkDo16(chunk, mmc->respBuf + i);
+
+    savestateChunkDoBool(chunk, &mmc->clockOn);
+    savestateChunkDoBool(chunk, &mmc->cmdQueued);
+    savestateChunkDoBool(chunk, &mmc->dataXferOngoing);
+
+    savestateChunkDo32(chunk, &mmc->fifoBytes);
+    savestateChunkDo32(chunk, &mmc->fifoOfst);
+    savestateChunkDoBuffer(chunk, mmc->blockFifo, sizeof(mmc->blockFifo));
+}
@@ -14,9 +14,12 @@ extern "C" {
 #endif
 
 struct PxaMmc;
+struct SavestateChunk;
 
 struct PxaMmc* pxaMmcInit(struct ArmMem* physMem, struct SocIc* ic, struct SocDma* dma);
 
+void pxaMmcSerialize(struct PxaMmc* mmc, struct SavestateChunk* chunk);
+
 void pxaMmcInsert(struct PxaMmc* mmc, struct VSD* vsd);  // NULL also acceptable
 
 #ifdef __cplusplus
@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include "cputil.h"
+#include "savestate_chunk.h"
 
 #define PXA_MEM_CONTROLLER_BASE 0x48000000UL
 #define PXA_MEM_CONTROLLER_SIZE 0x00004000UL
@@ -210,3 +211,19 @@ struct PxaMemCtrlr* pxaMemCtrlrInit(struct ArmMem* physMem, uint_fast8_t socRev)
 
     return mc;
 }
+
+void pxaMemCtrlrSerialize(struct PxaMemCtrlr *memCtrl, struct SavestateChunk *chunk) {
+    uint32_t *regs[] = {&memCtrl->mdcnfg,    &memCtrl->mdrefr,    &memCtrl->msc[0],
+                        &memCtrl->msc[1],    &memCtrl->msc[2],    &memCtrl->mecr,
+                        &memCtrl->sxcnfg,    &memCtrl->sxmrs,     &memCtrl->mcmem[0],
+                        &memCtrl->mcmem[1],  &memCtrl->mcatt[0],  &memCtrl->mcatt[1],
+                        &memCtrl->mcio[0],   &memCtrl->mcio[1],   &memCtrl->mdmrs,
+                        &memCtrl->arbCntrl,  &memCtrl->bscntr[0], &memCtrl->bscntr[1],
+                        &memCtrl->bscntr[2], &memCtrl->bscntr[3], &memCtrl->mdmrslp,
+                        &memCtrl->reg_0x20};
+
+    for (size_t i = 0; i < sizeof(regs) / sizeof(*regs); i++) savestateChunkDo32(chunk, regs[i]);
+
+    savestateChunkDo16(chunk, &memCtrl->sa1110);
+    savestateChunkDo8(chunk, &memCtrl->lcdbscntr);
+}
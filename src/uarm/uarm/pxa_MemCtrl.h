@@ -12,9 +12,12 @@ extern "C" {
 #endif
 
 struct PxaMemCtrlr;
+struct SavestateChunk;
 
 struct PxaMemCtrlr* pxaMemCtrlrInit(struct ArmMem* physMem, uint_fast8_t socRev);
 
+void pxaMemCtrlrSerialize(struct PxaMemCtrlr* memCtrl, struct SavestateChunk* chunk);
+
 #ifdef __cplusplus
 }
 #endif
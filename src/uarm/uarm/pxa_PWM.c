@@ -7,6 +7,7 @@
 
 #include "cputil.h"
 #include "mem.h"
+#include "savestate_chunk.h"
 
 #define PXA_PWM_SIZE 0x0010
 
@@ -72,3 +73,15 @@ struct PxaPwm* pxaPwmInit(struct ArmMem* physMem, uint32_t base) {
 
     return pwm;
 }
+
+void pxaPwmSerialize(struct PxaPwm *pwm, struct SavestateChunk *chunk) {
+    uint32_t duty = pwm->duty, per = pwm->per, ctrl = pwm->ctrl;
+
+    savestateChunkDo32(chunk, &duty);
+    savestateChunkDo32(chunk, &per);
+    savestateChunkDo32(chunk, &ctrl);
+
+    pwm->duty = duty;
+    pwm->per = per;
+    pwm->ctrl = ctrl;
+}
@@ -16,9 +16,12 @@ extern "C" {
 #define PXA_PWM3_BASE 0x40C00010UL
 
 struct PxaPwm;
+struct SavestateChunk;
 
 struct PxaPwm* pxaPwmInit(struct ArmMem* physMem, uint32_t base);
 
+void pxaPwmSerialize(struct PxaPwm* pwm, struct SavestateChunk* chunk);
+
 #ifdef __cplusplus
 }
 #endif
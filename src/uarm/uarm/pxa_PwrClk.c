@@ -7,6 +7,7 @@
 
 #include "SoC.h"
 #include "cputil.h"
+#include "savestate_chunk.h"
 
 #define PXA_CLOCK_MANAGER_BASE 0x41300000UL
 #define PXA_CLOCK_MANAGER_SIZE 0x00001000UL
@@ -335,3 +336,15 @@ struct PxaPwrClk *pxaPwrClkInit(struct ArmCpu *cpu, struct ArmMem *physMem, stru
 
     return pc;
 }
+
+void pxaPwrClkSerialize(struct PxaPwrClk *pc, struct SavestateChunk *chunk) {
+    uint32_t *regs[] = {&pc->CCCR, &pc->CKEN, &pc->OSCR, &pc->PMCR, &pc->PSSR, &pc->PSPR,
+                        &pc->PWER, &pc->PRER, &pc->PFER, &pc->PEDR, &pc->PCFR, &pc->RCSR,
+                        &pc->PMFW, &pc->PSTR, &pc->PVCR, &pc->PUCR, &pc->PKWR, &pc->PKSR};
+
+    for (size_t i = 0; i < sizeof(regs) / sizeof(*regs); i++) savestateChunkDo32(chunk, regs[i]);
+    for (size_t i = 0; i < 4; i++) savestateChunkDo32(chunk, pc->PGSR + i);
+    for (size_t i = 0; i < 32; i++) savestateChunkDo32(chunk, pc->PCMD + i);
+
+    savestateChunkDoBool(chunk, &pc->turbo);
+}
@@ -12,10 +12,13 @@ extern "C" {
 #endif
 
 struct PxaPwrClk;
+struct SavestateChunk;
 
 struct PxaPwrClk* pxaPwrClkInit(struct ArmCpu* cpu, struct ArmMem* physMem, struct SoC* soc,
                                 bool isPXA270);
 
+void pxaPwrClkSerialize(struct PxaPwrClk* pc, struct SavestateChunk* chunk);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,7 @@
 #include "cputil.h"
 #include "mem.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
 
 #define PXA_RTC_BASE 0x40900000UL
 #define PXA_RTC_SIZE 0x00001000UL
@@ -119,3 +120,11 @@ void pxaRtcTick(struct PxaRtc *rtc) {
     rtc->RCNR++;
     pxaRtcPrvUpdate(rtc);
 }
+
+void pxaRtcSerialize(struct PxaRtc *rtc, struct SavestateChunk *chunk) {
+    savestateChunkDo32(chunk, &rtc->lastSeenTime);
+    savestateChunkDo32(chunk, &rtc->RCNR);
+    savestateChunkDo32(chunk, &rtc->RTAR);
+    savestateChunkDo32(chunk, &rtc->RTTR);
+    savestateChunkDo8(chunk, &rtc->RTSR);
+}
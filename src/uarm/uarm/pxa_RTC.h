@@ -12,9 +12,12 @@ extern "C" {
 #endif
 
 struct PxaRtc;
+struct SavestateChunk;
 
 struct PxaRtc* pxaRtcInit(struct ArmMem* physMem, struct SocIc* ic);
 
+void pxaRtcSerialize(struct PxaRtc* rtc, struct SavestateChunk* chunk);
+
 void pxaRtcTick(struct PxaRtc* rtc);
 
 #ifdef __cplusplus
@@ -7,6 +7,7 @@
 #include "mem.h"
 #include "pxa_DMA.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
 #include "soc_SSP.h"
 
 #define PXA_SSP_SIZE 0x00010000UL
@@ -94,6 +95,26 @@ static bool socSspPrvFifoW(struct SocSsp *ssp, uint16_t val) {
     return true;
 }
 
+static uint32_t socSspPrvDmaFifo(void *userData, bool write, uint_fast8_t size, uint32_t *items,
+                                 uint32_t count) {
+    struct SocSsp *ssp = (struct SocSsp *)userData;
+    uint16_t val;
+    uint32_t i;
+
+    if (size != 4) return 0;
+
+    for (i = 0; i < count; i++) {
+        if (write)
+            socSspPrvFifoW(ssp, items[i]);
+        else {
+            socSspPrvFifoR(ssp, &val);
+            items[i] = val;
+        }
+    }
+
+    return i;
+}
+
 static bool socSspPrvMemAccessF(void *userData, uint32_t pa, uint_fast8_t size, bool write,
                                 void *buf) {
     struct SocSsp *ssp = (struct SocSsp *)userData;
@@ -195,6 +216,8 @@ struct SocSsp *socSspInit(struct ArmMem *physMem, struct Reschedule reschedule,
     if (!memRegionAdd(physMem, base, PXA_SSP_SIZE, socSspPrvMemAccessF, ssp))
         ERR("cannot add SSP to MEM\n");
 
+    socDmaAddFifo(dma, base + 0x10, socSspPrvDmaFifo, ssp);
+
     return ssp;
 }
 
@@ -212,4 +235,18 @@ bool socSspAddClient(struct SocSsp *ssp, SspClientProcF procF, void *userData) {
     return false;
 }
 
-bool socSspTaskRequired(struct SocSsp *ssp) { return ssp->sr & 0x10; }
\ No newline at end of file
+bool socSspTaskRequired(struct SocSsp *ssp) { return ssp->sr & 0x10; }
+
+void socSspSerialize(struct SocSsp *ssp, struct SavestateChunk *chunk) {
+    savestateChunkDo32(chunk, &ssp->cr0);
+    savestateChunkDo32(chunk, &ssp->cr1);
+    savestateChunkDo32(chunk, &ssp->sr);
+
+    for (size_t i = 0; i < 16; i++) {
+        savestateChunkDo16(chunk, ssp->rxFifo + i);
+        savestateChunkDo16(chunk, ssp->txFifo + i);
+    }
+
+    savestateChunkDo8(chunk, &ssp->rxFifoUsed);
+    savestateChunkDo8(chunk, &ssp->txFifoUsed);
+}
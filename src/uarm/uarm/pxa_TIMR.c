@@ -9,12 +9,17 @@
 #include "cputil.h"
 #include "mem.h"
 #include "pxa_IC.h"
+#include "savestate_chunk.h"
 
 #define PXA_TIMR_BASE 0x40A00000UL
 #define PXA_TIMR_SIZE 0x00010000UL
 
 struct PxaTimr {
     struct SocIc *ic;
+    struct Reschedule reschedule;
+
+    PxaTimrElapsedTicksF elapsedTicks;
+    void *elapsedTicksUserData;
 
     uint32_t OSMR[4];  // Match Register 0-3
     uint32_t OSCR;     // Counter Register
@@ -44,7 +49,7 @@ static void pxaTimrPrvCheckMatchMultiStep(struct PxaTimr *timr, uint_fast8_t idx
                                           uint32_t batchedTicks) {
     uint_fast8_t v = 1UL << idx;
 
-    if (batchedTicks >= (uint32_t)(timr->OSMR[idx] - oscrOld)) {
+    if ((uint32_t)(timr->OSMR[idx] - oscrOld - 1) < batchedTicks) {
         if (idx == 3 && timr->OWER) ERR("WDT fires\n");
 
         if (timr->OIER & v) timr->OSSR |= v;
@@ -81,6 +86,9 @@ static bool pxaTimrPrvMemAccessF(void *userData, uint32_t pa, uint_fast8_t size,
 
     pa = (pa - PXA_TIMR_BASE) >> 2;
 
+    const uint32_t elapsedTicks = timr->elapsedTicks(timr->elapsedTicksUserData);
+    if (elapsedTicks) pxaTimrTick(timr, elapsedTicks);
+
     if (write) {
         val = *(uint32_t *)buf;
 
@@ -111,6 +119,8 @@ static bool pxaTimrPrvMemAccessF(void *userData, uint32_t pa, uint_fast8_t size,
                 pxaTimrPrvUpdateSingleStep(timr);
                 break;
         }
+
+        timr->reschedule.rescheduleCb(timr->reschedule.ctx, RESCHEDULE_TASK_TIMER);
     } else {
         switch (pa) {
             case 0:
@@ -142,13 +152,17 @@ static bool pxaTimrPrvMemAccessF(void *userData, uint32_t pa, uint_fast8_t size,
     return true;
 }
 
-struct PxaTimr *pxaTimrInit(struct ArmMem *physMem, struct SocIc *ic) {
+struct PxaTimr *pxaTimrInit(struct ArmMem *physMem, struct SocIc *ic, struct Reschedule reschedule,
+                            PxaTimrElapsedTicksF elapsedTicks, void *elapsedTicksUserData) {
     struct PxaTimr *timr = (struct PxaTimr *)malloc(sizeof(*timr));
 
     if (!timr) ERR("cannot alloc OSTIMER");
 
     memset(timr, 0, sizeof(*timr));
     timr->ic = ic;
+    timr->reschedule = reschedule;
+    timr->elapsedTicks = elapsedTicks;
+    timr->elapsedTicksUserData = elapsedTicksUserData;
 
     if (!memRegionAdd(physMem, PXA_TIMR_BASE, PXA_TIMR_SIZE, pxaTimrPrvMemAccessF, timr))
         ERR("cannot add OSTIMER to MEM\n");
@@ -184,3 +198,11 @@ uint32_t pxaTimrTicksToNextInterrupt(struct PxaTimr *timr) {
 
     return ticksToNextInterrupt;
 }
+
+void pxaTimrSerialize(struct PxaTimr *timr, struct SavestateChunk *chunk) {
+    for (size_t i = 0; i < 4; i++) savestateChunkDo32(chunk, timr->OSMR + i);
+    savestateChunkDo32(chunk, &timr->OSCR);
+    savestateChunkDo8(chunk, &timr->OIER);
+    savestateChunkDo8(chunk, &timr->OWER);
+    savestateChunkDo8(chunk, &timr->OSSR);
+}
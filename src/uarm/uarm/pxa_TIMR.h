@@ -7,6 +7,7 @@
 
 #include "CPU.h"
 #include "mem.h"
+#include "reschedule.h"
 #include "soc_IC.h"
 
 #ifdef __cplusplus
@@ -14,8 +15,17 @@ extern "C" {
 #endif
 
 struct PxaTimr;
+struct SavestateChunk;
 
-struct PxaTimr* pxaTimrInit(struct ArmMem* physMem, struct SocIc* ic);
+// The timer is ticked in batches that end at the next match. Before the guest accesses a register,
+// elapsedTicks reports how far OSCR is behind, and reschedule is invoked if the next match may have
+// moved.
+typedef uint32_t (*PxaTimrElapsedTicksF)(void* userData);
+
+struct PxaTimr* pxaTimrInit(struct ArmMem* physMem, struct SocIc* ic, struct Reschedule reschedule,
+                            PxaTimrElapsedTicksF elapsedTicks, void* elapsedTicksUserData);
+
+void pxaTimrSerialize(struct PxaTimr* timr, struct SavestateChunk* chunk);
 
 void pxaTimrTick(struct PxaTimr* timr, uint32_t batchedClocks);
 
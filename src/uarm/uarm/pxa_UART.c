@@ -7,6 +7,7 @@
 
 #include "cputil.h"
 #include "mem.h"
+#include "savestate_chunk.h"
 
 #define UART_FIFO_DEPTH 64
 
@@ -597,3 +598,28 @@ static void socUartPrvRecalc(struct SocUart *uart) {
 }
 
 bool socUartTaskRequired(struct SocUart *uart) { return (uart->LSR & UART_LSR_TEMT) == 0; }
+
+static void socUartPrvSerializeFifo(struct UartFifo *fifo, struct SavestateChunk *chunk) {
+    savestateChunkDo8(chunk, &fifo->read);
+    savestateChunkDo8(chunk, &fifo->write);
+    for (size_t i = 0; i < UART_FIFO_DEPTH; i++) savestateChunkDo16(chunk, fifo->buf + i);
+}
+
+void socUartSerialize(struct SocUart *uart, struct SavestateChunk *chunk) {
+    uint8_t cyclesSinceRecv = uart->cyclesSinceRecv;
+
+    socUartPrvSerializeFifo(&uart->TX, chunk);
+    socUartPrvSerializeFifo(&uart->RX, chunk);
+
+    savestateChunkDo16(chunk, &uart->transmitShift);
+    savestateChunkDo16(chunk, &uart->transmitHolding);
+    savestateChunkDo16(chunk, &uart->receiveHolding);
+    savestateChunkDo8(chunk, &cyclesSinceRecv);
+
+    uint8_t *regs[] = {&uart->IER, &uart->IIR, &uart->FCR, &uart->LCR, &uart->LSR, &uart->MCR,
+                       &uart->MSR, &uart->SPR, &uart->DLL, &uart->DLH, &uart->ISR};
+
+    for (size_t i = 0; i < sizeof(regs) / sizeof(*regs); i++) savestateChunkDo8(chunk, regs[i]);
+
+    uart->cyclesSinceRecv = cyclesSinceRecv;
+}
@@ -9,8 +9,10 @@
 extern "C" {
 #endif
 
-#define RAM_BUFFER_MARK_DIRTY(buf, addr) \
-    ((buf).dirtyPages[(addr) >> 14] |= (1u << (((addr) >> 9) & 0x1f)))
+#define RAM_BUFFER_MARK_DIRTY_PAGES(dirtyPages, addr) \
+    ((dirtyPages)[(addr) >> 14] |= (1u << (((addr) >> 9) & 0x1f)))
+
+#define RAM_BUFFER_MARK_DIRTY(buf, addr) RAM_BUFFER_MARK_DIRTY_PAGES((buf).dirtyPages, addr)
 
 struct RamBuffer {
     size_t size;
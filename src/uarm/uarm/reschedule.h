@@ -8,6 +8,7 @@
 #define RESCHEDULE_TASK_SSP 2
 #define RESCHEDULE_TASK_UART 3
 #define RESCHEDULE_TASK_DMA 4
+#define RESCHEDULE_TASK_TIMER 5
 
 typedef void (*RescheduleCallbackT)(void* ctx, uint32_t type);
 
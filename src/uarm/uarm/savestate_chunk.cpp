@@ -0,0 +1,65 @@
+#include "savestate_chunk.h"
+
+#include "Chunk.h"
+#include "ChunkProbe.h"
+
+namespace {
+    template <typename T, void (ChunkProbe::*probeF)(T), void (Chunk::*putF)(T), T (Chunk::*getF)()>
+    void savestateChunkDo(SavestateChunk* chunk, T* value) {
+        switch (chunk->mode) {
+            case SavestateChunk::Mode::probe:
+                (chunk->probe->*probeF)(*value);
+                break;
+
+            case SavestateChunk::Mode::save:
+                (chunk->chunk->*putF)(*value);
+                break;
+
+            case SavestateChunk::Mode::load:
+                *value = (chunk->chunk->*getF)();
+                break;
+        }
+    }
+}  // namespace
+
+bool savestateChunkIsLoading(const SavestateChunk* chunk) {
+    return chunk->mode == SavestateChunk::Mode::load;
+}
+
+void savestateChunkDo8(SavestateChunk* chunk, uint8_t* value) {
+    savestateChunkDo<uint8_t, &ChunkProbe::Put8, &Chunk::Put8, &Chunk::Get8>(chunk, value);
+}
+
+void savestateChunkDo16(SavestateChunk* chunk, uint16_t* value) {
+    savestateChunkDo<uint16_t, &ChunkProbe::Put16, &Chunk::Put16, &Chunk::Get16>(chunk, value);
+}
+
+void savestateChunkDo32(SavestateChunk* chunk, uint32_t* value) {
+    savestateChunkDo<uint32_t, &ChunkProbe::Put32, &Chunk::Put32, &Chunk::Get32>(chunk, value);
+}
+
+void savestateChunkDo64(SavestateChunk* chunk, uint64_t* value) {
+    savestateChunkDo<uint64_t, &ChunkProbe::Put64, &Chunk::Put64, &Chunk::Get64>(chunk, value);
+}
+
+void savestateChunkDoBool(SavestateChunk* chunk, bool* value) {
+    savestateChunkDo<bool, &ChunkProbe::PutBool, &Chunk::PutBool, &Chunk::GetBool>(chunk, value);
+}
+
+void savestateChunkDoBuffer(SavestateChunk* chunk, void* buffer, size_t size) {
+    switch (chunk->mode) {
+        case SavestateChunk::Mode::probe:
+            chunk->probe->PutBuffer(buffer, size);
+            break;
+
+        case SavestateChunk::Mode::save:
+            chunk->chunk->PutBuffer(buffer, size);
+            break;
+
+        case SavestateChunk::Mode::load:
+            chunk->chunk->GetBuffer(buffer, size);
+            break;
+    }
+}
+
+void savestateChunkNotifyError(SavestateChunk* chunk) { chunk->error = true; }
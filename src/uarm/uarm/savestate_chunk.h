@@ -0,0 +1,86 @@
+#ifndef _SAVESTATE_CHUNK_H_
+#define _SAVESTATE_CHUNK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Access to a savestate chunk from C. Modules implement a single serialization function that
+// passes pointers to their state; depending on the mode of the chunk the values are either
+// written to the savestate or replaced with the values from the savestate.
+
+struct SavestateChunk;
+
+bool savestateChunkIsLoading(const struct SavestateChunk* chunk);
+
+void savestateChunkDo8(struct SavestateChunk* chunk, uint8_t* value);
+void savestateChunkDo16(struct SavestateChunk* chunk, uint16_t* value);
+void savestateChunkDo32(struct SavestateChunk* chunk, uint32_t* value);
+void savestateChunkDo64(struct SavestateChunk* chunk, uint64_t* value);
+void savestateChunkDoBool(struct SavestateChunk* chunk, bool* value);
+void savestateChunkDoBuffer(struct SavestateChunk* chunk, void* buffer, size_t size);
+
+// Flag the savestate as invalid, i.e. if the loaded state is inconsistent with the configuration
+void savestateChunkNotifyError(struct SavestateChunk* chunk);
+
+#ifdef __cplusplus
+}
+
+class Chunk;
+class ChunkProbe;
+
+struct SavestateChunk {
+    enum class Mode { probe, save, load };
+
+    explicit SavestateChunk(ChunkProbe& probe) : mode(Mode::probe), probe(&probe) {}
+    SavestateChunk(Chunk& chunk, bool loading)
+        : mode(loading ? Mode::load : Mode::save), chunk(&chunk) {}
+
+    SavestateChunk(Chunk* chunk, bool loading) : SavestateChunk(*chunk, loading) {}
+    SavestateChunk(ChunkProbe* probe, bool loading) : SavestateChunk(*probe) {}
+
+    bool HasError() const { return error; }
+
+    // Chained accessors in the style of the chunk helpers, for C++ code that shares a chunk
+    // with C modules
+    SavestateChunk& Do8(uint8_t& value) {
+        savestateChunkDo8(this, &value);
+        return *this;
+    }
+
+    SavestateChunk& Do16(uint16_t& value) {
+        savestateChunkDo16(this, &value);
+        return *this;
+    }
+
+    SavestateChunk& Do32(uint32_t& value) {
+        savestateChunkDo32(this, &value);
+        return *this;
+    }
+
+    SavestateChunk& Do64(uint64_t& value) {
+        savestateChunkDo64(this, &value);
+        return *this;
+    }
+
+    SavestateChunk& DoBool(bool& value) {
+        savestateChunkDoBool(this, &value);
+        return *this;
+    }
+
+    Mode mode;
+    bool error{false};
+
+    union {
+        ChunkProbe* probe;
+        Chunk* chunk;
+    };
+};
+
+#endif
+
+#endif  // _SAVESTATE_CHUNK_H_
@@ -32,6 +32,22 @@ class Scheduler {
     void Advance(uint64_t cycles, uint64_t cyclesPerSecond);
 
     uint64_t GetTime() const;
+    // Time after another number of cycles at the clock last passed to Advance / CyclesToNextUpdate
+    uint64_t GetTime(uint64_t cycles) const;
+
+    // Cycles advanced since init plus another number of cycles. Not part of the saved state.
+    uint64_t GetCycles(uint64_t cycles) const;
+
+    // Removes the ticks that have elapsed until the given time from the batch of a task and
+    // returns them, so that the client can catch up before the batch is dispatched. The last tick
+    // of a batch is always left to the regular dispatch, and the deadline does not change.
+    uint32_t TakeElapsedTicks(uint32_t taskType, uint64_t time);
+
+    uint64_t GetDispatchCount(uint32_t taskType) const;
+    uint64_t GetDispatchedTicks(uint32_t taskType) const;
+
+    template <typename U>
+    void DoSaveLoad(U& helper);
 
    private:
     template <bool atLeast>
@@ -51,6 +67,7 @@ class Scheduler {
 
    private:
     void UpdateNextUpdate();
+    void UpdateClock(uint64_t cyclesPerSecond);
 
    private:
     T& dispatchDelegate;
@@ -61,6 +78,18 @@ class Scheduler {
 
     uint64_t accTime{0};
     uint64_t nextUpdate{1_sec};
+
+    // cycle <-> nsec conversion in 32.32 fixed point, cached for the last clock. accTimeFraction
+    // carries the sub nanosecond remainder.
+    uint64_t cyclesPerSecond{0};
+    uint64_t nsecPerCycle{0};
+    uint64_t cyclesPerNsec{0};
+    uint32_t accTimeFraction{0};
+
+    uint64_t accCycles{0};
+
+    uint64_t dispatchCount[SCHEDULER_TASK_MAX + 1]{};
+    uint64_t dispatchedTicks[SCHEDULER_TASK_MAX + 1]{};
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -162,12 +191,30 @@ void Scheduler<T>::UnscheduleTask(uint32_t taskType) {
 
 template <typename T>
 uint64_t Scheduler<T>::CyclesToNextUpdate(uint64_t cyclesPerSecond) {
-    return ((nextUpdate - accTime) * cyclesPerSecond) / 1_sec + 1;
+    if (cyclesPerSecond != this->cyclesPerSecond) UpdateClock(cyclesPerSecond);
+
+    // Deadlines further out than a second are approached in steps. This keeps the products below
+    // (and the one in Advance) within 64 bits.
+    const uint64_t timeToNextUpdate = nextUpdate - accTime < 1_sec ? nextUpdate - accTime : 1_sec;
+
+    return ((timeToNextUpdate * cyclesPerNsec) >> 32) + 1;
 }
 
 template <typename T>
 void Scheduler<T>::Advance(uint64_t cycles, uint64_t cyclesPerSecond) {
-    accTime += ((cycles * 1_sec) / cyclesPerSecond);
+    if (cyclesPerSecond != this->cyclesPerSecond) UpdateClock(cyclesPerSecond);
+
+    accCycles += cycles;
+
+    if (cycles <= cyclesPerSecond) {
+        const uint64_t time = cycles * nsecPerCycle + accTimeFraction;
+
+        accTime += time >> 32;
+        accTimeFraction = time;
+    } else {
+        accTime += (cycles * 1_sec) / cyclesPerSecond;
+    }
+
     if (accTime < nextUpdate) return;
 
     while (true) {
@@ -180,6 +227,8 @@ void Scheduler<T>::Advance(uint64_t cycles, uint64_t cyclesPerSecond) {
 
         const uint32_t batchTicks = dispatchDelegate.DispatchTicks(taskType, task.batchedTicks);
         task.lastUpdate += task.batchedTicks * task.period;
+        dispatchCount[taskType]++;
+        dispatchedTicks[taskType] += task.batchedTicks;
 
         RescheduleTaskImpl<false>(taskType, batchTicks);
     }
@@ -192,6 +241,57 @@ uint64_t Scheduler<T>::GetTime() const {
     return accTime;
 }
 
+template <typename T>
+uint64_t Scheduler<T>::GetTime(uint64_t cycles) const {
+    return accTime + ((cycles * nsecPerCycle + accTimeFraction) >> 32);
+}
+
+template <typename T>
+uint64_t Scheduler<T>::GetCycles(uint64_t cycles) const {
+    return accCycles + cycles;
+}
+
+template <typename T>
+uint32_t Scheduler<T>::TakeElapsedTicks(uint32_t taskType, uint64_t time) {
+    Task& task{tasks[taskType]};
+
+    if (task.batchedTicks <= 1 || time < task.lastUpdate + task.period) return 0;
+
+    uint64_t ticks = (time - task.lastUpdate) / task.period;
+    if (ticks >= task.batchedTicks) ticks = task.batchedTicks - 1;
+
+    task.lastUpdate += ticks * task.period;
+    task.batchedTicks -= ticks;
+    dispatchedTicks[taskType] += ticks;
+
+    return ticks;
+}
+
+template <typename T>
+uint64_t Scheduler<T>::GetDispatchCount(uint32_t taskType) const {
+    return dispatchCount[taskType];
+}
+
+template <typename T>
+uint64_t Scheduler<T>::GetDispatchedTicks(uint32_t taskType) const {
+    return dispatchedTicks[taskType];
+}
+
+template <typename T>
+template <typename U>
+void Scheduler<T>::DoSaveLoad(U& helper) {
+    for (auto& task : tasks) {
+        helper.Do32(task.batchedTicks)
+            .Do64(task.period)
+            .Do64(task.lastUpdate)
+            .Do64(task.nextUpdate);
+    }
+
+    for (auto& entry : queueBuffer) helper.Do32(entry);
+
+    helper.Do64(accTime).Do64(nextUpdate).Do32(accTimeFraction).Do64(accCycles);
+}
+
 template <typename T>
 void Scheduler<T>::UpdateNextUpdate() {
     if (queue[-1] <= SCHEDULER_TASK_MAX) {
@@ -201,4 +301,14 @@ void Scheduler<T>::UpdateNextUpdate() {
     }
 }
 
+template <typename T>
+void Scheduler<T>::UpdateClock(uint64_t cyclesPerSecond) {
+    this->cyclesPerSecond = cyclesPerSecond;
+
+    // Rounding up cycles per nsec guarantees that CyclesToNextUpdate reaches the deadline
+    nsecPerCycle = (1_sec << 32) / cyclesPerSecond;
+    cyclesPerNsec = ((cyclesPerSecond / 1_sec) << 32) +
+                    (((cyclesPerSecond % 1_sec) << 32) + 1_sec - 1) / 1_sec;
+}
+
 #endif  // _SCHEDULER_H_
\ No newline at end of file
@@ -4,66 +4,87 @@
 #include <stdlib.h>
 #include <string.h>
 
-static size_t sectorsTotal = 0;
-static bool sdCardDirty = false;
+#include "cputil.h"
 
-static uint8_t* data = NULL;
-static uint32_t* dirtyPages = NULL;
+struct SdCard {
+    size_t sectorsTotal;
+    bool dirty;
 
-static size_t dirtyPagesSize = 0;
+    uint8_t* data;
+    bool ownsData;
 
-void sdCardInitializeWithData(size_t sectors, void* buf) {
-    if (dirtyPages) free(dirtyPages);
+    uint32_t* dirtyPages;
+    size_t dirtyPagesSize;
+};
 
-    size_t dirtyPagesSize4 = sectors / (16 * 32);
-    if ((dirtyPagesSize4 * 16 * 32) < sectors) dirtyPagesSize4++;
+struct SdCard* sdCardInitializeWithData(size_t sectors, void* buf) {
+    struct SdCard* sdCard = malloc(sizeof(*sdCard));
+    if (!sdCard) ERR("cannot alloc SD card");
 
-    data = buf;
-    sectorsTotal = sectors;
-    dirtyPagesSize = dirtyPagesSize4 * 4;
-    sdCardDirty = false;
+    memset(sdCard, 0, sizeof(*sdCard));
 
-    dirtyPages = malloc(dirtyPagesSize);
-    memset(dirtyPages, 0, dirtyPagesSize);
+    const size_t sectorsPerPage = SD_DIRTY_PAGE_SIZE / SD_SECTOR_SIZE;
+
+    size_t dirtyPagesSize4 = sectors / (sectorsPerPage * 32);
+    if ((dirtyPagesSize4 * sectorsPerPage * 32) < sectors) dirtyPagesSize4++;
+
+    sdCard->data = buf;
+    sdCard->sectorsTotal = sectors;
+    sdCard->dirtyPagesSize = dirtyPagesSize4 * 4;
+
+    sdCard->dirtyPages = malloc(sdCard->dirtyPagesSize);
+    memset(sdCard->dirtyPages, 0, sdCard->dirtyPagesSize);
+
+    return sdCard;
 }
 
-void sdCardInitialize(size_t sectors) {
+struct SdCard* sdCardInitialize(size_t sectors) {
     uint8_t* buf = malloc(sectors * SD_SECTOR_SIZE);
     memset(buf, 0, sectors * SD_SECTOR_SIZE);
 
-    sdCardInitializeWithData(sectors, buf);
+    struct SdCard* sdCard = sdCardInitializeWithData(sectors, buf);
+    sdCard->ownsData = true;
+
+    return sdCard;
+}
+
+void sdCardDestroy(struct SdCard* sdCard) {
+    if (sdCard->ownsData) free(sdCard->data);
+
+    free(sdCard->dirtyPages);
+    free(sdCard);
 }
 
-bool sdCardRead(uint32_t sector, void* buf) {
-    if (sector >= sectorsTotal) return false;
+bool sdCardRead(struct SdCard* sdCard, uint32_t sector, void* buf) {
+    if (sector >= sdCard->sectorsTotal) return false;
 
-    memcpy(buf, data + SD_SECTOR_SIZE * sector, SD_SECTOR_SIZE);
+    memcpy(buf, sdCard->data + SD_SECTOR_SIZE * sector, SD_SECTOR_SIZE);
 
     return true;
 }
 
-bool sdCardWrite(uint32_t sector, const void* buf) {
-    if (sector >= sectorsTotal) return false;
+bool sdCardWrite(struct SdCard* sdCard, uint32_t sector, const void* buf) {
+    if (sector >= sdCard->sectorsTotal) return false;
 
-    memcpy(data + SD_SECTOR_SIZE * sector, buf, SD_SECTOR_SIZE);
+    memcpy(sdCard->data + SD_SECTOR_SIZE * sector, buf, SD_SECTOR_SIZE);
 
-    const uint32_t page = sector >> 4;
-    dirtyPages[page / 32] |= (1u << (page % 32));
+    const uint32_t page = sector / (SD_DIRTY_PAGE_SIZE / SD_SECTOR_SIZE);
+    sdCard->dirtyPages[page / 32] |= (1u << (page % 32));
 
-    sdCardDirty = true;
+    sdCard->dirty = true;
     return true;
 }
 
-size_t sdCardSectorCount() { return sectorsTotal; }
+size_t sdCardSectorCount(struct SdCard* sdCard) { return sdCard->sectorsTotal; }
 
-struct Buffer sdCardData() {
-    return (struct Buffer){.size = sectorsTotal * SD_SECTOR_SIZE, .data = data};
+struct Buffer sdCardData(struct SdCard* sdCard) {
+    return (struct Buffer){.size = sdCard->sectorsTotal * SD_SECTOR_SIZE, .data = sdCard->data};
 }
 
-struct Buffer sdCardDirtyPages() {
-    return (struct Buffer){.size = dirtyPagesSize, .data = dirtyPages};
+struct Buffer sdCardDirtyPages(struct SdCard* sdCard) {
+    return (struct Buffer){.size = sdCard->dirtyPagesSize, .data = sdCard->dirtyPages};
 }
 
-bool sdCardIsDirty() { return sdCardDirty; }
+bool sdCardIsDirty(struct SdCard* sdCard) { return sdCard->dirty; }
 
-void sdCardSetDirty(bool isDirty) { sdCardDirty = isDirty; }
+void sdCardSetDirty(struct SdCard* sdCard, bool isDirty) { sdCard->dirty = isDirty; }
@@ -8,24 +8,31 @@
 #include "buffer.h"
 
 #define SD_SECTOR_SIZE 512
+// Granularity of the dirty page bitmap
+#define SD_DIRTY_PAGE_SIZE (16 * SD_SECTOR_SIZE)
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void sdCardInitialize(size_t sectors);
-void sdCardInitializeWithData(size_t sectors, void* data);
+struct SdCard;
 
-bool sdCardRead(uint32_t sector, void* data);
-bool sdCardWrite(uint32_t sector, const void* data);
+struct SdCard* sdCardInitialize(size_t sectors);
+// The data is not owned by the card and must outlive it
+struct SdCard* sdCardInitializeWithData(size_t sectors, void* data);
 
-size_t sdCardSectorCount();
+void sdCardDestroy(struct SdCard* sdCard);
 
-struct Buffer sdCardData();
-struct Buffer sdCardDirtyPages();
+bool sdCardRead(struct SdCard* sdCard, uint32_t sector, void* data);
+bool sdCardWrite(struct SdCard* sdCard, uint32_t sector, const void* data);
 
-bool sdCardIsDirty();
-void sdCardSetDirty(bool isDirty);
+size_t sdCardSectorCount(struct SdCard* sdCard);
+
+struct Buffer sdCardData(struct SdCard* sdCard);
+struct Buffer sdCardDirtyPages(struct SdCard* sdCard);
+
+bool sdCardIsDirty(struct SdCard* sdCard);
+void sdCardSetDirty(struct SdCard* sdCard, bool isDirty);
 
 #ifdef __cplusplus
 }
@@ -4,6 +4,8 @@
 #include "MMU.h"
 #include "RAM.h"
 #include "ROM.h"
+#include "Savestate.h"
+#include "SavestateLoader.h"
 #include "SoC.h"
 #include "cp15.h"
 #include "mem.h"
@@ -11,6 +13,8 @@
 #include "patch_dispatch.h"
 #include "patches.h"
 #include "ram_buffer.h"
+#include "savestate_chunk.h"
+#include "sdcard.h"
 #include "scheduler.h"
 #include "soc_AC97.h"
 #include "soc_DMA.h"
@@ -39,6 +43,7 @@
 #include "pxa255_UDC.h"
 
 // PXA27x
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -73,6 +78,50 @@
 #define PCM_HZ_ENABLED 44300
 #define PCM_HZ_DISABLED (44100 / 3)
 
+#define SAVESTATE_VERSION 1
+
+enum class ChunkType : uint32_t {
+    session = 1,
+    cpu,
+    ic,
+    dma,
+    gpio,
+    timr,
+    rtc,
+    ffUart,
+    hwUart,
+    stUart,
+    btUart,
+    pwrClk,
+    pwrI2c,
+    i2c,
+    memCtrl,
+    ac97,
+    ssp0,
+    ssp1,
+    ssp2,
+    i2s,
+    pwm0,
+    pwm1,
+    pwm2,
+    pwm3,
+    mmc,
+    lcd,
+    dsp,
+    udc1,
+    wmmx,
+    imc,
+    kpc,
+    udc2,
+    keypad,
+    vSD,
+    device,
+    nand,
+    patchDispatch,
+    ram,
+    sram
+};
+
 struct PenEvent {
     bool penDown;
     int x, y;
@@ -156,7 +205,16 @@ struct SoC {
 
     Device *dev;
 
+    Savestate<ChunkType> *savestate;
+
     uint32_t DispatchTicks(uint32_t clientType, uint32_t batchedTicks);
+
+    template <typename T>
+    void Save(T &savestate);
+    void Load(SavestateLoader<ChunkType> &loader);
+
+    template <typename T>
+    void DoSaveLoad(T &savestate);
 };
 
 extern "C" {
@@ -198,8 +256,32 @@ static void socPrvReschedule(void *ctx, uint32_t task) {
         case RESCHEDULE_TASK_DMA:
             soc->scheduler->RescheduleTask(SCHEDULER_TASK_AUX_1, 1);
             break;
+
+        case RESCHEDULE_TASK_TIMER:
+            soc->scheduler->RescheduleTask(SCHEDULER_TASK_TIMER,
+                                           pxaTimrTicksToNextInterrupt(soc->tmr));
+            break;
     }
+
+    // The CPU runs up to the deadline that was current when it started, so the new one may be
+    // missed otherwise
+    cpuEndCycle(soc->cpu);
+}
+
+static uint32_t socPrvTimerElapsedTicks(void *userData) {
+    struct SoC *soc = (struct SoC *)userData;
+
+    return soc->scheduler->TakeElapsedTicks(
+        SCHEDULER_TASK_TIMER, soc->scheduler->GetTime(cpuGetCycleProgress(soc->cpu)));
+}
 }
+
+static void socPrvSyscallClock(void *ctx, uint64_t *cycles, uint64_t *nsec) {
+    struct SoC *soc = (struct SoC *)ctx;
+    const uint32_t cycleProgress = cpuGetCycleProgress(soc->cpu);
+
+    *cycles = soc->scheduler->GetCycles(cycleProgress);
+    *nsec = soc->scheduler->GetTime(cycleProgress);
 }
 
 static void socSetupScheduler(Scheduler<SoC> *scheduler) {
@@ -228,9 +310,16 @@ static void socSetupScheduler(Scheduler<SoC> *scheduler) {
     scheduler->ScheduleTask(SCHEDULER_TASK_AUX_2, 1_sec / 30, 1);
 }
 
-SoC *socInit(void *romData, const uint32_t romSize, uint32_t sdNumSectors, SdSectorR sdR,
-             SdSectorW sdW, uint8_t *nandContent, size_t nandSize, int gdbPort,
-             uint_fast8_t socRev) {
+static bool socPrvSdRead(void *userData, uint32_t secNum, void *buf) {
+    return sdCardRead((struct SdCard *)userData, secNum, buf);
+}
+
+static bool socPrvSdWrite(void *userData, uint32_t secNum, const void *buf) {
+    return sdCardWrite((struct SdCard *)userData, secNum, buf);
+}
+
+SoC *socInit(void *romData, const uint32_t romSize, struct SdCard *sdCard, uint8_t *nandContent,
+             size_t nandSize, int gdbPort, uint_fast8_t socRev) {
     SoC *soc = (SoC *)malloc(sizeof(SoC));
     struct SocPeriphs sp = {};
 
@@ -243,6 +332,8 @@ SoC *socInit(void *romData, const uint32_t romSize, uint32_t sdNumSectors, SdSec
     soc->scheduler = new Scheduler<SoC>(*soc);
     socSetupScheduler(soc->scheduler);
 
+    soc->savestate = new Savestate<ChunkType>();
+
     soc->penEventQueue = new Queue<PenEvent>(EVENT_QUEUE_CAPACITY);
     soc->keyEventQueue = new Queue<KeyEvent>(EVENT_QUEUE_CAPACITY);
 
@@ -250,6 +341,7 @@ SoC *socInit(void *romData, const uint32_t romSize, uint32_t sdNumSectors, SdSec
     if (!soc->mem) ERR("Cannot init physical memory manager");
 
     soc->patchDispatch = initPatchDispatch();
+    patchDispatchSetClock(soc->patchDispatch, socPrvSyscallClock, soc);
 
     soc->cpu = cpuInit(ROM_BASE, soc->mem, true /* xscale */, false /* omap */, gdbPort,
                        socRev ? ((socRev == 1) ? CPUID_PXA260 : CPUID_PXA270) : CPUID_PXA255,
@@ -324,7 +416,7 @@ SoC *socInit(void *romData, const uint32_t romSize, uint32_t sdNumSectors, SdSec
     soc->gpio = socGpioInit(soc->mem, soc->ic, socRev);
     if (!soc->gpio) ERR("Cannot init PXA's GPIO");
 
-    soc->tmr = pxaTimrInit(soc->mem, soc->ic);
+    soc->tmr = pxaTimrInit(soc->mem, soc->ic, rescheduleSoc, socPrvTimerElapsedTicks, soc);
     if (!soc->tmr) ERR("Cannot init PXA's OSTIMER");
 
     soc->rtc = pxaRtcInit(soc->mem, soc->ic);
@@ -428,8 +520,8 @@ SoC *socInit(void *romData, const uint32_t romSize, uint32_t sdNumSectors, SdSec
     soc->kp = keypadInit(soc->gpio, true);
     if (!soc->kp) ERR("Cannot init keypad controller");
 
-    if (sdNumSectors) {
-        soc->vSD = vsdInit(sdR, sdW, sdNumSectors);
+    if (sdCard && sdCardSectorCount(sdCard)) {
+        soc->vSD = vsdInit(socPrvSdRead, socPrvSdWrite, sdCard, sdCardSectorCount(sdCard));
         if (!soc->vSD) ERR("Cannot init vSD");
 
         pxaMmcInsert(soc->mmc, soc->vSD);
@@ -538,8 +630,6 @@ void socSleep(SoC *soc) {
     if (soc->sleeping) return;
 
     soc->sleeping = true;
-    soc->scheduler->RescheduleTaskAtLeast(SCHEDULER_TASK_TIMER,
-                                          pxaTimrTicksToNextInterrupt(soc->tmr));
 
     cpuSetSleeping(soc->cpu);
 
@@ -551,7 +641,6 @@ void socWakeup(SoC *soc, uint8_t wakeupSource) {
     if (!soc->sleeping) return;
 
     soc->sleeping = false;
-    soc->scheduler->RescheduleTaskAtLeast(SCHEDULER_TASK_TIMER, 1);
 
     cpuWakeup(soc->cpu);
 
@@ -596,7 +685,7 @@ uint32_t SoC::DispatchTicks(uint32_t clientType, uint32_t batchedTicks) {
         case SCHEDULER_TASK_TIMER:
             pxaTimrTick(tmr, batchedTicks);
 
-            return sleeping ? pxaTimrTicksToNextInterrupt(tmr) : 1;
+            return pxaTimrTicksToNextInterrupt(tmr);
 
         case SCHEDULER_TASK_RTC:
             pxaRtcTick(rtc);
@@ -648,7 +737,9 @@ uint32_t *socGetPendingFrame(SoC *soc) { return pxaLcdGetPendingFrame(soc->lcd);
 
 void socResetPendingFrame(SoC *soc) { return pxaLcdResetPendingFrame(soc->lcd); }
 
-void socSetFramebufferDirty(struct SoC *soc) { pxaLcdSetFramebufferDirty(soc->lcd); }
+void socSetFramebufferDirty(struct SoC *soc, uint32_t pa, uint32_t size) {
+    pxaLcdSetFramebufferDirty(soc->lcd, pa, size);
+}
 
 bool socSetFramebuffer(struct SoC *soc, uint32_t start, uint32_t size) {
     if (start < RAM_BASE || start - RAM_BASE + size > deviceGetRamSize()) {
@@ -657,6 +748,7 @@ bool socSetFramebuffer(struct SoC *soc, uint32_t start, uint32_t size) {
     }
 
     ramSetFramebuffer(soc->ram, start, size);
+    cpuInvalidateHostPages(soc->cpu);
 
     return size != 0;
 }
@@ -700,4 +792,231 @@ struct Buffer socGetRamData(struct SoC *soc) {
 
 struct Buffer socGetRamDirtyPages(struct SoC *soc) {
     return {.size = soc->ramBuffer.dirtyPagesSize, .data = soc->ramBuffer.dirtyPages};
-}
\ No newline at end of file
+}
+
+template <typename T, typename F>
+static void socPrvDoChunk(T &savestate, ChunkType type, F serialize) {
+    typename T::chunkT *chunk = savestate.GetChunk(type);
+    if (!chunk) return;
+
+    chunk->Put32(SAVESTATE_VERSION);
+
+    SavestateChunk savestateChunk(chunk, false);
+    serialize(savestateChunk);
+
+    if (savestateChunk.HasError()) savestate.NotifyError();
+}
+
+template <typename F>
+static void socPrvDoChunk(SavestateLoader<ChunkType> &loader, ChunkType type, F serialize) {
+    Chunk *chunk = loader.GetChunk(type);
+    if (!chunk) {
+        fprintf(stderr, "unable to restore savestate: chunk 0x%04x missing\n", (uint32_t)type);
+        loader.NotifyError();
+
+        return;
+    }
+
+    if (chunk->Get32() != SAVESTATE_VERSION) {
+        fprintf(stderr, "unable to restore savestate: chunk 0x%04x has unsupported version\n",
+                (uint32_t)type);
+        loader.NotifyError();
+
+        return;
+    }
+
+    SavestateChunk savestateChunk(chunk, true);
+    serialize(savestateChunk);
+
+    if (savestateChunk.HasError()) loader.NotifyError();
+}
+
+template <typename T, typename U>
+static void socPrvDoChunk(T &savestate, ChunkType type, void (*serialize)(U *, SavestateChunk *),
+                          U *component) {
+    socPrvDoChunk(savestate, type,
+                  [&](SavestateChunk &chunk) { serialize(component, &chunk); });
+}
+
+// Memory is stored as a list of the pages that are marked dirty. On load, those pages are
+// overwritten and marked dirty again; all other pages are left untouched.
+static void socPrvSerializeDirtyPages(SavestateChunk &chunk, uint8_t *data, size_t size,
+                                      uint32_t *dirtyPages, size_t pageSize) {
+    const size_t pageCount = (size + pageSize - 1) / pageSize;
+    const bool loading = savestateChunkIsLoading(&chunk);
+    uint32_t dirtyPageCount = 0;
+
+    if (!loading) {
+        for (size_t page = 0; page < pageCount; page++)
+            if (dirtyPages[page >> 5] & (1u << (page & 0x1f))) dirtyPageCount++;
+    }
+
+    chunk.Do32(dirtyPageCount);
+
+    uint32_t page = 0;
+    for (uint32_t i = 0; i < dirtyPageCount; i++, page++) {
+        if (!loading) {
+            while (!(dirtyPages[page >> 5] & (1u << (page & 0x1f)))) page++;
+        }
+
+        chunk.Do32(page);
+
+        if (page >= pageCount) {
+            savestateChunkNotifyError(&chunk);
+            return;
+        }
+
+        const size_t offset = page * pageSize;
+        savestateChunkDoBuffer(&chunk, data + offset, std::min(pageSize, size - offset));
+
+        dirtyPages[page >> 5] |= (1u << (page & 0x1f));
+    }
+}
+
+template <typename T>
+void SoC::Save(T &savestate) {
+    DoSaveLoad(savestate);
+}
+
+template void SoC::Save(Savestate<ChunkType> &savestate);
+template void SoC::Save(SavestateProbe<ChunkType> &savestate);
+
+void SoC::Load(SavestateLoader<ChunkType> &loader) {
+    DoSaveLoad(loader);
+
+    penEventQueue->Clear();
+    keyEventQueue->Clear();
+    if (audioQueue) audioQueueClear(audioQueue);
+
+    // The LCD will set up the framebuffer again on its next scanout
+    ramSetFramebuffer(ram, 0, 0);
+    cpuInvalidateHostPages(cpu);
+}
+
+template <typename T>
+void SoC::DoSaveLoad(T &savestate) {
+    socPrvDoChunk(savestate, ChunkType::session, [&](SavestateChunk &chunk) {
+        chunk.DoBool(mouseDown).DoBool(enablePcmOutput).DoBool(pcmSuspended).DoBool(sleeping);
+        scheduler->DoSaveLoad(chunk);
+    });
+
+    socPrvDoChunk(savestate, ChunkType::cpu, cpuSerialize, cpu);
+    socPrvDoChunk(savestate, ChunkType::patchDispatch, patchDispatchSerialize, patchDispatch);
+
+    socPrvDoChunk(savestate, ChunkType::ic, socIcSerialize, ic);
+    socPrvDoChunk(savestate, ChunkType::dma, socDmaSerialize, dma);
+    socPrvDoChunk(savestate, ChunkType::gpio, socGpioSerialize, gpio);
+    socPrvDoChunk(savestate, ChunkType::timr, pxaTimrSerialize, tmr);
+    socPrvDoChunk(savestate, ChunkType::rtc, pxaRtcSerialize, rtc);
+    socPrvDoChunk(savestate, ChunkType::ffUart, socUartSerialize, ffUart);
+    if (hwUart) socPrvDoChunk(savestate, ChunkType::hwUart, socUartSerialize, hwUart);
+    socPrvDoChunk(savestate, ChunkType::stUart, socUartSerialize, stUart);
+    socPrvDoChunk(savestate, ChunkType::btUart, socUartSerialize, btUart);
+    socPrvDoChunk(savestate, ChunkType::pwrClk, pxaPwrClkSerialize, pwrClk);
+    if (pwrI2c) socPrvDoChunk(savestate, ChunkType::pwrI2c, socI2cSerialize, pwrI2c);
+    socPrvDoChunk(savestate, ChunkType::i2c, socI2cSerialize, i2c);
+    socPrvDoChunk(savestate, ChunkType::memCtrl, pxaMemCtrlrSerialize, memCtrl);
+    socPrvDoChunk(savestate, ChunkType::ac97, socAC97Serialize, ac97);
+    socPrvDoChunk(savestate, ChunkType::ssp0, socSspSerialize, ssp[0]);
+    if (ssp[1]) socPrvDoChunk(savestate, ChunkType::ssp1, socSspSerialize, ssp[1]);
+    if (ssp[2]) socPrvDoChunk(savestate, ChunkType::ssp2, socSspSerialize, ssp[2]);
+    socPrvDoChunk(savestate, ChunkType::i2s, socI2sSerialize, i2s);
+    socPrvDoChunk(savestate, ChunkType::pwm0, pxaPwmSerialize, pwm[0]);
+    socPrvDoChunk(savestate, ChunkType::pwm1, pxaPwmSerialize, pwm[1]);
+    if (pwm[2]) socPrvDoChunk(savestate, ChunkType::pwm2, pxaPwmSerialize, pwm[2]);
+    if (pwm[3]) socPrvDoChunk(savestate, ChunkType::pwm3, pxaPwmSerialize, pwm[3]);
+    socPrvDoChunk(savestate, ChunkType::mmc, pxaMmcSerialize, mmc);
+    socPrvDoChunk(savestate, ChunkType::lcd, pxaLcdSerialize, lcd);
+
+    if (sram) {
+        socPrvDoChunk(savestate, ChunkType::wmmx, pxa270wmmxSerialize, wmmx);
+        socPrvDoChunk(savestate, ChunkType::imc, pxaImcSerialize, imc);
+        socPrvDoChunk(savestate, ChunkType::kpc, pxaKpcSerialize, kpc);
+        socPrvDoChunk(savestate, ChunkType::udc2, pxa270UdcSerialize, udc2);
+    } else {
+        socPrvDoChunk(savestate, ChunkType::dsp, pxa255dspSerialize, dsp);
+        socPrvDoChunk(savestate, ChunkType::udc1, pxa255UdcSerialize, udc1);
+    }
+
+    socPrvDoChunk(savestate, ChunkType::keypad, keypadSerialize, kp);
+    if (vSD) socPrvDoChunk(savestate, ChunkType::vSD, vsdSerialize, vSD);
+    socPrvDoChunk(savestate, ChunkType::device, deviceSerialize, dev);
+
+    if (nand) {
+        socPrvDoChunk(savestate, ChunkType::nand, [&](SavestateChunk &chunk) {
+            struct Buffer data = nandGetData(nand);
+            struct Buffer dirtyPages = nandGetDirtyPages(nand);
+
+            nandSerialize(nand, &chunk);
+            socPrvSerializeDirtyPages(chunk, (uint8_t *)data.data, data.size,
+                                      (uint32_t *)dirtyPages.data, NAND_STORAGE_PAGE_SIZE);
+
+            if (savestateChunkIsLoading(&chunk)) nandSetDirty(nand, true);
+        });
+    }
+
+    socPrvDoChunk(savestate, ChunkType::ram, [&](SavestateChunk &chunk) {
+        socPrvSerializeDirtyPages(chunk, (uint8_t *)ramBuffer.buffer, ramBuffer.size,
+                                  ramBuffer.dirtyPages, 512);
+    });
+
+    if (sram) {
+        socPrvDoChunk(savestate, ChunkType::sram, [&](SavestateChunk &chunk) {
+            savestateChunkDoBuffer(&chunk, sramBuffer.buffer, sramBuffer.size);
+        });
+    }
+}
+
+bool socSave(struct SoC *soc) {
+    // The size of the savestate depends on the number of dirty pages, so we need to probe
+    // the layout on each save.
+    soc->savestate->Reset();
+
+    return soc->savestate->Save(*soc);
+}
+
+struct Buffer socGetSavestate(struct SoC *soc) {
+    return {.size = soc->savestate->GetSize(), .data = soc->savestate->GetBuffer()};
+}
+
+bool socLoad(struct SoC *soc, size_t size, void *buffer) {
+    SavestateLoader<ChunkType> loader;
+
+    return loader.Load(buffer, size, *soc);
+}
+
+uint64_t socGetArmInstructions(struct SoC *soc) { return cpuGetArmInstructions(soc->cpu); }
+
+uint64_t socGetPaceInstructions(struct SoC *soc) { return cpuGetPaceInstructions(soc->cpu); }
+
+uint64_t socGetDispatchCount(struct SoC *soc, uint32_t taskType) {
+    return soc->scheduler->GetDispatchCount(taskType);
+}
+
+uint64_t socGetDispatchedTicks(struct SoC *soc, uint32_t taskType) {
+    return soc->scheduler->GetDispatchedTicks(taskType);
+}
+
+void socPrintMemoryStatistics(struct SoC *soc, FILE *stream) {
+    memPrintStatistics(soc->mem, stream);
+}
+
+void socResetMemoryStatistics(struct SoC *soc) { memResetStatistics(soc->mem); }
+
+void socPrintSyscallStatistics(struct SoC *soc, FILE *stream, size_t maxEntries) {
+    patchDispatchPrintStatistics(soc->patchDispatch, stream, maxEntries);
+}
+
+void socResetSyscallStatistics(struct SoC *soc) {
+    patchDispatchResetStatistics(soc->patchDispatch);
+}
+
+void socSetSyscallTracing(struct SoC *soc, bool tracing) {
+    patchDispatchSetTracing(soc->patchDispatch, tracing);
+}
+
+bool socGetSyscallTracing(struct SoC *soc) { return patchDispatchGetTracing(soc->patchDispatch); }
+
+struct SyscallTrace *socGetSyscallTrace(struct SoC *soc) {
+    return patchDispatchGetTrace(soc->patchDispatch);
+}
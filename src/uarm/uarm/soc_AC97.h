@@ -17,6 +17,7 @@ extern "C" {
 #endif
 
 struct SocAC97;
+struct SavestateChunk;
 
 enum Ac97Codec {
     Ac97PrimaryAudio,
@@ -32,6 +33,9 @@ typedef bool (*Ac97CodecFifoR)(void *userData, uint32_t *regValP);
 typedef bool (*Ac97CodecFifoW)(void *userData, uint32_t val);
 
 struct SocAC97 *socAC97Init(struct ArmMem *physMem, struct SocIc *ic, struct SocDma *dma);
+
+void socAC97Serialize(struct SocAC97 *ac97, struct SavestateChunk *chunk);
+
 void socAC97Periodic(struct SocAC97 *ac97);
 
 // client api
@@ -13,14 +13,27 @@ extern "C" {
 #endif
 
 struct SocDma;
+struct SavestateChunk;
+
+// Moves up to count items of the given size (1, 2 or 4 bytes) between a peripheral FIFO and items,
+// write is from the point of view of the FIFO. Returns the number of items moved, everything that
+// is not moved is retried item by item through memAccess.
+typedef uint32_t (*SocDmaFifoF)(void* userData, bool write, uint_fast8_t size, uint32_t* items,
+                                uint32_t count);
 
 struct SocDma* socDmaInit(struct ArmMem* physMem, struct Reschedule reschedule, struct SocIc* ic);
+
+void socDmaSerialize(struct SocDma* dma, struct SavestateChunk* chunk);
+
 void socDmaPeriodic(struct SocDma* dma);
 void socDmaExternalReq(struct SocDma* dma, uint_fast8_t chNum,
                        bool requested);  // request a transfer burst
 
 bool socDmaTaskRequired(struct SocDma* dma);
 
+// Register the data register of a peripheral FIFO for block transfers
+void socDmaAddFifo(struct SocDma* dma, uint32_t pa, SocDmaFifoF fifoF, void* userData);
+
 #ifdef __cplusplus
 }
 #endif
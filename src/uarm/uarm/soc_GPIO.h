@@ -12,6 +12,7 @@ extern "C" {
 #endif
 
 struct SocGpio;
+struct SavestateChunk;
 
 typedef void (*GpioChangedNotifF)(void* userData, uint32_t gpio, bool oldState, bool newState);
 typedef void (*GpioDirsChangedF)(void* userData);
@@ -31,6 +32,8 @@ enum SocGpioState {  // these values make it look like all HiZ, AFR, and nonexis
 
 struct SocGpio* socGpioInit(struct ArmMem* physMem, struct SocIc* ic, uint_fast8_t socRev);
 
+void socGpioSerialize(struct SocGpio* gpio, struct SavestateChunk* chunk);
+
 // for external use :)
 enum SocGpioState socGpioGetState(struct SocGpio* gpio, uint_fast8_t gpioNum);
 void socGpioSetState(struct SocGpio* gpio, uint_fast8_t gpioNum,
@@ -13,6 +13,7 @@ extern "C" {
 #endif
 
 struct SocI2c;
+struct SavestateChunk;
 
 enum ActionI2C {  // designed so returns can be ORRed together with good results
     i2cStart,     // no params, no returns
@@ -26,6 +27,9 @@ typedef uint_fast8_t (*I2cDeviceActionF)(void *userData, enum ActionI2C stimulus
 
 struct SocI2c *socI2cInit(struct ArmMem *physMem, struct SocIc *ic, struct SocDma *dma,
                           uint32_t base, uint32_t irqNo);
+
+void socI2cSerialize(struct SocI2c *i2c, struct SavestateChunk *chunk);
+
 bool socI2cDeviceAdd(struct SocI2c *i2c, I2cDeviceActionF actF, void *userData);
 
 #ifdef __cplusplus
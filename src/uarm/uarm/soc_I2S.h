@@ -17,8 +17,12 @@ extern "C" {
 #endif
 
 struct SocI2s;
+struct SavestateChunk;
 
 struct SocI2s *socI2sInit(struct ArmMem *physMem, struct SocIc *ic, struct SocDma *dma);
+
+void socI2sSerialize(struct SocI2s *i2s, struct SavestateChunk *chunk);
+
 void socI2sPeriodic(struct SocI2s *i2s);
 
 #ifdef __cplusplus
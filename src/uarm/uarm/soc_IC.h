@@ -16,10 +16,13 @@ extern "C" {
 #endif
 
 struct SocIc;
+struct SavestateChunk;
 
 struct SocIc *socIcInit(struct ArmCpu *cpu, struct ArmMem *physMem, struct SoC *soc,
                         uint_fast8_t socRev);
 
+void socIcSerialize(struct SocIc *ic, struct SavestateChunk *chunk);
+
 void socIcInt(struct SocIc *ic, uint_fast8_t intNum, bool raise);
 
 #ifdef __cplusplus
@@ -18,6 +18,7 @@ extern "C" {
 #endif
 
 struct SocSsp;
+struct SavestateChunk;
 
 typedef uint_fast16_t (*SspClientProcF)(
     void* userData, uint_fast8_t nBits,
@@ -26,6 +27,9 @@ typedef uint_fast16_t (*SspClientProcF)(
 struct SocSsp* socSspInit(struct ArmMem* physMem, struct Reschedule reschedule, struct SocIc* ic,
                           struct SocDma* dma, uint32_t base, uint_fast8_t irqNo,
                           uint_fast8_t dmaReqNoBase);
+
+void socSspSerialize(struct SocSsp* ssp, struct SavestateChunk* chunk);
+
 void socSspPeriodic(struct SocSsp* ssp);
 bool socSspAddClient(struct SocSsp* ssp, SspClientProcF procF, void* userData);
 
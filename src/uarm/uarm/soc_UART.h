@@ -13,6 +13,7 @@ extern "C" {
 #endif
 
 struct SocUart;
+struct SavestateChunk;
 
 #define UART_CHAR_BREAK 0x800
 #define UART_CHAR_FRAME_ERR 0x400
@@ -24,6 +25,9 @@ typedef void (*SocUartWriteF)(uint_fast16_t chr, void *userData);
 
 struct SocUart *socUartInit(struct ArmMem *physMem, struct Reschedule reschedule, struct SocIc *ic,
                             uint32_t baseAddr, uint8_t irq);
+
+void socUartSerialize(struct SocUart *uart, struct SavestateChunk *chunk);
+
 void socUartProcess(struct SocUart *uart);  // write out data in TX fifo and read data into RX fifo
 
 void socUartSetFuncs(struct SocUart *uart, SocUartReadF readF, SocUartWriteF writeF,
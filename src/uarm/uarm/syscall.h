@@ -9,6 +9,10 @@ extern "C" {
 
 #define SYSCALL_UI_INITIALIZE 0xc55c
 #define SYSCALL_SYS_SET_AUTO_OFF_TIME 0x88c8
+#define SYSCALL_MEM_MOVE 0x8558
+#define SYSCALL_MEM_SET 0x85b0
+#define SYSCALL_STR_COPY 0x8788
+#define SYSCALL_STR_LEN 0x8798
 
 #define packSyscall(table, offset) ((table << 12) | offset)
 
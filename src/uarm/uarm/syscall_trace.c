@@ -0,0 +1,227 @@
+#include "syscall_trace.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cputil.h"
+#include "syscall.h"
+
+// Syscalls are dispatched through three tables with 0x400 entries each
+#define STATISTICS_TABLE_SIZE 0xc00
+
+struct SyscallTrace {
+    struct SyscallTraceEvent* events;
+    size_t capacity;
+    size_t writeIndex;
+    size_t eventCount;
+
+    struct SyscallTraceStatistics* statistics[STATISTICS_TABLE_SIZE];
+};
+
+static bool syscallTracePrvKey(uint32_t syscall, uint32_t* key) {
+    const uint32_t table = syscall >> 14;
+    if (table < 1 || table > 3 || syscall & 0x03) return false;
+
+    *key = ((table - 1) << 10) | ((syscall & 0xfff) >> 2);
+    return true;
+}
+
+static size_t syscallTracePrvBucket(uint64_t cycles) {
+    const size_t bucket = cycles ? 64 - __builtin_clzll(cycles) : 0;
+
+    return bucket < SYSCALL_TRACE_HISTOGRAM_BUCKETS ? bucket : SYSCALL_TRACE_HISTOGRAM_BUCKETS - 1;
+}
+
+static const char* syscallTracePrvName(uint32_t syscall) {
+    const char* name = getSyscallName(syscall);
+
+    return name ? name : "[unknown]";
+}
+
+struct SyscallTrace* syscallTraceInit(size_t capacity) {
+    struct SyscallTrace* trace = malloc(sizeof(*trace));
+    if (!trace) ERR("unable to allocate syscall trace\n");
+
+    memset(trace, 0, sizeof(*trace));
+
+    trace->capacity = capacity > 0 ? capacity : 1;
+    trace->events = malloc(trace->capacity * sizeof(*trace->events));
+    if (!trace->events) ERR("unable to allocate syscall trace\n");
+
+    return trace;
+}
+
+void syscallTraceDestroy(struct SyscallTrace* trace) {
+    syscallTraceReset(trace);
+
+    free(trace->events);
+    free(trace);
+}
+
+void syscallTraceRecord(struct SyscallTrace* trace, const struct SyscallTraceEvent* event) {
+    trace->events[trace->writeIndex] = *event;
+    trace->writeIndex = (trace->writeIndex + 1) % trace->capacity;
+    if (trace->eventCount < trace->capacity) trace->eventCount++;
+
+    uint32_t key;
+    if (!syscallTracePrvKey(event->syscall, &key)) return;
+
+    struct SyscallTraceStatistics* statistics = trace->statistics[key];
+    if (!statistics) {
+        statistics = trace->statistics[key] = malloc(sizeof(*statistics));
+        if (!statistics) ERR("unable to allocate syscall trace\n");
+
+        memset(statistics, 0, sizeof(*statistics));
+        statistics->syscall = event->syscall;
+    }
+
+    statistics->calls++;
+    statistics->cycles += event->cycles;
+    statistics->histogram[syscallTracePrvBucket(event->cycles)]++;
+
+    if (event->cycles > statistics->maxCycles) statistics->maxCycles = event->cycles;
+    if (event->depth > statistics->maxDepth) statistics->maxDepth = event->depth;
+}
+
+void syscallTraceReset(struct SyscallTrace* trace) {
+    trace->writeIndex = 0;
+    trace->eventCount = 0;
+
+    for (size_t i = 0; i < STATISTICS_TABLE_SIZE; i++) {
+        free(trace->statistics[i]);
+        trace->statistics[i] = NULL;
+    }
+}
+
+size_t syscallTraceEventCount(struct SyscallTrace* trace) { return trace->eventCount; }
+
+const struct SyscallTraceEvent* syscallTraceGetEvent(struct SyscallTrace* trace, size_t index) {
+    if (index >= trace->eventCount) return NULL;
+
+    return &trace->events[(trace->writeIndex + trace->capacity - trace->eventCount + index) %
+                          trace->capacity];
+}
+
+const struct SyscallTraceStatistics* syscallTraceGetStatistics(struct SyscallTrace* trace,
+                                                               uint32_t syscall) {
+    uint32_t key;
+
+    return syscallTracePrvKey(syscall, &key) ? trace->statistics[key] : NULL;
+}
+
+static int syscallTracePrvCompareCalls(const void* a, const void* b) {
+    const struct SyscallTraceStatistics* sa = *(const struct SyscallTraceStatistics* const*)a;
+    const struct SyscallTraceStatistics* sb = *(const struct SyscallTraceStatistics* const*)b;
+
+    if (sa->calls == sb->calls) return sa->syscall < sb->syscall ? -1 : 1;
+
+    return sa->calls > sb->calls ? -1 : 1;
+}
+
+static int syscallTracePrvCompareCycles(const void* a, const void* b) {
+    const struct SyscallTraceStatistics* sa = *(const struct SyscallTraceStatistics* const*)a;
+    const struct SyscallTraceStatistics* sb = *(const struct SyscallTraceStatistics* const*)b;
+
+    if (sa->cycles == sb->cycles) return syscallTracePrvCompareCalls(a, b);
+
+    return sa->cycles > sb->cycles ? -1 : 1;
+}
+
+static int syscallTracePrvCompareMaxCycles(const void* a, const void* b) {
+    const struct SyscallTraceStatistics* sa = *(const struct SyscallTraceStatistics* const*)a;
+    const struct SyscallTraceStatistics* sb = *(const struct SyscallTraceStatistics* const*)b;
+
+    if (sa->maxCycles == sb->maxCycles) return syscallTracePrvCompareCalls(a, b);
+
+    return sa->maxCycles > sb->maxCycles ? -1 : 1;
+}
+
+void syscallTracePrintTable(struct SyscallTrace* trace, FILE* stream, enum SyscallTraceSortKey key,
+                            size_t maxEntries) {
+    const struct SyscallTraceStatistics** sorted = malloc(STATISTICS_TABLE_SIZE * sizeof(*sorted));
+    if (!sorted) ERR("unable to allocate syscall trace\n");
+
+    size_t count = 0;
+    uint64_t totalCycles = 0;
+
+    for (size_t i = 0; i < STATISTICS_TABLE_SIZE; i++) {
+        if (!trace->statistics[i]) continue;
+
+        sorted[count++] = trace->statistics[i];
+        totalCycles += trace->statistics[i]->cycles;
+    }
+
+    switch (key) {
+        case SYSCALL_TRACE_SORT_CALLS:
+            qsort(sorted, count, sizeof(*sorted), syscallTracePrvCompareCalls);
+            break;
+
+        case SYSCALL_TRACE_SORT_CYCLES:
+            qsort(sorted, count, sizeof(*sorted), syscallTracePrvCompareCycles);
+            break;
+
+        case SYSCALL_TRACE_SORT_MAX_CYCLES:
+            qsort(sorted, count, sizeof(*sorted), syscallTracePrvCompareMaxCycles);
+            break;
+    }
+
+    fprintf(stream, "%-32s %10s %14s %8s %12s %12s %5s\n", "syscall", "calls", "cycles", "%",
+            "cycles/call", "max cycles", "depth");
+
+    for (size_t i = 0; i < count && i < maxEntries; i++)
+        fprintf(stream, "%-32s %10llu %14llu %8.2f %12llu %12llu %5lu\n",
+                syscallTracePrvName(sorted[i]->syscall), (unsigned long long)sorted[i]->calls,
+                (unsigned long long)sorted[i]->cycles,
+                totalCycles > 0 ? 100. * sorted[i]->cycles / totalCycles : 0.,
+                (unsigned long long)(sorted[i]->cycles / sorted[i]->calls),
+                (unsigned long long)sorted[i]->maxCycles, (unsigned long)sorted[i]->maxDepth);
+
+    free(sorted);
+}
+
+void syscallTraceWriteJson(struct SyscallTrace* trace, FILE* stream) {
+    bool first = true;
+
+    fprintf(stream, "[");
+
+    for (size_t i = 0; i < STATISTICS_TABLE_SIZE; i++) {
+        const struct SyscallTraceStatistics* statistics = trace->statistics[i];
+        if (!statistics) continue;
+
+        fprintf(stream,
+                "%s\n{\"syscall\":%lu,\"name\":\"%s\",\"calls\":%llu,\"cycles\":%llu,"
+                "\"maxCycles\":%llu,\"maxDepth\":%lu,\"histogram\":[",
+                first ? "" : ",", (unsigned long)statistics->syscall,
+                syscallTracePrvName(statistics->syscall), (unsigned long long)statistics->calls,
+                (unsigned long long)statistics->cycles, (unsigned long long)statistics->maxCycles,
+                (unsigned long)statistics->maxDepth);
+
+        for (size_t bucket = 0; bucket < SYSCALL_TRACE_HISTOGRAM_BUCKETS; bucket++)
+            fprintf(stream, "%s%llu", bucket ? "," : "",
+                    (unsigned long long)statistics->histogram[bucket]);
+
+        fprintf(stream, "]}");
+        first = false;
+    }
+
+    fprintf(stream, "\n]\n");
+}
+
+void syscallTraceWriteChromeTrace(struct SyscallTrace* trace, FILE* stream) {
+    fprintf(stream, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    // Calls on different stacks are shown as different threads
+    for (size_t i = 0; i < trace->eventCount; i++) {
+        const struct SyscallTraceEvent* event = syscallTraceGetEvent(trace, i);
+
+        fprintf(stream,
+                "%s\n{\"name\":\"%s\",\"cat\":\"syscall\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                "\"pid\":1,\"tid\":%lu,\"args\":{\"cycles\":%llu,\"depth\":%u}}",
+                i ? "," : "", syscallTracePrvName(event->syscall), event->startNsec / 1000.,
+                event->durationNsec / 1000., (unsigned long)event->stack,
+                (unsigned long long)event->cycles, (unsigned)event->depth);
+    }
+
+    fprintf(stream, "\n]}\n");
+}
@@ -0,0 +1,74 @@
+#ifndef _SYSCALL_TRACE_H_
+#define _SYSCALL_TRACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Per syscall statistics and a ring of the most recent completed calls. The patch dispatcher
+// records a call once it returns to its caller; the cost is measured in emulated cycles, the
+// timestamps in emulated nanoseconds.
+
+#define SYSCALL_TRACE_HISTOGRAM_BUCKETS 24
+
+enum SyscallTraceSortKey {
+    SYSCALL_TRACE_SORT_CALLS,
+    SYSCALL_TRACE_SORT_CYCLES,
+    SYSCALL_TRACE_SORT_MAX_CYCLES
+};
+
+struct SyscallTraceEvent {
+    uint32_t syscall;
+    uint32_t stack;
+    uint8_t depth;
+    uint64_t startNsec;
+    uint64_t durationNsec;
+    uint64_t cycles;
+};
+
+struct SyscallTraceStatistics {
+    uint32_t syscall;
+    uint64_t calls;
+    uint64_t cycles;
+    uint64_t maxCycles;
+    uint32_t maxDepth;
+    // Bucket n counts calls that took [2^(n-1), 2^n) cycles, the last bucket everything above
+    uint64_t histogram[SYSCALL_TRACE_HISTOGRAM_BUCKETS];
+};
+
+struct SyscallTrace;
+
+struct SyscallTrace* syscallTraceInit(size_t capacity);
+
+void syscallTraceDestroy(struct SyscallTrace* trace);
+
+void syscallTraceRecord(struct SyscallTrace* trace, const struct SyscallTraceEvent* event);
+
+void syscallTraceReset(struct SyscallTrace* trace);
+
+// Events are numbered from the oldest one that is still in the ring
+size_t syscallTraceEventCount(struct SyscallTrace* trace);
+const struct SyscallTraceEvent* syscallTraceGetEvent(struct SyscallTrace* trace, size_t index);
+
+// Returns NULL for syscalls that have not been recorded
+const struct SyscallTraceStatistics* syscallTraceGetStatistics(struct SyscallTrace* trace,
+                                                               uint32_t syscall);
+
+void syscallTracePrintTable(struct SyscallTrace* trace, FILE* stream, enum SyscallTraceSortKey key,
+                            size_t maxEntries);
+
+// Statistics as a JSON array of rows, one per syscall
+void syscallTraceWriteJson(struct SyscallTrace* trace, FILE* stream);
+
+// The event ring in the Chrome trace event format (chrome://tracing, Perfetto)
+void syscallTraceWriteChromeTrace(struct SyscallTrace* trace, FILE* stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _SYSCALL_TRACE_H_
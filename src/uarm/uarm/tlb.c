@@ -0,0 +1,74 @@
+#include "tlb.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cputil.h"
+
+#define SECTION_PAGES (1 << TLB_SECTION_PAGE_BITS)
+
+void tlbInit(struct Tlb* tlb) {
+    memset(tlb, 0, sizeof(*tlb));
+
+    tlbFlush(tlb);
+}
+
+void tlbDeinit(struct Tlb* tlb) {
+    for (size_t i = 0; i < TLB_SECTIONS; i++) free(tlb->sections[i]);
+
+    memset(tlb, 0, sizeof(*tlb));
+}
+
+void tlbFlush(struct Tlb* tlb) {
+    tlb->revision++;
+
+    if (tlb->revision != 0) return;
+
+    // The revision wrapped: all entries have to be cleared explicitly. This only has to touch
+    // the sections that are actually in use.
+    tlb->revision = 1;
+
+    for (size_t i = 0; i < (1 << TLB_FRONT_BITS); i++) tlb->front[i].entry.revision = 0;
+
+    for (size_t i = 0; i < TLB_SECTIONS; i++) {
+        if (!tlb->sections[i]) continue;
+
+        for (size_t j = 0; j < SECTION_PAGES; j++) tlb->sections[i][j].revision = 0;
+    }
+}
+
+void tlbInsert(struct Tlb* tlb, uint32_t va, uint32_t pa, uint_fast8_t ap, uint_fast8_t domain,
+               bool c, bool section) {
+    struct TlbEntry** sectionTable = tlb->sections + (va >> (12 + TLB_SECTION_PAGE_BITS));
+
+    if (!*sectionTable) {
+        *sectionTable = (struct TlbEntry*)calloc(SECTION_PAGES, sizeof(struct TlbEntry));
+        if (!*sectionTable) ERR("cannot alloc TLB section");
+
+        tlb->sectionsAllocated++;
+    }
+
+    struct TlbEntry* entry = *sectionTable + ((va >> 12) & (SECTION_PAGES - 1));
+
+    entry->pa = pa;
+    entry->ap = ap;
+    entry->domain = domain;
+    entry->c = c;
+    entry->section = section;
+    entry->revision = tlb->revision;
+}
+
+const struct TlbEntry* tlbLookupSlow(struct Tlb* tlb, uint32_t va) {
+    const struct TlbEntry* sectionTable = tlb->sections[va >> (12 + TLB_SECTION_PAGE_BITS)];
+    if (!sectionTable) return NULL;
+
+    const struct TlbEntry* entry = sectionTable + ((va >> 12) & (SECTION_PAGES - 1));
+    if (entry->revision != tlb->revision) return NULL;
+
+    struct TlbFrontEntry* frontEntry = tlb->front + ((va >> 12) & ((1 << TLB_FRONT_BITS) - 1));
+
+    frontEntry->page = va >> 12;
+    frontEntry->entry = *entry;
+
+    return &frontEntry->entry;
+}
@@ -0,0 +1,72 @@
+#ifndef _TLB_H_
+#define _TLB_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Two level TLB with 4k granularity. The front level is a small direct mapped cache, the
+// second level holds one table of 256 entries per 1MB section that is allocated on first use.
+// Both levels are invalidated in O(1) by bumping the revision.
+
+#define TLB_FRONT_BITS 12
+#define TLB_SECTION_PAGE_BITS 8
+#define TLB_SECTIONS (1 << (32 - 12 - TLB_SECTION_PAGE_BITS))
+
+// Operations in recorded TLB traces (see RECORD_TLB_TRACE in MMU.c)
+#define TLB_TRACE_OP_READ 0
+#define TLB_TRACE_OP_WRITE 1
+#define TLB_TRACE_OP_FLUSH 2
+#define TLB_TRACE_OP_FILL 3  // mapping size is or'ed into the op
+
+struct TlbEntry {
+    uint32_t pa;
+
+    uint32_t revision : 16;
+    uint32_t ap : 2;
+    uint32_t domain : 4;
+    uint32_t c : 1;
+    uint32_t section : 1;
+};
+
+struct TlbFrontEntry {
+    uint32_t page;
+    struct TlbEntry entry;
+};
+
+struct Tlb {
+    uint16_t revision;
+
+    struct TlbFrontEntry front[1 << TLB_FRONT_BITS];
+    struct TlbEntry* sections[TLB_SECTIONS];
+
+    uint32_t sectionsAllocated;
+};
+
+void tlbInit(struct Tlb* tlb);
+void tlbDeinit(struct Tlb* tlb);
+
+void tlbFlush(struct Tlb* tlb);
+
+void tlbInsert(struct Tlb* tlb, uint32_t va, uint32_t pa, uint_fast8_t ap, uint_fast8_t domain,
+               bool c, bool section);
+
+const struct TlbEntry* tlbLookupSlow(struct Tlb* tlb, uint32_t va);
+
+static inline const struct TlbEntry* tlbLookup(struct Tlb* tlb, uint32_t va) {
+    struct TlbFrontEntry* frontEntry = tlb->front + ((va >> 12) & ((1 << TLB_FRONT_BITS) - 1));
+
+    if (frontEntry->entry.revision == tlb->revision && frontEntry->page == va >> 12)
+        return &frontEntry->entry;
+
+    return tlbLookupSlow(tlb, va);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // _TLB_H_
@@ -1,7 +1,7 @@
 #include "UAE.h"
 
-regstruct regs;
-struct flag_struct regflags;
+UAE_THREAD_LOCAL regstruct regs;
+UAE_THREAD_LOCAL struct flag_struct regflags;
 
 int areg_byteinc[] = {1, 1, 1, 1, 1, 1, 1, 2};
 int imm8_table[] = {8, 1, 2, 3, 4, 5, 6, 7};
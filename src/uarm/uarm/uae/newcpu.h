@@ -64,7 +64,7 @@ typedef struct regstruct {
   uae_u16 padding;
 } __attribute__((aligned(8))) regstruct;
 
-extern regstruct regs;
+extern UAE_THREAD_LOCAL regstruct regs;
 
 #define m68k_dreg(r, num) ((r).regs[(num)])
 #define m68k_areg(r, num) (((r).regs + 8)[(num)])
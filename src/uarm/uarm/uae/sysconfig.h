@@ -1,5 +1,12 @@
 #define REGPARAM
 
+// The 68k registers are per thread, so independent instances can run concurrently
+#ifdef __cplusplus
+#define UAE_THREAD_LOCAL thread_local
+#else
+#define UAE_THREAD_LOCAL _Thread_local
+#endif
+
 #include <string.h>
 
 #ifdef _MSC_VER
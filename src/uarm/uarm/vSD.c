@@ -8,6 +8,7 @@
 #include <string.h>
 
 #include "cputil.h"
+#include "savestate_chunk.h"
 
 // this is not and will never be a full SD card emulator, deal with it!
 
@@ -32,6 +33,7 @@ enum State {  // matches and must match SD spec (v2 spec page 67 has the table)
 struct VSD {
     SdSectorR secR;
     SdSectorW secW;
+    void *secUserData;
     uint32_t nSec;
     enum State state;
     uint8_t busyCount;
@@ -579,7 +581,7 @@ enum SdDataReplyType vsdDataXferBlockToCard(struct VSD *vsd, const void *data, u
     // fprintf(stderr, "host to card xfer: %u bytes for sec %u\n", blockSz, vsd->curSec);
 
     if (vsd->bufIsData) {
-        if (!vsd->secW(vsd->curSec, data)) {
+        if (!vsd->secW(vsd->secUserData, vsd->curSec, data)) {
             fprintf(stderr, "failed to write SD backing store sec %lu\n",
                     (unsigned long)vsd->curSec);
             return SdDataErrBackingStore;
@@ -612,7 +614,7 @@ enum SdDataReplyType vsdDataXferBlockFromCard(struct VSD *vsd, void *data, uint3
     }
 
     if (vsd->bufIsData) {
-        if (!vsd->secR(vsd->curSec, data)) {
+        if (!vsd->secR(vsd->secUserData, vsd->curSec, data)) {
             fprintf(stderr, "failed to read SD backing store sec %lu\n",
                     (unsigned long)vsd->curSec);
             return SdDataErrBackingStore;
@@ -635,7 +637,7 @@ enum SdDataReplyType vsdDataXferBlockFromCard(struct VSD *vsd, void *data, uint3
     return SdDataOk;
 }
 
-struct VSD *vsdInit(SdSectorR sR, SdSectorW sW, uint32_t nSec) {
+struct VSD *vsdInit(SdSectorR sR, SdSectorW sW, void *userData, uint32_t nSec) {
     struct VSD *vsd = (struct VSD *)malloc(sizeof(struct VSD));
 
     if (vsd) {
@@ -643,6 +645,7 @@ struct VSD *vsdInit(SdSectorR sR, SdSectorW sW, uint32_t nSec) {
 
         vsd->secR = sR;
         vsd->secW = sW;
+        vsd->secUserData = userData;
         vsd->nSec = nSec;
 
         vsd->hcCard = nSec > 4194304;  // >2GB cards or more are reported as SDHC
@@ -679,3 +682,36 @@ uint8_t vsdCRC7(uint8_t *data, uint32_t sz) {
 
     return crc + 1;
 }
+
+void vsdSerialize(struct VSD *vsd, struct SavestateChunk *chunk) {
+    uint32_t state = vsd->state;
+    uint8_t flags = vsd->expectDataToUs | (vsd->hcCard << 1) | (vsd->acmdShift << 2) |
+                    (vsd->reportAcmdNext << 3);
+
+    savestateChunkDo32(chunk, &state);
+    savestateChunkDo8(chunk, &vsd->busyCount);
+    savestateChunkDo16(chunk, &vsd->rca);
+    savestateChunkDo32(chunk, &vsd->expectedBlockSz);
+    savestateChunkDoBuffer(chunk, vsd->dataBuf, sizeof(vsd->dataBuf));
+    savestateChunkDo8(chunk, &flags);
+
+    savestateChunkDo8(chunk, &vsd->initWaitLeft);
+    savestateChunkDo32(chunk, &vsd->prevAcmd41Param);
+
+    savestateChunkDoBuffer(chunk, vsd->curBuf, sizeof(vsd->curBuf));
+    savestateChunkDo32(chunk, &vsd->curSec);
+    savestateChunkDo16(chunk, &vsd->curBufLen);
+    savestateChunkDoBool(chunk, &vsd->bufIsData);
+    savestateChunkDoBool(chunk, &vsd->bufContinuous);
+
+    savestateChunkDoBool(chunk, &vsd->haveExpectedNumBlocks);
+    savestateChunkDo32(chunk, &vsd->numBlocksExpected);
+
+    if (state > StateDis) savestateChunkNotifyError(chunk);
+
+    vsd->state = state;
+    vsd->expectDataToUs = flags;
+    vsd->hcCard = flags >> 1;
+    vsd->acmdShift = flags >> 2;
+    vsd->reportAcmdNext = flags >> 3;
+}
@@ -10,6 +10,7 @@ extern "C" {
 #endif
 
 struct VSD;
+struct SavestateChunk;
 typedef struct VSD VSD;
 
 enum SdReplyType {
@@ -26,10 +27,12 @@ enum SdDataReplyType {
     SdDataErrBackingStore,
 };
 
-typedef bool (*SdSectorR)(uint32_t secNum, void *buf);
-typedef bool (*SdSectorW)(uint32_t secNum, const void *buf);
+typedef bool (*SdSectorR)(void *userData, uint32_t secNum, void *buf);
+typedef bool (*SdSectorW)(void *userData, uint32_t secNum, const void *buf);
 
-struct VSD *vsdInit(SdSectorR, SdSectorW, uint32_t nSec);
+struct VSD *vsdInit(SdSectorR, SdSectorW, void *userData, uint32_t nSec);
+
+void vsdSerialize(struct VSD *vsd, struct SavestateChunk *chunk);
 
 enum SdReplyType vsdCommand(struct VSD *vsd, uint8_t command, uint32_t param,
                             void *replyOut /* should be big enough for any reply */);
@@ -20,12 +20,14 @@
 #include <iostream>
 #include <memory>
 
+#include "FrameDiff.h"
 #include "MainLoop.h"
 #include "SoC.h"
 #include "audio_queue.h"
 #include "cputil.h"
 #include "device.h"
 #include "sdcard.h"
+#include "syscall_trace.h"
 
 using namespace std;
 
@@ -35,10 +37,30 @@ namespace {
     constexpr size_t AUDIO_QUEUE_SIZE = 44100 / MAIN_LOOP_FPS * 10;
 
     SoC* soc = nullptr;
+    SdCard* sdCard = nullptr;
 
     AudioQueue* audioQueue = nullptr;
     unique_ptr<MainLoop> mainLoop;
 
+    FrameDiffEncoder frameDiffEncoder;
+
+    char* syscallTraceExport = nullptr;
+
+    // The export stays valid until the next one
+    const char* exportSyscallTrace(void (*writer)(SyscallTrace*, FILE*)) {
+        SyscallTrace* trace = socGetSyscallTrace(soc);
+        if (!trace) return nullptr;
+
+        size_t size;
+        free(syscallTraceExport);
+
+        FILE* stream = open_memstream(&syscallTraceExport, &size);
+        writer(trace, stream);
+        fclose(stream);
+
+        return syscallTraceExport;
+    }
+
     void usage(const char* self) {
         fprintf(stderr,
                 "USAGE: %s {-r ROMFILE.bin | -x} [-g gdbPort] [-s SDCARD_IMG.bin] [-n NAND.bin] "
@@ -64,10 +86,10 @@ namespace {
             exit(-4);
         }
 
-        sdCardInitialize(sdCardSize / SD_SECTOR_SIZE);
+        sdCard = sdCardInitialize(sdCardSize / SD_SECTOR_SIZE);
 
         fseek(cardFile, 0, SEEK_SET);
-        size_t bytesRead = fread(sdCardData().data, 1, sdCardSize, cardFile);
+        size_t bytesRead = fread(sdCardData(sdCard).data, 1, sdCardSize, cardFile);
 
         if (bytesRead != sdCardSize) {
             fprintf(stderr, "failed to read sd card image %lu %lu\n", bytesRead, sdCardSize);
@@ -109,6 +131,24 @@ void EMSCRIPTEN_KEEPALIVE resetFrame() {
     socResetPendingFrame(soc);
 }
 
+// Encodes the pending frame against the last encoded one and returns the size of the packet, or 0
+// if there is no pending frame. The packet stays valid until the next call.
+uint32_t EMSCRIPTEN_KEEPALIVE encodeFrameDiff() {
+    uint32_t* frame = soc ? socGetPendingFrame(soc) : nullptr;
+    if (!frame) return 0;
+
+    DeviceDisplayConfiguration displayConfiguration;
+    deviceGetDisplayConfiguration(&displayConfiguration);
+
+    frameDiffEncoder.Encode(frame, displayConfiguration.width * 4, displayConfiguration.height, 32);
+
+    return frameDiffEncoder.GetSize();
+}
+
+void* EMSCRIPTEN_KEEPALIVE getFrameDiffData() { return frameDiffEncoder.GetData(); }
+
+void EMSCRIPTEN_KEEPALIVE requestFrameDiffKeyframe() { frameDiffEncoder.RequestKeyframe(); }
+
 uint32_t EMSCRIPTEN_KEEPALIVE getTimesliceSizeUsec() {
     return mainLoop ? mainLoop->GetTimesliceSizeUsec() : 0;
 }
@@ -179,27 +219,53 @@ bool EMSCRIPTEN_KEEPALIVE isNandDirty() { return socIsNandDirty(soc); }
 
 void EMSCRIPTEN_KEEPALIVE setNandDirty(bool isDirty) { socSetNandDirty(soc, isDirty); }
 
-uint32_t EMSCRIPTEN_KEEPALIVE getSdCardDataSize() { return sdCardData().size; }
+uint32_t EMSCRIPTEN_KEEPALIVE getSdCardDataSize() { return sdCard ? sdCardData(sdCard).size : 0; }
 
-void* EMSCRIPTEN_KEEPALIVE getSdCardData() { return sdCardData().data; }
+void* EMSCRIPTEN_KEEPALIVE getSdCardData() { return sdCard ? sdCardData(sdCard).data : nullptr; }
 
-void* EMSCRIPTEN_KEEPALIVE getSdCardDirtyPages() { return sdCardDirtyPages().data; }
+void* EMSCRIPTEN_KEEPALIVE getSdCardDirtyPages() {
+    return sdCard ? sdCardDirtyPages(sdCard).data : nullptr;
+}
 
-bool EMSCRIPTEN_KEEPALIVE isSdCardDirty() { return sdCardIsDirty(); }
+bool EMSCRIPTEN_KEEPALIVE isSdCardDirty() { return sdCard && sdCardIsDirty(sdCard); }
 
-void EMSCRIPTEN_KEEPALIVE setSdCardDirty(bool isDirty) { return sdCardSetDirty(isDirty); }
+void EMSCRIPTEN_KEEPALIVE setSdCardDirty(bool isDirty) {
+    if (sdCard) sdCardSetDirty(sdCard, isDirty);
+}
 
 uint32_t EMSCRIPTEN_KEEPALIVE getRamDataSize() { return socGetRamData(soc).size; }
 
 void* EMSCRIPTEN_KEEPALIVE getRamData() { return socGetRamData(soc).data; }
 
 void* EMSCRIPTEN_KEEPALIVE getRamDirtyPages() { return socGetRamDirtyPages(soc).data; }
+
+bool EMSCRIPTEN_KEEPALIVE saveState() { return socSave(soc); }
+
+uint32_t EMSCRIPTEN_KEEPALIVE getSavestateSize() { return socGetSavestate(soc).size; }
+
+void* EMSCRIPTEN_KEEPALIVE getSavestateData() { return socGetSavestate(soc).data; }
+
+bool EMSCRIPTEN_KEEPALIVE loadState(void* buffer, int size) { return socLoad(soc, size, buffer); }
+
+void EMSCRIPTEN_KEEPALIVE setSyscallTracing(bool tracing) { socSetSyscallTracing(soc, tracing); }
+
+void EMSCRIPTEN_KEEPALIVE resetSyscallTrace() {
+    SyscallTrace* trace = socGetSyscallTrace(soc);
+    if (trace) syscallTraceReset(trace);
+}
+
+const char* EMSCRIPTEN_KEEPALIVE getSyscallTraceStatistics() {
+    return exportSyscallTrace(syscallTraceWriteJson);
+}
+
+const char* EMSCRIPTEN_KEEPALIVE getSyscallChromeTrace() {
+    return exportSyscallTrace(syscallTraceWriteChromeTrace);
+}
 }
 
 void run(uint8_t* rom, uint32_t romLen, uint8_t* nand, size_t nandLen, int gdbPort,
          bool enableAudio, uint32_t mips = 0) {
-    soc = socInit(rom, romLen, sdCardSectorCount(), sdCardRead, sdCardWrite, nand, nandLen, gdbPort,
-                  deviceGetSocRev());
+    soc = socInit(rom, romLen, sdCard, nand, nandLen, gdbPort, deviceGetSocRev());
 
     audioQueue = audioQueueCreate(AUDIO_QUEUE_SIZE);
     socSetAudioQueue(soc, audioQueue);
@@ -214,7 +280,7 @@ extern "C" EMSCRIPTEN_KEEPALIVE void webMain(uint8_t* rom, int romLen, uint8_t*
                                              uint8_t* sd, int sdLen) {
     if (sd) {
         fprintf(stderr, "using %u bytes of SD\n", sdLen);
-        sdCardInitializeWithData(sdLen / SD_SECTOR_SIZE, sd);
+        sdCard = sdCardInitializeWithData(sdLen / SD_SECTOR_SIZE, sd);
     }
 
     fprintf(stderr, "using %u bytes of NOR\n", romLen);